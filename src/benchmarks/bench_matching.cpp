@@ -0,0 +1,248 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/matching/cascade_hasher.hpp"
+#include "openMVG/matching/metric.hpp"
+#include "openMVG/matching/metric_hamming.hpp"
+#include "openMVG/matching/regions_matcher.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::features;
+using namespace openMVG::matching;
+
+namespace {
+
+// Number of features per image used by the matcher benchmarks
+const size_t kFeatureCount = 2000;
+
+// Two views of a synthetic scene, described by regions whose ground truth
+//  correspondences are known: each 3D point gets a random descriptor and its
+//  projections a noisy copy of it. The query features are shuffled.
+template <typename RegionsT>
+struct SyntheticRegionsPair
+{
+  RegionsT database_regions, query_regions;
+  std::vector<uint32_t> ground_truth; // database index of each query feature
+
+  explicit SyntheticRegionsPair(const size_t feature_count)
+  {
+    // The data generation only uses fixed seeds
+    std::srand(0);
+    const NViewDataSet d = NRealisticCamerasRing(2, feature_count);
+    std::mt19937 random_generator(std::mt19937::default_seed);
+    std::uniform_int_distribution<int> value_distribution(0, 255);
+    std::uniform_int_distribution<int> noise_distribution(-8, 8);
+    std::uniform_int_distribution<int> bit_distribution(0, 63);
+
+    ground_truth.resize(feature_count);
+    std::iota(ground_truth.begin(), ground_truth.end(), 0);
+    std::shuffle(ground_truth.begin(), ground_truth.end(), random_generator);
+
+    using DescriptorT = typename RegionsT::DescriptorT;
+    database_regions.Descriptors().resize(feature_count);
+    query_regions.Descriptors().resize(feature_count);
+    for (size_t i = 0; i < feature_count; ++i)
+    {
+      const uint32_t j = ground_truth[i];
+      database_regions.Features().emplace_back(d._x[0](0, i), d._x[0](1, i), 1.f, 0.f);
+      query_regions.Features().emplace_back(d._x[1](0, j), d._x[1](1, j), 1.f, 0.f);
+
+      DescriptorT & descriptor = database_regions.Descriptors()[i];
+      for (uint32_t k = 0; k < DescriptorT::static_size; ++k)
+        descriptor(k) = value_distribution(random_generator);
+    }
+    for (size_t i = 0; i < feature_count; ++i)
+    {
+      const DescriptorT & descriptor = database_regions.Descriptors()[ground_truth[i]];
+      DescriptorT & noisy_descriptor = query_regions.Descriptors()[i];
+      for (uint32_t k = 0; k < DescriptorT::static_size; ++k)
+      {
+        if (query_regions.IsBinary())
+        {
+          // Flip a random bit of one byte out of eight
+          const int bit = bit_distribution(random_generator);
+          noisy_descriptor(k) = static_cast<int>(descriptor(k)) ^ ((bit < 8) ? (1 << bit) : 0);
+        }
+        else
+        {
+          noisy_descriptor(k) = std::min(std::max(
+            static_cast<int>(descriptor(k)) + noise_distribution(random_generator), 0), 255);
+        }
+      }
+    }
+  }
+
+  // Ratio of the ground truth correspondences that are found
+  //  (matches are given as (database, query) indexes)
+  double Recall(const IndMatches & matches) const
+  {
+    size_t inlier_count = 0;
+    for (const IndMatch & match : matches)
+      inlier_count += (ground_truth[match.j_] == match.i_);
+    return inlier_count / static_cast<double>(ground_truth.size());
+  }
+};
+
+template <typename RegionsT>
+void BenchmarkMatcher(State & state, const EMatcherType matcher_type)
+{
+  const SyntheticRegionsPair<RegionsT> data(kFeatureCount);
+  IndMatches matches;
+  // Create the matcher (index the database) and match the query regions, as
+  //  in the matching pipeline.
+  while (state.KeepRunning())
+  {
+    DistanceRatioMatch(0.8f, matcher_type,
+      data.database_regions, data.query_regions, matches);
+    DoNotOptimize(matches.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kFeatureCount);
+  state.counters["recall"] = data.Recall(matches);
+}
+
+template <typename MetricT, typename RegionsT>
+void BenchmarkMetric(State & state)
+{
+  const SyntheticRegionsPair<RegionsT> data(kFeatureCount);
+  const auto & database_descriptors = data.database_regions.Descriptors();
+  const auto & query_descriptors = data.query_regions.Descriptors();
+  const size_t size = RegionsT::DescriptorT::static_size;
+  MetricT metric;
+  // Distance of each query descriptor to its database correspondence
+  while (state.KeepRunning())
+  {
+    for (size_t i = 0; i < kFeatureCount; ++i)
+      DoNotOptimize(metric(database_descriptors[data.ground_truth[i]].data(),
+                           query_descriptors[i].data(), size));
+  }
+  state.SetItemsProcessed(state.iterations() * kFeatureCount);
+}
+
+using Float_Regions = Scalar_Regions<SIOPointFeature, float, 128>;
+
+} // namespace
+
+//-- Metrics (one item is one distance)
+
+OPENMVG_BENCHMARK(Metric, L2_uint8_128)
+{
+  BenchmarkMetric<L2<uint8_t>, SIFT_Regions>(state);
+}
+
+OPENMVG_BENCHMARK(Metric, L2_float_128)
+{
+  BenchmarkMetric<L2<float>, Float_Regions>(state);
+}
+
+OPENMVG_BENCHMARK(Metric, Hamming_512)
+{
+  BenchmarkMetric<Hamming<uint8_t>, AKAZE_Binary_Regions>(state);
+}
+
+//-- Matchers (one item is one query descriptor)
+
+OPENMVG_BENCHMARK(Matcher, BRUTE_FORCE_L2)
+{
+  BenchmarkMatcher<SIFT_Regions>(state, BRUTE_FORCE_L2);
+}
+
+OPENMVG_BENCHMARK(Matcher, ANN_L2)
+{
+  BenchmarkMatcher<SIFT_Regions>(state, ANN_L2);
+}
+
+OPENMVG_BENCHMARK(Matcher, CASCADE_HASHING_L2)
+{
+  BenchmarkMatcher<SIFT_Regions>(state, CASCADE_HASHING_L2);
+}
+
+OPENMVG_BENCHMARK(Matcher, HNSW_L2)
+{
+  BenchmarkMatcher<SIFT_Regions>(state, HNSW_L2);
+}
+
+OPENMVG_BENCHMARK(Matcher, BRUTE_FORCE_HAMMING)
+{
+  BenchmarkMatcher<AKAZE_Binary_Regions>(state, BRUTE_FORCE_HAMMING);
+}
+
+//-- CascadeHasher stages (one item is one descriptor)
+
+namespace {
+
+using DescriptorMatrix =
+  Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+DescriptorMatrix AsMatrix(const SIFT_Regions & regions)
+{
+  return Eigen::Map<const DescriptorMatrix>(
+    regions.Descriptors()[0].data(), regions.RegionCount(), 128);
+}
+
+} // namespace
+
+OPENMVG_BENCHMARK(CascadeHasher, CreateHashedDescriptions)
+{
+  const SyntheticRegionsPair<SIFT_Regions> data(kFeatureCount);
+  const DescriptorMatrix descriptors = AsMatrix(data.database_regions);
+  CascadeHasher cascade_hasher;
+  cascade_hasher.Init(128);
+  const Eigen::VectorXf zero_mean_descriptor =
+    CascadeHasher::GetZeroMeanDescriptor(descriptors);
+  while (state.KeepRunning())
+  {
+    const HashedDescriptions hashed_descriptions =
+      cascade_hasher.CreateHashedDescriptions(descriptors, zero_mean_descriptor);
+    DoNotOptimize(hashed_descriptions.hashed_desc.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kFeatureCount);
+}
+
+OPENMVG_BENCHMARK(CascadeHasher, Match_HashedDescriptions)
+{
+  const SyntheticRegionsPair<SIFT_Regions> data(kFeatureCount);
+  const DescriptorMatrix
+    database_descriptors = AsMatrix(data.database_regions),
+    query_descriptors = AsMatrix(data.query_regions);
+  CascadeHasher cascade_hasher;
+  cascade_hasher.Init(128);
+  const Eigen::VectorXf zero_mean_descriptor =
+    CascadeHasher::GetZeroMeanDescriptor(database_descriptors);
+  const HashedDescriptions
+    database_hashes = cascade_hasher.CreateHashedDescriptions(database_descriptors, zero_mean_descriptor),
+    query_hashes = cascade_hasher.CreateHashedDescriptions(query_descriptors, zero_mean_descriptor);
+
+  IndMatches matches;
+  std::vector<int> distances;
+  while (state.KeepRunning())
+  {
+    matches.clear();
+    distances.clear();
+    cascade_hasher.Match_HashedDescriptions(
+      query_hashes, query_descriptors,
+      database_hashes, database_descriptors,
+      &matches, &distances, 2);
+    DoNotOptimize(matches.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kFeatureCount);
+  // Ratio of the query features whose correspondence is in the 2 candidates
+  size_t inlier_count = 0;
+  for (const IndMatch & match : matches)
+    inlier_count += (data.ground_truth[match.i_] == match.j_);
+  state.counters["recall"] = inlier_count / static_cast<double>(kFeatureCount);
+}
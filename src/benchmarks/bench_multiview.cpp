@@ -0,0 +1,156 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "openMVG/multiview/projection.hpp"
+#include "openMVG/multiview/solver_essential_five_point.hpp"
+#include "openMVG/multiview/solver_homography_kernel.hpp"
+#include "openMVG/multiview/solver_resection_p3p_ke.hpp"
+#include "openMVG/multiview/solver_resection_p3p_kneip.hpp"
+#include "openMVG/multiview/solver_resection_p3p_nordberg.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/numeric/extract_columns.hpp"
+
+#include <cstdlib>
+#include <numeric>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+
+namespace {
+
+// Number of distinct minimal samples the solvers cycle on
+const size_t kSampleCount = 64;
+
+// Two views of a synthetic scene (noise free)
+struct SyntheticTwoViews
+{
+  NViewDataSet d;
+  Mat3X bearing1, bearing2;
+  // Minimal samples (point indexes) of the given size
+  std::vector<std::vector<uint32_t>> samples;
+
+  SyntheticTwoViews(const size_t sample_size, const bool planar_scene = false)
+  {
+    // The data generation only uses fixed seeds
+    std::srand(0);
+    d = NRealisticCamerasRing(8, 256);
+    if (planar_scene)
+    {
+      d._X.row(2).setZero();
+      for (size_t i = 0; i < d._n; ++i)
+        d._x[i] = Project(d.P(i), d._X);
+    }
+    bearing1 = (d._K[0].inverse() * d._x[0].colwise().homogeneous()).colwise().normalized();
+    bearing2 = (d._K[1].inverse() * d._x[1].colwise().homogeneous()).colwise().normalized();
+
+    std::mt19937 random_generator(std::mt19937::default_seed);
+    std::vector<uint32_t> point_ids(d._X.cols());
+    std::iota(point_ids.begin(), point_ids.end(), 0);
+    for (size_t i = 0; i < kSampleCount; ++i)
+    {
+      std::shuffle(point_ids.begin(), point_ids.end(), random_generator);
+      samples.emplace_back(point_ids.cbegin(), point_ids.cbegin() + sample_size);
+    }
+  }
+};
+
+template <typename SolverT>
+void BenchmarkP3P(State & state)
+{
+  const SyntheticTwoViews data(SolverT::MINIMUM_SAMPLES);
+  std::vector<Mat> bearing_samples, X_samples;
+  for (const auto & sample : data.samples)
+  {
+    bearing_samples.push_back(ExtractColumns(data.bearing1, sample));
+    X_samples.push_back(ExtractColumns(data.d._X, sample));
+  }
+
+  std::vector<Mat34> models;
+  size_t model_count = 0;
+  uint64_t i = 0;
+  while (state.KeepRunning())
+  {
+    models.clear();
+    SolverT::Solve(bearing_samples[i % kSampleCount], X_samples[i % kSampleCount], &models);
+    model_count += models.size();
+    DoNotOptimize(models.data());
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["models_per_solve"] = model_count / static_cast<double>(state.iterations());
+}
+
+} // namespace
+
+//-- Minimal solvers (one item is one solve)
+
+OPENMVG_BENCHMARK(Solver, FivePoint)
+{
+  const SyntheticTwoViews data(5);
+  std::vector<Mat3X> x1_samples, x2_samples;
+  for (const auto & sample : data.samples)
+  {
+    x1_samples.push_back(ExtractColumns(data.bearing1, sample));
+    x2_samples.push_back(ExtractColumns(data.bearing2, sample));
+  }
+
+  std::vector<Mat3> models;
+  size_t model_count = 0;
+  uint64_t i = 0;
+  while (state.KeepRunning())
+  {
+    models.clear();
+    FivePointsRelativePose(x1_samples[i % kSampleCount], x2_samples[i % kSampleCount], &models);
+    model_count += models.size();
+    DoNotOptimize(models.data());
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["models_per_solve"] = model_count / static_cast<double>(state.iterations());
+}
+
+OPENMVG_BENCHMARK(Solver, P3P_Kneip)
+{
+  BenchmarkP3P<euclidean_resection::P3PSolver_Kneip>(state);
+}
+
+OPENMVG_BENCHMARK(Solver, P3P_Ke)
+{
+  BenchmarkP3P<euclidean_resection::P3PSolver_Ke>(state);
+}
+
+OPENMVG_BENCHMARK(Solver, P3P_Nordberg)
+{
+  BenchmarkP3P<euclidean_resection::P3PSolver_Nordberg>(state);
+}
+
+OPENMVG_BENCHMARK(Solver, Homography_FourPoint)
+{
+  const SyntheticTwoViews data(4, true);
+  std::vector<Mat> x1_samples, x2_samples;
+  for (const auto & sample : data.samples)
+  {
+    x1_samples.push_back(ExtractColumns(data.d._x[0], sample));
+    x2_samples.push_back(ExtractColumns(data.d._x[1], sample));
+  }
+
+  std::vector<Mat3> models;
+  uint64_t i = 0;
+  while (state.KeepRunning())
+  {
+    models.clear();
+    homography::kernel::FourPointSolver::Solve(
+      x1_samples[i % kSampleCount], x2_samples[i % kSampleCount], &models);
+    DoNotOptimize(models.data());
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
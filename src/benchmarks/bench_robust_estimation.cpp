@@ -0,0 +1,146 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "openMVG/multiview/conditioning.hpp"
+#include "openMVG/multiview/projection.hpp"
+#include "openMVG/multiview/solver_essential_kernel.hpp"
+#include "openMVG/multiview/solver_fundamental_kernel.hpp"
+#include "openMVG/multiview/solver_homography_kernel.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
+
+#include <cstdlib>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::robust;
+
+namespace {
+
+// Image size of the synthetic cameras (nViewDatasetConfigurator default)
+const int kImageSize = 1000;
+
+// Noisy correspondences of two views of a synthetic scene:
+//  a gaussian noise (0.5 pixel) is added to the projections and a ratio of
+//  them is replaced by random image positions (outliers).
+struct SyntheticCorrespondences
+{
+  NViewDataSet d;
+  Mat2X x1, x2;
+  Mat3X bearing1, bearing2;
+
+  SyntheticCorrespondences
+  (
+    const size_t point_count,
+    const double outlier_ratio,
+    const bool planar_scene = false
+  )
+  {
+    // The data generation only uses fixed seeds
+    std::srand(0);
+    d = NRealisticCamerasRing(8, point_count);
+    if (planar_scene)
+    {
+      d._X.row(2).setZero();
+      for (size_t i = 0; i < d._n; ++i)
+        d._x[i] = Project(d.P(i), d._X);
+    }
+
+    std::mt19937 random_generator(std::mt19937::default_seed);
+    std::normal_distribution<double> noise_distribution(0.0, 0.5);
+    std::uniform_real_distribution<double> position_distribution(0.0, kImageSize);
+    x1 = d._x[0];
+    x2 = d._x[1];
+    const size_t outlier_count = outlier_ratio * point_count;
+    for (size_t i = 0; i < point_count; ++i)
+    {
+      if (i < outlier_count)
+      {
+        x2.col(i) << position_distribution(random_generator),
+                     position_distribution(random_generator);
+      }
+      else
+      {
+        x1.col(i) += Vec2(noise_distribution(random_generator), noise_distribution(random_generator));
+        x2.col(i) += Vec2(noise_distribution(random_generator), noise_distribution(random_generator));
+      }
+    }
+    bearing1 = (d._K[0].inverse() * x1.colwise().homogeneous()).colwise().normalized();
+    bearing2 = (d._K[1].inverse() * x2.colwise().homogeneous()).colwise().normalized();
+  }
+};
+
+template <typename KernelT>
+void BenchmarkACRansac
+(
+  State & state,
+  const KernelT & kernel,
+  const ACRansacEvaluationOptions & evaluation_options = ACRansacEvaluationOptions()
+)
+{
+  std::vector<uint32_t> vec_inliers;
+  typename KernelT::Model model;
+  while (state.KeepRunning())
+  {
+    ACRANSAC(kernel, vec_inliers, 1024, &model,
+      std::numeric_limits<double>::infinity(), false, evaluation_options);
+    DoNotOptimize(model.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["inlier_ratio"] = vec_inliers.size() / static_cast<double>(kernel.NumSamples());
+}
+
+using EssentialKernel = ACKernelAdaptorEssential<
+  essential::kernel::FivePointSolver,
+  fundamental::kernel::EpipolarDistanceError,
+  Mat3>;
+
+using HomographyKernel = ACKernelAdaptor<
+  homography::kernel::FourPointSolver,
+  homography::kernel::AsymmetricError,
+  UnnormalizerI,
+  Mat3>;
+
+} // namespace
+
+//-- A contrario robust estimation: 1024 iterations on 1000 correspondences
+//    with 30% of outliers (one item is one robust estimation)
+
+OPENMVG_BENCHMARK(ACRANSAC, Essential_FivePoint)
+{
+  const SyntheticCorrespondences data(1000, 0.3);
+  const EssentialKernel kernel(
+    data.x1, data.bearing1, kImageSize, kImageSize,
+    data.x2, data.bearing2, kImageSize, kImageSize,
+    data.d._K[0], data.d._K[1]);
+  BenchmarkACRansac(state, kernel);
+}
+
+OPENMVG_BENCHMARK(ACRANSAC, Homography_FourPoint)
+{
+  const SyntheticCorrespondences data(1000, 0.3, true);
+  const HomographyKernel kernel(
+    data.x1, kImageSize, kImageSize,
+    data.x2, kImageSize, kImageSize, false);
+  BenchmarkACRansac(state, kernel);
+}
+
+OPENMVG_BENCHMARK(ACRANSAC, Homography_FourPoint_BailOut)
+{
+  const SyntheticCorrespondences data(1000, 0.3, true);
+  const HomographyKernel kernel(
+    data.x1, kImageSize, kImageSize,
+    data.x2, kImageSize, kImageSize, false);
+  ACRansacEvaluationOptions evaluation_options;
+  evaluation_options.bail_out = true;
+  BenchmarkACRansac(state, kernel, evaluation_options);
+}
@@ -0,0 +1,119 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/tracks/tracks.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::benchmark;
+using namespace openMVG::matching;
+using namespace openMVG::tracks;
+
+namespace {
+
+// Pairwise matches of a synthetic scene: each view sees a random subset of
+//  the 3D points (with shuffled feature ids) and the views are matched with
+//  their neighbors on the camera ring. A small ratio of wrong matches creates
+//  conflicting tracks (one track seen twice in a view).
+PairWiseMatches SyntheticPairWiseMatches
+(
+  const size_t view_count,
+  const size_t point_count,
+  const size_t neighbor_count,
+  size_t & match_count
+)
+{
+  // The data generation only uses fixed seeds
+  std::srand(0);
+  const NViewDataSet d = NRealisticCamerasRing(view_count, point_count);
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  std::bernoulli_distribution visibility_distribution(0.8);
+  std::bernoulli_distribution outlier_distribution(0.001);
+
+  // feature_ids[view][point]: feature id of the point in the view (or -1)
+  std::vector<std::vector<int>> feature_ids(view_count);
+  for (size_t i = 0; i < view_count; ++i)
+  {
+    std::vector<int> shuffled_ids(d._X.cols());
+    std::iota(shuffled_ids.begin(), shuffled_ids.end(), 0);
+    std::shuffle(shuffled_ids.begin(), shuffled_ids.end(), random_generator);
+    feature_ids[i].resize(d._X.cols(), -1);
+    for (size_t j = 0; j < feature_ids[i].size(); ++j)
+      if (visibility_distribution(random_generator))
+        feature_ids[i][j] = shuffled_ids[j];
+  }
+
+  PairWiseMatches pairwise_matches;
+  match_count = 0;
+  for (size_t i = 0; i < view_count; ++i)
+  {
+    for (size_t k = 1; k <= neighbor_count; ++k)
+    {
+      const size_t j = (i + k) % view_count;
+      IndMatches & matches = pairwise_matches[{std::min(i, j), std::max(i, j)}];
+      for (size_t p = 0; p < feature_ids[i].size(); ++p)
+      {
+        const int feature_i = feature_ids[i][p];
+        const int feature_j = outlier_distribution(random_generator) ?
+          feature_ids[j][(p + 1) % feature_ids[j].size()] : feature_ids[j][p];
+        if (feature_i < 0 || feature_j < 0)
+          continue;
+        if (i < j)
+          matches.emplace_back(feature_i, feature_j);
+        else
+          matches.emplace_back(feature_j, feature_i);
+        ++match_count;
+      }
+    }
+  }
+  return pairwise_matches;
+}
+
+} // namespace
+
+//-- Tracks (one item is one pairwise match)
+
+OPENMVG_BENCHMARK(TracksBuilder, Build)
+{
+  size_t match_count = 0;
+  const PairWiseMatches pairwise_matches =
+    SyntheticPairWiseMatches(32, 2000, 4, match_count);
+  while (state.KeepRunning())
+  {
+    TracksBuilder tracks_builder;
+    tracks_builder.Build(pairwise_matches);
+    DoNotOptimize(tracks_builder.NbTracks());
+  }
+  state.SetItemsProcessed(state.iterations() * match_count);
+}
+
+OPENMVG_BENCHMARK(TracksBuilder, Build_Filter_Export)
+{
+  size_t match_count = 0;
+  const PairWiseMatches pairwise_matches =
+    SyntheticPairWiseMatches(32, 2000, 4, match_count);
+  STLMAPTracks map_tracks;
+  while (state.KeepRunning())
+  {
+    TracksBuilder tracks_builder;
+    tracks_builder.Build(pairwise_matches);
+    tracks_builder.Filter();
+    map_tracks.clear();
+    tracks_builder.ExportToSTL(map_tracks);
+    DoNotOptimize(map_tracks.size());
+  }
+  state.SetItemsProcessed(state.iterations() * match_count);
+  state.counters["track_count"] = map_tracks.size();
+}
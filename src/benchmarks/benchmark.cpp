@@ -0,0 +1,213 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+#include "openMVG/version.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+
+namespace openMVG {
+namespace benchmark {
+
+std::vector<Benchmark> & Registry()
+{
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+namespace {
+
+// Run the benchmark once with the given number of iterations
+State Run(const Benchmark & benchmark, uint64_t iterations)
+{
+  State state(iterations);
+  benchmark.function(state);
+  return state;
+}
+
+// Find a number of iterations such that a run lasts at least min_time
+uint64_t Calibrate(const Benchmark & benchmark, double min_time)
+{
+  const uint64_t max_iterations = 1000000000;
+  uint64_t iterations = 1;
+  while (iterations < max_iterations)
+  {
+    const double elapsed = Run(benchmark, iterations).elapsed_seconds();
+    if (elapsed >= min_time)
+      break;
+    // Predict the needed count with a 20% margin, but do not grow too fast
+    //  since the first runs are noisy (cold caches)
+    const double predicted = iterations * 1.2 * min_time / std::max(elapsed, 1e-9);
+    iterations = static_cast<uint64_t>(std::min(predicted, iterations * 10.));
+    iterations = std::min(std::max(iterations, uint64_t(2)), max_iterations);
+  }
+  return iterations;
+}
+
+std::string CompilerString()
+{
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " OPENMVG_TO_STRING(_MSC_VER);
+#else
+  return "unknown";
+#endif
+}
+
+std::string JSONString(const std::string & str)
+{
+  std::string escaped = "\"";
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+
+} // namespace
+
+std::vector<Result> RunBenchmarks(const Options & options, std::ostream & log)
+{
+  std::vector<Benchmark> benchmarks = Registry();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+    [](const Benchmark & a, const Benchmark & b) { return a.name < b.name; });
+
+  std::vector<Result> results;
+  for (const Benchmark & benchmark : benchmarks)
+  {
+    if (!options.filter.empty() &&
+        benchmark.name.find(options.filter) == std::string::npos)
+      continue;
+
+    log << benchmark.name << " ... " << std::flush;
+
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = Calibrate(benchmark, options.min_time);
+    result.repetitions = std::max(options.repetitions, 1);
+
+    std::vector<double> ns_per_iteration;
+    uint64_t items_processed = 0;
+    for (int i = 0; i < result.repetitions; ++i)
+    {
+      const State state = Run(benchmark, result.iterations);
+      ns_per_iteration.push_back(state.elapsed_seconds() * 1e9 / result.iterations);
+      items_processed = state.items_processed();
+      result.counters = state.counters;
+    }
+
+    std::sort(ns_per_iteration.begin(), ns_per_iteration.end());
+    const size_t n = ns_per_iteration.size();
+    result.median_ns = (n % 2) ? ns_per_iteration[n / 2]
+      : (ns_per_iteration[n / 2 - 1] + ns_per_iteration[n / 2]) / 2.;
+    result.min_ns = ns_per_iteration.front();
+    result.mean_ns = std::accumulate(ns_per_iteration.cbegin(), ns_per_iteration.cend(), 0.) / n;
+    double variance = 0.;
+    for (const double value : ns_per_iteration)
+      variance += (value - result.mean_ns) * (value - result.mean_ns);
+    result.stddev_ns = (n > 1) ? std::sqrt(variance / (n - 1)) : 0.;
+    if (items_processed > 0)
+    {
+      result.items_per_second =
+        static_cast<double>(items_processed) / result.iterations / (result.median_ns * 1e-9);
+    }
+
+    log << result.median_ns << " ns/iteration (" << result.iterations << " iterations)" << std::endl;
+    results.push_back(result);
+  }
+  return results;
+}
+
+void ExportJSON(const std::vector<Result> & results, const Options & options, std::ostream & os)
+{
+  os << std::setprecision(10);
+  os << "{\n"
+     << "  \"context\": {\n"
+     << "    \"openmvg_version\": " << JSONString(OPENMVG_VERSION_STRING) << ",\n"
+     << "    \"compiler\": " << JSONString(CompilerString()) << ",\n"
+#ifdef NDEBUG
+     << "    \"debug\": false,\n"
+#else
+     << "    \"debug\": true,\n"
+#endif
+#ifdef OPENMVG_USE_AVX2
+     << "    \"avx2\": true,\n"
+#else
+     << "    \"avx2\": false,\n"
+#endif
+#ifdef OPENMVG_USE_OPENMP
+     << "    \"openmp\": true,\n"
+#else
+     << "    \"openmp\": false,\n"
+#endif
+     << "    \"min_time\": " << options.min_time << ",\n"
+     << "    \"repetitions\": " << options.repetitions << "\n"
+     << "  },\n"
+     << "  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const Result & result = results[i];
+    os << (i == 0 ? "\n" : ",\n")
+       << "    {\n"
+       << "      \"name\": " << JSONString(result.name) << ",\n"
+       << "      \"iterations\": " << result.iterations << ",\n"
+       << "      \"repetitions\": " << result.repetitions << ",\n"
+       << "      \"median_ns\": " << result.median_ns << ",\n"
+       << "      \"min_ns\": " << result.min_ns << ",\n"
+       << "      \"mean_ns\": " << result.mean_ns << ",\n"
+       << "      \"stddev_ns\": " << result.stddev_ns << ",\n"
+       << "      \"items_per_second\": " << result.items_per_second << ",\n"
+       << "      \"counters\": {";
+    bool first = true;
+    for (const auto & counter : result.counters)
+    {
+      os << (first ? "" : ", ") << JSONString(counter.first) << ": " << counter.second;
+      first = false;
+    }
+    os << "}\n"
+       << "    }";
+  }
+  os << "\n  ]\n"
+     << "}" << std::endl;
+}
+
+void ExportCSV(const std::vector<Result> & results, std::ostream & os)
+{
+  os << std::setprecision(10);
+  os << "name,iterations,repetitions,median_ns,min_ns,mean_ns,stddev_ns,items_per_second,counters\n";
+  for (const Result & result : results)
+  {
+    os << result.name << ','
+       << result.iterations << ','
+       << result.repetitions << ','
+       << result.median_ns << ','
+       << result.min_ns << ','
+       << result.mean_ns << ','
+       << result.stddev_ns << ','
+       << result.items_per_second << ',';
+    bool first = true;
+    for (const auto & counter : result.counters)
+    {
+      os << (first ? "" : ";") << counter.first << '=' << counter.second;
+      first = false;
+    }
+    os << '\n';
+  }
+  os << std::flush;
+}
+
+} // namespace benchmark
+} // namespace openMVG
@@ -0,0 +1,162 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_BENCHMARKS_BENCHMARK_HPP
+#define OPENMVG_BENCHMARKS_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//------------------
+//-- Micro-benchmark harness
+//------------------
+// A benchmark is a function that prepares its data and then times a loop:
+//
+//  OPENMVG_BENCHMARK(Metric, L2_float)
+//  {
+//    const std::vector<float> a = ..., b = ...;  // Not timed
+//    while (state.KeepRunning())                 // Timed
+//      DoNotOptimize(metric(a.data(), b.data(), a.size()));
+//    state.SetItemsProcessed(state.iterations());
+//  }
+//
+// The runner chooses the number of iterations so that a run lasts at least
+// the asked minimal time, then repeats the run and reports statistics of the
+// time per iteration. The data must be generated with fixed seeds so that the
+// results of two builds can be compared.
+//------------------
+
+namespace openMVG {
+namespace benchmark {
+
+class State
+{
+public:
+  explicit State(uint64_t max_iterations)
+    : max_iterations_(max_iterations)
+  {
+  }
+
+  /// Return true while some iterations have to be timed.
+  /// The timer starts at the first call and stops at the last one.
+  bool KeepRunning()
+  {
+    if (!started_)
+    {
+      started_ = true;
+      start_ = Clock::now();
+    }
+    if (iterations_ < max_iterations_)
+    {
+      ++iterations_;
+      return true;
+    }
+    elapsed_ += Clock::now() - start_;
+    return false;
+  }
+
+  /// Exclude some work done inside the loop from the timing.
+  void PauseTiming() { elapsed_ += Clock::now() - start_; }
+  void ResumeTiming() { start_ = Clock::now(); }
+
+  uint64_t iterations() const { return max_iterations_; }
+
+  /// Number of processed items (matches, descriptors, ...) by the whole run.
+  void SetItemsProcessed(uint64_t items) { items_processed_ = items; }
+  uint64_t items_processed() const { return items_processed_; }
+
+  /// Informative values (i.e. a recall) exported along the timings.
+  std::map<std::string, double> counters;
+
+  double elapsed_seconds() const
+  {
+    return std::chrono::duration<double>(elapsed_).count();
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  uint64_t max_iterations_ = 0;
+  uint64_t iterations_ = 0;
+  uint64_t items_processed_ = 0;
+  bool started_ = false;
+  Clock::time_point start_;
+  Clock::duration elapsed_ = Clock::duration::zero();
+};
+
+using BenchmarkFunction = std::function<void(State &)>;
+
+struct Benchmark
+{
+  std::string name;
+  BenchmarkFunction function;
+};
+
+/// The registered benchmarks (sorted by name when they are run)
+std::vector<Benchmark> & Registry();
+
+struct Registrar
+{
+  Registrar(const std::string & name, const BenchmarkFunction & function)
+  {
+    Registry().push_back({name, function});
+  }
+};
+
+/// Prevent the compiler to optimize out a computed value.
+template <typename T>
+inline void DoNotOptimize(const T & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void * sink;
+  sink = &value;
+#endif
+}
+
+struct Options
+{
+  std::string filter;         // Run only the benchmarks whose name contains it
+  double min_time = 0.5;      // Minimal duration of a run (seconds)
+  int repetitions = 5;        // Number of timed runs
+  std::string format = "json";// Output format: json or csv
+};
+
+struct Result
+{
+  std::string name;
+  uint64_t iterations = 0;
+  int repetitions = 0;
+  double median_ns = 0., min_ns = 0., mean_ns = 0., stddev_ns = 0.;
+  double items_per_second = 0.;
+  std::map<std::string, double> counters;
+};
+
+/// Run the registered benchmarks that match the filter.
+std::vector<Result> RunBenchmarks(const Options & options, std::ostream & log);
+
+void ExportJSON(const std::vector<Result> & results, const Options & options, std::ostream & os);
+void ExportCSV(const std::vector<Result> & results, std::ostream & os);
+
+} // namespace benchmark
+} // namespace openMVG
+
+/// Declare and register the benchmark "Group/Name"
+#define OPENMVG_BENCHMARK(Group, Name) \
+  static void Group##_##Name##_Benchmark(openMVG::benchmark::State & state); \
+  static const openMVG::benchmark::Registrar Group##_##Name##_Registrar \
+    (#Group "/" #Name, Group##_##Name##_Benchmark); \
+  static void Group##_##Name##_Benchmark(openMVG::benchmark::State & state)
+
+#endif // OPENMVG_BENCHMARKS_BENCHMARK_HPP
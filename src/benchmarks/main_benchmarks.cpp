@@ -0,0 +1,99 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "benchmarks/benchmark.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace openMVG::benchmark;
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+
+  Options options;
+  std::string sOutputFile;
+
+  cmd.add( make_option('f', options.filter, "filter") );
+  cmd.add( make_option('t', options.min_time, "min_time") );
+  cmd.add( make_option('r', options.repetitions, "repetitions") );
+  cmd.add( make_option('F', options.format, "format") );
+  cmd.add( make_option('o', sOutputFile, "output") );
+  cmd.add( make_switch('l', "list") );
+
+  try {
+    cmd.process(argc, argv);
+  } catch (const std::string& s) {
+    std::cerr << "Usage: " << argv[0] << '\n'
+      << "[-f|--filter] run only the benchmarks whose name contains this string\n"
+      << "[-t|--min_time] minimal duration of a timed run in seconds (default: 0.5)\n"
+      << "[-r|--repetitions] number of timed runs (default: 5)\n"
+      << "[-F|--format] output format:\n"
+      << "   json: (default)\n"
+      << "   csv\n"
+      << "[-o|--output] output file (default: standard output)\n"
+      << "[-l|--list] list the available benchmarks\n"
+      << std::endl;
+
+    std::cerr << s << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (cmd.used('l'))
+  {
+    std::vector<std::string> names;
+    for (const Benchmark & benchmark : Registry())
+      names.push_back(benchmark.name);
+    std::sort(names.begin(), names.end());
+    for (const std::string & name : names)
+      std::cout << name << '\n';
+    return EXIT_SUCCESS;
+  }
+
+  if (options.format != "json" && options.format != "csv")
+  {
+    std::cerr << "Invalid output format: " << options.format << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (options.min_time <= 0. || options.repetitions < 1)
+  {
+    std::cerr << "Invalid min_time or repetitions." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The progress log goes to std::cerr, so that std::cout can be redirected
+  const std::vector<Result> results = RunBenchmarks(options, std::cerr);
+  if (results.empty())
+  {
+    std::cerr << "No benchmark matches the filter: " << options.filter << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream file;
+  if (!sOutputFile.empty())
+  {
+    file.open(sOutputFile);
+    if (!file)
+    {
+      std::cerr << "Cannot open the output file: " << sOutputFile << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream & os = sOutputFile.empty() ? std::cout : file;
+  if (options.format == "json")
+    ExportJSON(results, options, os);
+  else
+    ExportCSV(results, os);
+
+  return EXIT_SUCCESS;
+}
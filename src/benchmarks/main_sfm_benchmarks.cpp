@@ -0,0 +1,439 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Scalability benchmark of the SfM pipelines on synthetic scenes:
+//  for each scene size, a scene is generated and the asked stages
+//  (track building, incremental, global and stellar SfM, bundle adjustment)
+//  are timed on it. Each stage reports its time and its peak memory.
+
+#include "openMVG/cameras/Camera_Common.hpp"
+#include "openMVG/sfm/pipelines/global/sfm_global_engine_relative_motions.hpp"
+#include "openMVG/sfm/pipelines/sequential/sequential_SfM.hpp"
+#include "openMVG/sfm/pipelines/sequential/sequential_SfM2.hpp"
+#include "openMVG/sfm/pipelines/sequential/SfmSceneInitializerStellar.hpp"
+#include "openMVG/sfm/pipelines/sfm_synthetic_scene.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+#include "openMVG/system/memory_usage.hpp"
+#include "openMVG/tracks/tracks.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::sfm;
+
+namespace {
+
+struct StageResult
+{
+  std::string stage;
+  IndexT view_count = 0;
+  IndexT landmark_count = 0;
+  double seconds = 0.0;
+  uint64_t peak_memory = 0; // bytes
+  bool success = false;
+  // Reconstruction statistics (0 if not relevant)
+  size_t reconstructed_poses = 0;
+  size_t reconstructed_landmarks = 0;
+  double rmse = 0.0;
+};
+
+// Root mean square of the landmark reprojection residuals
+double RMSE(const SfM_Data & sfm_data)
+{
+  double squared_error_sum = 0.0;
+  size_t residual_count = 0;
+  for (const auto & landmark_it : sfm_data.GetLandmarks())
+  {
+    for (const auto & obs_it : landmark_it.second.obs)
+    {
+      const View * view = sfm_data.GetViews().at(obs_it.first).get();
+      if (!sfm_data.IsPoseAndIntrinsicDefined(view))
+        continue;
+      const geometry::Pose3 pose = sfm_data.GetPoseOrDie(view);
+      const auto intrinsic = sfm_data.GetIntrinsics().at(view->id_intrinsic);
+      squared_error_sum +=
+        intrinsic->residual(pose(landmark_it.second.X), obs_it.second.x).squaredNorm();
+      ++residual_count;
+    }
+  }
+  return residual_count == 0 ? 0.0 : std::sqrt(squared_error_sum / residual_count);
+}
+
+// Time a stage and measure its peak memory
+StageResult RunStage
+(
+  const std::string & stage,
+  const SyntheticScene & scene,
+  const std::function<bool(StageResult &)> & function
+)
+{
+  StageResult result;
+  result.stage = stage;
+  result.view_count = scene.sfm_data.GetViews().size();
+  result.landmark_count = scene.sfm_data.GetLandmarks().size();
+
+  std::cerr << "-- " << stage << " (" << result.view_count << " views)" << std::endl;
+  system::ResetPeakMemoryUsage();
+  const auto start = std::chrono::steady_clock::now();
+  result.success = function(result);
+  result.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  result.peak_memory = system::PeakMemoryUsage();
+  std::cerr << "   " << result.seconds << " s, "
+    << result.peak_memory / double(1 << 20) << " MiB"
+    << (result.success ? "" : " (failed)") << std::endl;
+  return result;
+}
+
+// Record the size of a reconstructed scene
+void SetReconstructionStatistics
+(
+  const SfM_Data & sfm_data,
+  StageResult & result
+)
+{
+  result.reconstructed_poses = sfm_data.GetPoses().size();
+  result.reconstructed_landmarks = sfm_data.GetLandmarks().size();
+  result.rmse = RMSE(sfm_data);
+}
+
+// The pipelines input: the scene without its poses and landmarks
+SfM_Data PipelineInput(const SfM_Data & ground_truth)
+{
+  SfM_Data sfm_data;
+  sfm_data.views = ground_truth.views;
+  sfm_data.intrinsics = ground_truth.intrinsics;
+  return sfm_data;
+}
+
+void ExportJSON
+(
+  const std::vector<StageResult> & results,
+  const SyntheticSceneOptions & options,
+  std::ostream & os
+)
+{
+  const char * trajectories[] = {"RING", "LINE", "GRID"};
+  os << "{\n"
+     << "  \"context\": {\n"
+     << "    \"trajectory\": \"" << trajectories[int(options.trajectory)] << "\",\n"
+     << "    \"observation_noise\": " << options.observation_noise << ",\n"
+     << "    \"outlier_ratio\": " << options.outlier_ratio << ",\n"
+     << "    \"max_track_length\": " << options.max_track_length << ",\n"
+     << "    \"peak_memory_per_stage\": "
+     << (system::ResetPeakMemoryUsage() ? "true" : "false") << "\n"
+     << "  },\n"
+     << "  \"stages\": [";
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const StageResult & result = results[i];
+    os << (i == 0 ? "\n" : ",\n")
+       << "    {\n"
+       << "      \"stage\": \"" << result.stage << "\",\n"
+       << "      \"view_count\": " << result.view_count << ",\n"
+       << "      \"landmark_count\": " << result.landmark_count << ",\n"
+       << "      \"success\": " << (result.success ? "true" : "false") << ",\n"
+       << "      \"seconds\": " << result.seconds << ",\n"
+       << "      \"peak_memory_bytes\": " << result.peak_memory << ",\n"
+       << "      \"reconstructed_poses\": " << result.reconstructed_poses << ",\n"
+       << "      \"reconstructed_landmarks\": " << result.reconstructed_landmarks << ",\n"
+       << "      \"rmse\": " << result.rmse << "\n"
+       << "    }";
+  }
+  os << "\n  ]\n}" << std::endl;
+}
+
+void ExportCSV
+(
+  const std::vector<StageResult> & results,
+  std::ostream & os
+)
+{
+  os << "stage,view_count,landmark_count,success,seconds,peak_memory_bytes,"
+     << "reconstructed_poses,reconstructed_landmarks,rmse\n";
+  for (const StageResult & result : results)
+  {
+    os << result.stage << ',' << result.view_count << ',' << result.landmark_count << ','
+       << result.success << ',' << result.seconds << ',' << result.peak_memory << ','
+       << result.reconstructed_poses << ',' << result.reconstructed_landmarks << ','
+       << result.rmse << '\n';
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+
+  SyntheticSceneOptions scene_options;
+  std::string sTrajectory = "LINE";
+  std::string sViewCounts = "1000";
+  int landmarks_per_view = 100;
+  std::string sStages = "tracks,incremental,global,stellar,ba";
+  std::string sWorkDir = "sfm_benchmarks";
+  std::string sExportDir;
+  std::string sFormat = "json";
+  std::string sOutputFile;
+
+  cmd.add( make_option('t', sTrajectory, "trajectory") );
+  cmd.add( make_option('n', sViewCounts, "views") );
+  cmd.add( make_option('l', landmarks_per_view, "landmarks_per_view") );
+  cmd.add( make_option('s', sStages, "stages") );
+  cmd.add( make_option('N', scene_options.observation_noise, "noise") );
+  cmd.add( make_option('R', scene_options.outlier_ratio, "outlier_ratio") );
+  cmd.add( make_option('w', sWorkDir, "work_dir") );
+  cmd.add( make_option('e', sExportDir, "export_dir") );
+  cmd.add( make_option('F', sFormat, "format") );
+  cmd.add( make_option('o', sOutputFile, "output") );
+
+  try {
+    cmd.process(argc, argv);
+  } catch (const std::string& s) {
+    std::cerr << "Usage: " << argv[0] << '\n'
+      << "[-t|--trajectory] camera trajectory of the synthetic scenes:\n"
+      << "   RING: cameras on a circle, looking at its center\n"
+      << "   LINE: (default) cameras on a line, looking sideways\n"
+      << "   GRID: cameras on a grid, looking down\n"
+      << "[-n|--views] comma separated list of scene sizes (default: 1000)\n"
+      << "   i.e. 1000,10000,100000\n"
+      << "[-l|--landmarks_per_view] (default: 100)\n"
+      << "[-s|--stages] comma separated list of the stages to run\n"
+      << "   (default: tracks,incremental,global,stellar,ba)\n"
+      << "[-N|--noise] observation noise in pixel (default: 0.5)\n"
+      << "[-R|--outlier_ratio] ratio of wrong matches (default: 0.05)\n"
+      << "[-w|--work_dir] directory of the pipelines outputs (default: sfm_benchmarks)\n"
+      << "[-e|--export_dir] export the generated scenes (SfM_Data, features and matches)\n"
+      << "[-F|--format] output format:\n"
+      << "   json: (default)\n"
+      << "   csv\n"
+      << "[-o|--output] output file (default: standard output)\n"
+      << std::endl;
+
+    std::cerr << s << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::map<std::string, ESyntheticTrajectory> trajectories =
+  {
+    {"RING", ESyntheticTrajectory::RING},
+    {"LINE", ESyntheticTrajectory::LINE},
+    {"GRID", ESyntheticTrajectory::GRID}
+  };
+  if (trajectories.count(sTrajectory) == 0)
+  {
+    std::cerr << "Invalid trajectory: " << sTrajectory << std::endl;
+    return EXIT_FAILURE;
+  }
+  scene_options.trajectory = trajectories.at(sTrajectory);
+
+  std::vector<IndexT> view_counts;
+  {
+    std::istringstream is(sViewCounts);
+    std::string token;
+    while (std::getline(is, token, ','))
+      view_counts.push_back(std::strtoul(token.c_str(), nullptr, 10));
+  }
+  std::vector<std::string> stages;
+  {
+    std::istringstream is(sStages);
+    std::string token;
+    while (std::getline(is, token, ','))
+      stages.push_back(token);
+  }
+  for (const std::string & stage : stages)
+  {
+    if (stage != "tracks" && stage != "incremental" && stage != "global" &&
+        stage != "stellar" && stage != "ba")
+    {
+      std::cerr << "Invalid stage: " << stage << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (sFormat != "json" && sFormat != "csv")
+  {
+    std::cerr << "Invalid output format: " << sFormat << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (view_counts.empty() || landmarks_per_view <= 0)
+  {
+    std::cerr << "Invalid scene size." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<StageResult> results;
+  for (const IndexT view_count : view_counts)
+  {
+    scene_options.view_count = view_count;
+    scene_options.landmark_count = view_count * landmarks_per_view;
+
+    SyntheticScene scene;
+    const StageResult generation = RunStage("generation", scene, [&](StageResult &)
+    {
+      return GenerateSyntheticScene(scene_options, scene);
+    });
+    results.push_back(generation);
+    results.back().view_count = view_count;
+    results.back().landmark_count = scene.sfm_data.GetLandmarks().size();
+    if (!generation.success)
+      return EXIT_FAILURE;
+
+    if (!sExportDir.empty())
+    {
+      const std::string scene_dir =
+        stlplus::create_filespec(sExportDir, std::to_string(view_count));
+      if (!stlplus::folder_exists(sExportDir))
+        stlplus::folder_create(sExportDir);
+      if (!ExportSyntheticScene(scene, scene_dir))
+      {
+        std::cerr << "Cannot export the scene to: " << scene_dir << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    for (const std::string & stage : stages)
+    {
+      // The engines export their intermediate results in their output directory
+      const std::string out_dir = stlplus::create_filespec(
+        stlplus::create_filespec(sWorkDir, std::to_string(view_count)), stage);
+      if (stage != "tracks" && stage != "ba" && !stlplus::folder_exists(out_dir))
+      {
+        stlplus::folder_create(sWorkDir);
+        stlplus::folder_create(stlplus::folder_part(out_dir));
+        if (!stlplus::folder_create(out_dir))
+        {
+          std::cerr << "Cannot create the work directory: " << out_dir << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      if (stage == "tracks")
+      {
+        results.push_back(RunStage(stage, scene, [&](StageResult & result)
+        {
+          tracks::TracksBuilder tracks_builder;
+          tracks_builder.Build(scene.matches_provider.pairWise_matches_);
+          tracks_builder.Filter();
+          tracks::STLMAPTracks map_tracks;
+          tracks_builder.ExportToSTL(map_tracks);
+          result.reconstructed_landmarks = map_tracks.size();
+          return !map_tracks.empty();
+        }));
+      }
+      else if (stage == "incremental")
+      {
+        SfM_Data sfm_data = PipelineInput(scene.sfm_data);
+        results.push_back(RunStage(stage, scene, [&](StageResult & result)
+        {
+          SequentialSfMReconstructionEngine sfm_engine(sfm_data, out_dir);
+          sfm_engine.SetFeaturesProvider(&scene.features_provider);
+          sfm_engine.SetMatchesProvider(&scene.matches_provider);
+          sfm_engine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::NONE);
+          const bool success = sfm_engine.Process();
+          SetReconstructionStatistics(sfm_engine.Get_SfM_Data(), result);
+          return success;
+        }));
+      }
+      else if (stage == "global")
+      {
+        SfM_Data sfm_data = PipelineInput(scene.sfm_data);
+        results.push_back(RunStage(stage, scene, [&](StageResult & result)
+        {
+          GlobalSfMReconstructionEngine_RelativeMotions sfm_engine(sfm_data, out_dir);
+          sfm_engine.SetFeaturesProvider(&scene.features_provider);
+          sfm_engine.SetMatchesProvider(&scene.matches_provider);
+          sfm_engine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::NONE);
+          const bool success = sfm_engine.Process();
+          SetReconstructionStatistics(sfm_engine.Get_SfM_Data(), result);
+          return success;
+        }));
+      }
+      else if (stage == "stellar")
+      {
+        SfM_Data sfm_data = PipelineInput(scene.sfm_data);
+        results.push_back(RunStage(stage, scene, [&](StageResult & result)
+        {
+          SfMSceneInitializerStellar scene_initializer(
+            sfm_data, &scene.features_provider, &scene.matches_provider);
+          SequentialSfMReconstructionEngine2 sfm_engine(&scene_initializer, sfm_data, out_dir);
+          sfm_engine.SetFeaturesProvider(&scene.features_provider);
+          sfm_engine.SetMatchesProvider(&scene.matches_provider);
+          sfm_engine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::NONE);
+          const bool success = sfm_engine.Process();
+          SetReconstructionStatistics(sfm_engine.Get_SfM_Data(), result);
+          return success;
+        }));
+      }
+      else if (stage == "ba")
+      {
+        // Refine the ground truth scene once its poses and landmarks are perturbed
+        SfM_Data sfm_data = scene.sfm_data;
+        std::mt19937 random_generator(std::mt19937::default_seed);
+        std::normal_distribution<double> pose_noise(0.0, 0.01), point_noise(0.0, 0.05);
+        for (auto & pose_it : sfm_data.poses)
+        {
+          const geometry::Pose3 & pose = pose_it.second;
+          const Mat3 R = RotationAroundX(pose_noise(random_generator)) *
+            RotationAroundY(pose_noise(random_generator)) * pose.rotation();
+          const Vec3 C = pose.center() + Vec3(pose_noise(random_generator),
+            pose_noise(random_generator), pose_noise(random_generator));
+          pose_it.second = geometry::Pose3(R, C);
+        }
+        for (auto & landmark_it : sfm_data.structure)
+        {
+          landmark_it.second.X += Vec3(point_noise(random_generator),
+            point_noise(random_generator), point_noise(random_generator));
+        }
+        results.push_back(RunStage(stage, scene, [&](StageResult & result)
+        {
+          Bundle_Adjustment_Ceres bundle_adjustment(
+            Bundle_Adjustment_Ceres::BA_Ceres_options(false));
+          const bool success = bundle_adjustment.Adjust(sfm_data,
+            Optimize_Options(
+              cameras::Intrinsic_Parameter_Type::NONE,
+              Extrinsic_Parameter_Type::ADJUST_ALL,
+              Structure_Parameter_Type::ADJUST_ALL));
+          SetReconstructionStatistics(sfm_data, result);
+          return success;
+        }));
+      }
+    }
+  }
+
+  std::ofstream file;
+  if (!sOutputFile.empty())
+  {
+    file.open(sOutputFile);
+    if (!file)
+    {
+      std::cerr << "Cannot open the output file: " << sOutputFile << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream & os = sOutputFile.empty() ? std::cout : file;
+  if (sFormat == "json")
+    ExportJSON(results, scene_options, os);
+  else
+    ExportCSV(results, os);
+
+  return EXIT_SUCCESS;
+}
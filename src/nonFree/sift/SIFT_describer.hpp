@@ -14,8 +14,10 @@
 #include "openMVG/image/image_container.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <numeric>
+#include <vector>
 
 extern "C" {
 #include "nonFree/sift/vl/sift.h"
@@ -154,63 +156,44 @@ public:
     if (_params._peak_threshold >= 0)
       vl_sift_set_peak_thresh(filt, 255*_params._peak_threshold/_params._num_scales);
 
-    Descriptor<vl_sift_pix, 128> descr;
-    Descriptor<unsigned char, 128> descriptor;
-
     // Process SIFT computation
     vl_sift_process_first_octave(filt, If.data());
 
     // Build alias to cached data
     auto regions = std::unique_ptr<Regions_type>(new Regions_type);
 
+    if (max_features_ > 0)
+    {
+      DescribeSIFT_Selection(filt, If, mask, *regions);
+      vl_sift_delete(filt);
+      return regions;
+    }
+
     // reserve some memory for faster keypoint saving
     regions->Features().reserve(2000);
     regions->Descriptors().reserve(2000);
 
+    std::vector<const VlSiftKeypoint *> octave_keys;
     while (true) {
       vl_sift_detect(filt);
 
       VlSiftKeypoint const *keys  = vl_sift_get_keypoints(filt);
       const int nkeys = vl_sift_get_nkeypoints(filt);
 
-      // Update gradient before launching parallel extraction
-      vl_sift_update_gradient(filt);
-
-      #ifdef OPENMVG_USE_OPENMP
-      #pragma omp parallel for private(descr, descriptor)
-      #endif
+      // Feature masking
+      octave_keys.clear();
       for (int i = 0; i < nkeys; ++i) {
-
-        // Feature masking
         if (mask)
         {
           const image::Image<unsigned char> & maskIma = *mask;
           if (maskIma(keys[i].y, keys[i].x) == 0)
             continue;
         }
+        octave_keys.push_back(keys + i);
+      }
 
-        double angles [4] = {0.0, 0.0, 0.0, 0.0};
-        int nangles = 1; // by default (1 upright feature)
-        if (_bOrientation)
-        { // compute from 1 to 4 orientations
-          nangles = vl_sift_calc_keypoint_orientations(filt, angles, keys+i);
-        }
+      DescribeKeypoints(filt, octave_keys, regions->Features(), regions->Descriptors());
 
-        for (int q=0 ; q < nangles ; ++q) {
-          vl_sift_calc_keypoint_descriptor(filt, &descr[0], keys+i, angles[q]);
-          const SIOPointFeature fp(keys[i].x, keys[i].y,
-            keys[i].sigma, static_cast<float>(angles[q]));
-
-          siftDescToUChar(&descr[0], descriptor, _params._root_sift);
-          #ifdef OPENMVG_USE_OPENMP
-          #pragma omp critical
-          #endif
-          {
-            regions->Descriptors().push_back(descriptor);
-            regions->Features().push_back(fp);
-          }
-        }
-      }
       if (vl_sift_process_next_octave(filt))
         break; // Last octave
     }
@@ -228,6 +211,223 @@ public:
   inline void serialize( Archive & ar );
 
 private:
+  /**
+  @brief Compute the regions of keypoints of the current octave (from 1 to 4
+    regions per keypoint, depending on the found orientations).
+    The keypoints are described in parallel in per keypoint slots, then the
+    regions are appended in the keypoints order: the output does not depend
+    on the number of threads.
+  @param filt SIFT filter (processing the octave of the keypoints).
+  @param keys The keypoints to describe.
+  @param[in,out] features The regions features.
+  @param[in,out] descriptors The regions descriptors.
+  @param[out] region_keys Index in keys of each appended region (optional).
+  */
+  void DescribeKeypoints(
+    VlSiftFilt * filt,
+    const std::vector<const VlSiftKeypoint *> & keys,
+    Regions_type::FeatsT & features,
+    Regions_type::DescsT & descriptors,
+    std::vector<uint32_t> * region_keys = nullptr
+  ) const
+  {
+    if (keys.empty())
+      return;
+
+    // Update gradient before launching parallel extraction
+    vl_sift_update_gradient(filt);
+
+    const int max_orientations = 4;
+    std::vector<int> key_region_count(keys.size(), 0);
+    Regions_type::FeatsT key_features(keys.size() * max_orientations);
+    Regions_type::DescsT key_descriptors(keys.size() * max_orientations);
+
+    #ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 32)
+    #endif
+    for (int i = 0; i < static_cast<int>(keys.size()); ++i) {
+      const VlSiftKeypoint * key = keys[i];
+
+      double angles [4] = {0.0, 0.0, 0.0, 0.0};
+      int nangles = 1; // by default (1 upright feature)
+      if (_bOrientation)
+      { // compute from 1 to 4 orientations
+        nangles = vl_sift_calc_keypoint_orientations(filt, angles, key);
+      }
+
+      Descriptor<vl_sift_pix, 128> descr;
+      for (int q=0 ; q < nangles ; ++q) {
+        vl_sift_calc_keypoint_descriptor(filt, &descr[0], key, angles[q]);
+        key_features[i * max_orientations + q] = SIOPointFeature(key->x, key->y,
+          key->sigma, static_cast<float>(angles[q]));
+        siftDescToUChar(&descr[0], key_descriptors[i * max_orientations + q], _params._root_sift);
+      }
+      key_region_count[i] = nangles;
+    }
+
+    // Concatenate the regions in the keypoints order
+    for (size_t i = 0; i < keys.size(); ++i) {
+      for (int q = 0; q < key_region_count[i]; ++q) {
+        features.push_back(key_features[i * max_orientations + q]);
+        descriptors.push_back(key_descriptors[i * max_orientations + q]);
+        if (region_keys)
+          region_keys->push_back(i);
+      }
+    }
+  }
+
+  /// Gaussian levels of an octave that are used by the keypoints description
+  struct OctaveLevels
+  {
+    int o;
+    int width;
+    int height;
+    std::vector<vl_sift_pix> levels;
+  };
+
+  /**
+  @brief Copy the Gaussian levels of the current octave that are used by the
+    gradient computation (levels s_min + 1 to s_max - 2).
+  @param filt SIFT filter.
+  @return The copied octave levels.
+  */
+  static OctaveLevels SaveOctaveLevels(const VlSiftFilt * filt)
+  {
+    OctaveLevels octave;
+    octave.o = filt->o_cur;
+    octave.width = filt->octave_width;
+    octave.height = filt->octave_height;
+    const size_t level_size = static_cast<size_t>(octave.width) * octave.height;
+    const vl_sift_pix * first = filt->octave + level_size;
+    octave.levels.assign(first, first + level_size * (filt->s_max - filt->s_min - 2));
+    return octave;
+  }
+
+  /**
+  @brief Make a saved octave the current octave of the SIFT filter, to describe
+    its keypoints.
+  @param octave The saved octave levels.
+  @param filt SIFT filter.
+  */
+  static void RestoreOctaveLevels(const OctaveLevels & octave, VlSiftFilt * filt)
+  {
+    filt->o_cur = octave.o;
+    filt->octave_width = octave.width;
+    filt->octave_height = octave.height;
+    const size_t level_size = static_cast<size_t>(octave.width) * octave.height;
+    std::copy(octave.levels.begin(), octave.levels.end(), filt->octave + level_size);
+    // The gradient must be computed again from the restored levels
+    filt->grad_o = filt->o_min - 1;
+  }
+
+  /**
+  @brief Compute the regions of the best max_features_ keypoints (ranked by
+    their DoG peak value and spread over the image).
+    The scale space is computed once: the Gaussian levels used by the
+    description are kept per octave while the keypoints of all the octaves are
+    detected, then only the kept keypoints are described.
+  @param filt SIFT filter (the first octave is processed).
+  @param If The processed image.
+  @param mask 8-bit gray image for keypoint filtering (optional).
+  @param[out] regions The computed regions.
+  */
+  void DescribeSIFT_Selection(
+    VlSiftFilt * filt,
+    const image::Image<float> & If,
+    const image::Image<unsigned char>* mask,
+    Regions_type & regions
+  ) const
+  {
+    // Detect the keypoints of all the octaves
+    std::vector<VlSiftKeypoint> keypoints;
+    std::vector<Vec2f> positions;
+    std::vector<float> responses;
+    std::vector<OctaveLevels> octaves;
+    keypoints.reserve(5000);
+    positions.reserve(5000);
+    responses.reserve(5000);
+    while (true) {
+      vl_sift_detect(filt);
+
+      VlSiftKeypoint const *keys  = vl_sift_get_keypoints(filt);
+      const int nkeys = vl_sift_get_nkeypoints(filt);
+      const int w = vl_sift_get_octave_width(filt);
+      const int h = vl_sift_get_octave_height(filt);
+      octaves.push_back(SaveOctaveLevels(filt));
+      for (int i = 0; i < nkeys; ++i) {
+        // Feature masking
+        if (mask)
+        {
+          const image::Image<unsigned char> & maskIma = *mask;
+          if (maskIma(keys[i].y, keys[i].x) == 0)
+            continue;
+        }
+        keypoints.push_back(keys[i]);
+        positions.emplace_back(keys[i].x, keys[i].y);
+        // DoG value at the detected extremum
+        responses.push_back(std::abs(filt->dog[
+          keys[i].ix + keys[i].iy * w + (keys[i].is - filt->s_min) * w * h]));
+      }
+      if (vl_sift_process_next_octave(filt))
+        break; // Last octave
+    }
+
+    const std::vector<uint32_t> selected = SelectFeatures(positions, responses,
+      max_features_, If.Width(), If.Height(), feature_selection_);
+    if (selected.empty())
+      return;
+
+    int last_octave = keypoints[selected[0]].o;
+    for (const uint32_t i : selected)
+      last_octave = std::max(last_octave, keypoints[i].o);
+
+    // Describe the kept keypoints (a keypoint can have up to 4 orientations)
+    Regions_type::FeatsT features;
+    Regions_type::DescsT descriptors;
+    std::vector<float> region_responses;
+    std::vector<const VlSiftKeypoint *> octave_keys;
+    std::vector<float> octave_responses;
+    std::vector<uint32_t> region_keys;
+    for (OctaveLevels & octave : octaves) {
+      if (octave.o > last_octave)
+        break;
+      octave_keys.clear();
+      octave_responses.clear();
+      for (const uint32_t i : selected) {
+        if (keypoints[i].o == octave.o) {
+          octave_keys.push_back(&keypoints[i]);
+          octave_responses.push_back(responses[i]);
+        }
+      }
+      if (!octave_keys.empty()) {
+        RestoreOctaveLevels(octave, filt);
+        region_keys.clear();
+        DescribeKeypoints(filt, octave_keys, features, descriptors, &region_keys);
+        for (const uint32_t i : region_keys)
+          region_responses.push_back(octave_responses[i]);
+      }
+      // Release the octave once described
+      std::vector<vl_sift_pix>().swap(octave.levels);
+    }
+
+    // Several orientations can be found for a keypoint:
+    //  select again among the described regions to honor the budget
+    positions.clear();
+    for (const SIOPointFeature & feature : features)
+      positions.push_back(feature.coords());
+    std::vector<uint32_t> kept_regions = SelectFeatures(positions, region_responses,
+      max_features_, If.Width(), If.Height(), feature_selection_);
+    // Keep the regions of a keypoint together
+    std::sort(kept_regions.begin(), kept_regions.end());
+
+    regions.Features().reserve(kept_regions.size());
+    regions.Descriptors().reserve(kept_regions.size());
+    for (const uint32_t i : kept_regions) {
+      regions.Features().push_back(features[i]);
+      regions.Descriptors().push_back(descriptors[i]);
+    }
+  }
+
   Params _params;
   bool _bOrientation;
 };
@@ -769,6 +769,51 @@ copy_and_upsample_rows
   }
 }
 
+/** ------------------------------------------------------------------
+ ** @internal
+ ** @brief Convolve the columns of an image by tiles (transposed output)
+ ** @param dst         output image buffer.
+ ** @param dst_stride  output image stride.
+ ** @param src         input image buffer.
+ ** @param src_width   input image width.
+ ** @param src_height  input image height.
+ ** @param filt        filter.
+ ** @param filt_width  filter half width.
+ **
+ ** The tiles are processed in parallel (if OpenMP is enabled). Their
+ ** size does not depend on the number of threads, so neither does the
+ ** result.
+ **/
+
+#define VL_SIFT_CONV_TILE_WIDTH 64
+
+static void
+_vl_sift_convcol_tiles (vl_sift_pix * dst,
+                        vl_size dst_stride,
+                        vl_sift_pix const * src,
+                        vl_size src_width,
+                        vl_size src_height,
+                        vl_sift_pix const * filt,
+                        vl_index filt_width)
+{
+  int const num_tiles = (int)
+    ((src_width + VL_SIFT_CONV_TILE_WIDTH - 1) / VL_SIFT_CONV_TILE_WIDTH) ;
+  int t ;
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (src_width * src_height > 65536)
+#endif
+  for (t = 0 ; t < num_tiles ; ++t) {
+    vl_size const x0 = (vl_size) t * VL_SIFT_CONV_TILE_WIDTH ;
+    vl_size const tile_width = VL_MIN(VL_SIFT_CONV_TILE_WIDTH, src_width - x0) ;
+    vl_imconvcol_vf (dst + x0 * dst_stride, dst_stride,
+                     src + x0, tile_width, src_height, src_width,
+                     filt,
+                     - filt_width, filt_width,
+                     1, VL_PAD_BY_CONTINUITY | VL_TRANSPOSE) ;
+  }
+}
+
 /** ------------------------------------------------------------------
  ** @internal
  ** @brief Smooth an image
@@ -814,17 +859,13 @@ _vl_sift_smooth (VlSiftFilt * self,
     return ;
   }
 
-  vl_imconvcol_vf (tempImage, height,
-                   inputImage, width, height, width,
-                   self->gaussFilter,
-                   - self->gaussFilterWidth, self->gaussFilterWidth,
-                   1, VL_PAD_BY_CONTINUITY | VL_TRANSPOSE) ;
-
-  vl_imconvcol_vf (outputImage, width,
-                   tempImage, height, width, height,
-                   self->gaussFilter,
-                   - self->gaussFilterWidth, self->gaussFilterWidth,
-                   1, VL_PAD_BY_CONTINUITY | VL_TRANSPOSE) ;
+  _vl_sift_convcol_tiles (tempImage, height,
+                          inputImage, width, height,
+                          self->gaussFilter, self->gaussFilterWidth) ;
+
+  _vl_sift_convcol_tiles (outputImage, width,
+                          tempImage, height, width,
+                          self->gaussFilter, self->gaussFilterWidth) ;
 }
 
 /** ------------------------------------------------------------------
@@ -1464,14 +1505,19 @@ vl_sift_update_gradient (VlSiftFilt *f)
   int const xo    = 1 ;
   int const yo    = w ;
   int const so    = h * w ;
-  int y, s ;
+  int s ;
 
   if (f->grad_o == f->o_cur) return ;
 
+  /* the levels are processed in parallel (if OpenMP is enabled) */
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) if (w * h > 65536)
+#endif
   for (s  = s_min + 1 ;
        s <= s_max - 2 ; ++ s) {
 
     vl_sift_pix *src, *end, *grad, gx, gy ;
+    int y ;
 
 #define SAVE_BACK                                                       \
     *grad++ = vl_fast_sqrt_f (gx*gx + gy*gy) ;                          \
@@ -12,8 +12,13 @@
 #include "openMVG/clustering/kmeans_trait.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <numeric>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 namespace openMVG
@@ -127,7 +132,10 @@ std::vector< DataType > ComputeCenterOfMass( const std::vector< DataType > & pts
 * @param[out] centers Centers of the clusters
 * @param nb_cluster requested number of cluster in the output
 * @param max_nb_iteration maximum number of iteration to do for clustering
-* @note This is the standard llyod algorithm
+* @note This is the standard llyod algorithm, the assignment step is accelerated with
+*  the triangle inequality bounds of:
+*  "Making k-means even faster", G. Hamerly, SIAM International Conference on Data Mining 2010.
+*  (the clustering is the same as the one of the standard algorithm)
 */
 template< typename DataType >
 void KMeans( const std::vector< DataType > & source_data,
@@ -159,15 +167,23 @@ void KMeans( const std::vector< DataType > & source_data,
     centers.emplace_back( source_data[ distrib_first( rng ) ] );
 
     std::vector< typename trait::scalar_type > dists;
+    MinimumDistanceToAnyCenter( source_data, centers, dists );
 
     for( uint32_t id_center = 1; id_center < nb_cluster; ++id_center )
     {
       // Compute Di / \sum Di pdf
-      MinimumDistanceToAnyCenter( source_data, centers, dists );
       std::discrete_distribution<size_t> distrib_c( dists.cbegin(), dists.cend() );
 
       // Sample a point from this distribution
       centers.emplace_back( source_data[distrib_c( rng )] );
+
+      // Update Di (only the new center can reduce the minimum distances)
+      const DataType & new_center = centers.back();
+      #pragma omp parallel for
+      for( int id_pt = 0; id_pt < static_cast<int>(source_data.size()); ++id_pt )
+      {
+        dists[ id_pt ] = std::min( dists[ id_pt ], trait::L2( source_data[ id_pt ], new_center ) );
+      }
     }
   }
   else if (init_type == KMeansInitType::KMEANS_INIT_RANDOM)
@@ -191,6 +207,45 @@ void KMeans( const std::vector< DataType > & source_data,
   // Assign all element to the first center
   cluster_assignment.resize( source_data.size(), nb_cluster );
 
+  // Hamerly bounds (in distance, not in squared distance):
+  // - upper_bound: upper bound of the distance to the assigned center,
+  // - lower_bound: lower bound of the distance to the second nearest center.
+  // A point cannot change of center if its upper bound is less than its lower
+  // bound or than the half distance from its center to any other center.
+  const auto distance = []( const DataType & a, const DataType & b )
+  {
+    return std::sqrt( static_cast<double>( trait::L2( a, b ) ) );
+  };
+  std::vector< double > upper_bound( source_data.size() ), lower_bound( source_data.size() );
+  std::vector< double > half_center_separation( nb_cluster ), center_drift( nb_cluster );
+
+  // Search the nearest and the second nearest center of a point
+  // (return true if the assigned center changed)
+  const auto full_search = [&]( const int id_pt )
+  {
+    double d1 = std::numeric_limits<double>::max(), d2 = d1;
+    uint32_t nearest_center = nb_cluster;
+    for( uint32_t cur_center = 0; cur_center < nb_cluster; ++cur_center )
+    {
+      const double cur_dist = static_cast<double>( trait::L2( source_data[id_pt], centers[ cur_center ] ) );
+      if( cur_dist < d1 )
+      {
+        d2 = d1;
+        d1 = cur_dist;
+        nearest_center = cur_center;
+      }
+      else if( cur_dist < d2 )
+      {
+        d2 = cur_dist;
+      }
+    }
+    upper_bound[id_pt] = std::sqrt( d1 );
+    lower_bound[id_pt] = std::sqrt( d2 );
+    const bool changed = cluster_assignment[id_pt] != nearest_center;
+    cluster_assignment[id_pt] = nearest_center;
+    return changed;
+  };
+
   bool changed;
   uint32_t id_iteration = 0;
 
@@ -200,27 +255,556 @@ void KMeans( const std::vector< DataType > & source_data,
     changed = false;
 
     // 2.1 affect center to each points
-    #pragma omp parallel for shared(changed)
-    for( int id_pt = 0; id_pt < static_cast<int>(source_data.size()); ++id_pt )
+    if( id_iteration == 0 )
     {
-      const DataType & cur_pt = source_data[id_pt];
-      // Compute nearest center of this point
-      const uint32_t nearest_center = NearestCenterID( cur_pt, centers );
-      if( cluster_assignment[id_pt] != nearest_center )
+      #pragma omp parallel for reduction(||:changed)
+      for( int id_pt = 0; id_pt < static_cast<int>(source_data.size()); ++id_pt )
       {
-        cluster_assignment[id_pt] = nearest_center;
-        changed = true;
+        if( full_search( id_pt ) )
+        {
+          changed = true;
+        }
+      }
+    }
+    else
+    {
+      // Half distance from each center to its nearest other center
+      #pragma omp parallel for
+      for( int id_center = 0; id_center < static_cast<int>(nb_cluster); ++id_center )
+      {
+        double min_dist = std::numeric_limits<double>::max();
+        for( uint32_t other_center = 0; other_center < nb_cluster; ++other_center )
+        {
+          if( other_center != static_cast<uint32_t>(id_center) )
+          {
+            min_dist = std::min( min_dist, static_cast<double>( trait::L2( centers[id_center], centers[other_center] ) ) );
+          }
+        }
+        half_center_separation[id_center] = 0.5 * std::sqrt( min_dist );
+      }
+
+      #pragma omp parallel for reduction(||:changed)
+      for( int id_pt = 0; id_pt < static_cast<int>(source_data.size()); ++id_pt )
+      {
+        const double bound = std::max( half_center_separation[ cluster_assignment[id_pt] ], lower_bound[id_pt] );
+        if( upper_bound[id_pt] <= bound )
+        {
+          continue;
+        }
+        // Tighten the upper bound before testing all the centers
+        upper_bound[id_pt] = distance( source_data[id_pt], centers[ cluster_assignment[id_pt] ] );
+        if( upper_bound[id_pt] <= bound )
+        {
+          continue;
+        }
+        if( full_search( id_pt ) )
+        {
+          changed = true;
+        }
       }
     }
 
     // 2.2 Compute new centers of mass
-    centers = ComputeCenterOfMass( source_data, cluster_assignment, nb_cluster );
+    std::vector< DataType > new_centers = ComputeCenterOfMass( source_data, cluster_assignment, nb_cluster );
+    // An empty cluster keeps its previous center
+    std::vector< bool > used_center( nb_cluster, false );
+    for( const uint32_t id_center : cluster_assignment )
+    {
+      used_center[id_center] = true;
+    }
+    for( uint32_t id_center = 0; id_center < nb_cluster; ++id_center )
+    {
+      if( !used_center[id_center] )
+      {
+        new_centers[id_center] = centers[id_center];
+      }
+      center_drift[id_center] = distance( centers[id_center], new_centers[id_center] );
+    }
+    centers = std::move( new_centers );
+
+    // 2.3 Update the bounds according to the center displacements
+    const auto max_drift = std::max_element( center_drift.cbegin(), center_drift.cend() );
+    const uint32_t max_drift_center = std::distance( center_drift.cbegin(), max_drift );
+    double second_max_drift = 0.0;
+    for( uint32_t id_center = 0; id_center < nb_cluster; ++id_center )
+    {
+      if( id_center != max_drift_center )
+      {
+        second_max_drift = std::max( second_max_drift, center_drift[id_center] );
+      }
+    }
+    #pragma omp parallel for
+    for( int id_pt = 0; id_pt < static_cast<int>(source_data.size()); ++id_pt )
+    {
+      const uint32_t id_center = cluster_assignment[id_pt];
+      upper_bound[id_pt] += center_drift[id_center];
+      lower_bound[id_pt] -= ( id_center == max_drift_center ) ? second_max_drift : *max_drift;
+    }
 
     ++id_iteration;
   }
   while( changed && id_iteration < max_nb_iteration );
 }
 
+/**
+* @brief Parameters of the KMeans clustering of a data matrix
+*/
+struct KMeansParams
+{
+  /// Number of requested clusters
+  uint32_t nb_cluster = 0;
+  /// Maximum number of iterations (full batch: Lloyd iterations, mini-batch: number of batches)
+  uint32_t max_nb_iteration = 100;
+  /// Kind of initialization of the centers
+  KMeansInitType init_type = KMeansInitType::KMEANS_INIT_PP;
+  /// Number of points sampled at each iteration of the mini-batch kmeans
+  /// (0: exact full batch kmeans)
+  uint32_t mini_batch_size = 0;
+  /// Number of randomly sampled points used to initialize the centers
+  /// (0: all the points). Useful to limit the cost of the Kmeans++ initialization.
+  uint32_t init_sample_size = 0;
+  /// Seed of the random number generator
+  uint64_t seed = std::mt19937_64::default_seed;
+};
+
+/// Scalar type of the centers of a clustering (float for integer data, i.e uint8 descriptors)
+template< typename T >
+using KMeansCenterScalar = typename std::conditional<std::is_floating_point<T>::value, T, float>::type;
+
+/// Row-major matrix of centers (one center per row)
+template< typename T >
+using KMeansCentersMatrix = Eigen::Matrix<KMeansCenterScalar<T>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+namespace kmeans_internal
+{
+
+/// Number of points processed together by the distance kernel
+static const int kBlockSize = 64;
+
+template< typename S >
+using RowMatrix = Eigen::Matrix<S, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/**
+* @brief Nearest and second nearest centers of a block of points
+* The squared distances are computed as ||x||^2 - 2 x.c + ||c||^2 in order to
+*  compute all the point/center dot products as a single (SIMD) matrix product.
+* @param points Block of points (one point per row)
+* @param centers Centers (one center per row)
+* @param centers_sq_norm Squared norm of the centers
+* @param[out] nearest Id of the nearest center of each point
+* @param[out] nearest_sq_dist Squared distance to the nearest center (optional)
+* @param[out] second_sq_dist Squared distance to the second nearest center (optional)
+*/
+template< typename S >
+void NearestCenters( const RowMatrix<S> & points,
+                     const RowMatrix<S> & centers,
+                     const Eigen::Matrix<S, Eigen::Dynamic, 1> & centers_sq_norm,
+                     uint32_t * nearest,
+                     S * nearest_sq_dist,
+                     S * second_sq_dist )
+{
+  const RowMatrix<S> dots = points * centers.transpose();
+  for( Eigen::Index id_pt = 0; id_pt < points.rows(); ++id_pt )
+  {
+    S d1 = std::numeric_limits<S>::max(), d2 = d1;
+    uint32_t nearest_center = 0;
+    const S * dot = dots.row( id_pt ).data();
+    for( Eigen::Index id_center = 0; id_center < centers.rows(); ++id_center )
+    {
+      const S cur_dist = centers_sq_norm[id_center] - S( 2 ) * dot[id_center];
+      if( cur_dist < d1 )
+      {
+        d2 = d1;
+        d1 = cur_dist;
+        nearest_center = static_cast<uint32_t>( id_center );
+      }
+      else if( cur_dist < d2 )
+      {
+        d2 = cur_dist;
+      }
+    }
+    const S pt_sq_norm = points.row( id_pt ).squaredNorm();
+    nearest[id_pt] = nearest_center;
+    if( nearest_sq_dist )
+    {
+      nearest_sq_dist[id_pt] = std::max( S( 0 ), d1 + pt_sq_norm );
+    }
+    if( second_sq_dist )
+    {
+      second_sq_dist[id_pt] = ( d2 == std::numeric_limits<S>::max() ) ?
+        d2 : std::max( S( 0 ), d2 + pt_sq_norm );
+    }
+  }
+}
+
+/**
+* @brief Nearest and second nearest centers of a list of points
+* @param data Data points (one point per row)
+* @param ids Id of the rows to process (nullptr: the count first rows)
+* @param count Number of points to process
+* @param centers Centers (one center per row)
+* @param[out] nearest Id of the nearest center of each processed point
+* @param[out] nearest_sq_dist Squared distance to the nearest center (optional)
+* @param[out] second_sq_dist Squared distance to the second nearest center (optional)
+*/
+template< typename Derived, typename S >
+void AssignToNearestCenters( const Eigen::MatrixBase<Derived> & data,
+                             const uint32_t * ids,
+                             const Eigen::Index count,
+                             const RowMatrix<S> & centers,
+                             uint32_t * nearest,
+                             S * nearest_sq_dist,
+                             S * second_sq_dist )
+{
+  const Eigen::Matrix<S, Eigen::Dynamic, 1> centers_sq_norm = centers.rowwise().squaredNorm();
+  const int nb_block = static_cast<int>( ( count + kBlockSize - 1 ) / kBlockSize );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( int id_block = 0; id_block < nb_block; ++id_block )
+  {
+    const Eigen::Index begin = static_cast<Eigen::Index>( id_block ) * kBlockSize;
+    const Eigen::Index size = std::min<Eigen::Index>( kBlockSize, count - begin );
+    RowMatrix<S> block( size, data.cols() );
+    if( ids )
+    {
+      for( Eigen::Index i = 0; i < size; ++i )
+      {
+        block.row( i ) = data.row( ids[begin + i] ).template cast<S>();
+      }
+    }
+    else
+    {
+      block = data.middleRows( begin, size ).template cast<S>();
+    }
+    NearestCenters( block, centers, centers_sq_norm, nearest + begin,
+                    nearest_sq_dist ? nearest_sq_dist + begin : nullptr,
+                    second_sq_dist ? second_sq_dist + begin : nullptr );
+  }
+}
+
+/**
+* @brief Initialize the centers (random or Kmeans++ seeding) from a sample of the points
+*/
+template< typename Derived, typename S, typename RngType >
+void InitCenters( const Eigen::MatrixBase<Derived> & data,
+                  const KMeansParams & params,
+                  RowMatrix<S> & centers,
+                  RngType & rng )
+{
+  const size_t nb_point = static_cast<size_t>( data.rows() );
+  std::vector< uint32_t > candidates;
+  if( params.init_sample_size == 0 || params.init_sample_size >= nb_point )
+  {
+    candidates.resize( nb_point );
+    std::iota( candidates.begin(), candidates.end(), 0 );
+  }
+  else
+  {
+    std::uniform_int_distribution<uint32_t> distrib( 0, static_cast<uint32_t>( nb_point - 1 ) );
+    candidates.resize( params.init_sample_size );
+    for( auto & id : candidates )
+    {
+      id = distrib( rng );
+    }
+  }
+
+  centers.resize( params.nb_cluster, data.cols() );
+  std::uniform_int_distribution<size_t> distrib_candidate( 0, candidates.size() - 1 );
+  if( params.init_type == KMeansInitType::KMEANS_INIT_PP )
+  {
+    // Kmeans++ init (see KMeans), the minimum distances are updated incrementally:
+    // a new center c can only be nearer to a point x than its nearest center n if
+    //  d(c, n) < 2 d(x, n) (triangle inequality), so most of the points are skipped.
+    centers.row( 0 ) = data.row( candidates[distrib_candidate( rng )] ).template cast<S>();
+    std::vector< S > dists( candidates.size(), std::numeric_limits<S>::max() );
+    std::vector< uint32_t > nearest( candidates.size(), 0 );
+    std::vector< S > center_sq_dists( params.nb_cluster, std::numeric_limits<S>::max() );
+    for( uint32_t id_center = 0; id_center < params.nb_cluster; ++id_center )
+    {
+      if( id_center > 0 )
+      {
+        size_t id_candidate;
+        if( *std::max_element( dists.cbegin(), dists.cend() ) > S( 0 ) )
+        {
+          std::discrete_distribution<size_t> distrib_c( dists.cbegin(), dists.cend() );
+          id_candidate = distrib_c( rng );
+        }
+        else // Less distinct points than centers
+        {
+          id_candidate = distrib_candidate( rng );
+        }
+        centers.row( id_center ) = data.row( candidates[id_candidate] ).template cast<S>();
+        center_sq_dists.resize( id_center );
+        for( uint32_t other_center = 0; other_center < id_center; ++other_center )
+        {
+          center_sq_dists[other_center] = ( centers.row( other_center ) - centers.row( id_center ) ).squaredNorm();
+        }
+      }
+      // The candidates are processed by blocks, converted to the center scalar type
+      const int nb_block = static_cast<int>( ( candidates.size() + kBlockSize - 1 ) / kBlockSize );
+      #pragma omp parallel
+      {
+        RowMatrix<S> block( kBlockSize, data.cols() );
+        std::array< size_t, kBlockSize > block_ids;
+        #pragma omp for schedule(dynamic)
+        for( int id_block = 0; id_block < nb_block; ++id_block )
+        {
+          const size_t begin = static_cast<size_t>( id_block ) * kBlockSize;
+          const size_t end = std::min( candidates.size(), begin + kBlockSize );
+          int block_size = 0;
+          for( size_t i = begin; i < end; ++i )
+          {
+            if( id_center == 0 || center_sq_dists[ nearest[i] ] < S( 4 ) * dists[i] )
+            {
+              block.row( block_size ) = data.row( candidates[i] ).template cast<S>();
+              block_ids[ block_size++ ] = i;
+            }
+          }
+          const Eigen::Matrix<S, Eigen::Dynamic, 1> block_dists =
+            ( block.topRows( block_size ).rowwise() - centers.row( id_center ) ).rowwise().squaredNorm();
+          for( int j = 0; j < block_size; ++j )
+          {
+            const size_t i = block_ids[j];
+            if( block_dists[j] < dists[i] )
+            {
+              dists[i] = block_dists[j];
+              nearest[i] = id_center;
+            }
+          }
+        }
+      }
+    }
+  }
+  else
+  {
+    // Standard Llyod init
+    for( uint32_t id_center = 0; id_center < params.nb_cluster; ++id_center )
+    {
+      centers.row( id_center ) = data.row( candidates[distrib_candidate( rng )] ).template cast<S>();
+    }
+  }
+}
+
+/**
+* @brief Compute the center of mass of the clusters (an empty cluster keeps its center)
+*/
+template< typename Derived, typename S >
+void UpdateCenters( const Eigen::MatrixBase<Derived> & data,
+                    const std::vector< uint32_t > & cluster_assignment,
+                    RowMatrix<S> & centers )
+{
+  RowMatrix<double> sums = RowMatrix<double>::Zero( centers.rows(), centers.cols() );
+  std::vector< size_t > counts( centers.rows(), 0 );
+
+  #pragma omp parallel
+  {
+    RowMatrix<double> local_sums = RowMatrix<double>::Zero( centers.rows(), centers.cols() );
+    std::vector< size_t > local_counts( centers.rows(), 0 );
+    #pragma omp for
+    for( int id_pt = 0; id_pt < static_cast<int>( data.rows() ); ++id_pt )
+    {
+      local_sums.row( cluster_assignment[id_pt] ) += data.row( id_pt ).template cast<double>();
+      ++local_counts[ cluster_assignment[id_pt] ];
+    }
+    #pragma omp critical
+    {
+      sums += local_sums;
+      std::transform( counts.cbegin(), counts.cend(), local_counts.cbegin(), counts.begin(), std::plus<size_t>() );
+    }
+  }
+
+  for( Eigen::Index id_center = 0; id_center < centers.rows(); ++id_center )
+  {
+    if( counts[id_center] > 0 )
+    {
+      centers.row( id_center ) = ( sums.row( id_center ) / static_cast<double>( counts[id_center] ) ).template cast<S>();
+    }
+  }
+}
+
+} // namespace kmeans_internal
+
+/**
+* @brief Compute kmeans clustering on a data matrix (one point per row).
+*  This version is designed for large datasets (i.e. training of visual vocabularies
+*  from millions of descriptors):
+*  - the points are stored contiguously in a row-major matrix (an Eigen::Map can be used
+*    to avoid any copy, i.e. over a std::vector of uint8 SIFT descriptors),
+*  - integer data are supported (the centers are then computed as float),
+*  - the distances of a block of points to all the centers are computed with a matrix product (SIMD),
+*  - the exact (full batch) mode uses the Hamerly triangle inequality bounds to skip
+*    most of the distance computations,
+*  - the mini-batch mode updates the centers from small random batches of points:
+*    "Web-Scale K-Means Clustering", D. Sculley, WWW 2010.
+* @param data Input data (one point per row)
+* @param[out] cluster_assignment index for each point in the input set to a specified cluster
+* @param[out] centers Centers of the clusters (one center per row)
+* @param params Clustering parameters
+*/
+template< typename Derived >
+void KMeans( const Eigen::MatrixBase<Derived> & data,
+             std::vector< uint32_t > & cluster_assignment,
+             KMeansCentersMatrix<typename Derived::Scalar> & centers,
+             const KMeansParams & params )
+{
+  using S = KMeansCenterScalar<typename Derived::Scalar>;
+  using namespace kmeans_internal;
+
+  const size_t nb_point = static_cast<size_t>( data.rows() );
+  const uint32_t nb_cluster = params.nb_cluster;
+  if( nb_point == 0 || nb_cluster == 0 )
+  {
+    return;
+  }
+
+  std::mt19937_64 rng( params.seed );
+
+  // 1 - init center of mass
+  InitCenters( data, params, centers, rng );
+
+  cluster_assignment.resize( nb_point );
+
+  // 2 - Perform mini-batch kmeans
+  if( params.mini_batch_size > 0 )
+  {
+    std::uniform_int_distribution<uint32_t> distrib( 0, static_cast<uint32_t>( nb_point - 1 ) );
+    std::vector< uint32_t > batch( params.mini_batch_size ), batch_nearest( params.mini_batch_size );
+    std::vector< uint64_t > center_counts( nb_cluster, 0 );
+    for( uint32_t id_iteration = 0; id_iteration < params.max_nb_iteration; ++id_iteration )
+    {
+      for( auto & id : batch )
+      {
+        id = distrib( rng );
+      }
+      AssignToNearestCenters( data, batch.data(), batch.size(), centers,
+                              batch_nearest.data(), static_cast<S*>( nullptr ), static_cast<S*>( nullptr ) );
+      // Gradient step with a per center learning rate (1 / #points assigned to the center)
+      for( size_t i = 0; i < batch.size(); ++i )
+      {
+        const uint32_t id_center = batch_nearest[i];
+        const S eta = S( 1 ) / static_cast<S>( ++center_counts[id_center] );
+        centers.row( id_center ) +=
+          eta * ( data.row( batch[i] ).template cast<S>() - centers.row( id_center ) );
+      }
+    }
+    AssignToNearestCenters( data, static_cast<const uint32_t*>( nullptr ), data.rows(), centers,
+                            cluster_assignment.data(), static_cast<S*>( nullptr ), static_cast<S*>( nullptr ) );
+    return;
+  }
+
+  // 2 - Perform full batch kmeans (see KMeans for the description of the Hamerly bounds)
+  std::vector< S > upper_bound( nb_point ), lower_bound( nb_point );
+  std::vector< S > half_center_separation( nb_cluster ), center_drift( nb_cluster );
+  std::vector< uint32_t > center_nearest( nb_cluster ), to_update, nearest;
+  std::vector< S > nearest_sq_dist, second_sq_dist;
+
+  bool changed;
+  uint32_t id_iteration = 0;
+  do
+  {
+    changed = false;
+
+    // 2.1 affect center to each points
+    if( id_iteration == 0 )
+    {
+      AssignToNearestCenters( data, static_cast<const uint32_t*>( nullptr ), data.rows(), centers,
+                              cluster_assignment.data(), upper_bound.data(), lower_bound.data() );
+      #pragma omp parallel for
+      for( int id_pt = 0; id_pt < static_cast<int>( nb_point ); ++id_pt )
+      {
+        upper_bound[id_pt] = std::sqrt( upper_bound[id_pt] );
+        lower_bound[id_pt] = std::sqrt( lower_bound[id_pt] );
+      }
+      changed = true;
+    }
+    else
+    {
+      // Half distance from each center to its nearest other center
+      // (the nearest center of a center is itself, so the second one is used)
+      AssignToNearestCenters( centers, static_cast<const uint32_t*>( nullptr ), centers.rows(), centers,
+                              center_nearest.data(), static_cast<S*>( nullptr ), half_center_separation.data() );
+      for( auto & separation : half_center_separation )
+      {
+        separation = S( 0.5 ) * std::sqrt( separation );
+      }
+
+      // List the points for which the bounds cannot prove that the assignment is unchanged
+      to_update.clear();
+      #pragma omp parallel
+      {
+        std::vector< uint32_t > local_to_update;
+        #pragma omp for
+        for( int id_pt = 0; id_pt < static_cast<int>( nb_point ); ++id_pt )
+        {
+          const uint32_t id_center = cluster_assignment[id_pt];
+          const S bound = std::max( half_center_separation[id_center], lower_bound[id_pt] );
+          if( upper_bound[id_pt] <= bound )
+          {
+            continue;
+          }
+          // Tighten the upper bound before testing all the centers
+          upper_bound[id_pt] = ( data.row( id_pt ).template cast<S>() - centers.row( id_center ) ).norm();
+          if( upper_bound[id_pt] > bound )
+          {
+            local_to_update.push_back( id_pt );
+          }
+        }
+        #pragma omp critical
+        {
+          to_update.insert( to_update.end(), local_to_update.cbegin(), local_to_update.cend() );
+        }
+      }
+
+      nearest.resize( to_update.size() );
+      nearest_sq_dist.resize( to_update.size() );
+      second_sq_dist.resize( to_update.size() );
+      AssignToNearestCenters( data, to_update.data(), to_update.size(), centers,
+                              nearest.data(), nearest_sq_dist.data(), second_sq_dist.data() );
+      for( size_t i = 0; i < to_update.size(); ++i )
+      {
+        const uint32_t id_pt = to_update[i];
+        if( cluster_assignment[id_pt] != nearest[i] )
+        {
+          cluster_assignment[id_pt] = nearest[i];
+          changed = true;
+        }
+        upper_bound[id_pt] = std::sqrt( nearest_sq_dist[i] );
+        lower_bound[id_pt] = std::sqrt( second_sq_dist[i] );
+      }
+    }
+
+    // 2.2 Compute new centers of mass
+    const RowMatrix<S> previous_centers = centers;
+    UpdateCenters( data, cluster_assignment, centers );
+
+    // 2.3 Update the bounds according to the center displacements
+    for( uint32_t id_center = 0; id_center < nb_cluster; ++id_center )
+    {
+      center_drift[id_center] = ( centers.row( id_center ) - previous_centers.row( id_center ) ).norm();
+    }
+    const auto max_drift = std::max_element( center_drift.cbegin(), center_drift.cend() );
+    const uint32_t max_drift_center = std::distance( center_drift.cbegin(), max_drift );
+    S second_max_drift = S( 0 );
+    for( uint32_t id_center = 0; id_center < nb_cluster; ++id_center )
+    {
+      if( id_center != max_drift_center )
+      {
+        second_max_drift = std::max( second_max_drift, center_drift[id_center] );
+      }
+    }
+    #pragma omp parallel for
+    for( int id_pt = 0; id_pt < static_cast<int>( nb_point ); ++id_pt )
+    {
+      const uint32_t id_center = cluster_assignment[id_pt];
+      upper_bound[id_pt] += center_drift[id_center];
+      lower_bound[id_pt] -= ( id_center == max_drift_center ) ? second_max_drift : *max_drift;
+    }
+
+    ++id_iteration;
+  }
+  while( changed && id_iteration < params.max_nb_iteration );
+}
+
 } // namespace clustering
 } // namespace openMVG
 
@@ -100,7 +100,11 @@ void KMeanTesting
 {\
   /* Does the right number of cluster are found?*/\
   EXPECT_EQ(NB_CLUSTER, centers.size());\
-\
+  KMEANS_CHECK_IDS(NB_CLUSTER, ids);\
+}
+
+#define KMEANS_CHECK_IDS(NB_CLUSTER, ids) \
+{\
   /* Does points are labelled to valid cluster ids?*/\
   {\
     std::vector< uint32_t > ids_cpy(ids.size());\
@@ -321,6 +325,128 @@ TEST( clustering, threeClustersEigenVec )
   }
 }
 
+TEST( clustering, threeClustersRowMajorMatrix )
+{
+  const int dimension = 8;
+  Mat mat_centers;
+  const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> pts =
+    InitRandom3ClusterDataset(mat_centers, dimension).transpose().cast<float>();
+
+  for (const auto kmean_init_type : KMEAN_INIT_TYPES)
+  {
+    for (const uint32_t mini_batch_size : {0, 256})
+    {
+      KMeansParams params;
+      params.nb_cluster = NB_CLUSTER;
+      params.init_type = kmean_init_type;
+      params.mini_batch_size = mini_batch_size;
+
+      std::vector<uint32_t> ids;
+      KMeansCentersMatrix<float> centers;
+      KMeans(pts, ids, centers, params);
+
+      EXPECT_EQ(pts.rows(), ids.size());
+      EXPECT_EQ(NB_CLUSTER, centers.rows());
+      KMEANS_CHECK_IDS(NB_CLUSTER, ids);
+    }
+  }
+}
+
+TEST( clustering, threeClustersUint8Descriptors )
+{
+  // uint8 descriptors (i.e. SIFT like) stored contiguously, values in [44, 212]
+  const int dimension = 128;
+  Mat mat_centers;
+  const Mat pts = InitRandom3ClusterDataset(mat_centers, dimension);
+  std::vector<unsigned char> descriptors(pts.size());
+  for (int i = 0; i < pts.cols(); ++i)
+    for (int j = 0; j < dimension; ++j)
+      descriptors[i * dimension + j] = static_cast<unsigned char>(pts(j, i) * 12.0 + 128.0);
+
+  using MatrixMap = Eigen::Map<const Eigen::Matrix<unsigned char, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+  const MatrixMap map_descriptors(descriptors.data(), pts.cols(), dimension);
+
+  for (const uint32_t mini_batch_size : {0, 256})
+  {
+    KMeansParams params;
+    params.nb_cluster = NB_CLUSTER;
+    params.mini_batch_size = mini_batch_size;
+    params.init_sample_size = 1000;
+
+    std::vector<uint32_t> ids;
+    KMeansCentersMatrix<unsigned char> centers;
+    KMeans(map_descriptors, ids, centers, params);
+
+    EXPECT_EQ(NB_CLUSTER, centers.rows());
+    KMEANS_CHECK_IDS(NB_CLUSTER, ids);
+    // The centers are the mean of the clusters
+    for (int i = 0; i < NB_CLUSTER; ++i)
+    {
+      const float expected = mat_centers(0, i) * 12.0 + 128.0;
+      EXPECT_NEAR(expected, centers.row(ids[i * NB_POINT]).mean(), 1.0);
+    }
+  }
+}
+
+// The accelerated kmeans must give the same clustering as the standard llyod algorithm
+TEST( clustering, acceleratedKMeansIsExact )
+{
+  const int dimension = 4;
+  const int nb_point = 5000;
+  const uint32_t nb_cluster = 25;
+  std::mt19937_64 rng(std::mt19937_64::default_seed);
+  std::uniform_real_distribution<double> distrib(-1.0, 1.0);
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> pts(nb_point, dimension);
+  for (int i = 0; i < pts.size(); ++i)
+    pts.data()[i] = distrib(rng);
+
+  // Reference llyod iterations (brute force assignment)
+  KMeansParams params;
+  params.nb_cluster = nb_cluster;
+  params.init_type = KMeansInitType::KMEANS_INIT_RANDOM;
+  params.max_nb_iteration = 0;
+  KMeansCentersMatrix<double> ref_centers;
+  std::vector<uint32_t> ref_ids(nb_point, nb_cluster);
+  std::mt19937_64 init_rng(params.seed);
+  kmeans_internal::InitCenters(pts, params, ref_centers, init_rng);
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (int i = 0; i < nb_point; ++i)
+    {
+      Eigen::Index nearest;
+      (ref_centers.rowwise() - pts.row(i)).rowwise().squaredNorm().minCoeff(&nearest);
+      if (ref_ids[i] != nearest)
+      {
+        ref_ids[i] = nearest;
+        changed = true;
+      }
+    }
+    kmeans_internal::UpdateCenters(pts, ref_ids, ref_centers);
+  }
+
+  // Accelerated kmeans (same initial centers)
+  params.max_nb_iteration = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> ids;
+  KMeansCentersMatrix<double> centers;
+  KMeans(pts, ids, centers, params);
+
+  EXPECT_EQ(ref_ids.size(), ids.size());
+  EXPECT_TRUE(ref_ids == ids);
+  EXPECT_MATRIX_NEAR(ref_centers, centers, 1e-8);
+
+  // Same result with the std::vector interface
+  std::vector<Vec> vec_pts(nb_point);
+  for (int i = 0; i < nb_point; ++i)
+    vec_pts[i] = pts.row(i).transpose();
+  std::vector<uint32_t> vec_ids;
+  std::vector<Vec> vec_centers;
+  KMeans(vec_pts, vec_ids, vec_centers, nb_cluster,
+         std::numeric_limits<uint32_t>::max(), KMeansInitType::KMEANS_INIT_RANDOM);
+  EXPECT_TRUE(ref_ids == vec_ids);
+}
+
 /* ************************************************************************* */
 int main()
 {
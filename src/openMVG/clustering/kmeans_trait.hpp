@@ -534,9 +534,7 @@ class KMeansVectorDataTrait<Vec>
     */
     static type null( const type & dummy )
     {
-      static type res( dummy.size() );
-      res.fill( scalar_type( 0 ) );
-      return res;
+      return type::Zero( dummy.size() );
     }
 
     /**
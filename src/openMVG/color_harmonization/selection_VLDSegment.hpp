@@ -69,6 +69,9 @@ class commonDataByPair_VLDSegment  : public commonDataByPair
     // gvld-consistancy matrix, intitialized to -1,  >0 consistancy value, -1=unknow, -2=false
     std::vector<bool> valide( _vec_PutativeMatches.size(), true );// indices of match in the initial matches, if true at the end of KVLD, a match is kept.
 
+    // The image scale-spaces are computed once and shared by the KVLD re-selections
+    const ImageScale chaineA( imgA ), chaineB( imgB );
+
     size_t it_num = 0;
     KvldParameters kvldparameters;//initial parameters of KVLD
     //kvldparameters.K = 5;
@@ -76,7 +79,7 @@ class commonDataByPair_VLDSegment  : public commonDataByPair
       it_num < 5 &&
       kvldparameters.inlierRate >
       KVLD(
-        imgA, imgB,
+        chaineA, chaineB,
         _vec_featsL, _vec_featsR,
         matchesPair, matchesFiltered,
         vec_score, E, valide, kvldparameters ) )
@@ -107,19 +107,13 @@ float AKAZE::ComputeAutomaticContrastFactor( const Image<float> & src , const fl
 
 const float fderivative_factor = 1.5f;      // Factor for the multiscale derivatives
 
-void AKAZE::ComputeAKAZESlice( const Image<float> & src , const int p , const int q , const int nbSlice ,
+void AKAZE::ComputeAKAZESliceDiffusion( const Image<float> & src , const int p , const int q , const int nbSlice ,
                         const float sigma0 , // first octave initial scale
                         const float contrast_factor ,
-                        Image<float> & Li , // Diffusion image
-                        Image<float> & Lx , // X derivatives
-                        Image<float> & Ly , // Y derivatives
-                        Image<float> & Lhess ) // Det(Hessian)
+                        Image<float> & Li ) // Diffusion image
 {
   const float sigma_cur = Sigma( sigma0 , p , q , nbSlice );
-  const float ratio = 1 << p; //pow(2,p);
-  const int sigma_scale = std::round(sigma_cur * fderivative_factor / ratio);
 
-  Image<float> smoothed;
   if (p == 0 && q == 0 )
   {
     // Compute new image
@@ -144,6 +138,7 @@ void AKAZE::ComputeAKAZESlice( const Image<float> & src , const int p , const in
     const float total_cycle_time = t_cur - t_prev;
 
     // Compute first derivatives (Scharr scale 1, non normalized) for diffusion coef
+    Image<float> smoothed, Lx, Ly;
     ImageGaussianFilter( in , 1.f , smoothed, 0, 0 );
 
     ImageScharrXDerivative( smoothed , Lx , false );
@@ -157,10 +152,22 @@ void AKAZE::ComputeAKAZESlice( const Image<float> & src , const int p , const in
     std::vector<float> tau;
     FEDCycleTimings( total_cycle_time , 0.25f , tau );
     ImageFEDCycle( in , diff , tau );
-    Li = in; // evolution image
+    Li.swap( in ); // evolution image
   }
+}
+
+void AKAZE::ComputeAKAZESliceDerivatives( const Image<float> & Li , const int p , const int q , const int nbSlice ,
+                        const float sigma0 , // first octave initial scale
+                        Image<float> & Lx , // X derivatives
+                        Image<float> & Ly , // Y derivatives
+                        Image<float> & Lhess ) // Det(Hessian)
+{
+  const float sigma_cur = Sigma( sigma0 , p , q , nbSlice );
+  const float ratio = 1 << p; //pow(2,p);
+  const int sigma_scale = std::round(sigma_cur * fderivative_factor / ratio);
 
   // Compute Hessian response
+  Image<float> smoothed;
   if (p == 0 && q == 0 )
   {
     smoothed = Li;
@@ -224,7 +231,12 @@ void AKAZE::Compute_AKAZEScaleSpace()
 
   float contrast_factor = ComputeAutomaticContrastFactor( in_, 0.7f );
 
-  Image<float> input = in_;
+  // The non linear diffusion is a sequential chain (each slice is diffused
+  //  from the previous one), but the derivatives and the Hessian of a slice
+  //  only depend on its diffusion image:
+  // 1. compute the diffusion images (the FED steps are parallel),
+  // 2. compute the derivatives and Hessian of all the slices in parallel.
+  evolution_.resize( options_.iNbOctave * options_.iNbSlicePerOctave );
 
   // Octave computation
   for (int p = 0; p < options_.iNbOctave; ++p )
@@ -233,26 +245,41 @@ void AKAZE::Compute_AKAZEScaleSpace()
 
     for (int q = 0; q < options_.iNbSlicePerOctave; ++q )
     {
-      evolution_.emplace_back(TEvolution());
-      TEvolution & evo = evolution_.back();
-      // Compute Slice at (p,q) index
-      ComputeAKAZESlice( input , p , q , options_.iNbSlicePerOctave , options_.fSigma0 , contrast_factor,
-        evo.cur , evo.Lx , evo.Ly , evo.Lhess );
+      const int slice_id = p * options_.iNbSlicePerOctave + q;
+      // Compute Slice at (p,q) index from the previous one
+      ComputeAKAZESliceDiffusion(
+        (slice_id == 0) ? in_ : evolution_[slice_id - 1].cur,
+        p , q , options_.iNbSlicePerOctave , options_.fSigma0 , contrast_factor,
+        evolution_[slice_id].cur );
+    }
+  }
 
-      // Prepare inputs for next slice
-      input = evo.cur;
+  // Scale space derivatives (largest slices first)
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int slice_id = 0; slice_id < static_cast<int>( evolution_.size() ); ++slice_id )
+  {
+    TEvolution & evo = evolution_[slice_id];
+    ComputeAKAZESliceDerivatives( evo.cur ,
+      slice_id / options_.iNbSlicePerOctave , slice_id % options_.iNbSlicePerOctave ,
+      options_.iNbSlicePerOctave , options_.fSigma0 ,
+      evo.Lx , evo.Ly , evo.Lhess );
+  }
 
-      // DEBUG octave image
+  // DEBUG octave image
 #if DEBUG_OCTAVE
-      std::stringstream str;
-      str << "./" << "_oct_" << p << "_" << q << ".png";
-      Image<float> tmp = evo.cur;
-      convert_scale(tmp);
-      Image<unsigned char> tmp2 ((tmp*255).cast<unsigned char>());
-      WriteImage( str.str().c_str() , tmp2 );
-#endif // DEBUG_OCTAVE
-    }
+  for (int slice_id = 0; slice_id < static_cast<int>( evolution_.size() ); ++slice_id )
+  {
+    std::stringstream str;
+    str << "./" << "_oct_" << slice_id / options_.iNbSlicePerOctave
+        << "_" << slice_id % options_.iNbSlicePerOctave << ".png";
+    Image<float> tmp = evolution_[slice_id].cur;
+    convert_scale(tmp);
+    Image<unsigned char> tmp2 ((tmp*255).cast<unsigned char>());
+    WriteImage( str.str().c_str() , tmp2 );
   }
+#endif // DEBUG_OCTAVE
 }
 
 void detectDuplicates(
@@ -7,10 +7,19 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "openMVG/features/akaze/image_describer_akaze.hpp"
+#include "openMVG/image/image_diffusion.hpp"
+#include "openMVG/image/image_filtering.hpp"
 #include "openMVG/image/image_io.hpp"
 
 #include "testing/testing.h"
 
+#include <cstring>
+#include <random>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace openMVG;
 using namespace openMVG::image;
 using namespace openMVG::features;
@@ -18,6 +27,87 @@ using namespace openMVG::features;
 static const std::string png_filename = std::string( THIS_SOURCE_DIR )
   + "/../../../openMVG_Samples/imageData/StanfordMobileVisualSearch/Ace_0.png";
 
+namespace {
+
+// Reference FED cycle done by separate passes: each step computes the FED
+//  increment (pixel by pixel on the central part), then adds it to the image.
+void ReferenceFEDCycle
+(
+  Image<float> & self,
+  const Image<float> & diff,
+  const std::vector<float> & tau
+)
+{
+  const int width = self.Width(), height = self.Height();
+  Image<float> increment;
+  for (const float t : tau)
+  {
+    const float half_t = t * 0.5f;
+    // Borders
+    ImageFED( self , diff , t , increment );
+    // Central part
+    for (int i = 1; i < height - 1; ++i)
+    {
+      for (int j = 1; j < width - 1; ++j)
+      {
+        const float cur_src = self( i , j );
+        const float cur_diff = diff( i , j );
+        const float a = ( cur_diff + diff( i , j + 1 ) ) * ( self( i , j + 1 ) - cur_src );
+        const float b = ( cur_diff + diff( i - 1 , j ) ) * ( cur_src - self( i - 1 , j ) );
+        const float c = ( cur_diff + diff( i , j - 1 ) ) * ( cur_src - self( i , j - 1 ) );
+        const float d = ( cur_diff + diff( i + 1 , j ) ) * ( self( i + 1 , j ) - cur_src );
+        increment( i , j ) = half_t * ( a - c + d - b );
+      }
+    }
+    // Corners are not diffused
+    increment( 0 , 0 ) = increment( 0 , width - 1 ) = 0.f;
+    increment( height - 1 , 0 ) = increment( height - 1 , width - 1 ) = 0.f;
+    self.array() += increment.array();
+  }
+}
+
+#ifdef OPENMVG_USE_OPENMP
+// Describe an image with the given number of threads
+template <typename DescriberT>
+std::unique_ptr<Regions> DescribeWithThreads
+(
+  const Image<unsigned char> & image,
+  const int nb_thread
+)
+{
+  const int max_thread = omp_get_max_threads();
+  omp_set_num_threads( nb_thread );
+  std::unique_ptr<Regions> regions = DescriberT().Describe( image );
+  omp_set_num_threads( max_thread );
+  return regions;
+}
+
+// Compare the features (position, scale, orientation) and the descriptors
+template <typename RegionsT>
+bool SameRegions
+(
+  const Regions & regions_a,
+  const Regions & regions_b
+)
+{
+  const RegionsT * a = dynamic_cast<const RegionsT *>( &regions_a );
+  const RegionsT * b = dynamic_cast<const RegionsT *>( &regions_b );
+  if ( !a || !b || a->RegionCount() != b->RegionCount() )
+    return false;
+  for (size_t i = 0; i < a->RegionCount(); ++i)
+  {
+    const SIOPointFeature & feat_a = a->Features()[i], & feat_b = b->Features()[i];
+    if ( feat_a.x() != feat_b.x() || feat_a.y() != feat_b.y() ||
+         feat_a.scale() != feat_b.scale() || feat_a.orientation() != feat_b.orientation() )
+      return false;
+  }
+  return std::memcmp( a->Descriptors().data(), b->Descriptors().data(),
+    a->Descriptors().size() * sizeof( typename RegionsT::DescriptorT ) ) == 0;
+}
+#endif // OPENMVG_USE_OPENMP
+
+} // namespace
+
 TEST( AKAZE , EmptyImage )
 {
   Image<unsigned char> image_in;
@@ -58,6 +148,59 @@ TEST( AKAZE , AKAZE_Image_describer_MLDB )
   EXPECT_TRUE(extractor.Describe(image_in)->RegionCount() > 0);
 }
 
+// The fused FED steps give exactly the image of the separate
+//  increment computation and addition passes.
+TEST( AKAZE , FEDCycle_SameAsSeparatePasses )
+{
+  Image<unsigned char> image_in;
+  EXPECT_TRUE( ReadImage( png_filename.c_str(), &image_in ) );
+  const Image<float> image( image_in.GetMat().cast<float>() / 255.f );
+
+  // Perona Malik diffusion coefficients
+  Image<float> smoothed, Lx, Ly, diff;
+  ImageGaussianFilter( image , 1.f , smoothed, 0, 0 );
+  ImageScharrXDerivative( smoothed , Lx , false );
+  ImageScharrYDerivative( smoothed , Ly , false );
+  ImagePeronaMalikG2DiffusionCoef( Lx , Ly , 0.02f , diff );
+
+  std::vector<float> tau;
+  FEDCycleTimings( 2.f , 0.25f , tau );
+  EXPECT_TRUE( tau.size() > 1 );
+
+  Image<float> fused = image, reference = image;
+  ImageFEDCycle( fused , diff , tau );
+  ReferenceFEDCycle( reference , diff , tau );
+  EXPECT_TRUE( fused.GetMat() != image.GetMat() );
+  EXPECT_TRUE( fused.GetMat() == reference.GetMat() );
+}
+
+#ifdef OPENMVG_USE_OPENMP
+// The parallel scale space computation (slice derivatives, FED bands)
+//  gives exactly the sequential keypoints and descriptors.
+TEST( AKAZE , SameResultsWithThreads )
+{
+  Image<unsigned char> image_in;
+  EXPECT_TRUE( ReadImage( png_filename.c_str(), &image_in ) );
+
+  {
+    const std::unique_ptr<Regions> sequential =
+      DescribeWithThreads<AKAZE_Image_describer_SURF>( image_in, 1 );
+    const std::unique_ptr<Regions> parallel =
+      DescribeWithThreads<AKAZE_Image_describer_SURF>( image_in, 4 );
+    EXPECT_TRUE( sequential->RegionCount() > 0 );
+    EXPECT_TRUE( SameRegions<AKAZE_Float_Regions>( *sequential, *parallel ) );
+  }
+  {
+    const std::unique_ptr<Regions> sequential =
+      DescribeWithThreads<AKAZE_Image_describer_MLDB>( image_in, 1 );
+    const std::unique_ptr<Regions> parallel =
+      DescribeWithThreads<AKAZE_Image_describer_MLDB>( image_in, 4 );
+    EXPECT_TRUE( sequential->RegionCount() > 0 );
+    EXPECT_TRUE( SameRegions<AKAZE_Binary_Regions>( *sequential, *parallel ) );
+  }
+}
+#endif // OPENMVG_USE_OPENMP
+
 /* ************************************************************************* */
 int main()
 {
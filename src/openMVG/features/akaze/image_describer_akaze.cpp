@@ -13,6 +13,41 @@
 namespace openMVG {
 namespace features {
 
+namespace {
+
+// Keep the strongest keypoints, spread over the image (if more than max_count)
+void Select_Keypoints
+(
+  std::vector<AKAZEKeypoint> & kpts,
+  size_t max_count,
+  EFeatureSelection selection,
+  const image::Image<unsigned char> & image
+)
+{
+  if (max_count == 0 || kpts.size() <= max_count)
+    return;
+
+  std::vector<Vec2f> positions;
+  std::vector<float> responses;
+  positions.reserve(kpts.size());
+  responses.reserve(kpts.size());
+  for (const AKAZEKeypoint & pt : kpts)
+  {
+    positions.emplace_back(pt.x, pt.y);
+    responses.push_back(pt.response);
+  }
+  const std::vector<uint32_t> selected = SelectFeatures(positions, responses,
+    max_count, image.Width(), image.Height(), selection);
+
+  std::vector<AKAZEKeypoint> selected_kpts;
+  selected_kpts.reserve(selected.size());
+  for (const uint32_t i : selected)
+    selected_kpts.push_back(kpts[i]);
+  kpts.swap(selected_kpts);
+}
+
+} // namespace
+
 std::unique_ptr<AKAZE_Image_describer_SURF::Regions_type>
 AKAZE_Image_describer_SURF::Describe_AKAZE_SURF
 (
@@ -44,6 +79,8 @@ AKAZE_Image_describer_SURF::Describe_AKAZE_SURF
                             }),
              kpts.end());
 
+  Select_Keypoints(kpts, max_features_, feature_selection_, image);
+
   regions->Features().resize(kpts.size());
   regions->Descriptors().resize(kpts.size());
 
@@ -101,6 +138,8 @@ AKAZE_Image_describer_LIOP::Describe_AKAZE_LIOP
                             }),
              kpts.end());
 
+  Select_Keypoints(kpts, max_features_, feature_selection_, image);
+
   regions->Features().resize(kpts.size());
   regions->Descriptors().resize(kpts.size());
 
@@ -169,6 +208,8 @@ AKAZE_Image_describer_MLDB::Describe_AKAZE_MLDB
                             }),
              kpts.end());
 
+  Select_Keypoints(kpts, max_features_, feature_selection_, image);
+
   regions->Features().resize(kpts.size());
   regions->Descriptors().resize(kpts.size());
 
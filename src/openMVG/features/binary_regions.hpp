@@ -118,6 +118,30 @@ public:
     return descDist * descDist;
   }
 
+  void SquaredDescriptorDistances
+  (
+    size_t i,
+    const Regions * regions,
+    const std::vector<uint32_t> & js,
+    std::vector<double> & distances
+  ) const override
+  {
+    assert(i < vec_descs_.size());
+    assert(regions);
+
+    const Binary_Regions<FeatT, L> * regionsT = dynamic_cast<const Binary_Regions<FeatT, L> *>(regions);
+    matching::Hamming<unsigned char> metric;
+    const unsigned char * query = vec_descs_[i].data();
+    distances.resize(js.size());
+    for (size_t k = 0; k < js.size(); ++k)
+    {
+      assert(js[k] < regionsT->vec_descs_.size());
+      const typename matching::Hamming<unsigned char>::ResultType descDist =
+        metric(query, regionsT->vec_descs_[js[k]].data(), DescriptorT::static_size);
+      distances[k] = descDist * descDist;
+    }
+  }
+
   /// Add the Inth region to another Region container
   void CopyRegion(size_t i, Regions * region_container) const override
   {
@@ -11,7 +11,14 @@
 #include "openMVG/image/image_container.hpp"
 #include "third_party/fast/fast.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 //
 // Bibliography
 //
@@ -25,6 +32,188 @@ namespace openMVG
 namespace features
 {
 
+namespace
+{
+
+using CornerScoreCall = int (*) (const unsigned char *, const int[], int);
+
+/// A detected corner and its score
+struct ScoredCorner
+{
+  int score;
+  int x, y;
+};
+
+/// Offsets of the 16 pixels of the Bresenham circle of radius 3
+/// (in the order used by the fastN_corner_score functions).
+void MakeCircleOffsets(int pixel[16], const int stride)
+{
+  const int dx[16] = {0, 1, 2, 3, 3,  3,  2,  1,  0, -1, -2, -3, -3, -3, -2, -1};
+  const int dy[16] = {3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1,  0,  1,  2,  3};
+  for (int i = 0; i < 16; ++i)
+    pixel[i] = dx[i] + dy[i] * stride;
+}
+
+/// Segment test: list (in raster order) the pixels of [x_begin, x_end[ x [y_begin, y_end[
+/// with an arc of at least arc_length contiguous circle pixels that are all
+/// brighter than center + threshold or all darker than center - threshold.
+/// The area must lie at least 3 pixels away from the image border.
+void SegmentTest
+(
+  const image::Image<unsigned char> & ima,
+  const int x_begin, const int x_end,
+  const int y_begin, const int y_end,
+  const int threshold,
+  const int arc_length,
+  const int pixel[16],
+  std::vector<ScoredCorner> & corners
+)
+{
+  const int stride = ima.Width();
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  // 16 pixels are tested at once. Unsigned comparisons are done with signed
+  // ones on the 0x80 shifted values. The length of the brighter and darker
+  // runs are counted along the circle (+ its arc_length - 1 first pixels for
+  // the wrap around).
+  const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+  const __m128i barrier = _mm_set1_epi8(static_cast<char>(std::min(threshold, 255)));
+  const __m128i min_arc = _mm_set1_epi8(static_cast<char>(arc_length - 1));
+  const __m128i one = _mm_set1_epi8(1);
+#endif
+  for (int y = y_begin; y < y_end; ++y)
+  {
+    const unsigned char * row = ima.data() + y * stride;
+    int x = x_begin;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    for (; x + 16 <= x_end; x += 16)
+    {
+      const unsigned char * p = row + x;
+      const __m128i center = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      const __m128i brighter = _mm_xor_si128(_mm_adds_epu8(center, barrier), sign);
+      const __m128i darker = _mm_xor_si128(_mm_subs_epu8(center, barrier), sign);
+
+      __m128i is_brighter[16], is_darker[16];
+      const auto compare = [&](const int i)
+      {
+        const __m128i value = _mm_xor_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + pixel[i])), sign);
+        is_brighter[i] = _mm_cmpgt_epi8(value, brighter);
+        is_darker[i] = _mm_cmpgt_epi8(darker, value);
+      };
+
+      // Quick rejection: an arc of 9 pixels or more contains at least
+      // two of the four compass pixels
+      __m128i brighter_count = _mm_setzero_si128(), darker_count = _mm_setzero_si128();
+      for (int i = 0; i < 16; i += 4)
+      {
+        compare(i);
+        brighter_count = _mm_sub_epi8(brighter_count, is_brighter[i]);
+        darker_count = _mm_sub_epi8(darker_count, is_darker[i]);
+      }
+      if (_mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpgt_epi8(brighter_count, one), _mm_cmpgt_epi8(darker_count, one))) == 0)
+        continue;
+
+      for (int i = 0; i < 16; ++i)
+        if (i % 4 != 0)
+          compare(i);
+
+      __m128i brighter_run = _mm_setzero_si128(), darker_run = _mm_setzero_si128();
+      __m128i brighter_max = _mm_setzero_si128(), darker_max = _mm_setzero_si128();
+      for (int k = 0; k < 16 + arc_length - 1; ++k)
+      {
+        const int i = k & 15;
+        // run = (run + 1) if the pixel pass the test, else 0
+        brighter_run = _mm_and_si128(_mm_sub_epi8(brighter_run, is_brighter[i]), is_brighter[i]);
+        darker_run = _mm_and_si128(_mm_sub_epi8(darker_run, is_darker[i]), is_darker[i]);
+        brighter_max = _mm_max_epu8(brighter_max, brighter_run);
+        darker_max = _mm_max_epu8(darker_max, darker_run);
+      }
+      int mask = _mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpgt_epi8(brighter_max, min_arc), _mm_cmpgt_epi8(darker_max, min_arc)));
+      for (int i = 0; mask != 0; ++i, mask >>= 1)
+      {
+        if (mask & 1)
+          corners.push_back({0, x + i, y});
+      }
+    }
+#endif
+    for (; x < x_end; ++x)
+    {
+      const unsigned char * p = row + x;
+      const int brighter = *p + threshold, darker = *p - threshold;
+      int brighter_run = 0, darker_run = 0;
+      for (int k = 0; k < 16 + arc_length - 1; ++k)
+      {
+        const int value = p[pixel[k & 15]];
+        brighter_run = (value > brighter) ? brighter_run + 1 : 0;
+        darker_run = (value < darker) ? darker_run + 1 : 0;
+        if (brighter_run >= arc_length || darker_run >= arc_length)
+        {
+          corners.push_back({0, x, y});
+          break;
+        }
+      }
+    }
+  }
+}
+
+/// Detect the non-maximum suppressed corners of the [x_begin, x_end[ x [y_begin, y_end[ cell
+void DetectInCell
+(
+  const image::Image<unsigned char> & ima,
+  const int x_begin, const int x_end,
+  const int y_begin, const int y_end,
+  const int threshold,
+  const int arc_length,
+  const CornerScoreCall corner_score,
+  const int pixel[16],
+  std::vector<ScoredCorner> & cell_corners
+)
+{
+  // The corners of the 1 pixel ring around the cell are required by the
+  // non-maximum suppression (only the pixels 3 pixels away from the border can be tested)
+  const int
+    area_x_begin = std::max(3, x_begin - 1), area_x_end = std::min(ima.Width() - 3, x_end + 1),
+    area_y_begin = std::max(3, y_begin - 1), area_y_end = std::min(ima.Height() - 3, y_end + 1);
+  cell_corners.clear();
+  if (area_x_begin >= area_x_end || area_y_begin >= area_y_end)
+    return;
+
+  std::vector<ScoredCorner> corners;
+  SegmentTest(ima, area_x_begin, area_x_end, area_y_begin, area_y_end,
+    threshold, arc_length, pixel, corners);
+
+  // Score map of the area (-1 if the pixel is not a corner)
+  const int area_width = area_x_end - area_x_begin + 2;
+  std::vector<int> scores(area_width * (area_y_end - area_y_begin + 2), -1);
+  const auto score_at = [&](const int x, const int y) -> int &
+  {
+    return scores[(y - area_y_begin + 1) * area_width + x - area_x_begin + 1];
+  };
+  for (ScoredCorner & corner : corners)
+  {
+    corner.score = corner_score(ima.data() + corner.y * ima.Width() + corner.x, pixel, threshold);
+    score_at(corner.x, corner.y) = corner.score;
+  }
+
+  // Non-maximum suppression (a corner is discarded if a neighbor has a higher or equal score)
+  for (const ScoredCorner & corner : corners)
+  {
+    if (corner.x < x_begin || corner.x >= x_end || corner.y < y_begin || corner.y >= y_end)
+      continue;
+    bool is_maximum = true;
+    for (int dy = -1; dy <= 1 && is_maximum; ++dy)
+      for (int dx = -1; dx <= 1 && is_maximum; ++dx)
+        if ((dx != 0 || dy != 0) && score_at(corner.x + dx, corner.y + dy) >= corner.score)
+          is_maximum = false;
+    if (is_maximum)
+      cell_corners.push_back(corner);
+  }
+}
+
+} // namespace
+
 FastCornerDetector::FastCornerDetector
 (
   int size,
@@ -40,31 +229,130 @@ void FastCornerDetector::detect
   std::vector<PointFeature> & regions
 )
 {
-  using FastDetectorCall =
-    xy* (*) (const unsigned char *, int, int, int, int, int *);
-
-  FastDetectorCall detector = nullptr;
-  if (size_ ==  9) detector =  fast9_detect_nonmax;
-  if (size_ == 10) detector = fast10_detect_nonmax;
-  if (size_ == 11) detector = fast11_detect_nonmax;
-  if (size_ == 12) detector = fast12_detect_nonmax;
-  if (!detector)
+  // Detect all the corners at the constructor threshold
+  detect(ima, regions, std::numeric_limits<size_t>::max(), 64, threshold_);
+
+  // List the corners in raster order
+  std::sort(regions.begin(), regions.end(),
+    [](const PointFeature & a, const PointFeature & b)
+    {
+      return std::make_pair(a.y(), a.x()) < std::make_pair(b.y(), b.x());
+    });
+}
+
+void FastCornerDetector::detect
+(
+  const image::Image<unsigned char> & ima,
+  std::vector<PointFeature> & regions,
+  const size_t max_count,
+  const int cell_size,
+  const int min_threshold
+)
+{
+  CornerScoreCall corner_score = nullptr;
+  if (size_ ==  9) corner_score =  fast9_corner_score;
+  if (size_ == 10) corner_score = fast10_corner_score;
+  if (size_ == 11) corner_score = fast11_corner_score;
+  if (size_ == 12) corner_score = fast12_corner_score;
+  regions.clear();
+  if (!corner_score)
   {
     std::cout << "Invalid size for FAST detector: " << size_ << std::endl;
     return;
   }
+  if (cell_size <= 0)
+  {
+    return;
+  }
 
-  int num_corners = 0;
-  xy* detections = detector(ima.data(),
-     ima.Width(), ima.Height(), ima.Width(),
-     threshold_, &num_corners);
-  regions.clear();
-  regions.reserve(num_corners);
-  for (int i = 0; i < num_corners; ++i)
+  int pixel[16];
+  MakeCircleOffsets(pixel, ima.Width());
+
+  const int
+    cell_cols = (ima.Width() + cell_size - 1) / cell_size,
+    cell_rows = (ima.Height() + cell_size - 1) / cell_size,
+    cell_count = cell_cols * cell_rows;
+  // Even share of the budget (the adaptive threshold tries to reach it)
+  const size_t cell_budget = (cell_count == 0) ? 0 :
+    (max_count == std::numeric_limits<size_t>::max()) ? max_count :
+    (max_count + cell_count - 1) / cell_count;
+
+  std::vector<std::vector<ScoredCorner>> cell_corners(cell_count);
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int cell = 0; cell < cell_count; ++cell)
+  {
+    const int
+      x_begin = (cell % cell_cols) * cell_size,
+      y_begin = (cell / cell_cols) * cell_size,
+      x_end = std::min(ima.Width(), x_begin + cell_size),
+      y_end = std::min(ima.Height(), y_begin + cell_size);
+    std::vector<ScoredCorner> & corners = cell_corners[cell];
+    int threshold = std::max(threshold_, min_threshold);
+    DetectInCell(ima, x_begin, x_end, y_begin, y_end,
+      threshold, size_, corner_score, pixel, corners);
+    while (corners.size() < cell_budget && threshold > min_threshold)
+    {
+      threshold = std::max(threshold / 2, min_threshold);
+      DetectInCell(ima, x_begin, x_end, y_begin, y_end,
+        threshold, size_, corner_score, pixel, corners);
+    }
+    // Strongest corners first
+    std::stable_sort(corners.begin(), corners.end(),
+      [](const ScoredCorner & a, const ScoredCorner & b) { return a.score > b.score; });
+  }
+
+  // Find the per cell quota that fits the budget: the cells that cannot fill
+  // their share give it to the others
+  size_t corner_count = 0, max_cell_count = 0;
+  for (const auto & corners : cell_corners)
+  {
+    corner_count += corners.size();
+    max_cell_count = std::max(max_cell_count, corners.size());
+  }
+  size_t quota = max_cell_count;
+  if (corner_count > max_count)
+  {
+    // smallest quota such that sum(min(cell count, quota)) >= max_count
+    size_t low = 0, high = max_cell_count;
+    while (low < high)
+    {
+      const size_t mid = (low + high) / 2;
+      size_t count = 0;
+      for (const auto & corners : cell_corners)
+        count += std::min(corners.size(), mid);
+      if (count >= max_count)
+        high = mid;
+      else
+        low = mid + 1;
+    }
+    quota = low;
+  }
+
+  // Keep quota - 1 corners per cell, then the best last ranked corners that fit the budget
+  size_t remaining = std::min(max_count, corner_count);
+  std::vector<std::pair<int, int>> last_ranked; // (score, cell)
+  for (int cell = 0; cell < cell_count; ++cell)
+  {
+    const size_t kept = std::min(cell_corners[cell].size(), quota > 0 ? quota - 1 : 0);
+    remaining -= kept;
+    if (cell_corners[cell].size() >= quota && quota > 0)
+      last_ranked.emplace_back(cell_corners[cell][quota - 1].score, cell);
+  }
+  std::stable_sort(last_ranked.begin(), last_ranked.end(),
+    [](const std::pair<int, int> & a, const std::pair<int, int> & b) { return a.first > b.first; });
+  std::vector<size_t> cell_kept(cell_count, quota > 0 ? quota - 1 : 0);
+  for (size_t i = 0; i < last_ranked.size() && i < remaining; ++i)
+    ++cell_kept[last_ranked[i].second];
+
+  regions.reserve(std::min(max_count, corner_count));
+  for (int cell = 0; cell < cell_count; ++cell)
   {
-    regions.emplace_back(detections[i].x, detections[i].y);
+    const std::vector<ScoredCorner> & corners = cell_corners[cell];
+    for (size_t i = 0; i < std::min(corners.size(), cell_kept[cell]); ++i)
+      regions.emplace_back(corners[i].x, corners[i].y);
   }
-  free( detections );
 }
 
 } // namespace features
@@ -47,11 +47,38 @@ public:
     int threshold = 30
   );
 
+  /**
+   * Detect all the (non-maximum suppressed) corners of the image.
+   * The corners are listed in raster order.
+  **/
   void detect
   (
     const image::Image<unsigned char> & ima,
     std::vector<PointFeature> & regions
   );
+
+  /**
+   * Detect corners evenly spread over the image (grid based keypoint budget).
+   * The image is split in square cells that are processed in parallel and
+   * each cell keeps its strongest corners up to an even share of max_count
+   * (the share of the cells that do not fill it is given to the others).
+   * A cell with too few corners is processed again with a lower threshold
+   * (halved down to min_threshold) in order to deal with low contrast areas.
+   *
+   * \param ima           The input image.
+   * \param regions       The detected corners (by cell, then by decreasing score).
+   * \param max_count     The maximal number of detected corners.
+   * \param cell_size     The size of the grid cells in pixels.
+   * \param min_threshold The lowest threshold used by the adaptive detection.
+  **/
+  void detect
+  (
+    const image::Image<unsigned char> & ima,
+    std::vector<PointFeature> & regions,
+    const size_t max_count,
+    const int cell_size = 64,
+    const int min_threshold = 5
+  );
 };
 
 } // namespace features
@@ -0,0 +1,130 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/fast/fast_detector.hpp"
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/image/image_io.hpp"
+#include "third_party/fast/fast.h"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+using namespace openMVG;
+using namespace openMVG::features;
+
+// Grid of squares: bright ones on the left half, low contrast ones on the right half
+image::Image<unsigned char> SquaresImage()
+{
+  image::Image<unsigned char> image(512, 256, true, 0);
+  for (int y = 8; y + 8 < image.Height(); y += 16)
+    for (int x = 8; x + 8 < image.Width(); x += 16)
+      for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 8; ++j) // (a small gradient avoids score ties)
+          image(y + i, x + j) = (x < image.Width() / 2 ? 160 : 8) + i + 2 * j;
+  return image;
+}
+
+TEST(FastCornerDetector, Detect)
+{
+  const image::Image<unsigned char> image = SquaresImage();
+  std::vector<PointFeature> feats;
+  FastCornerDetector(9, 30).detect(image, feats);
+  // Only the 4 corners of the bright squares are detected
+  EXPECT_EQ(16 * 15 * 4, feats.size());
+  for (const auto & feat : feats)
+    EXPECT_TRUE(feat.x() < image.Width() / 2);
+  // The corners are listed in raster order
+  EXPECT_TRUE(std::is_sorted(feats.cbegin(), feats.cend(),
+    [](const PointFeature & a, const PointFeature & b)
+    { return a.y() < b.y() || (a.y() == b.y() && a.x() < b.x()); }));
+}
+
+TEST(FastCornerDetector, GridBudget)
+{
+  const image::Image<unsigned char> image = SquaresImage();
+  const size_t max_count = 200;
+  std::vector<PointFeature> feats;
+  FastCornerDetector(9, 30).detect(image, feats, max_count, 64, 5);
+  EXPECT_EQ(max_count, feats.size());
+
+  // The adaptive threshold finds the low contrast corners:
+  // the corners are evenly spread over the image cells
+  std::vector<int> cell_count(8 * 4, 0);
+  for (const auto & feat : feats)
+    ++cell_count[static_cast<int>(feat.y()) / 64 * 8 + static_cast<int>(feat.x()) / 64];
+  const auto minmax = std::minmax_element(cell_count.cbegin(), cell_count.cend());
+  EXPECT_TRUE(*minmax.second - *minmax.first <= 1);
+
+  // Without adaptive threshold only the bright half can be used
+  FastCornerDetector(9, 30).detect(image, feats, max_count, 64, 30);
+  EXPECT_EQ(max_count, feats.size());
+  for (const auto & feat : feats)
+    EXPECT_TRUE(feat.x() < image.Width() / 2);
+}
+
+// Tell if the tiled detection finds the same corners as the reference FAST-9
+//  implementation, in the same raster order.
+bool SameAsReference
+(
+  const image::Image<unsigned char> & image,
+  const int threshold
+)
+{
+  std::vector<PointFeature> feats;
+  FastCornerDetector(9, threshold).detect(image, feats);
+
+  int corner_count = 0;
+  xy * corners = fast9_detect_nonmax(image.data(), image.Width(), image.Height(),
+    image.Width(), threshold, &corner_count);
+  bool same_corners = (static_cast<size_t>(corner_count) == feats.size());
+  for (int i = 0; i < corner_count && same_corners; ++i)
+    same_corners = (feats[i].x() == corners[i].x && feats[i].y() == corners[i].y);
+  free(corners);
+  return same_corners;
+}
+
+TEST(FastCornerDetector, SameAsReference_Image)
+{
+  const std::string png_filename = std::string(THIS_SOURCE_DIR)
+    + "/../../../openMVG_Samples/imageData/StanfordMobileVisualSearch/Ace_0.png";
+  image::Image<unsigned char> image;
+  EXPECT_TRUE(image::ReadImage(png_filename.c_str(), &image));
+
+  // Crop the image to sizes that are not a multiple of the 64 pixels cells:
+  //  the border cells are smaller than the others.
+  for (const auto size : {std::make_pair(500, 500), std::make_pair(451, 389), std::make_pair(131, 200)})
+  {
+    const image::Image<unsigned char> crop(
+      image.GetMat().block(0, 0, size.second, size.first));
+    for (const int threshold : {5, 10, 20, 40})
+      EXPECT_TRUE(SameAsReference(crop, threshold));
+  }
+}
+
+TEST(FastCornerDetector, SameAsReference_Noise)
+{
+  std::mt19937 random_generator(0);
+  std::uniform_int_distribution<int> value(0, 255);
+  for (const auto size : {std::make_pair(320, 240), std::make_pair(333, 197), std::make_pair(70, 9)})
+  {
+    image::Image<unsigned char> image(size.first, size.second);
+    for (int y = 0; y < image.Height(); ++y)
+      for (int x = 0; x < image.Width(); ++x)
+        image(y, x) = value(random_generator);
+    for (const int threshold : {5, 20, 60, 120})
+      EXPECT_TRUE(SameAsReference(image, threshold));
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
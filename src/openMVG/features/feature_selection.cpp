@@ -0,0 +1,206 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/feature_selection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace openMVG {
+namespace features {
+
+namespace {
+
+// Regular grid covering the image, used to bucket the features
+struct SelectionGrid
+{
+  SelectionGrid(int width, int height, float cell_size)
+    : cell_size_(std::max(1.f, cell_size)),
+      cols_(std::max(1, static_cast<int>(std::ceil(width / cell_size_)))),
+      rows_(std::max(1, static_cast<int>(std::ceil(height / cell_size_))))
+  {}
+
+  int Col(const Vec2f & pos) const
+  {
+    return std::min(cols_ - 1, std::max(0, static_cast<int>(pos.x() / cell_size_)));
+  }
+
+  int Row(const Vec2f & pos) const
+  {
+    return std::min(rows_ - 1, std::max(0, static_cast<int>(pos.y() / cell_size_)));
+  }
+
+  int Cell(const Vec2f & pos) const
+  {
+    return Row(pos) * cols_ + Col(pos);
+  }
+
+  const float cell_size_;
+  const int cols_, rows_;
+};
+
+// Round robin over the cells: each cell gives its strongest remaining feature
+void GridSelection
+(
+  const std::vector<Vec2f> & positions,
+  const std::vector<uint32_t> & by_response,
+  size_t max_count,
+  int width,
+  int height,
+  std::vector<uint32_t> & selected
+)
+{
+  // A few candidates per cell, to favor strong features over weak features
+  //  that would only be picked for being alone in their cell
+  const float features_per_cell = 4.f;
+  const SelectionGrid grid(width, height,
+    std::sqrt(features_per_cell * width * height / max_count));
+
+  // Rank of the features in their cell
+  std::vector<uint32_t> cell_count(grid.cols_ * grid.rows_, 0);
+  std::vector<uint32_t> rank(positions.size());
+  for (const uint32_t i : by_response)
+    rank[i] = cell_count[grid.Cell(positions[i])]++;
+
+  // Best ranks first, and by decreasing response for a given rank
+  selected = by_response;
+  std::stable_sort(selected.begin(), selected.end(),
+    [&rank](uint32_t a, uint32_t b) { return rank[a] < rank[b]; });
+  selected.resize(max_count);
+}
+
+// Keep the features having the largest suppression radius, i.e. the
+//  distance to the closest stronger feature.
+// Note: the robustness factor of [1] is not used (a feature is suppressed by
+//  any stronger feature), else all the features of the top response band
+//  would get an infinite radius, whatever their spread.
+void ANMSSelection
+(
+  const std::vector<Vec2f> & positions,
+  const std::vector<float> & responses,
+  const std::vector<uint32_t> & by_response,
+  size_t max_count,
+  int width,
+  int height,
+  std::vector<uint32_t> & selected
+)
+{
+  // The already processed (stronger) features are bucketed in a grid
+  //  (around one feature per cell) to speed up the closest feature search.
+  const SelectionGrid grid(width, height,
+    std::sqrt(static_cast<float>(width) * height / positions.size()));
+  std::vector<std::vector<uint32_t>> cells(grid.cols_ * grid.rows_);
+
+  std::vector<float> radius(positions.size(), std::numeric_limits<float>::infinity());
+  size_t inserted = 0;
+  for (const uint32_t i : by_response)
+  {
+    while (inserted < by_response.size() &&
+           responses[by_response[inserted]] > responses[i])
+    {
+      const uint32_t j = by_response[inserted++];
+      cells[grid.Cell(positions[j])].push_back(j);
+    }
+    if (inserted == 0)
+      continue;
+
+    // Visit the cells ring by ring, until no closer feature can be found
+    const Vec2f & pos = positions[i];
+    const int col = grid.Col(pos), row = grid.Row(pos);
+    const int max_ring = std::max(grid.cols_, grid.rows_);
+    float best_sq_dist = std::numeric_limits<float>::infinity();
+    for (int ring = 0; ring <= max_ring; ++ring)
+    {
+      for (int r = row - ring; r <= row + ring; ++r)
+      {
+        if (r < 0 || r >= grid.rows_)
+          continue;
+        const bool border_row = (r == row - ring || r == row + ring);
+        for (int c = col - ring; c <= col + ring; c += (border_row ? 1 : 2 * ring))
+        {
+          if (c >= 0 && c < grid.cols_)
+          {
+            for (const uint32_t j : cells[r * grid.cols_ + c])
+              best_sq_dist = std::min(best_sq_dist, (positions[j] - pos).squaredNorm());
+          }
+          if (ring == 0)
+            break;
+        }
+      }
+      // The features of the next rings are at least ring * cell_size away
+      const float min_next_dist = ring * grid.cell_size_;
+      if (best_sq_dist <= min_next_dist * min_next_dist)
+        break;
+    }
+    radius[i] = std::sqrt(best_sq_dist);
+  }
+
+  // Largest radius first, and by decreasing response for a given radius
+  selected = by_response;
+  std::stable_sort(selected.begin(), selected.end(),
+    [&radius](uint32_t a, uint32_t b) { return radius[a] > radius[b]; });
+  selected.resize(max_count);
+}
+
+} // namespace
+
+bool StringToEnum_EFeatureSelection
+(
+  const std::string & name,
+  EFeatureSelection & selection
+)
+{
+  if (name == "GRID")
+    selection = EFeatureSelection::GRID;
+  else if (name == "ANMS")
+    selection = EFeatureSelection::ANMS;
+  else
+    return false;
+  return true;
+}
+
+std::vector<uint32_t> SelectFeatures
+(
+  const std::vector<Vec2f> & positions,
+  const std::vector<float> & responses,
+  size_t max_count,
+  int width,
+  int height,
+  EFeatureSelection selection
+)
+{
+  std::vector<uint32_t> by_response(positions.size());
+  std::iota(by_response.begin(), by_response.end(), 0);
+  std::stable_sort(by_response.begin(), by_response.end(),
+    [&responses](uint32_t a, uint32_t b) { return responses[a] > responses[b]; });
+
+  if (max_count == 0 || positions.size() <= max_count ||
+      width <= 0 || height <= 0)
+  {
+    if (max_count != 0 && by_response.size() > max_count)
+      by_response.resize(max_count);
+    return by_response;
+  }
+
+  std::vector<uint32_t> selected;
+  switch (selection)
+  {
+    case EFeatureSelection::GRID:
+      GridSelection(positions, by_response, max_count, width, height, selected);
+    break;
+    case EFeatureSelection::ANMS:
+      ANMSSelection(positions, responses, by_response, max_count, width, height, selected);
+    break;
+  }
+  return selected;
+}
+
+} // namespace features
+} // namespace openMVG
@@ -0,0 +1,72 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_FEATURES_FEATURE_SELECTION_HPP
+#define OPENMVG_FEATURES_FEATURE_SELECTION_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+
+namespace openMVG {
+namespace features {
+
+/// Strategy used to keep a spatially well distributed subset of features
+enum class EFeatureSelection
+{
+  // Image split in cells, the cells are visited in turn and give their
+  //  strongest remaining feature
+  GRID,
+  // Adaptive Non Maximal Suppression [1]: keep the features that are the
+  //  strongest in the largest neighborhood
+  ANMS
+};
+
+// [1] Multi-Image Matching using Multi-Scale Oriented Patches.
+//     M. Brown, R. Szeliski and S. Winder. CVPR 2005.
+
+/**
+* @brief Convert a string to a feature selection strategy
+* @param[in] name "GRID" or "ANMS"
+* @param[out] selection The corresponding strategy
+* @return True if the name is known
+*/
+bool StringToEnum_EFeatureSelection
+(
+  const std::string & name,
+  EFeatureSelection & selection
+);
+
+/**
+* @brief Select at most max_count features, ranked by response and spread
+*  over the image.
+* @param positions Feature positions (in image coordinates)
+* @param responses Feature detector responses (the larger, the stronger)
+* @param max_count Maximal number of selected features (0: no limit)
+* @param width Image width
+* @param height Image height
+* @param selection Selection strategy
+* @return The indexes of the selected features, ordered by decreasing
+*  priority (the first ones are the most relevant).
+*/
+std::vector<uint32_t> SelectFeatures
+(
+  const std::vector<Vec2f> & positions,
+  const std::vector<float> & responses,
+  size_t max_count,
+  int width,
+  int height,
+  EFeatureSelection selection = EFeatureSelection::GRID
+);
+
+} // namespace features
+} // namespace openMVG
+
+#endif // OPENMVG_FEATURES_FEATURE_SELECTION_HPP
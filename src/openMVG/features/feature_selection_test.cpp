@@ -0,0 +1,104 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/feature_selection.hpp"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::features;
+
+namespace {
+
+// Strong features crowded in the top left corner, weak features elsewhere
+void CrowdedScene
+(
+  std::vector<Vec2f> & positions,
+  std::vector<float> & responses
+)
+{
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<float> corner(0.f, 100.f), image(0.f, 1000.f);
+  for (int i = 0; i < 1000; ++i)
+  {
+    positions.emplace_back(corner(random_generator), corner(random_generator));
+    responses.push_back(10.f + corner(random_generator));
+  }
+  for (int i = 0; i < 1000; ++i)
+  {
+    positions.emplace_back(image(random_generator), image(random_generator));
+    responses.push_back(1.f + corner(random_generator) / 100.f);
+  }
+}
+
+// Count the selected features that are located in the top left corner
+size_t CountInCorner
+(
+  const std::vector<Vec2f> & positions,
+  const std::vector<uint32_t> & selected
+)
+{
+  return std::count_if(selected.begin(), selected.end(),
+    [&](uint32_t i) { return positions[i].x() < 100.f && positions[i].y() < 100.f; });
+}
+
+} // namespace
+
+TEST(FeatureSelection, NoLimit)
+{
+  const std::vector<Vec2f> positions = {{1.f, 1.f}, {2.f, 2.f}, {3.f, 3.f}};
+  const std::vector<float> responses = {1.f, 3.f, 2.f};
+  for (const EFeatureSelection selection : {EFeatureSelection::GRID, EFeatureSelection::ANMS})
+  {
+    // All the features are kept, ordered by decreasing response
+    const std::vector<uint32_t> expected = {1, 2, 0};
+    EXPECT_TRUE(expected == SelectFeatures(positions, responses, 0, 10, 10, selection));
+    EXPECT_TRUE(expected == SelectFeatures(positions, responses, 3, 10, 10, selection));
+  }
+}
+
+TEST(FeatureSelection, SpatialSpread)
+{
+  std::vector<Vec2f> positions;
+  std::vector<float> responses;
+  CrowdedScene(positions, responses);
+
+  // Response only ranking keeps the crowded corner
+  const size_t budget = 200;
+  std::vector<uint32_t> by_response(positions.size());
+  std::iota(by_response.begin(), by_response.end(), 0);
+  std::sort(by_response.begin(), by_response.end(),
+    [&](uint32_t a, uint32_t b) { return responses[a] > responses[b]; });
+  by_response.resize(budget);
+  EXPECT_EQ(budget, CountInCorner(positions, by_response));
+
+  for (const EFeatureSelection selection : {EFeatureSelection::GRID, EFeatureSelection::ANMS})
+  {
+    const std::vector<uint32_t> selected =
+      SelectFeatures(positions, responses, budget, 1000, 1000, selection);
+    EXPECT_EQ(budget, selected.size());
+
+    // Each feature is selected once
+    std::vector<uint32_t> sorted_selected = selected;
+    std::sort(sorted_selected.begin(), sorted_selected.end());
+    EXPECT_TRUE(std::adjacent_find(sorted_selected.begin(), sorted_selected.end())
+      == sorted_selected.end());
+
+    // The strongest feature comes first and the corner does not take the whole budget
+    EXPECT_EQ(by_response[0], selected[0]);
+    EXPECT_TRUE(CountInCorner(positions, selected) < budget / 4);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
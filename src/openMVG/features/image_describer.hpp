@@ -12,6 +12,7 @@
 #include <memory>
 #include <string>
 
+#include "openMVG/features/feature_selection.hpp"
 #include "openMVG/features/regions.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 
@@ -43,6 +44,26 @@ public:
     EDESCRIBER_PRESET preset
   ) = 0;
 
+  /**
+  @brief Limit the number of regions computed per image.
+    The strongest keypoints are kept, spread over the image, before their
+    description.
+  @param max_features Maximal number of regions per image (0: no limit).
+  @param selection Strategy used to spread the kept keypoints.
+  */
+  void Set_max_features
+  (
+    size_t max_features,
+    EFeatureSelection selection = EFeatureSelection::GRID
+  )
+  {
+    max_features_ = max_features;
+    feature_selection_ = selection;
+  }
+
+  /// Maximal number of regions per image (0: no limit)
+  size_t Get_max_features() const { return max_features_; }
+
   /**
   @brief Detect regions on the image and compute their attributes (description)
   @param image Image.
@@ -107,6 +128,10 @@ public:
   {
     return regions->LoadFeatures(sfileNameFeats);
   }
+
+protected:
+  size_t max_features_ = 0;
+  EFeatureSelection feature_selection_ = EFeatureSelection::GRID;
 };
 
 } // namespace features
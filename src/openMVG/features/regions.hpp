@@ -9,7 +9,10 @@
 #ifndef OPENMVG_FEATURES_REGIONS_HPP
 #define OPENMVG_FEATURES_REGIONS_HPP
 
+#include <cstdint>
 #include <string>
+#include <vector>
+
 #include <openMVG/features/feature.hpp>
 #include <openMVG/features/feature_container.hpp>
 #include <openMVG/numeric/eigen_alias_definition.hpp>
@@ -71,6 +74,20 @@ public:
     const Regions *,
     size_t j) const = 0;
 
+  /// Return the squared distances between the descriptor i and a list of
+  ///  descriptors of another Regions container (same metric as above).
+  // Override it to resolve the container type once for the whole list.
+  virtual void SquaredDescriptorDistances(
+    size_t i,
+    const Regions * regions,
+    const std::vector<uint32_t> & js,
+    std::vector<double> & distances) const
+  {
+    distances.resize(js.size());
+    for (size_t k = 0; k < js.size(); ++k)
+      distances[k] = SquaredDescriptorDistance(i, regions, js[k]);
+  }
+
   /// Add the Inth region to another Region container
   virtual void CopyRegion(size_t i, Regions *) const = 0;
 
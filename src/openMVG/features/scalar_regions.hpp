@@ -114,6 +114,28 @@ public:
     return metric(vec_descs_[i].data(), regionsT->vec_descs_[j].data(), DescriptorT::static_size);
   }
 
+  void SquaredDescriptorDistances
+  (
+    size_t i,
+    const Regions * regions,
+    const std::vector<uint32_t> & js,
+    std::vector<double> & distances
+  ) const override
+  {
+    assert(i < vec_descs_.size());
+    assert(regions);
+
+    const Scalar_Regions<FeatT, T, L> * regionsT = dynamic_cast<const Scalar_Regions<FeatT, T, L> *>(regions);
+    matching::L2<T> metric;
+    const T * query = vec_descs_[i].data();
+    distances.resize(js.size());
+    for (size_t k = 0; k < js.size(); ++k)
+    {
+      assert(js[k] < regionsT->vec_descs_.size());
+      distances[k] = metric(query, regionsT->vec_descs_[js[k]].data(), DescriptorT::static_size);
+    }
+  }
+
   /// Add the Inth region to another Region container
   void CopyRegion(size_t i, Regions * region_container) const override
   {
@@ -48,6 +48,8 @@ Changes are:
 #ifndef OPENMVG_FEATURES_SIFT_SIFT_ANATOMY_IMAGE_DESCRIBER_HPP
 #define OPENMVG_FEATURES_SIFT_SIFT_ANATOMY_IMAGE_DESCRIBER_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <vector>
 
@@ -154,31 +156,90 @@ public:
       // +1 for dog computation
       // +2 for 3d discrete extrema definition
 
+      const GaussianScaleSpaceParams scale_space_params =
+        (params_.first_octave_ == -1)
+        ? GaussianScaleSpaceParams(1.6f/2.0f, 1.0f/2.0f, 0.5f, supplementary_images)
+        : GaussianScaleSpaceParams(1.6f, 1.0f, 0.5f, supplementary_images);
       HierarchicalGaussianScaleSpace octave_gen(
         params_.num_octaves_,
         params_.num_scales_,
-        (params_.first_octave_ == -1)
-        ? GaussianScaleSpaceParams(1.6f/2.0f, 1.0f/2.0f, 0.5f, supplementary_images)
-        : GaussianScaleSpaceParams(1.6f, 1.0f, 0.5f, supplementary_images));
+        scale_space_params);
       octave_gen.SetImage( If );
 
       std::vector<sift::Keypoint> keypoints;
       keypoints.reserve(5000);
       Octave octave;
-      while ( octave_gen.NextOctave( octave ) )
+      if (max_features_ == 0)
       {
-        std::vector<sift::Keypoint> keys;
-        // Find Keypoints
-        sift::SIFT_KeypointExtractor keypointDetector(
-          params_.peak_threshold_ / octave_gen.NbSlice(),
-          params_.edge_threshold_);
-        keypointDetector(octave, keys);
-        // Find Keypoints orientation and compute their description
-        sift::Sift_DescriptorExtractor descriptorExtractor;
-        descriptorExtractor(octave, keys);
-
-        // Concatenate the found keypoints
-        std::move(keys.begin(), keys.end(), std::back_inserter(keypoints));
+        while ( octave_gen.NextOctave( octave ) )
+        {
+          std::vector<sift::Keypoint> keys;
+          // Find Keypoints
+          sift::SIFT_KeypointExtractor keypointDetector(
+            params_.peak_threshold_ / octave_gen.NbSlice(),
+            params_.edge_threshold_);
+          keypointDetector(octave, keys);
+          // Find Keypoints orientation and compute their description
+          sift::Sift_DescriptorExtractor descriptorExtractor;
+          descriptorExtractor(octave, keys);
+
+          // Concatenate the found keypoints
+          std::move(keys.begin(), keys.end(), std::back_inserter(keypoints));
+        }
+      }
+      else
+      {
+        // Feature budget:
+        // - detect the keypoints of all the octaves (the octaves are kept),
+        // - keep the strongest ones, spread over the image,
+        // - describe the kept keypoints on their octave.
+        std::vector<sift::Keypoint> detected_keys;
+        detected_keys.reserve(5000);
+        std::vector<Octave> octaves;
+        while ( octave_gen.NextOctave( octave ) )
+        {
+          std::vector<sift::Keypoint> keys;
+          sift::SIFT_KeypointExtractor keypointDetector(
+            params_.peak_threshold_ / octave_gen.NbSlice(),
+            params_.edge_threshold_);
+          keypointDetector(octave, keys);
+          std::move(keys.begin(), keys.end(), std::back_inserter(detected_keys));
+          // The next octave sampling rate is computed from the current one
+          const float delta = octave.delta;
+          octaves.push_back(std::move(octave));
+          octave.delta = delta;
+        }
+        // Feature masking
+        if (mask)
+        {
+          const image::Image<unsigned char> & maskIma = *mask;
+          detected_keys.erase(std::remove_if(detected_keys.begin(), detected_keys.end(),
+            [&](const sift::Keypoint & k) { return maskIma(k.y, k.x) == 0; }),
+            detected_keys.end());
+        }
+        Select_Keypoints(detected_keys, image.Width(), image.Height());
+
+        // Dispatch the kept keypoints to their octave
+        std::vector<std::vector<sift::Keypoint>> octave_keys(octaves.size());
+        for (const auto & k : detected_keys)
+          octave_keys[k.o].push_back(k);
+        detected_keys.clear();
+
+        for (size_t o = 0; o < octaves.size(); ++o)
+        {
+          std::vector<sift::Keypoint> & keys = octave_keys[o];
+          if (!keys.empty())
+          {
+            sift::Sift_DescriptorExtractor descriptorExtractor;
+            descriptorExtractor(octaves[o], keys);
+            std::move(keys.begin(), keys.end(), std::back_inserter(keypoints));
+          }
+          // Release the octave once described
+          octaves[o] = Octave();
+        }
+        // A keypoint can have several orientations: select again among the
+        //  described keypoints to honor the budget
+        Select_Keypoints(keypoints, image.Width(), image.Height());
       }
       for (const auto & k : keypoints)
       {
@@ -216,6 +277,42 @@ public:
   }
 
  private:
+  /**
+  @brief Keep the best max_features_ keypoints (ranked by their peak value
+    and spread over the image).
+  @param[in,out] keys The keypoints, ordered by decreasing priority on return.
+  @param width Image width.
+  @param height Image height.
+  */
+  void Select_Keypoints
+  (
+    std::vector<sift::Keypoint> & keys,
+    int width,
+    int height
+  ) const
+  {
+    if (max_features_ == 0 || keys.size() <= max_features_)
+      return;
+
+    std::vector<Vec2f> positions;
+    std::vector<float> responses;
+    positions.reserve(keys.size());
+    responses.reserve(keys.size());
+    for (const auto & k : keys)
+    {
+      positions.emplace_back(k.x, k.y);
+      responses.push_back(std::abs(k.val));
+    }
+    const std::vector<uint32_t> selected = SelectFeatures(positions, responses,
+      max_features_, width, height, feature_selection_);
+
+    std::vector<sift::Keypoint> selected_keys;
+    selected_keys.reserve(selected.size());
+    for (const uint32_t i : selected)
+      selected_keys.push_back(std::move(keys[i]));
+    keys.swap(selected_keys);
+  }
+
   Params params_;
 };
 
@@ -41,8 +41,14 @@ The implementation is based on
         http://www.ipol.im/pub/algo/rd_anatomy_sift/
 */
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 #include "openMVG/features/feature.hpp"
 #include "openMVG/features/sift/hierarchical_gaussian_scale_space.hpp"
 #include "openMVG/features/sift/sift_keypoint.hpp"
@@ -79,107 +85,100 @@ struct SIFT_KeypointExtractor
   */
   void operator()( const Octave & octave , std::vector<Keypoint> & keypoints )
   {
-    if (!ComputeDogs(octave))
+    // The Difference of Gaussians (Dogs) are never stored as a whole:
+    //  they are computed on the fly from two consecutive Gaussian slices.
+    if (octave.slices.size() < 2)
       return;
-    Find_3d_discrete_extrema(keypoints, 0.8f);
-    Keypoints_refine_position(keypoints);
+    Find_3d_discrete_extrema(octave, keypoints, 0.8f);
+    Keypoints_refine_position(octave, keypoints);
   }
 
 protected:
   /**
-  * @brief Compute the Difference of Gaussians (Dogs) for a Gaussian octave
-  * @param Octave The input Gaussian octave
-  * @retval true If Dogs have been computed
-  * @retval false if Dogs cannot be computed (less than 2 images)
+  * @brief Difference of Gaussians (Dog) value of a Gaussian octave
+  * @param octave The Gaussian octave
+  * @param s The Dog slice id (difference of the Gaussian slices s+1 and s)
+  * @param row The discrete y point position
+  * @param col The discrete x point position
   */
-  bool ComputeDogs(const Octave & octave)
+  static inline float Dog
+  (
+    const Octave & octave,
+    const int s,
+    const int row,
+    const int col
+  )
   {
-    const int n = octave.slices.size();
-    if (n < 2)
-      return false;
+    return octave.slices[s + 1](row, col) - octave.slices[s](row, col);
+  }
 
-    m_Dogs.slices.resize(n-1);
-    m_Dogs.octave_level = octave.octave_level;
-    m_Dogs.delta = octave.delta;
-    m_Dogs.sigmas = octave.sigmas;
-    for (int s = 0; s < m_Dogs.slices.size(); ++s)
+  /**
+  * @brief Compute a row of absolute Dog values
+  * @param octave The Gaussian octave
+  * @param s The Dog slice id
+  * @param row The row id
+  * @param[out] abs_dog The absolute Dog values of the row (width values)
+  */
+  static void Compute_abs_dog_row
+  (
+    const Octave & octave,
+    const int s,
+    const int row,
+    float * abs_dog
+  )
+  {
+    const int w = octave.slices[s].Width();
+    const float * P = octave.slices[s + 1].data() + static_cast<size_t>(row) * w;
+    const float * M = octave.slices[s].data() + static_cast<size_t>(row) * w;
+    for (int col = 0; col < w; ++col)
     {
-      const image::Image<float> &P = octave.slices[s+1];
-      const image::Image<float> &M = octave.slices[s];
-      m_Dogs.slices[s] = P - M;
+      abs_dog[col] = std::abs(P[col] - M[col]);
     }
-    return true;
   }
 
   /**
-  * @brief Tell if a point is local maximum/minimum
-  * @param slices A Dog octave
-  * @param id_slice The "middle" index, the slice id
-  * @param id_row The discrete y point position
+  * @brief Tell if a point is local maximum/minimum (in absolute Dog value)
+  * @param rows The 3x3 (slice, row) absolute Dog rows around the point
   * @param id_col The discrete x point position
   * @retval true If the point is local maximum/minimum
   * @retval false If the point is not a local maximum/minimum
   */
   static inline bool is_local_min_max
   (
-    const std::vector<image::Image<float>> & slices,
-    const size_t id_slice,
-    const size_t id_row,
-    const size_t id_col
+    const float * const rows[3][3],
+    const int id_col
   )
   {
-    const float pix_val = std::abs(slices[id_slice](id_row, id_col));
-
-    const bool is_min_or_max =
-      // Current slice
-      (pix_val > std::abs(slices[id_slice](id_row - 1, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice](id_row - 1, id_col))) &&
-      (pix_val > std::abs(slices[id_slice](id_row - 1, id_col + 1))) &&
-      (pix_val > std::abs(slices[id_slice](id_row, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice](id_row, id_col + 1))) &&
-      (pix_val > std::abs(slices[id_slice](id_row + 1, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice](id_row + 1, id_col))) &&
-      (pix_val > std::abs(slices[id_slice](id_row + 1, id_col + 1))) &&
-      // Above slice
-      (pix_val > std::abs(slices[id_slice - 1](id_row - 1, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row - 1, id_col))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row - 1, id_col + 1))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row, id_col))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row, id_col + 1))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row + 1, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row + 1, id_col))) &&
-      (pix_val > std::abs(slices[id_slice - 1](id_row + 1, id_col + 1))) &&
-      // Bottom slice
-      (pix_val > std::abs(slices[id_slice + 1](id_row - 1, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row - 1, id_col))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row - 1, id_col + 1))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row, id_col))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row, id_col + 1))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row + 1, id_col - 1))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row + 1, id_col))) &&
-      (pix_val > std::abs(slices[id_slice + 1](id_row + 1, id_col + 1)));
-
-    return is_min_or_max;
+    const float pix_val = rows[1][1][id_col];
+    for (int s = 0; s < 3; ++s)
+    {
+      for (int r = 0; r < 3; ++r)
+      {
+        const float * row = rows[s][r] + id_col;
+        if (!(pix_val > row[-1]) || !(pix_val > row[1]) ||
+            ((s != 1 || r != 1) && !(pix_val > row[0])))
+          return false;
+      }
+    }
+    return true;
   }
 
-
   /**
   * @brief Compute the 2D Hessian response of the DoG operator is computed via finite difference schemes
+  * @param octave The Gaussian octave
   * @param key A Keypoint (the field edgeResp will be updated)
   * @retval the Harris and Stephen Edge response value
   */
   float Compute_edge_response
   (
+    const Octave & octave,
     Keypoint & key
   ) const
   {
     const int s = key.s;
     const int i = key.i; // i = id_row
     const int j = key.j; // j = id_col
-    const Octave & octave = m_Dogs;
-    const image::Image<float> & im = octave.slices[s];
+    const auto im = [&octave, s](int row, int col) { return Dog(octave, s, row, col); };
     // Compute the 2d Hessian at pixel (i,j)
     const float hXX = im(j,i-1) + im(j,i+1) - 2.f * im(j,i);
     const float hYY = im(j+1,i) + im(j-1,i) - 2.f * im(j,i);
@@ -191,53 +190,119 @@ protected:
 
   /**
   * @brief Find discrete extrema position (position, scale) in the Dog domain
+  * Rows of absolute Dog values are streamed (only 3x3 rows are kept in memory)
+  *  and the Dog slices are processed in parallel.
+  * @param octave The Gaussian octave
   * @param[out] keypoints The list of found extrema as Keypoints
   * @param percent Percentage applied on of the internal Edge threshold value
   */
   void Find_3d_discrete_extrema
   (
+    const Octave & octave,
     std::vector<Keypoint> & keypoints,
     float percent = 1.0f
   ) const
   {
-    const int ns = m_Dogs.slices.size();
-    const float delta = m_Dogs.delta;
-    const int h = m_Dogs.slices[0].Height();
-    const int w = m_Dogs.slices[0].Width();
+    const int ns = static_cast<int>(octave.slices.size()) - 1; // Dog slice count
+    const float delta = octave.delta;
+    const int h = octave.slices[0].Height();
+    const int w = octave.slices[0].Width();
+    const float threshold = m_peak_threshold * percent;
+    if (ns < 3 || h < 3 || w < 3)
+      return;
 
     // Loop through the slices of the image stack (one octave)
+    std::vector<std::vector<Keypoint>> slice_keypoints(ns);
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
     for (int s = 1; s < ns-1; ++s)
     {
+      // Rolling buffer of the absolute Dog rows [slice s-1..s+1][row-1..row+1]
+      std::vector<float> buffer(9 * w);
+      const float * rows[3][3];
+      float * row_buffers[3][3];
+      for (int ds = 0; ds < 3; ++ds)
+      {
+        for (int dr = 0; dr < 3; ++dr)
+        {
+          row_buffers[ds][dr] = &buffer[(3 * ds + dr) * w];
+          if (dr > 0)
+            Compute_abs_dog_row(octave, s - 1 + ds, dr - 1, row_buffers[ds][dr]);
+        }
+      }
+
       for (int id_row = 1; id_row < h-1; ++id_row )
       {
-        for (int id_col = 1; id_col < w-1; ++id_col )
+        for (int ds = 0; ds < 3; ++ds)
+        {
+          // Recycle the oldest row to store the next one
+          std::rotate(row_buffers[ds], row_buffers[ds] + 1, row_buffers[ds] + 3);
+          Compute_abs_dog_row(octave, s - 1 + ds, id_row + 1, row_buffers[ds][2]);
+          for (int dr = 0; dr < 3; ++dr)
+            rows[ds][dr] = row_buffers[ds][dr];
+        }
+
+        const auto add_keypoint = [&](const int id_col)
+        {
+          // if 3d discrete extrema, save a candidate keypoint
+          Keypoint key;
+          key.i = id_col;
+          key.j = id_row;
+          key.s = s;
+          key.o = octave.octave_level;
+          key.x = delta * id_col;
+          key.y = delta * id_row;
+          key.sigma = octave.sigmas[s];
+          key.val = Dog(octave, s, id_row, id_col);
+          slice_keypoints[s].emplace_back(key);
+        };
+
+        int id_col = 1;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        // Test 4 consecutive pixels at once
+        const __m128 threshold4 = _mm_set1_ps(threshold);
+        for ( ; id_col + 4 <= w-1; id_col += 4)
         {
-          const float pix_val = m_Dogs.slices[s](id_row, id_col);
-          if (std::abs(pix_val) > m_peak_threshold * percent)
-          if (is_local_min_max(m_Dogs.slices, s, id_row, id_col))
+          const __m128 pix_val = _mm_loadu_ps(rows[1][1] + id_col);
+          __m128 is_extrema = _mm_cmpgt_ps(pix_val, threshold4);
+          if (_mm_movemask_ps(is_extrema) == 0)
+            continue;
+          for (int ds = 0; ds < 3 && _mm_movemask_ps(is_extrema) != 0; ++ds)
           {
-            // if 3d discrete extrema, save a candidate keypoint
-            Keypoint key;
-            key.i = id_col;
-            key.j = id_row;
-            key.s = s;
-            key.o = m_Dogs.octave_level;
-            key.x = delta * id_col;
-            key.y = delta * id_row;
-            key.sigma = m_Dogs.sigmas[s];
-            key.val = pix_val;
-            keypoints.emplace_back(key);
+            for (int dr = 0; dr < 3; ++dr)
+            {
+              const float * row = rows[ds][dr] + id_col;
+              is_extrema = _mm_and_ps(is_extrema, _mm_cmpgt_ps(pix_val, _mm_loadu_ps(row - 1)));
+              is_extrema = _mm_and_ps(is_extrema, _mm_cmpgt_ps(pix_val, _mm_loadu_ps(row + 1)));
+              if (ds != 1 || dr != 1)
+                is_extrema = _mm_and_ps(is_extrema, _mm_cmpgt_ps(pix_val, _mm_loadu_ps(row)));
+            }
           }
+          const int mask = _mm_movemask_ps(is_extrema);
+          for (int k = 0; k < 4; ++k)
+          {
+            if (mask & (1 << k))
+              add_keypoint(id_col + k);
+          }
+        }
+#endif
+        for ( ; id_col < w-1; ++id_col )
+        {
+          if (rows[1][1][id_col] > threshold && is_local_min_max(rows, id_col))
+            add_keypoint(id_col);
         }
       }
     }
+    for (const auto & keys : slice_keypoints)
+      keypoints.insert(keypoints.end(), keys.begin(), keys.end());
     keypoints.shrink_to_fit();
   }
 
 
   /**
   * @brief Refine the 3D location of a Keypoint using the local Hessian value (discrete to subpixel)
-  * @param stack The list of found extrema as Keypoints
+  * @param octave The Gaussian octave
   * @param i Input discrete x location of the keypoint
   * @param j Input discrete y location of the keypoint
   * @param s Input scale of the keypoint
@@ -251,7 +316,7 @@ protected:
   */
   static bool Inverse_3D_Taylor_second_order_expansion
   (
-    const Octave & stack, // the dog stack
+    const Octave & octave,
     int i, int j, int s,
     float *di, float *dj, float *ds, float *val,
     const float ofstMax
@@ -261,9 +326,10 @@ protected:
     float gX,gY,gS;
     float ofstX, ofstY, ofstS, ofstVal;
 
-    const image::Image<float> & slice = stack.slices[s];
-    const image::Image<float> & sliceU = stack.slices[s+1];
-    const image::Image<float> & sliceD = stack.slices[s-1];
+    // Dog slices s, s+1 and s-1
+    const auto slice  = [&octave, s](int row, int col) { return Dog(octave, s, row, col); };
+    const auto sliceU = [&octave, s](int row, int col) { return Dog(octave, s + 1, row, col); };
+    const auto sliceD = [&octave, s](int row, int col) { return Dog(octave, s - 1, row, col); };
 
     // Compute the 3d Hessian at pixel (i,j,s)  Finite difference scheme
     hXX = slice(j,i-1) + slice(j,i+1) - 2.f*slice(j,i);
@@ -332,10 +398,12 @@ protected:
 
   /**
   * @brief Refine the keypoint position (location in space and scale), discard keypoints that cannot be refined.
+  * @param octave The Gaussian octave
   * @param[in,out] key The list of refined keypoints
   */
   void Keypoints_refine_position
   (
+    const Octave & octave,
     std::vector<Keypoint> & keypoints
   ) const
   {
@@ -345,10 +413,9 @@ protected:
     const float ofstMax = 0.6f;
 
     // Ratio between two consecutive scales in the slice
-    const float sigma_ratio = m_Dogs.sigmas[1] / m_Dogs.sigmas[0];
+    const float sigma_ratio = octave.sigmas[1] / octave.sigmas[0];
     const float edge_thres = Square(m_edge_threshold + 1) / m_edge_threshold;
 
-    const Octave & octave = m_Dogs;
     const int w = octave.slices[0].Width();
     const int h = octave.slices[0].Height();
     const float delta  = octave.delta;
@@ -410,7 +477,7 @@ protected:
           kp.sigma = octave.sigmas[sc] * pow(sigma_ratio, ofstS); // logarithmic scale
           kp.val = val;
           // Edge check
-          if (Compute_edge_response(kp) >=0 && std::abs(kp.edgeResp) <= edge_thres)
+          if (Compute_edge_response(octave, kp) >=0 && std::abs(kp.edgeResp) <= edge_thres)
           {
             // Border check
             if (Border_Check(kp, w, h))
@@ -426,8 +493,6 @@ protected:
   }
 
 protected:
-  Octave m_Dogs;
-
   // Keypoint detection parameters
   float m_peak_threshold;     // threshold on DoG operator
   float m_edge_threshold;    // threshold on the ratio of principal curvatures
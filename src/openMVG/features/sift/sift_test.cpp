@@ -22,6 +22,89 @@ using namespace openMVG::features;
 using namespace openMVG::features::sift;
 using namespace openMVG::system;
 
+namespace {
+
+// Reference Dog extrema detection done by separate passes:
+//  the whole Difference of Gaussians stack is computed first,
+//  then scanned for the 3D discrete extrema (in absolute Dog value).
+std::vector<Keypoint> Reference_3d_discrete_extrema
+(
+  const Octave & octave,
+  const float threshold
+)
+{
+  std::vector<Image<float>> dogs(octave.slices.size() - 1);
+  for (size_t s = 0; s < dogs.size(); ++s)
+    dogs[s] = octave.slices[s + 1] - octave.slices[s];
+
+  std::vector<Keypoint> keypoints;
+  for (int s = 1; s < static_cast<int>(dogs.size()) - 1; ++s)
+  {
+    for (int id_row = 1; id_row < dogs[s].Height() - 1; ++id_row)
+    {
+      for (int id_col = 1; id_col < dogs[s].Width() - 1; ++id_col)
+      {
+        const float pix_val = std::abs(dogs[s](id_row, id_col));
+        if (!(pix_val > threshold))
+          continue;
+        bool is_extrema = true;
+        for (int ds = -1; ds <= 1; ++ds)
+          for (int dr = -1; dr <= 1; ++dr)
+            for (int dc = -1; dc <= 1; ++dc)
+              if (ds != 0 || dr != 0 || dc != 0)
+                is_extrema = is_extrema &&
+                  pix_val > std::abs(dogs[s + ds](id_row + dr, id_col + dc));
+        if (is_extrema)
+        {
+          Keypoint key;
+          key.i = id_col;
+          key.j = id_row;
+          key.s = s;
+          key.o = octave.octave_level;
+          key.x = octave.delta * id_col;
+          key.y = octave.delta * id_row;
+          key.sigma = octave.sigmas[s];
+          key.val = dogs[s](id_row, id_col);
+          keypoints.emplace_back(key);
+        }
+      }
+    }
+  }
+  return keypoints;
+}
+
+// Expose the detection stages of the keypoint extractor
+struct SIFT_KeypointExtractor_Stages : public SIFT_KeypointExtractor
+{
+  using SIFT_KeypointExtractor::SIFT_KeypointExtractor;
+  using SIFT_KeypointExtractor::Find_3d_discrete_extrema;
+  using SIFT_KeypointExtractor::Keypoints_refine_position;
+};
+
+// Compare the keypoint positions, scales and values
+//  (and edge responses if they are computed, i.e. for refined keypoints)
+bool SameKeypoints
+(
+  const std::vector<Keypoint> & a,
+  const std::vector<Keypoint> & b,
+  const bool compare_edge_response
+)
+{
+  if (a.size() != b.size())
+    return false;
+  for (size_t k = 0; k < a.size(); ++k)
+  {
+    if (a[k].i != b[k].i || a[k].j != b[k].j || a[k].s != b[k].s || a[k].o != b[k].o ||
+        a[k].x != b[k].x || a[k].y != b[k].y || a[k].sigma != b[k].sigma ||
+        a[k].val != b[k].val ||
+        (compare_edge_response && a[k].edgeResp != b[k].edgeResp))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
 TEST( GaussianScaleSpace , OctaveGeneration )
 {
   Image<unsigned char> in;
@@ -117,6 +200,43 @@ TEST( Sift_Keypoint , DetectionAndDescription )
   svgFile.close();
 }
 
+// The fused Dog + extrema detection gives exactly the keypoints
+//  of the separate Dog computation and extrema detection passes.
+TEST( Sift_Keypoint , FusedDogExtrema_SameAsSeparatePasses )
+{
+  Image<unsigned char> in;
+
+  const std::string png_filename = std::string( THIS_SOURCE_DIR )
+    + "/../../../openMVG_Samples/imageData/StanfordMobileVisualSearch/Ace_0.png";
+  EXPECT_TRUE( ReadImage( png_filename.c_str(), &in ) );
+
+  HierarchicalGaussianScaleSpace octave_gen(6, 3, GaussianScaleSpaceParams(1.6f, 1.0f, 0.5f, 3));
+  const image::Image<float> image(in.GetMat().cast<float>()/255.0f);
+  octave_gen.SetImage( image );
+
+  const float peak_threshold = 0.04f / octave_gen.NbSlice();
+  size_t keypoint_count = 0;
+  Octave octave;
+  while (octave_gen.NextOctave( octave ))
+  {
+    SIFT_KeypointExtractor_Stages keypointDetector(peak_threshold, 10.f, 5);
+
+    // Discrete extrema
+    std::vector<Keypoint> extrema;
+    keypointDetector.Find_3d_discrete_extrema(octave, extrema, 0.8f);
+    std::vector<Keypoint> reference = Reference_3d_discrete_extrema(octave, peak_threshold * 0.8f);
+    EXPECT_TRUE(SameKeypoints(reference, extrema, false));
+
+    // Refined keypoints (position, scale, value)
+    std::vector<Keypoint> keys;
+    keypointDetector(octave, keys);
+    keypointDetector.Keypoints_refine_position(octave, reference);
+    EXPECT_TRUE(SameKeypoints(reference, keys, true));
+    keypoint_count += keys.size();
+  }
+  EXPECT_TRUE(keypoint_count > 0);
+}
+
 TEST( Sift , EmptyImage )
 {
   Image<unsigned char> image_in;
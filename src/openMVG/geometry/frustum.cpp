@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <limits>
 
 namespace openMVG{
 namespace geometry{
@@ -139,6 +140,35 @@ const std::vector<Vec3> & Frustum::frustum_points() const
   return points;
 }
 
+Eigen::AlignedBox<double, 3> Frustum::bounding_box() const
+{
+  Eigen::AlignedBox<double, 3> box;
+  if ( isTruncated() )
+  {
+    for ( const Vec3 & point : points )
+    {
+      box.extend( point );
+    }
+    return box;
+  }
+  // Infinite cone: C + sum(t_i * ray_i), t_i >= 0
+  //  it goes to infinity along an axis if one of its ray goes in this direction
+  const double inf = std::numeric_limits<double>::infinity();
+  box.extend( cones[0] );
+  for ( int i = 1; i < 5; ++i )
+  {
+    const Vec3 ray = cones[i] - cones[0];
+    for ( int axis = 0; axis < 3; ++axis )
+    {
+      if ( ray( axis ) > 0 )
+        box.max()( axis ) = inf;
+      else if ( ray( axis ) < 0 )
+        box.min()( axis ) = -inf;
+    }
+  }
+  return box;
+}
+
 bool Frustum::export_Ply
 (
   const Frustum & frustum,
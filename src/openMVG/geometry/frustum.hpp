@@ -14,6 +14,8 @@
 
 #include "openMVG/geometry/half_space_intersection.hpp"
 
+#include <Eigen/Geometry>
+
 namespace openMVG
 {
 
@@ -129,6 +131,14 @@ struct Frustum : public HalfPlaneObject
   */
   const std::vector<Vec3> & frustum_points() const;
 
+  /**
+  * @brief Return the axis aligned bounding box of the frustum
+  * @return Bounding box of the frustum volume
+  * @note For an infinite frustum the box is unbounded along the axis
+  *  directions the cone opens to (infinite coordinates)
+  */
+  Eigen::AlignedBox<double, 3> bounding_box() const;
+
   /**
   * @brief Export the Frustum as a PLY file (infinite frustum as exported as a normalized cone)
   * @return true if the file can be saved on disk
@@ -179,6 +179,36 @@ TEST(frustum, empty_intersection)
   }
 }
 
+TEST(frustum, bounding_box)
+{
+  const int focal = 1000;
+  const int principal_Point = 500;
+  const int iNviews = 4;
+  const NViewDataSet d =
+    NRealisticCamerasRing(
+    iNviews, 6,
+    nViewDatasetConfigurator(focal, focal, principal_Point, principal_Point, 5, 0));
+
+  for (int i = 0; i < iNviews; ++i)
+  {
+    // Truncated frustum: the box is the bounding box of the support points
+    const Frustum truncated(principal_Point*2, principal_Point*2, d._K[i], d._R[i], d._C[i], 1., 5.);
+    const Eigen::AlignedBox<double, 3> truncated_box = truncated.bounding_box();
+    for (const Vec3 & point : truncated.frustum_points())
+      EXPECT_TRUE(truncated_box.contains(point));
+    EXPECT_TRUE(truncated_box.sizes().allFinite());
+
+    // Infinite frustum: the box contains the cone rays
+    const Frustum infinite(principal_Point*2, principal_Point*2, d._K[i], d._R[i], d._C[i]);
+    const Eigen::AlignedBox<double, 3> infinite_box = infinite.bounding_box();
+    EXPECT_TRUE(infinite_box.contains(truncated_box));
+    for (int k = 1; k < 5; ++k)
+      for (const double t : {0., 1., 1e3, 1e9})
+        EXPECT_TRUE(infinite_box.contains(
+          Vec3(infinite.cones[0] + t * (infinite.cones[k] - infinite.cones[0]))));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
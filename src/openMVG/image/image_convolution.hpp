@@ -9,7 +9,9 @@
 #ifndef OPENMVG_IMAGE_IMAGE_CONVOLUTION_HPP
 #define OPENMVG_IMAGE_IMAGE_CONVOLUTION_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <vector>
 
 #include "openMVG/image/image_container.hpp"
@@ -193,76 +195,85 @@ void ImageSeparableConvolution( const ImageType & img ,
 
 using RowMatrixXf = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
-/// Specialization for Float based image (for arbitrary sized kernel)
+/**
+ ** Mirror an index into [0, size) without repeating the border sample
+ ** (i.e -1 -> 1, size -> size - 2)
+ **/
+inline int MirrorIndex( int i, const int size )
+{
+  if ( size == 1 )
+    return 0;
+  while ( i < 0 || i >= size )
+  {
+    i = ( i < 0 ) ? -i : 2 * ( size - 1 ) - i;
+  }
+  return i;
+}
+
+/**
+ ** Specialization for Float based image (for arbitrary sized kernel)
+ ** The vertical and the horizontal passes are fused: each output row is
+ **  vertically filtered in a small (cache resident) extended row buffer, that
+ **  is then horizontally filtered in the output row. Borders are mirrored.
+ ** Bands of rows are processed in parallel.
+ ** @param image Input image
+ ** @param kernel_x horizontal kernel (odd size)
+ ** @param kernel_y vertical kernel (odd size)
+ ** @param[out] out Convolved image (must not be the input image)
+ **/
 inline void SeparableConvolution2d( const RowMatrixXf& image,
                                     const Eigen::Matrix<float, 1, Eigen::Dynamic>& kernel_x,
                                     const Eigen::Matrix<float, 1, Eigen::Dynamic>& kernel_y,
                                     RowMatrixXf* out )
 {
-  const int sigma_y = static_cast<int>( kernel_y.cols() );
-  const int half_sigma_y = static_cast<int>( kernel_y.cols() ) / 2;
+  const int rows = static_cast<int>( image.rows() );
+  const int cols = static_cast<int>( image.cols() );
+  const int size_x = static_cast<int>( kernel_x.cols() );
+  const int half_size_x = size_x / 2;
+  const int size_y = static_cast<int>( kernel_y.cols() );
+  const int half_size_y = size_y / 2;
 
-  // Convolving a vertical filter across rows is the same thing as transpose
-  // multiply i.e. kernel_y^t * rows. This will give us the convoled value for
-  // each row. However, care must be taken at the top and bottom borders.
-  const Eigen::Matrix<float, 1, Eigen::Dynamic> reverse_kernel_y = kernel_y.reverse();
-#if defined(OPENMVG_USE_OPENMP)
-  #pragma omp parallel for schedule(dynamic)
-#endif
-  for ( int i = 0; i < half_sigma_y; i++ )
-  {
-    const int forward_size = i + half_sigma_y + 1;
-    const int reverse_size = sigma_y - forward_size;
-    out->row( i ) = kernel_y.tail( forward_size ) *
-                    image.block( 0, 0, forward_size, image.cols() ) +
-                    reverse_kernel_y.tail( reverse_size ) *
-                    image.block( 1, 0, reverse_size, image.cols() );
-
-    // Apply the same technique for the end rows.
-    out->row( image.rows() - i - 1 ) =
-      kernel_y.head( forward_size ) *
-      image.block( image.rows() - forward_size, 0, forward_size, image.cols() )
-      +
-      reverse_kernel_y.head( reverse_size ) *
-      image.block( image.rows() - reverse_size - 1, 0, reverse_size, image.cols() );
-  }
+  out->resize( rows, cols );
+  if ( rows == 0 || cols == 0 )
+    return;
+
+  // Small bands of consecutive rows share most of their input rows in cache
+  const int band_height = 16;
+  const int band_count = ( rows + band_height - 1 ) / band_height;
 
-  // Applying the rest of the y filter.
 #if defined(OPENMVG_USE_OPENMP)
-  #pragma omp parallel for schedule(dynamic)
+  #pragma omp parallel
 #endif
-  for ( int row = half_sigma_y; row < image.rows() - half_sigma_y; row++ )
   {
-    out->row( row ) =  kernel_y * image.block( row - half_sigma_y, 0, sigma_y, out->cols() );
-  }
-
-  const int sigma_x = static_cast<int>( kernel_x.cols() );
-  const int half_sigma_x = static_cast<int>( kernel_x.cols() / 2 );
+    std::vector<float> line( cols + 2 * half_size_x );
+    std::vector<const float *> input_rows( size_y );
 
-  // Convolving with the horizontal filter is easy. Rather than using the kernel
-  // as a sliding window, we use the row pixels as a sliding window around the
-  // filter. We prepend and append the proper border values so that we are sure
-  // to end up with the correct convolved values.
-  Eigen::RowVectorXf temp_row( image.cols() + sigma_x - 1 );
 #if defined(OPENMVG_USE_OPENMP)
-  #pragma omp parallel for firstprivate(temp_row), schedule(dynamic)
+    #pragma omp for schedule(dynamic)
 #endif
-  for ( int row = 0; row < out->rows(); row++ )
-  {
-    temp_row.head( half_sigma_x ) =
-      out->row( row ).segment( 1, half_sigma_x ).reverse();
-    temp_row.segment( half_sigma_x, image.cols() ) = out->row( row );
-    temp_row.tail( half_sigma_x ) =
-      out->row( row )
-      .segment( image.cols() - 2 - half_sigma_x, half_sigma_x )
-      .reverse();
-
-    // Convolve the row. We perform the first step here explicitly so that we
-    // avoid setting the row equal to zero.
-    out->row( row ) = kernel_x( 0 ) * temp_row.head( image.cols() );
-    for ( int i = 1; i < sigma_x; i++ )
+    for ( int band = 0; band < band_count; ++band )
     {
-      out->row( row ) += kernel_x( i ) * temp_row.segment( i, image.cols() );
+      const int last_row = std::min( rows, ( band + 1 ) * band_height );
+      for ( int row = band * band_height; row < last_row; ++row )
+      {
+        // Vertical filtering in the line buffer
+        for ( int k = 0; k < size_y; ++k )
+        {
+          input_rows[k] = image.data() + MirrorIndex( row - half_size_y + k, rows ) * cols;
+        }
+        float * line_center = line.data() + half_size_x;
+        conv_rows_( input_rows.data(), kernel_y.data(), cols, size_y, line_center );
+
+        // Extend the line buffer with the mirrored border values
+        for ( int k = 1; k <= half_size_x; ++k )
+        {
+          line_center[-k] = line_center[MirrorIndex( -k, cols )];
+          line_center[cols - 1 + k] = line_center[MirrorIndex( cols - 1 + k, cols )];
+        }
+
+        // Horizontal filtering in the output row
+        conv_line_( line.data(), kernel_x.data(), cols, size_x, out->data() + row * cols );
+      }
     }
   }
 }
@@ -11,6 +11,12 @@
 
 #include <cstddef>
 
+#if defined(OPENMVG_USE_AVX)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 namespace openMVG
 {
 namespace image
@@ -35,6 +41,149 @@ void conv_buffer_( T1* buffer, const T2* kernel, int rsize, int ksize )
     buffer[i] = sum;
   }
 }
+
+/// Packet of floats used by the vectorized float convolutions
+#if defined(OPENMVG_USE_AVX)
+struct conv_packet_
+{
+  static const int size = 8;
+  __m256 v;
+  static conv_packet_ load( const float * p ) { return { _mm256_loadu_ps( p ) }; }
+  void store( float * p ) const { _mm256_storeu_ps( p, v ); }
+  // this + k * x
+  void madd( const float k, const conv_packet_ & x )
+  { v = _mm256_add_ps( v, _mm256_mul_ps( _mm256_set1_ps( k ), x.v ) ); }
+  static conv_packet_ mul( const float k, const conv_packet_ & x )
+  { return { _mm256_mul_ps( _mm256_set1_ps( k ), x.v ) }; }
+};
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+struct conv_packet_
+{
+  static const int size = 4;
+  __m128 v;
+  static conv_packet_ load( const float * p ) { return { _mm_loadu_ps( p ) }; }
+  void store( float * p ) const { _mm_storeu_ps( p, v ); }
+  void madd( const float k, const conv_packet_ & x )
+  { v = _mm_add_ps( v, _mm_mul_ps( _mm_set1_ps( k ), x.v ) ); }
+  static conv_packet_ mul( const float k, const conv_packet_ & x )
+  { return { _mm_mul_ps( _mm_set1_ps( k ), x.v ) }; }
+};
+#else
+struct conv_packet_
+{
+  static const int size = 1;
+  float v;
+  static conv_packet_ load( const float * p ) { return { *p }; }
+  void store( float * p ) const { *p = v; }
+  void madd( const float k, const conv_packet_ & x ) { v += k * x.v; }
+  static conv_packet_ mul( const float k, const conv_packet_ & x ) { return { k * x.v }; }
+};
+#endif
+
+/**
+ ** Generic float filtering: out[x] = sum_k kernel[k] * src(k)[x]
+ ** Vectorized over x, with four independent accumulators to hide the
+ **  arithmetic latency. The accumulation order is the same for all x.
+ ** @param src functor returning the input pointer for the kernel tap k
+ ** @param kernel kernel array
+ ** @param cols output length
+ ** @param ksize kernel length
+ ** @param out output array
+ **/
+template <typename InputFunctor>
+inline void conv_float_
+(
+  const InputFunctor & src,
+  const float * kernel,
+  int cols,
+  int ksize,
+  float * out
+)
+{
+  const int n = conv_packet_::size;
+  int x = 0;
+  for ( ; x + 4 * n <= cols; x += 4 * n )
+  {
+    const float * in = src( 0 ) + x;
+    conv_packet_
+      sum0 = conv_packet_::mul( kernel[0], conv_packet_::load( in ) ),
+      sum1 = conv_packet_::mul( kernel[0], conv_packet_::load( in + n ) ),
+      sum2 = conv_packet_::mul( kernel[0], conv_packet_::load( in + 2 * n ) ),
+      sum3 = conv_packet_::mul( kernel[0], conv_packet_::load( in + 3 * n ) );
+    for ( int k = 1; k < ksize; ++k )
+    {
+      in = src( k ) + x;
+      sum0.madd( kernel[k], conv_packet_::load( in ) );
+      sum1.madd( kernel[k], conv_packet_::load( in + n ) );
+      sum2.madd( kernel[k], conv_packet_::load( in + 2 * n ) );
+      sum3.madd( kernel[k], conv_packet_::load( in + 3 * n ) );
+    }
+    sum0.store( out + x );
+    sum1.store( out + x + n );
+    sum2.store( out + x + 2 * n );
+    sum3.store( out + x + 3 * n );
+  }
+  for ( ; x + n <= cols; x += n )
+  {
+    conv_packet_ sum = conv_packet_::mul( kernel[0], conv_packet_::load( src( 0 ) + x ) );
+    for ( int k = 1; k < ksize; ++k )
+    {
+      sum.madd( kernel[k], conv_packet_::load( src( k ) + x ) );
+    }
+    sum.store( out + x );
+  }
+  for ( ; x < cols; ++x )
+  {
+    float sum = kernel[0] * src( 0 )[x];
+    for ( int k = 1; k < ksize; ++k )
+    {
+      sum += kernel[k] * src( k )[x];
+    }
+    out[x] = sum;
+  }
+}
+
+/**
+ ** Vertical filtering of float rows: out[x] = sum_k kernel[k] * rows[k][x]
+ ** @param rows array of ksize input row pointers
+ ** @param kernel kernel array
+ ** @param cols row length
+ ** @param ksize kernel length
+ ** @param out output row
+**/
+inline void conv_rows_
+(
+  const float * const * rows,
+  const float * kernel,
+  int cols,
+  int ksize,
+  float * out
+)
+{
+  conv_float_( [rows]( int k ) { return rows[k]; }, kernel, cols, ksize, out );
+}
+
+/**
+ ** Horizontal filtering of an extended float row [halfKernelSize][row][halfKernelSize]
+ ** out[x] = sum_k kernel[k] * buffer[x + k]
+ ** @param buffer extended row to filter
+ ** @param kernel kernel array
+ ** @param cols output row length
+ ** @param ksize kernel length
+ ** @param out output row (must not overlap buffer)
+**/
+inline void conv_line_
+(
+  const float * buffer,
+  const float * kernel,
+  int cols,
+  int ksize,
+  float * out
+)
+{
+  conv_float_( [buffer]( int k ) { return buffer + k; }, kernel, cols, ksize, out );
+}
+
 } // namespace image
 } // namespace openMVG
 
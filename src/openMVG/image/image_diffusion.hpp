@@ -51,77 +51,87 @@ void ImagePeronaMalikG2DiffusionCoef( const Image & Lx , const Image & Ly , cons
   out.array() = ( static_cast<Real>( 1.f ) + ( Lx.array().square() + Ly.array().square() ) / ( k * k ) ).inverse();
 }
 
+/**
+** Apply Fast Explicit Diffusion to an image row (central columns)
+** The rows are accessed through raw pointers (no aliasing in the inner loop),
+**  so that the loop is vectorized by the compiler.
+** @param src_up, src_cur, src_down rows i-1, i, i+1 of the input image
+** @param diff_up, diff_cur, diff_down rows i-1, i, i+1 of the diffusion coefficient image
+** @param half_t Half diffusion time
+** @param width Row length
+** @param out Output row: FED increment (+ input value if AddSource)
+**/
+template<bool AddSource, typename Real>
+inline void ImageFEDRow
+(
+  const Real * src_up , const Real * src_cur , const Real * src_down ,
+  const Real * diff_up , const Real * diff_cur , const Real * diff_down ,
+  const Real half_t ,
+  const int width ,
+  Real * out
+)
+{
+  for (int j = 1; j < width - 1; ++j)
+  {
+    // Compute diffusion factor for given pixel
+    const Real cur_src = src_cur[j];
+    const Real cur_diff = diff_cur[j];
+    const Real a = ( cur_diff + diff_cur[j + 1] ) * ( src_cur[j + 1] - cur_src );
+    const Real b = ( cur_diff + diff_up[j] ) * ( cur_src - src_up[j] );
+    const Real c = ( cur_diff + diff_cur[j - 1] ) * ( cur_src - src_cur[j - 1] );
+    const Real d = ( cur_diff + diff_down[j] ) * ( src_down[j] - cur_src );
+    const Real value = half_t * ( a - c + d - b );
+    out[j] = AddSource ? cur_src + value : value;
+  }
+}
+
 /**
 ** Apply Fast Explicit Diffusion to an Image (on central part)
 ** @param src input image
 ** @param diff diffusion coefficient image
 ** @param half_t Half diffusion time
-** @param out Output image
+** @param out Output image: FED increment (+ input value if AddSource)
 ** @param row_start Row range beginning (range is [row_start; row_end [ )
 ** @param row_end Row range end (range is [row_start; row_end [ )
 **/
-template<typename Image>
+template<bool AddSource = false, typename Image>
 void ImageFEDCentral( const Image & src , const Image & diff , const typename Image::Tpixel half_t , Image & out ,
                       const int row_start , const int row_end )
 {
-  using Real = typename Image::Tpixel;
   const int width = src.Width();
-  Real n_diff[4];
-  Real n_src[4];
   // Compute FED step on general range
   for (int i = row_start; i < row_end; ++i)
   {
-    for (int j = 1; j < width - 1; ++j)
-    {
-      // Retrieve neighbors : TODO check if we need a cache efficient version ?
-      n_diff[0] = diff( i , j + 1 );
-      n_diff[1] = diff( i - 1 , j );
-      n_diff[2] = diff( i , j - 1 );
-      n_diff[3] = diff( i + 1 , j );
-      n_src[0] = src( i , j + 1 );
-      n_src[1] = src( i - 1 , j );
-      n_src[2] = src( i , j - 1 );
-      n_src[3] = src( i + 1 , j );
-
-      // Compute diffusion factor for given pixel
-      const Real cur_src = src( i , j );
-      const Real cur_diff = diff( i , j );
-      const Real a = ( cur_diff + n_diff[0] ) * ( n_src[0] - cur_src );
-      const Real b = ( cur_diff + n_diff[1] ) * ( cur_src - n_src[1] );
-      const Real c = ( cur_diff + n_diff[2] ) * ( cur_src - n_src[2] );
-      const Real d = ( cur_diff + n_diff[3] ) * ( n_src[3] - cur_src );
-      const Real value = half_t * ( a - c + d - b );
-      out( i , j ) = value;
-    }
+    ImageFEDRow<AddSource>(
+      src.data() + ( i - 1 ) * width, src.data() + i * width, src.data() + ( i + 1 ) * width,
+      diff.data() + ( i - 1 ) * width, diff.data() + i * width, diff.data() + ( i + 1 ) * width,
+      half_t, width, out.data() + i * width );
   }
 }
 
 /**
 ** Apply Fast Explicit Diffusion to an Image (on central part)
+** Bands of rows are processed in parallel.
 ** @param src input image
 ** @param diff diffusion coefficient image
 ** @param half_t Half diffusion time
-** @param out Output image
+** @param out Output image: FED increment (+ input value if AddSource)
 **/
-template<typename Image>
+template<bool AddSource = false, typename Image>
 void ImageFEDCentralCPPThread( const Image & src , const Image & diff , const typename Image::Tpixel half_t , Image & out )
 {
-#ifdef OPENMVG_USE_OPENMP
-  const int nb_thread = omp_get_max_threads();
-#else
-  const int nb_thread = 1;
-#endif
-
-  // Compute ranges
-  std::vector<int > range;
-  SplitRange( 1 , ( int ) ( src.rows() - 1 ) , nb_thread , range );
+  // Bands small enough to keep their 3 working rows in cache
+  const int band_height = 32;
+  const int band_count = ( static_cast<int>( src.rows() ) - 2 + band_height - 1 ) / band_height;
 
 #ifdef OPENMVG_USE_OPENMP
   #pragma omp parallel for schedule(dynamic)
 #endif
-  for (int i = 1; i < static_cast<int>( range.size() ); ++i)
+  for (int band = 0; band < band_count; ++band)
   {
-    ImageFEDCentral( src, diff, half_t, out, range[i - 1] , range[i] );
+    const int row_start = 1 + band * band_height;
+    const int row_end = std::min( row_start + band_height , static_cast<int>( src.rows() ) - 1 );
+    ImageFEDCentral<AddSource>( src, diff, half_t, out, row_start , row_end );
   }
 }
 
@@ -130,10 +140,10 @@ void ImageFEDCentralCPPThread( const Image & src , const Image & diff , const ty
 ** @param src input image
 ** @param diff diffusion coefficient image
 ** @param t diffusion time
-** @param out output image
+** @param out output image: FED increment (+ input value if AddSource)
 **/
-template<typename Image>
-void ImageFED( const Image & src , const Image & diff , const typename Image::Tpixel t , Image & out )
+template<bool AddSource, typename Image>
+void ImageFEDStep( const Image & src , const Image & diff , const typename Image::Tpixel t , Image & out )
 {
   using Real = typename Image::Tpixel;
   const int width = src.Width();
@@ -147,7 +157,7 @@ void ImageFED( const Image & src , const Image & diff , const typename Image::Tp
   Real n_src[4];
 
   // Take care of the central part
-  ImageFEDCentralCPPThread( src , diff , half_t , out );
+  ImageFEDCentralCPPThread<AddSource>( src , diff , half_t , out );
 
   // Take care of the border
   // - first/last row
@@ -170,7 +180,7 @@ void ImageFED( const Image & src , const Image & diff , const typename Image::Tp
     const Real c = ( cur_diff + n_diff[2] ) * ( cur_src - n_src[2] );
     const Real d = ( cur_diff + n_diff[3] ) * ( n_src[3] - cur_src );
     const Real value = half_t * ( a - c + d );
-    out( 0 , j ) = value;
+    out( 0 , j ) = AddSource ? cur_src + value : value;
   }
 
   // Compute FED step on last row
@@ -190,7 +200,7 @@ void ImageFED( const Image & src , const Image & diff , const typename Image::Tp
     const Real b = ( cur_diff + n_diff[1] ) * ( cur_src - n_src[1] );
     const Real c = ( cur_diff + n_diff[2] ) * ( cur_src - n_src[2] );
     const Real value = half_t * ( a - c - b );
-    out( height - 1 , j ) = value;
+    out( height - 1 , j ) = AddSource ? cur_src + value : value;
   }
 
   // Compute FED step on first col
@@ -210,7 +220,7 @@ void ImageFED( const Image & src , const Image & diff , const typename Image::Tp
     const Real b = ( cur_diff + n_diff[1] ) * ( cur_src - n_src[1] );
     const Real d = ( cur_diff + n_diff[3] ) * ( n_src[3] - cur_src );
     const Real value = half_t * ( a + d - b );
-    out( i , 0 ) = value;
+    out( i , 0 ) = AddSource ? cur_src + value : value;
   }
 
   // Compute FED step on last col
@@ -230,12 +240,36 @@ void ImageFED( const Image & src , const Image & diff , const typename Image::Tp
     const Real c = ( cur_diff + n_diff[2] ) * ( cur_src - n_src[2] );
     const Real d = ( cur_diff + n_diff[3] ) * ( n_src[3] - cur_src );
     const Real value = half_t * ( - c + d - b );
-    out( i , width - 1 ) = value;
+    out( i , width - 1 ) = AddSource ? cur_src + value : value;
   }
+
+  // Corners are not diffused
+  if (AddSource)
+  {
+    out( 0 , 0 ) = src( 0 , 0 );
+    out( 0 , width - 1 ) = src( 0 , width - 1 );
+    out( height - 1 , 0 ) = src( height - 1 , 0 );
+    out( height - 1 , width - 1 ) = src( height - 1 , width - 1 );
+  }
+}
+
+/**
+** Apply Fast Explicit Diffusion of an Image
+** @param src input image
+** @param diff diffusion coefficient image
+** @param t diffusion time
+** @param out output image (FED increment)
+**/
+template<typename Image>
+void ImageFED( const Image & src , const Image & diff , const typename Image::Tpixel t , Image & out )
+{
+  ImageFEDStep<false>( src , diff , t , out );
 }
 
 /**
  ** Compute Fast Explicit Diffusion cycle
+ ** Each step directly writes the diffused image in a second buffer (the
+ **  FED increment is never stored) and the buffers are swapped.
  ** @param self input/output image
  ** @param diff diffusion coefficient
  ** @param tau cycle timing vector
@@ -246,8 +280,8 @@ void ImageFEDCycle( Image & self , const Image & diff , const std::vector<typena
   Image tmp;
   for (int i = 0; i < tau.size(); ++i)
   {
-    ImageFED( self , diff , tau[i] , tmp );
-    self.array() += tmp.array();
+    ImageFEDStep<true>( self , diff , tau[i] , tmp );
+    self.swap( tmp );
   }
 }
 
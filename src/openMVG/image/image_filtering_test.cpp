@@ -11,6 +11,8 @@
 
 #include "testing/testing.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 using namespace openMVG;
@@ -131,6 +133,40 @@ TEST(Image, Convolution_Sobel_X_Y)
   EXPECT_TRUE(WriteImage("out_SobelY.png", Image<unsigned char>(outFiltered.cast<unsigned char>())));
 }
 
+TEST(Image, SeparableConvolution_Float)
+{
+  // Odd sizes to exercise the vectorized and the scalar paths
+  for (const int size : {3, 7, 45, 101})
+  {
+    Image<float> in(size + 2, size);
+    for (int y = 0; y < in.Height(); ++y)
+      for (int x = 0; x < in.Width(); ++x)
+        in(y, x) = static_cast<float>(rand() % 256);
+
+    const Vec kernel_horiz = ComputeGaussianKernel(7, 1.6);
+    const Vec kernel_vert = ComputeGaussianKernel(9, 2.0);
+    Image<float> out;
+    ImageSeparableConvolution(in, kernel_horiz, kernel_vert, out);
+    EXPECT_EQ(in.Width(), out.Width());
+    EXPECT_EQ(in.Height(), out.Height());
+
+    // Compare to a direct 2D convolution with mirrored borders
+    double max_error = 0.0;
+    for (int y = 0; y < in.Height(); ++y)
+      for (int x = 0; x < in.Width(); ++x)
+      {
+        double sum = 0.0;
+        for (int j = 0; j < kernel_vert.size(); ++j)
+          for (int i = 0; i < kernel_horiz.size(); ++i)
+            sum += kernel_vert(j) * kernel_horiz(i) *
+              in(MirrorIndex(y + j - kernel_vert.size() / 2, in.Height()),
+                 MirrorIndex(x + i - kernel_horiz.size() / 2, in.Width()));
+        max_error = std::max(max_error, std::abs(sum - out(y, x)));
+      }
+    EXPECT_NEAR(0.0, max_error, 1e-3);
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
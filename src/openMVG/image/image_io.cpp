@@ -8,6 +8,7 @@
 
 #include "openMVG/image/image_io.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -56,25 +57,77 @@ Format GetFormat(const char *c) {
   return Unknown;
 }
 
+namespace {
+
+// Decode an image into a raw interleaved array (native depth)
+class VectorSink : public ImageDecodingSink
+{
+public:
+  VectorSink(std::vector<unsigned char> * array, int * w, int * h, int * depth)
+    : array_(array), w_(w), h_(h), depth_(depth) {}
+
+  int PreferredDepth() const override { return 0; }
+
+  bool Resize(int w, int h, int depth) override {
+    *w_ = w;
+    *h_ = h;
+    *depth_ = depth;
+    array_->resize(static_cast<size_t>(w) * h * depth);
+    return true;
+  }
+
+  unsigned char * Row(int y) override {
+    return &(*array_)[0] + static_cast<size_t>(y) * (*w_) * (*depth_);
+  }
+
+  void CommitRow(int) override {}
+
+private:
+  std::vector<unsigned char> * array_;
+  int * w_, * h_, * depth_;
+};
+
+} // namespace
+
 int ReadImage(const char *filename,
               std::vector<unsigned char> * ptr,
               int * w,
               int * h,
               int * depth){
+  VectorSink sink(ptr, w, h, depth);
+  return ReadImage(filename, &sink);
+}
+
+int ReadImage(const char *filename,
+              ImageDecodingSink * sink,
+              int scale_denom){
   const Format f = GetFormat(filename);
+  if (f == Tiff)
+    return ReadTiff(filename, sink);
+  if (f == Unknown)
+    return 0;
 
+  FILE *file = fopen(filename, "rb");
+  if (!file) {
+    std::cerr << "Error: Couldn't open " << filename << " fopen returned 0";
+    return 0;
+  }
+  int res = 0;
   switch (f) {
     case Pnm:
-      return ReadPnm(filename, ptr, w, h, depth);
+      res = ReadPnmStream(file, sink);
+      break;
     case Png:
-      return ReadPng(filename, ptr, w, h, depth);
+      res = ReadPngStream(file, sink);
+      break;
     case Jpg:
-      return ReadJpg(filename, ptr, w, h, depth);
-    case Tiff:
-      return ReadTiff(filename, ptr, w, h, depth);
+      res = ReadJpgStream(file, sink, scale_denom);
+      break;
     default:
-      return 0;
+      break;
   };
+  fclose(file);
+  return res;
 }
 
 int WriteImage(const char * filename,
@@ -102,14 +155,15 @@ int ReadJpg(const char * filename,
             std::vector<unsigned char> * ptr,
             int * w,
             int * h,
-            int * depth) {
+            int * depth,
+            int scale_denom) {
 
   FILE *file = fopen(filename, "rb");
   if (!file) {
     std::cerr << "Error: Couldn't open " << filename << " fopen returned 0";
     return 0;
   }
-  int res = ReadJpgStream(file, ptr, w, h, depth);
+  int res = ReadJpgStream(file, ptr, w, h, depth, scale_denom);
   fclose(file);
   return res;
 }
@@ -131,7 +185,15 @@ int ReadJpgStream(FILE * file,
                   std::vector<unsigned char> * ptr,
                   int * w,
                   int * h,
-                  int * depth) {
+                  int * depth,
+                  int scale_denom) {
+  VectorSink sink(ptr, w, h, depth);
+  return ReadJpgStream(file, &sink, scale_denom);
+}
+
+int ReadJpgStream(FILE * file,
+                  ImageDecodingSink * sink,
+                  int scale_denom) {
   jpeg_decompress_struct cinfo;
   struct my_error_mgr jerr;
   cinfo.err = jpeg_std_error(&jerr.pub);
@@ -146,21 +208,31 @@ int ReadJpgStream(FILE * file,
   jpeg_create_decompress(&cinfo);
   jpeg_stdio_src(&cinfo, file);
   jpeg_read_header(&cinfo, TRUE);
+  // libjpeg supports a M/8 scaling, restrict it to the power of two reductions
+  switch (scale_denom) {
+    case 2: case 4: case 8:
+      cinfo.scale_num = 1;
+      cinfo.scale_denom = scale_denom;
+      break;
+    default:
+      break;
+  }
+  // For a gray destination, only decode the luminance channel
+  if (sink->PreferredDepth() == 1 && cinfo.jpeg_color_space == JCS_YCbCr) {
+    cinfo.out_color_space = JCS_GRAYSCALE;
+  }
   jpeg_start_decompress(&cinfo);
 
-  int row_stride = cinfo.output_width * cinfo.output_components;
-
-  *h = cinfo.output_height;
-  *w = cinfo.output_width;
-  *depth = cinfo.output_components;
-  ptr->resize((*h)*(*w)*(*depth));
-
-  unsigned char *ptrCpy = &(*ptr)[0];
+  if (!sink->Resize(cinfo.output_width, cinfo.output_height, cinfo.output_components)) {
+    jpeg_destroy_decompress(&cinfo);
+    return 0;
+  }
 
   while (cinfo.output_scanline < cinfo.output_height) {
-    JSAMPROW scanline[1] = { ptrCpy };
+    const int y = cinfo.output_scanline;
+    JSAMPROW scanline[1] = { sink->Row(y) };
     jpeg_read_scanlines(&cinfo, scanline, 1);
-    ptrCpy += row_stride;
+    sink->CommitRow(y);
   }
 
   jpeg_finish_decompress(&cinfo);
@@ -257,6 +329,12 @@ int ReadPngStream(FILE *file,
                   int * w,
                   int * h,
                   int * depth)  {
+  VectorSink sink(ptr, w, h, depth);
+  return ReadPngStream(file, &sink);
+}
+
+int ReadPngStream(FILE *file,
+                  ImageDecodingSink * sink)  {
 
   // first check the eight byte PNG signature
   png_byte  pbSig[8];
@@ -314,6 +392,9 @@ int ReadPngStream(FILE *file,
   if (png_get_gAMA(png_ptr, info_ptr, &dGamma))
     png_set_gamma(png_ptr, (double) 2.2, dGamma);
 
+  // interlaced images are decoded in several passes over the rows
+  const int number_of_passes = png_set_interlace_handling(png_ptr);
+
   // after the transformations are registered, update info_ptr data
 
   png_read_update_info(png_ptr, info_ptr);
@@ -324,37 +405,41 @@ int ReadPngStream(FILE *file,
     &iColorType, nullptr, nullptr, nullptr);
 
   // Get number of byte along a tow
-  png_uint_32         ulRowBytes;
-  ulRowBytes = png_get_rowbytes(png_ptr, info_ptr);
+  const png_uint_32 ulRowBytes = png_get_rowbytes(png_ptr, info_ptr);
 
-  // and allocate memory for an array of row-pointers
-  png_byte   **ppbRowPointers = nullptr;
-  if ((ppbRowPointers = (png_bytepp) malloc(hPNG
-    * sizeof(png_bytep))) == nullptr)
+  if (!sink->Resize(wPNG, hPNG, png_get_channels(png_ptr, info_ptr)))
   {
-    std::cerr << "PNG: out of memory" << std::endl;
+    png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
     return 0;
   }
 
-  *w = wPNG;
-  *h = hPNG;
-  *depth = png_get_channels(png_ptr, info_ptr);
-
-  // now we can allocate memory to store the image
-  ptr->resize((*h)*(*w)*(*depth));
-
-  // set the individual row-pointers to point at the correct offsets
-  for (png_uint_32 i = 0; i < hPNG; i++)
-    ppbRowPointers[i] = &((*ptr)[0]) + i * ulRowBytes;
-
-  // now we can go ahead and just read the whole image
-  png_read_image(png_ptr, ppbRowPointers);
+  if (number_of_passes == 1)
+  {
+    // decode the rows straight to their destination
+    for (png_uint_32 i = 0; i < hPNG; i++)
+    {
+      png_read_row(png_ptr, sink->Row(i), nullptr);
+      sink->CommitRow(i);
+    }
+  }
+  else
+  {
+    // the passes need the whole image: decode it, then forward the rows
+    std::vector<png_byte> image(static_cast<size_t>(hPNG) * ulRowBytes);
+    std::vector<png_bytep> row_pointers(hPNG);
+    for (png_uint_32 i = 0; i < hPNG; i++)
+      row_pointers[i] = &image[0] + i * ulRowBytes;
+    png_read_image(png_ptr, &row_pointers[0]);
+    for (png_uint_32 i = 0; i < hPNG; i++)
+    {
+      std::memcpy(sink->Row(i), row_pointers[i], ulRowBytes);
+      sink->CommitRow(i);
+    }
+  }
 
   // read the additional chunks in the PNG file (not really needed)
   png_read_end(png_ptr, nullptr);
 
-  free (ppbRowPointers);
-
   png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
   return 1;
 }
@@ -446,6 +531,12 @@ int ReadPnmStream(FILE *file,
                   int * w,
                   int * h,
                   int * depth) {
+  VectorSink sink(array, w, h, depth);
+  return ReadPnmStream(file, &sink);
+}
+
+int ReadPnmStream(FILE *file,
+                  ImageDecodingSink * sink) {
 
   const int NUM_VALUES = 3;
   const int INT_BUFFER_SIZE = 256;
@@ -460,10 +551,11 @@ int ReadPnmStream(FILE *file,
   if (res != 1) {
     return 0;
   }
+  int depth;
   if (magicnumber == 5) {
-    *depth = 1;
+    depth = 1;
   } else if (magicnumber == 6) {
-    *depth = 3;
+    depth = 3;
   } else {
     return 0;
   }
@@ -508,13 +600,18 @@ int ReadPnmStream(FILE *file,
   }
 
   // Read pixels.
-  (*array).resize( values[1] * values[0] * (*depth));
-  *w = values[0];
-  *h = values[1];
-  res = fread( &(*array)[0], 1, array->size(), file);
-  if (res != array->size()) {
+  const int w = values[0], h = values[1];
+  if (!sink->Resize(w, h, depth)) {
     return 0;
   }
+  const size_t row_bytes = static_cast<size_t>(w) * depth;
+  for (int y = 0; y < h; ++y) {
+    res = fread(sink->Row(y), 1, row_bytes, file);
+    if (res != row_bytes) {
+      return 0;
+    }
+    sink->CommitRow(y);
+  }
   return 1;
 }
 
@@ -564,36 +661,66 @@ int ReadTiff(const char * filename,
   int * w,
   int * h,
   int * depth)
+{
+  VectorSink sink(ptr, w, h, depth);
+  return ReadTiff(filename, &sink);
+}
+
+int ReadTiff(const char * filename,
+  ImageDecodingSink * sink)
 {
   TIFF* tiff = TIFFOpen(filename, "r");
   if (!tiff) {
     std::cerr << "Error: Couldn't open " << filename << " fopen returned 0";
     return 0;
   }
+  uint32 w = 0, h = 0;
   uint16 bps, spp;
 
-  TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, w);
-  TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, h);
+  TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, &w);
+  TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, &h);
   TIFFGetField(tiff, TIFFTAG_BITSPERSAMPLE, &bps);
   TIFFGetField(tiff, TIFFTAG_SAMPLESPERPIXEL, &spp);
-  *depth = bps * spp / 8;
+  const int depth = bps * spp / 8;
 
-  ptr->resize((*h)*(*w)*(*depth));
+  if (!sink->Resize(w, h, depth)) {
+    TIFFClose(tiff);
+    return 0;
+  }
+  const size_t row_bytes = static_cast<size_t>(w) * depth;
 
-  if (*depth==4) {
-    if (ptr != nullptr) {
-      if (!TIFFReadRGBAImageOriented(tiff, *w, *h, (uint32*)&((*ptr)[0]), ORIENTATION_TOPLEFT, 0)) {
-        TIFFClose(tiff);
-        return 0;
-      }
+  if (depth==4) {
+    std::vector<uint32> rgba(static_cast<size_t>(w) * h);
+    if (!TIFFReadRGBAImageOriented(tiff, w, h, &rgba[0], ORIENTATION_TOPLEFT, 0)) {
+      TIFFClose(tiff);
+      return 0;
+    }
+    for (uint32 y = 0; y < h; ++y) {
+      std::memcpy(sink->Row(y), &rgba[static_cast<size_t>(y) * w], row_bytes);
+      sink->CommitRow(y);
     }
   } else {
-    for (size_t i=0; i<TIFFNumberOfStrips(tiff); ++i) {
-      if (TIFFReadEncodedStrip(tiff, i, ((uint8*)&((*ptr)[0]))+i*TIFFStripSize(tiff),(tsize_t)-1) ==
-        std::numeric_limits<tsize_t>::max()) {
+    // Decode one strip at a time and forward its rows
+    uint32 rows_per_strip = h;
+    TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rows_per_strip);
+    rows_per_strip = std::max<uint32>(1, std::min(rows_per_strip, h));
+    std::vector<uint8> strip(TIFFStripSize(tiff));
+    uint32 y = 0;
+    for (tstrip_t i = 0; i < TIFFNumberOfStrips(tiff) && y < h; ++i) {
+      const tmsize_t strip_bytes = TIFFReadEncodedStrip(tiff, i, &strip[0], (tsize_t)-1);
+      const uint32 strip_rows = std::min(rows_per_strip, h - y);
+      if (strip_bytes < 0 || static_cast<size_t>(strip_bytes) < strip_rows * row_bytes) {
         TIFFClose(tiff);
         return 0;
       }
+      for (uint32 r = 0; r < strip_rows; ++r, ++y) {
+        std::memcpy(sink->Row(y), &strip[r * row_bytes], row_bytes);
+        sink->CommitRow(y);
+      }
+    }
+    if (y != h) {
+      TIFFClose(tiff);
+      return 0;
     }
   }
   TIFFClose(tiff);
@@ -50,6 +50,128 @@ enum Format
 */
 Format GetFormat( const char *c );
 
+/**
+* @brief Destination of a row by row image decoding.
+* Decoders call Resize once the image size is known, then decode each row
+*  (depth interleaved 8 bit channels) into the buffer returned by Row and
+*  call CommitRow. It lets decoders write straight into the final storage.
+*/
+class ImageDecodingSink
+{
+public:
+  virtual ~ImageDecodingSink() = default;
+
+  /**
+  * @brief Number of channels the destination stores (0 for no preference).
+  * Decoders that can convert the color space on the fly (JPEG) use it.
+  */
+  virtual int PreferredDepth() const = 0;
+
+  /**
+  * @brief Prepare the destination for a w x h image with depth channels
+  * @retval false if the depth is not supported by the destination
+  */
+  virtual bool Resize( int w, int h, int depth ) = 0;
+
+  /// Buffer of (w * depth) bytes where the row y has to be decoded
+  virtual unsigned char * Row( int y ) = 0;
+
+  /// Notify that the row y has been decoded
+  virtual void CommitRow( int y ) = 0;
+};
+
+/**
+* @brief Decode into an Image<T> (unsigned char, RGBColor or RGBAColor).
+* Rows that have the pixel layout of T are decoded in place, the other ones
+*  are decoded in a single row buffer and converted.
+* Accepted depths: gray (1, 3, 4), RGB (3, 4), RGBA (4).
+*/
+template<typename T>
+class ImageSink : public ImageDecodingSink
+{
+public:
+  explicit ImageSink( Image<T> * image ) : image_( image ), depth_( 0 ) {}
+
+  int PreferredDepth() const override
+  {
+    return static_cast<int>( sizeof( T ) );
+  }
+
+  bool Resize( int w, int h, int depth ) override
+  {
+    const int target_depth = PreferredDepth();
+    if ( !( depth == target_depth || ( depth == 3 && target_depth == 1 ) || depth == 4 ) )
+    {
+      return false;
+    }
+    depth_ = depth;
+    image_->resize( w, h, false );
+    row_buffer_.resize( depth_ != target_depth ? w * depth_ : 0 );
+    return true;
+  }
+
+  unsigned char * Row( int y ) override
+  {
+    if ( row_buffer_.empty() )
+      return reinterpret_cast<unsigned char*>( image_->data() + static_cast<size_t>( y ) * image_->Width() );
+    return row_buffer_.data();
+  }
+
+  void CommitRow( int y ) override
+  {
+    if ( row_buffer_.empty() )
+      return;
+    T * row = image_->data() + static_cast<size_t>( y ) * image_->Width();
+    if ( depth_ == 3 )
+      ConvertRow( reinterpret_cast<const RGBColor*>( row_buffer_.data() ), row );
+    else
+      ConvertRow( reinterpret_cast<const RGBAColor*>( row_buffer_.data() ), row );
+  }
+
+private:
+  template<typename Tin>
+  void ConvertRow( const Tin * in, T * out ) const
+  {
+    for ( int x = 0; x < image_->Width(); ++x )
+      Convert( in[x], out[x] );
+  }
+  // Identity conversions are never used (the row is decoded in place)
+  void ConvertRow( const T *, T * ) const {}
+
+  Image<T> * image_;
+  int depth_;
+  std::vector<unsigned char> row_buffer_;
+};
+
+/**
+* @brief Decode an image into a sink
+* @param path Input path of the image to load
+* @param[out] sink Decoding destination
+* @param scale_denom JPEG only: downscaling factor applied by the decoder
+*  (1, 2, 4 or 8). Other formats are decoded at full resolution.
+* @retval 1 If loading is correct
+* @retval 0 If there was an error during load operation
+*/
+int ReadImage( const char * path, ImageDecodingSink * sink, int scale_denom = 1 );
+
+/**
+* @brief Load an image<T> (gray, RGB or RGBA) by decoding it directly into its
+*  storage. Gray targets are converted by the JPEG decoder.
+* @param path Input path of the image to load
+* @param[out] image Output image
+* @param scale_denom JPEG only: DCT domain downscaling (1, 2, 4 or 8).
+*  The output size is ceil(size / scale_denom), other formats are decoded at
+*  full resolution (check the output image size).
+* @retval 1 If loading is correct
+* @retval 0 If there was an error during load operation
+*/
+template<typename T>
+int ReadImage( const char * path, Image<T> * image, int scale_denom )
+{
+  ImageSink<T> sink( image );
+  return ReadImage( path, &sink, scale_denom );
+}
+
 
 
 /**
@@ -123,6 +245,15 @@ int ReadPng( const char * path , std::vector<unsigned char> * array , int * w, i
 */
 int ReadPngStream( FILE * stream , std::vector<unsigned char> * array , int * w, int * h, int * depth );
 
+/**
+* @brief Read PNG file from a stream into a decoding sink
+* @param[in] stream Input data stream
+* @param[out] sink Decoding destination
+* @retval 0 if there was an error during read operation
+* @return non nul value if read operation is valid
+*/
+int ReadPngStream( FILE * stream , ImageDecodingSink * sink );
+
 
 /**
 * @brief Write PNG file to a file
@@ -158,10 +289,13 @@ int WritePngStream( FILE * stream ,  const std::vector<unsigned char>& array, in
 * @param[out] w Image width
 * @param[out] h Image height
 * @param[out] depth Depth of image
+* @param scale_denom Downscaling factor applied by the decoder (1, 2, 4 or 8)
 * @retval 0 if there is an error during read operation
 * @return non nul value if read operation is valid
+* @note A scale_denom > 1 is performed in the DCT domain and is cheaper than
+*  decoding the full resolution image. Output size is ceil(size / scale_denom).
 */
-int ReadJpg( const char * path , std::vector<unsigned char> * array, int * w, int * h, int * depth );
+int ReadJpg( const char * path , std::vector<unsigned char> * array, int * w, int * h, int * depth, int scale_denom = 1 );
 
 /**
 * @brief Read JPEG image from stream
@@ -170,10 +304,22 @@ int ReadJpg( const char * path , std::vector<unsigned char> * array, int * w, in
 * @param[out] w Image width
 * @param[out] h Image height
 * @param[out] depth Depth of image
+* @param scale_denom Downscaling factor applied by the decoder (1, 2, 4 or 8)
 * @retval 0 if there is an error during read operation
 * @return non nul value if read operation is valid
 */
-int ReadJpgStream( FILE * stream , std::vector<unsigned char> * array, int * w, int * h, int * depth );
+int ReadJpgStream( FILE * stream , std::vector<unsigned char> * array, int * w, int * h, int * depth, int scale_denom = 1 );
+
+/**
+* @brief Read JPEG image from stream into a decoding sink
+* @param[in] stream Input data stream
+* @param[out] sink Decoding destination (its preferred depth selects the
+*  output color space: gray or RGB)
+* @param scale_denom Downscaling factor applied by the decoder (1, 2, 4 or 8)
+* @retval 0 if there is an error during read operation
+* @return non nul value if read operation is valid
+*/
+int ReadJpgStream( FILE * stream , ImageDecodingSink * sink, int scale_denom = 1 );
 
 /**
 * @brief Write JPEG file
@@ -243,6 +389,15 @@ int ReadPnm( const char * path , std::vector<unsigned char> * array, int * w, in
 */
 int ReadPnmStream( FILE * stream , std::vector<unsigned char> * array, int * w, int * h, int * depth );
 
+/**
+* @brief Read PNM/PGM from a stream into a decoding sink
+* @param[in] stream Input image stream data
+* @param[out] sink Decoding destination
+* @retval 0 if there was an error during read operation
+* @return non nul value if there was an error during read operation
+*/
+int ReadPnmStream( FILE * stream , ImageDecodingSink * sink );
+
 /**
 * @brief Write PNM/PGM from to a file
 * @param[in] path Output image path
@@ -282,6 +437,15 @@ int WritePnmStream( FILE *,  const std::vector<unsigned char>& array, int w, int
 */
 int ReadTiff( const char * path , std::vector<unsigned char> * array, int * w, int * h, int * depth );
 
+/**
+* @brief Read TIFF image from a file into a decoding sink
+* @param path Input file path
+* @param[out] sink Decoding destination
+* @retval 0 if there was an error during read operation
+* @return non nul value if there was an error during read operation
+*/
+int ReadTiff( const char * path , ImageDecodingSink * sink );
+
 /**
 * @brief write TIFF image to a file
 * @param path Output file path
@@ -366,37 +530,7 @@ bool Read_TIFF_ImageHeader( const char * path , ImageHeader * hdr );
 template<>
 inline int ReadImage( const char * path, Image<unsigned char> * im )
 {
-  std::vector<unsigned char> ptr;
-  int w, h, depth;
-  const int res = ReadImage( path, &ptr, &w, &h, &depth );
-  if ( res == 1 && depth == 1 )
-  {
-    //convert raw array to Image
-    ( *im ) = Eigen::Map<Image<unsigned char>::Base>( &ptr[0], h, w );
-  }
-  else if ( res == 1 && depth == 3 )
-  {
-    //-- Must convert RGB to gray
-    RGBColor * ptrCol = reinterpret_cast<RGBColor*>( &ptr[0] );
-    Image<RGBColor> rgbColIm;
-    rgbColIm = Eigen::Map<Image<RGBColor>::Base>( ptrCol, h, w );
-    //convert RGB to gray
-    ConvertPixelType( rgbColIm, im );
-  }
-  else if ( res == 1 && depth == 4 )
-  {
-    //-- Must convert RGBA to gray
-    RGBAColor * ptrCol = reinterpret_cast<RGBAColor*>( &ptr[0] );
-    Image<RGBAColor> rgbaColIm;
-    rgbaColIm = Eigen::Map<Image<RGBAColor>::Base>( ptrCol, h, w );
-    //convert RGBA to gray
-    ConvertPixelType( rgbaColIm, im );
-  }
-  else if ( depth != 1 )
-  {
-    return 0;
-  }
-  return res;
+  return ReadImage( path, im, 1 );
 }
 
 
@@ -410,29 +544,7 @@ inline int ReadImage( const char * path, Image<unsigned char> * im )
 template<>
 inline int ReadImage( const char * path, Image<RGBColor> * im )
 {
-  std::vector<unsigned char> ptr;
-  int w, h, depth;
-  const int res = ReadImage( path, &ptr, &w, &h, &depth );
-  if ( res == 1 && depth == 3 )
-  {
-    RGBColor * ptrCol = reinterpret_cast<RGBColor*>( &ptr[0] );
-    //convert raw array to Image
-    ( *im ) = Eigen::Map<Image<RGBColor>::Base>( ptrCol, h, w );
-  }
-  else if ( res == 1 && depth == 4 )
-  {
-    //-- Must convert RGBA to RGB
-    RGBAColor * ptrCol = reinterpret_cast<RGBAColor*>( &ptr[0] );
-    Image<RGBAColor> rgbaColIm;
-    rgbaColIm = Eigen::Map<Image<RGBAColor>::Base>( ptrCol, h, w );
-    //convert RGBA to RGB
-    ConvertPixelType( rgbaColIm, im );
-  }
-  else
-  {
-    return 0;
-  }
-  return res;
+  return ReadImage( path, im, 1 );
 }
 
 /**
@@ -445,20 +557,7 @@ inline int ReadImage( const char * path, Image<RGBColor> * im )
 template<>
 inline int ReadImage( const char * path, Image<RGBAColor> * im )
 {
-  std::vector<unsigned char> ptr;
-  int w, h, depth;
-  const int res = ReadImage( path, &ptr, &w, &h, &depth );
-  if ( depth != 4 )
-  {
-    return 0;
-  }
-  if ( res == 1 )
-  {
-    RGBAColor * ptrCol = reinterpret_cast<RGBAColor*>( &ptr[0] );
-    //convert raw array to Image
-    ( *im ) = Eigen::Map<Image<RGBAColor>::Base>( ptrCol, h, w );
-  }
-  return res;
+  return ReadImage( path, im, 1 );
 }
 
 //--------
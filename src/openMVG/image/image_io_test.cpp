@@ -12,6 +12,7 @@
 #include "testing/testing.h"
 
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 
@@ -126,6 +127,41 @@ TEST(ImageIOTest, Jpg) {
   remove(filename.c_str());
 }
 
+TEST(ImageIOTest, Jpg_ScaledDecoding) {
+  Image<RGBColor> image(64, 32);
+  for (int y = 0; y < image.Height(); ++y)
+    for (int x = 0; x < image.Width(); ++x)
+      image(y, x) = (x < 32) ? RGBColor(200, 40, 10) : RGBColor(10, 60, 220);
+  const std::string filename = ("test_write_jpg_scaled.jpg");
+  EXPECT_TRUE(WriteJpg(filename.c_str(), image, 100));
+
+  // DCT domain downscaling
+  Image<RGBColor> half_image;
+  EXPECT_TRUE(ReadImage(filename.c_str(), &half_image, 2));
+  EXPECT_EQ(32, half_image.Width());
+  EXPECT_EQ(16, half_image.Height());
+  Image<unsigned char> eighth_image;
+  EXPECT_TRUE(ReadImage(filename.c_str(), &eighth_image, 8));
+  EXPECT_EQ(8, eighth_image.Width());
+  EXPECT_EQ(4, eighth_image.Height());
+
+  // Luminance only decoding of a color jpeg stays close to the RGB conversion
+  Image<RGBColor> color_image;
+  Image<unsigned char> gray_image;
+  EXPECT_TRUE(ReadImage(filename.c_str(), &color_image));
+  EXPECT_TRUE(ReadImage(filename.c_str(), &gray_image));
+  EXPECT_EQ(color_image.Width(), gray_image.Width());
+  EXPECT_EQ(color_image.Height(), gray_image.Height());
+  for (int y = 0; y < gray_image.Height(); ++y)
+    for (int x = 0; x < gray_image.Width(); ++x)
+    {
+      unsigned char gray;
+      Convert(color_image(y, x), gray);
+      EXPECT_TRUE(std::abs(int(gray) - int(gray_image(y, x))) <= 2);
+    }
+  remove(filename.c_str());
+}
+
 TEST(ReadPnm, Pgm) {
   Image<unsigned char> image;
   const std::string pgm_filename = string(THIS_SOURCE_DIR) + "/image_test/two_pixels.pgm";
@@ -46,8 +46,13 @@ bool BisectionLP(
     const double gamma = (gammaLow + gammaUp) / 2.0;
 
     //-- Setup constraint and solver
+    // (the following steps only update the problem, in order to allow the
+    //  solver to warm start from the previous step)
     cstraintBuilder.Build(gamma, constraint);
-    solver.setup(constraint);
+    if (k == 1)
+      solver.setup(constraint);
+    else
+      solver.update(constraint);
     //--
     // Solving
     const bool bFeasible = solver.solve();
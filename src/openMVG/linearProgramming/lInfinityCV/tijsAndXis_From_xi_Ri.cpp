@@ -55,6 +55,7 @@ void EncodeTiXi
   assert(Ncam == Ri.size());
 
   A.resize(5 * Nobs, 3 * (N3D + Ncam));
+  A.reserve(Eigen::VectorXi::Constant(A.rows(), 5)); // At most 5 coefficients per row
 
   C.resize(5 * Nobs, 1);
   C.fill(0.0);
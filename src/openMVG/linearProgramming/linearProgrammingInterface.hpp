@@ -91,6 +91,14 @@ public:
   virtual bool setup(const LP_Constraints & constraints) = 0;
   virtual bool setup(const LP_Constraints_Sparse & constraints) = 0;
 
+  /// Update the constraint of an already setup problem (i.e. between two
+  ///  bisection steps). If the constraint keeps the same structure (signs
+  ///  and non-zero coefficient pattern), a solver can keep its problem and
+  ///  warm start the next solve from the previous solution basis.
+  /// Default implementation is a new setup.
+  virtual bool update(const LP_Constraints & constraints) { return setup(constraints); }
+  virtual bool update(const LP_Constraints_Sparse & constraints) { return setup(constraints); }
+
   /// Setup the feasibility and found the solution that best fit the constraint.
   virtual bool solve() = 0;
 
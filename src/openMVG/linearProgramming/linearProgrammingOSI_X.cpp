@@ -10,13 +10,15 @@
 #include <assert.h>
 #include <cstddef>
 #include "CoinPackedVector.hpp"
+#include "CoinWarmStart.hpp"
 #include "OsiClpSolverInterface.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 
 namespace openMVG   {
 namespace linearProgramming  {
 
-OSI_X_SolverWrapper::OSI_X_SolverWrapper(int nbParams) : LP_Solver(nbParams)
+OSI_X_SolverWrapper::OSI_X_SolverWrapper(int nbParams) : LP_Solver(nbParams),
+  bWarmStart_(false)
 {
   si.reset(new OsiClpSolverInterface);
   si->setLogLevel(0);
@@ -31,14 +33,11 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints & cstraints) //cstraints <-
   assert(nbParams_ == cstraints.nbParams_);
 
   const unsigned int NUMVAR = cstraints.constraint_mat_.cols();
-  std::vector<double>
-    col_lb(NUMVAR), // the column lower bounds
-    col_ub(NUMVAR); // the column upper bounds
+  col_lb_.resize(NUMVAR); // the column lower bounds
+  col_ub_.resize(NUMVAR); // the column upper bounds
 
   this->nbParams_ = NUMVAR;
 
-  si->setObjSense( ((cstraints.bminimize_) ? 1 : -1) );
-
   const Mat & A = cstraints.constraint_mat_;
 
   //Equality constraint will be done by two constraints due to the API limitation ( >= & <=).
@@ -46,12 +45,11 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints & cstraints) //cstraints <-
     std::count(cstraints.vec_sign_.begin(), cstraints.vec_sign_.end(), LP_Constraints::LP_EQUAL);
 
   // Define default lower and upper bound to [-inf, inf]
-  std::vector<double>
-    row_lb(nbLine, -si->getInfinity()), // the row lower bounds
-    row_ub(nbLine, si->getInfinity()); // the row upper bounds
+  row_lb_.assign(nbLine, -si->getInfinity()); // the row lower bounds
+  row_ub_.assign(nbLine, si->getInfinity()); // the row upper bounds
 
-  std::unique_ptr<CoinPackedMatrix> matrix(new CoinPackedMatrix(false,0,0));
-  matrix->setDimensions(0, NUMVAR);
+  matrix_ = std::make_shared<CoinPackedMatrix>(false,0,0);
+  matrix_->setDimensions(0, NUMVAR);
 
   //-- Add row-wise constraint
   size_t indexRow = 0;
@@ -68,8 +66,8 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints & cstraints) //cstraints <-
       {
         row.insert(j, coef * temp.data()[j]);
       }
-      row_ub[indexRow] = coef * cstraints.constraint_objective_(i);
-      matrix->appendRow(row);
+      row_ub_[indexRow] = coef * cstraints.constraint_objective_(i);
+      matrix_->appendRow(row);
       ++indexRow;
     }
 
@@ -81,8 +79,8 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints & cstraints) //cstraints <-
       {
         row.insert(j, coef * temp.data()[j]);
       }
-      row_ub[indexRow] = coef * cstraints.constraint_objective_(i);
-      matrix->appendRow(row);
+      row_ub_[indexRow] = coef * cstraints.constraint_objective_(i);
+      matrix_->appendRow(row);
       ++indexRow;
     }
   }
@@ -91,19 +89,21 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints & cstraints) //cstraints <-
   if (cstraints.vec_bounds_.size() == 1)
   {
     // Setup the same bound for all the parameters
-    std::fill(col_lb.begin(), col_lb.end(), cstraints.vec_bounds_[0].first);
-    std::fill(col_ub.begin(), col_ub.end(), cstraints.vec_bounds_[0].second);
+    std::fill(col_lb_.begin(), col_lb_.end(), cstraints.vec_bounds_[0].first);
+    std::fill(col_ub_.begin(), col_ub_.end(), cstraints.vec_bounds_[0].second);
   }
   else // each parameter have its own bounds
   {
     for (int i=0; i < this->nbParams_; ++i)
     {
-      col_lb[i] = cstraints.vec_bounds_[i].first;
-      col_ub[i] = cstraints.vec_bounds_[i].second;
+      col_lb_[i] = cstraints.vec_bounds_[i].first;
+      col_ub_[i] = cstraints.vec_bounds_[i].second;
     }
   }
 
-  si->loadProblem(*matrix, &col_lb[0], &col_ub[0], cstraints.vec_cost_.empty() ? nullptr : &cstraints.vec_cost_[0], &row_lb[0], &row_ub[0] );
+  vec_sign_ = cstraints.vec_sign_;
+  bWarmStart_ = false;
+  loadProblem(cstraints.vec_cost_, cstraints.bminimize_);
 
   return true;
 }
@@ -117,14 +117,11 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints_Sparse & cstraints) //cstra
   assert(nbParams_ == cstraints.nbParams_);
 
   const int NUMVAR = cstraints.constraint_mat_.cols();
-  std::vector<double>
-    col_lb(NUMVAR), // the column lower bounds
-    col_ub(NUMVAR); // the column upper bounds
+  col_lb_.resize(NUMVAR); // the column lower bounds
+  col_ub_.resize(NUMVAR); // the column upper bounds
 
   this->nbParams_ = NUMVAR;
 
-  si->setObjSense( ((cstraints.bminimize_) ? 1 : -1) );
-
   const sRMat & A = cstraints.constraint_mat_;
 
   //Equality constraint will be done by two constraints due to the API limitation (>= & <=)
@@ -132,12 +129,11 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints_Sparse & cstraints) //cstra
     std::count(cstraints.vec_sign_.begin(), cstraints.vec_sign_.end(), LP_Constraints::LP_EQUAL);
 
   // Define default lower and upper bound to [-inf, inf]
-  std::vector<double>
-    row_lb(nbLine, -si->getInfinity()), // the row lower bounds
-    row_ub(nbLine, si->getInfinity()); // the row upper bounds
+  row_lb_.assign(nbLine, -si->getInfinity()); // the row lower bounds
+  row_ub_.assign(nbLine, si->getInfinity()); // the row upper bounds
 
-  std::unique_ptr<CoinPackedMatrix> matrix(new CoinPackedMatrix(false,0,0));
-  matrix->setDimensions(0, NUMVAR);
+  matrix_ = std::make_shared<CoinPackedMatrix>(false,0,0);
+  matrix_->setDimensions(0, NUMVAR);
 
   //-- Add row-wise constraint
   size_t rowindex = 0;
@@ -155,8 +151,8 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints_Sparse & cstraints) //cstra
          cstraints.vec_sign_[i] == LP_Constraints::LP_LESS_OR_EQUAL )
     {
       const int coef = 1;
-      row_ub[rowindex] = coef * cstraints.constraint_objective_(i);
-      matrix->appendRow( vec_colno.size(),
+      row_ub_[rowindex] = coef * cstraints.constraint_objective_(i);
+      matrix_->appendRow( vec_colno.size(),
                    &vec_colno[0],
                    &vec_value[0] );
       ++rowindex;
@@ -170,8 +166,8 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints_Sparse & cstraints) //cstra
       {
         iter_val *= coef;
       }
-      row_ub[rowindex] = coef * cstraints.constraint_objective_(i);
-      matrix->appendRow( vec_colno.size(),
+      row_ub_[rowindex] = coef * cstraints.constraint_objective_(i);
+      matrix_->appendRow( vec_colno.size(),
                    &vec_colno[0],
                    &vec_value[0] );
       ++rowindex;
@@ -182,29 +178,123 @@ bool OSI_X_SolverWrapper::setup(const LP_Constraints_Sparse & cstraints) //cstra
   if (cstraints.vec_bounds_.size() == 1)
   {
     // Setup the same bound for all the parameters
-    std::fill(col_lb.begin(), col_lb.end(), cstraints.vec_bounds_[0].first);
-    std::fill(col_ub.begin(), col_ub.end(), cstraints.vec_bounds_[0].second);
+    std::fill(col_lb_.begin(), col_lb_.end(), cstraints.vec_bounds_[0].first);
+    std::fill(col_ub_.begin(), col_ub_.end(), cstraints.vec_bounds_[0].second);
   }
   else  // each parameter have its own bounds
   {
     for (int i=0; i < this->nbParams_; ++i)
     {
-      col_lb[i] = cstraints.vec_bounds_[i].first;
-      col_ub[i] = cstraints.vec_bounds_[i].second;
+      col_lb_[i] = cstraints.vec_bounds_[i].first;
+      col_ub_[i] = cstraints.vec_bounds_[i].second;
     }
   }
 
-  si->loadProblem(
-    *matrix,
-    &col_lb[0],
-    &col_ub[0],
-    cstraints.vec_cost_.empty() ? nullptr : &cstraints.vec_cost_[0],
-    &row_lb[0],
-    &row_ub[0]);
+  vec_sign_ = cstraints.vec_sign_;
+  bWarmStart_ = false;
+  loadProblem(cstraints.vec_cost_, cstraints.bminimize_);
+
+  return true;
+}
+
+bool OSI_X_SolverWrapper::update(const LP_Constraints_Sparse & cstraints)
+{
+  if (!si || !matrix_ ||
+      cstraints.vec_sign_ != vec_sign_ ||
+      cstraints.constraint_mat_.cols() != matrix_->getNumCols())
+  {
+    return setup(cstraints);
+  }
+
+  const sRMat & A = cstraints.constraint_mat_;
+
+  // Rewrite in place the coefficients of the row-ordered matrix
+  //  (the rows are ordered as in setup: a constraint gives its LESS_OR_EQUAL
+  //   row and then its negated GREATER_OR_EQUAL row)
+  double * elements = matrix_->getMutableElements();
+  const int * indices = matrix_->getIndices();
+  const CoinBigIndex * starts = matrix_->getVectorStarts();
+  const int * lengths = matrix_->getVectorLengths();
+  const int nbLine = matrix_->getNumRows();
+
+  int rowindex = 0;
+  for (int i=0; i < A.rows(); ++i)
+  {
+    for (const int coef : {1, -1})
+    {
+      if ((coef == 1 && cstraints.vec_sign_[i] == LP_Constraints::LP_GREATER_OR_EQUAL) ||
+          (coef == -1 && cstraints.vec_sign_[i] == LP_Constraints::LP_LESS_OR_EQUAL))
+      {
+        continue;
+      }
+      if (rowindex >= nbLine)
+      {
+        return setup(cstraints);
+      }
+
+      CoinBigIndex pos = starts[rowindex];
+      int count = 0;
+      for (sRMat::InnerIterator it(A,i); it; ++it, ++pos, ++count)
+      {
+        // The non-zero pattern of the row must be unchanged
+        if (count >= lengths[rowindex] || indices[pos] != it.col())
+        {
+          return setup(cstraints);
+        }
+        elements[pos] = coef * it.value();
+      }
+      if (count != lengths[rowindex])
+      {
+        return setup(cstraints);
+      }
+      row_ub_[rowindex] = coef * cstraints.constraint_objective_(i);
+      ++rowindex;
+    }
+  }
+  if (rowindex != nbLine)
+  {
+    return setup(cstraints);
+  }
+
+  //-- Update bounds for all the parameters
+  if (cstraints.vec_bounds_.size() == 1)
+  {
+    std::fill(col_lb_.begin(), col_lb_.end(), cstraints.vec_bounds_[0].first);
+    std::fill(col_ub_.begin(), col_ub_.end(), cstraints.vec_bounds_[0].second);
+  }
+  else  // each parameter have its own bounds
+  {
+    for (int i=0; i < this->nbParams_; ++i)
+    {
+      col_lb_[i] = cstraints.vec_bounds_[i].first;
+      col_ub_[i] = cstraints.vec_bounds_[i].second;
+    }
+  }
+
+  // Reload the problem and restore the basis of the previous solve
+  std::unique_ptr<CoinWarmStart> basis(si->getWarmStart());
+  loadProblem(cstraints.vec_cost_, cstraints.bminimize_);
+  bWarmStart_ = basis && si->setWarmStart(basis.get());
 
   return true;
 }
 
+void OSI_X_SolverWrapper::loadProblem
+(
+  const std::vector<double> & vec_cost,
+  bool bminimize
+)
+{
+  si->setObjSense( ((bminimize) ? 1 : -1) );
+  si->loadProblem(
+    *matrix_,
+    &col_lb_[0],
+    &col_ub_[0],
+    vec_cost.empty() ? nullptr : &vec_cost[0],
+    &row_lb_[0],
+    &row_ub_[0]);
+}
+
 
 bool OSI_X_SolverWrapper::solve()
 {
@@ -212,7 +302,10 @@ bool OSI_X_SolverWrapper::solve()
   if ( si )
   {
     si->getModelPtr()->setPerturbation(50);
-    si->initialSolve();
+    if (bWarmStart_)
+      si->resolve(); // (dual) simplex from the previous basis
+    else
+      si->initialSolve();
     return si->isProvenOptimal();
   }
   return false;
@@ -14,6 +14,7 @@
 
 #include "openMVG/linearProgramming/linearProgrammingInterface.hpp"
 
+class CoinPackedMatrix;
 class OsiClpSolverInterface;
 
 namespace openMVG   {
@@ -32,12 +33,27 @@ public:
   bool setup(const LP_Constraints & constraints) override;
   bool setup(const LP_Constraints_Sparse & constraints) override;
 
+  /// Rewrite the coefficients and bounds of the loaded problem and keep the
+  ///  basis of the previous solve as a warm start.
+  /// Fallback to setup if the structure of the constraint has changed.
+  using LP_Solver::update;
+  bool update(const LP_Constraints_Sparse & constraints) override;
+
   bool solve() override;
 
   bool getSolution(std::vector<double> & estimatedParams) override;
 
 private:
+  /// Load the stored problem in the solver
+  void loadProblem(const std::vector<double> & vec_cost, bool bminimize);
+
   std::shared_ptr<OsiClpSolverInterface> si;
+
+  // Last loaded problem (row-ordered constraint matrix, column and row bounds)
+  std::shared_ptr<CoinPackedMatrix> matrix_;
+  std::vector<double> col_lb_, col_ub_, row_lb_, row_ub_;
+  std::vector<LP_Constraints::eLP_SIGN> vec_sign_;
+  bool bWarmStart_; // Solve from the basis of the previous solution
 };
 
 using OSI_CLP_SolverWrapper = OSI_X_SolverWrapper;
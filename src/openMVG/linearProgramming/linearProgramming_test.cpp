@@ -149,6 +149,43 @@ TEST(linearProgramming, osiclp_sparse_sample) {
   EXPECT_NEAR( 8.33, vec_solution[3], 1e-2);
 }
 
+TEST(linearProgramming, osiclp_sparse_update) {
+
+  LP_Constraints_Sparse cstraint;
+  BuildSparseLinearProblem(cstraint);
+
+  std::vector<double> vec_solution(4), vec_solution_expected(4);
+  OSI_CLP_SolverWrapper solver(4);
+  solver.setup(cstraint);
+  EXPECT_TRUE(solver.solve());
+
+  // Same structure, new coefficients and bounds: warm started solve
+  cstraint.constraint_mat_.coeffRef(2,3) = 2;
+  cstraint.constraint_objective_[2] = 20;
+  EXPECT_TRUE(solver.update(cstraint));
+  EXPECT_TRUE(solver.solve());
+  solver.getSolution(vec_solution);
+
+  OSI_CLP_SolverWrapper solver_expected(4);
+  solver_expected.setup(cstraint);
+  EXPECT_TRUE(solver_expected.solve());
+  solver_expected.getSolution(vec_solution_expected);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_NEAR(vec_solution_expected[i], vec_solution[i], 1e-6);
+
+  // New structure (one more coefficient): the update is a new setup
+  cstraint.constraint_mat_.coeffRef(2,0) = 1;
+  EXPECT_TRUE(solver.update(cstraint));
+  EXPECT_TRUE(solver.solve());
+  solver.getSolution(vec_solution);
+
+  solver_expected.setup(cstraint);
+  EXPECT_TRUE(solver_expected.solve());
+  solver_expected.getSolution(vec_solution_expected);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_NEAR(vec_solution_expected[i], vec_solution[i], 1e-6);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -28,7 +28,16 @@ float getRange(
   int a,
   const float p )
 {
-  float range = sqrt( float( 3.f * I.Height() * I.Width() ) / ( p * a * PI_ ) );
+  return getRange( I.Width(), I.Height(), a, p );
+}
+
+float getRange(
+  int width,
+  int height,
+  int a,
+  const float p )
+{
+  float range = sqrt( float( 3.f * height * width ) / ( p * a * PI_ ) );
   return range;
 }
 
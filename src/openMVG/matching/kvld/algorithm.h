@@ -185,5 +185,6 @@ inline float consistent( const T& a1, const T& a2, const T& b1, const T& b2 )
   return d;
 }
 float getRange(const openMVG::image::Image<float>& I, int a, const float p);
+float getRange(int width, int height, int a, const float p);
 
 #endif // OPENMVG_MATCHING_KVLD_ALGORITHM_H
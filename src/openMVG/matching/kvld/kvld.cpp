@@ -12,7 +12,12 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 using namespace openMVG;
 using namespace openMVG::image;
@@ -43,9 +48,9 @@ ImageScale::ImageScale( const Image<float>& I, double r )
     angles[ k ].resize( int( I.Width() / ratio ), int( I.Height() / ratio ) );
     magnitudes[ k ].resize( int( I.Width() / ratio ), int( I.Height() / ratio ) );
 
-    for (int i = 0; i < I2.Width(); i++ )
+    for (int j = 0; j < I2.Height(); j++ )
     {
-      for (int j = 0; j < I2.Height(); j++ )
+      for (int i = 0; i < I2.Width(); i++ )
       {
         I2( j, i ) = inter( double( i + 0.5 ) * ratio, double( j + 0.5 ) * ratio, ratio );
       }
@@ -78,6 +83,16 @@ void ImageScale::GradAndNorm( const Image<float>& I, Image<float>& angle, Image<
   }
 }
 
+int ImageScale::Width() const
+{
+  return angles[ 0 ].Width();
+}
+
+int ImageScale::Height() const
+{
+  return angles[ 0 ].Height();
+}
+
 int ImageScale::getIndex( const double r )const
 {
   const double step = sqrt( 2.0 );
@@ -194,48 +209,211 @@ VLD::VLD( const ImageScale& series, T const& P1, T const& P2 ) : contrast( 0.0 )
   normalize_weight( weight );
 }
 
-float KVLD( const Image<float>& I1,
-            const Image<float>& I2,
+namespace {
+
+//====== gvld(or vld)-consistency storages ======//
+// value of a pair of matches: -1=unknow, -2=false, >=0 consistancy value
+
+// dense matrix (externalized for illustration reason)
+struct DenseConsistency
+{
+  openMVG::Mat& E;
+
+  explicit DenseConsistency( openMVG::Mat& E ): E( E ){}
+  inline double get( size_t it1, size_t it2 )const { return E( it1, it2 ); }
+  inline void set( size_t it1, size_t it2, double value )
+  {
+    E( it1, it2 ) = value;
+    E( it2, it1 ) = value;
+  }
+};
+
+// sparse storage, only the evaluated neighbor pairs are stored
+struct SparseConsistency
+{
+  std::unordered_map<uint64_t, double> E;
+
+  static inline uint64_t key( size_t it1, size_t it2 )
+  {
+    return ( uint64_t( std::min( it1, it2 ) ) << 32 ) | uint64_t( std::max( it1, it2 ) );
+  }
+  inline double get( size_t it1, size_t it2 )const
+  {
+    const auto it = E.find( key( it1, it2 ) );
+    return ( it == E.end() ) ? -1 : it->second;
+  }
+  inline void set( size_t it1, size_t it2, double value )
+  {
+    E[ key( it1, it2 ) ] = value;
+  }
+};
+
+//====== spatial hashing of the match positions ======//
+// Each match is stored in the grid cell of its position, cells are as large as the neighborhood range,
+// so the matches closer than the range of a position are in the 3x3 cells around it.
+class MatchGrid
+{
+  const double cell_size;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+  inline std::pair<int64_t, int64_t> cell( float x, float y )const
+  {
+    return { int64_t( std::floor( x / cell_size ) ), int64_t( std::floor( y / cell_size ) ) };
+  }
+  static inline uint64_t key( int64_t cx, int64_t cy )
+  {
+    return ( uint64_t( cx ) << 32 ) ^ uint64_t( cy & 0xffffffff );
+  }
+
+public:
+  MatchGrid( const float range ): cell_size( std::max( double( range ), 1.0 ) ){}
+
+  inline void insert( float x, float y, uint32_t it )
+  {
+    const auto c = cell( x, y );
+    cells[ key( c.first, c.second ) ].push_back( it );
+  }
+
+  // append the matches of the 3x3 cells around (x,y)
+  inline void query( float x, float y, std::vector<uint32_t>& candidates )const
+  {
+    const auto c = cell( x, y );
+    for (int64_t cy = c.second - 1; cy <= c.second + 1; ++cy )
+      for (int64_t cx = c.first - 1; cx <= c.first + 1; ++cx )
+      {
+        const auto it = cells.find( key( cx, cy ) );
+        if (it != cells.end() )
+          candidates.insert( candidates.end(), it->second.begin(), it->second.end() );
+      }
+  }
+};
+
+// For each match, list (in ascending order) the matches that are its neighbors: far enough from it in both
+// images and closer than the range in one of them. The positions are hashed in a grid in order to avoid
+// testing all the pairs of matches.
+std::vector<std::vector<uint32_t>> neighborMatches(
+  const std::vector<features::SIOPointFeature> & F1,
+  const std::vector<features::SIOPointFeature> & F2,
+  const std::vector<Pair>& matches,
+  const float range1,
+  const float range2 )
+{
+  const size_t size = matches.size();
+  MatchGrid grid1( range1 ), grid2( range2 );
+  for (size_t it = 0; it < size; it++ )
+  {
+    grid1.insert( F1[ matches[ it ].first ].x(), F1[ matches[ it ].first ].y(), it );
+    grid2.insert( F2[ matches[ it ].second ].x(), F2[ matches[ it ].second ].y(), it );
+  }
+
+  std::vector<std::vector<uint32_t>> neighbors( size );
+#ifdef OPENMVG_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int it1 = 0; it1 < static_cast<int>( size ); it1++ )
+  {
+    const size_t a1 = matches[ it1 ].first, b1 = matches[ it1 ].second;
+    std::vector<uint32_t> candidates;
+    grid1.query( F1[ a1 ].x(), F1[ a1 ].y(), candidates );
+    grid2.query( F2[ b1 ].x(), F2[ b1 ].y(), candidates );
+    std::sort( candidates.begin(), candidates.end() );
+    candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+    for (const uint32_t it2 : candidates )
+    {
+      if (it2 == static_cast<uint32_t>( it1 ) )
+        continue;
+      const size_t a2 = matches[ it2 ].first, b2 = matches[ it2 ].second;
+      if (point_distance( F1[ a1 ], F1[ a2 ] ) > min_dist && point_distance( F2[ b1 ], F2[ b2 ] ) > min_dist &&
+        ( point_distance( F1[ a1 ], F1[ a2 ] ) < range1   || point_distance( F2[ b1 ], F2[ b2 ] ) < range2 ) )
+        neighbors[ it1 ].push_back( it2 );
+    }
+  }
+  return neighbors;
+}
+
+// For each match, list (in ascending order) the matches that share one of its points
+// (same index or same position in only one of the images).
+std::vector<std::vector<uint32_t>> conflictingMatches(
+  const std::vector<features::SIOPointFeature> & F1,
+  const std::vector<features::SIOPointFeature> & F2,
+  const std::vector<Pair>& matches )
+{
+  // (+0.f merges -0 and +0 which compare equal)
+  const auto position_key = []( const features::SIOPointFeature & P )
+  {
+    const float x = P.x() + 0.f, y = P.y() + 0.f;
+    uint32_t ux, uy;
+    std::memcpy( &ux, &x, sizeof( float ) );
+    std::memcpy( &uy, &y, sizeof( float ) );
+    return ( uint64_t( ux ) << 32 ) | uy;
+  };
+
+  const size_t size = matches.size();
+  std::unordered_map<uint64_t, std::vector<uint32_t>> byA, byB, byPos1, byPos2;
+  for (size_t it = 0; it < size; it++ )
+  {
+    byA[ matches[ it ].first ].push_back( it );
+    byB[ matches[ it ].second ].push_back( it );
+    byPos1[ position_key( F1[ matches[ it ].first ] ) ].push_back( it );
+    byPos2[ position_key( F2[ matches[ it ].second ] ) ].push_back( it );
+  }
+
+  std::vector<std::vector<uint32_t>> conflicts( size );
+  std::vector<uint32_t> candidates;
+  for (size_t it1 = 0; it1 < size; it1++ )
+  {
+    const size_t a1 = matches[ it1 ].first, b1 = matches[ it1 ].second;
+    candidates.clear();
+    for (const auto * group : { &byA[ a1 ], &byB[ b1 ], &byPos1[ position_key( F1[ a1 ] ) ], &byPos2[ position_key( F2[ b1 ] ) ] } )
+      candidates.insert( candidates.end(), group->begin(), group->end() );
+    std::sort( candidates.begin(), candidates.end() );
+    candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+    for (const uint32_t it2 : candidates )
+    {
+      if (it2 == it1 )
+        continue;
+      const size_t a2 = matches[ it2 ].first, b2 = matches[ it2 ].second;
+      if (a1 == a2 || b1 == b2
+          || ( F1[ a1 ].x() == F1[ a2 ].x() && F1[ a1 ].y() == F1[ a2 ].y() &&
+             ( F2[ b1 ].x() != F2[ b2 ].x() || F2[ b1 ].y() != F2[ b2 ].y() ) )
+          || ( ( F1[ a1 ].x() != F1[ a2 ].x() || F1[ a1 ].y() != F1[ a2 ].y() ) &&
+                 F2[ b1 ].x() == F2[ b2 ].x() && F2[ b1 ].y() == F2[ b2 ].y() ) )
+        conflicts[ it1 ].push_back( it2 );
+    }
+  }
+  return conflicts;
+}
+
+template <typename Consistency>
+float KVLD_impl( const ImageScale& Chaine1,
+            const ImageScale& Chaine2,
             const std::vector<features::SIOPointFeature> & F1,
             const std::vector<features::SIOPointFeature> & F2,
             const std::vector<Pair>& matches,
             std::vector<Pair>& matchesFiltered,
             std::vector<double>& score,
-            openMVG::Mat& E,
+            Consistency& E,
             std::vector<bool>& valide,
             KvldParameters& kvldParameters )
 {
   matchesFiltered.clear();
   score.clear();
-  ImageScale Chaine1( I1 );
-  ImageScale Chaine2( I2 );
-
-  std::cout << "Image scale-space complete..." << std::endl;
+  if (matches.empty() )
+    return 0.f;
 
-  const float range1 = getRange( I1, std::min( F1.size(), matches.size() ), kvldParameters.inlierRate );
-  const float range2 = getRange( I2, std::min( F2.size(), matches.size() ), kvldParameters.inlierRate );
+  const float range1 = getRange( Chaine1.Width(), Chaine1.Height(), std::min( F1.size(), matches.size() ), kvldParameters.inlierRate );
+  const float range2 = getRange( Chaine2.Width(), Chaine2.Height(), std::min( F2.size(), matches.size() ), kvldParameters.inlierRate );
 
   const size_t size = matches.size();
 
-  //================distance map construction, foruse of selecting neighbors===============//
-  std::cout << "computing distance maps" << std::endl;
-
-  const bool bPrecomputedDist = false;
-
-  openMVG::Matf dist1, dist2;
-  if (bPrecomputedDist )
-  {
-    dist1 = openMVG::Matf::Zero( F1.size(), F1.size() );
-    dist2 = openMVG::Matf::Zero( F2.size(), F2.size() );
-
-    for (size_t a1 = 0; a1 < F1.size(); ++a1 )
-      for (size_t a2 = a1; a2 < F1.size(); ++a2 )
-        dist1( a1, a2 ) = dist1( a2, a1 ) = point_distance( F1[ a1 ], F1[ a2 ] );
-
-    for (size_t b1 = 0; b1 < F2.size(); ++b1 )
-      for (size_t b2 = b1; b2 < F2.size(); ++b2 )
-        dist2( b1, b2 ) = dist2( b2, b1 ) = point_distance( F2[ b1 ], F2[ b2 ] );
-  }
+  //================neighbor lists construction, for use of selecting neighbors===============//
+  // (positions and ranges are fixed during the process: the neighbors are computed once)
+  const std::vector<std::vector<uint32_t>> neighbors = neighborMatches( F1, F2, matches, range1, range2 );
+  std::vector<std::vector<uint32_t>> conflicts;
+  if (uniqueMatch )
+    conflicts = conflictingMatches( F1, F2, matches );
 
   std::fill( valide.begin(), valide.end(), true );
   std::vector<double> scoretable( size, 0.0 );
@@ -259,51 +437,44 @@ float KVLD( const Image<float>& I1,
       {
         size_t a1 = matches[ it1 ].first, b1 = matches[ it1 ].second;
 
-        for (size_t it2 = it1 + 1; it2 < size; it2++ )
+        const std::vector<uint32_t> & neighbors1 = neighbors[ it1 ];
+        for (auto iter = std::upper_bound( neighbors1.begin(), neighbors1.end(), uint32_t( it1 ) );
+             iter != neighbors1.end(); ++iter )
+        {
+          const size_t it2 = *iter;
           if (valide[ it2 ])
           {
             const size_t a2 = matches[ it2 ].first, b2 = matches[ it2 ].second;
 
-            bool bOk = false;
-            if (bPrecomputedDist )
-              bOk = ( dist1( a1, a2 ) > min_dist && dist2( b1, b2 ) > min_dist
-                 && ( dist1( a1, a2 ) < range1   || dist2( b1, b2 ) < range2 ) );
-            else
-              bOk = ( point_distance( F1[ a1 ], F1[ a2 ] ) > min_dist && point_distance( F2[ b1 ], F2[ b2 ] ) > min_dist &&
-                    ( point_distance( F1[ a1 ], F1[ a2 ] ) < range1   || point_distance( F2[ b1 ], F2[ b2 ] ) < range2 ) );
-            if (bOk )
-            {
-              if (E( it1, it2 ) == -1 )
-              { //update E ifunknow
-                E( it1, it2 ) = -2;
-                E( it2, it1 ) = -2;
+            if (E.get( it1, it2 ) == -1 )
+            { //update E ifunknow
+              E.set( it1, it2, -2 );
 
-                if (!kvldParameters.geometry || consistent( F1[ a1 ], F1[ a2 ], F2[ b1 ], F2[ b2 ] ) < distance_thres )
+              if (!kvldParameters.geometry || consistent( F1[ a1 ], F1[ a2 ], F2[ b1 ], F2[ b2 ] ) < distance_thres )
+              {
+                VLD vld1( Chaine1, F1[ a1 ], F1[ a2 ] );
+                VLD vld2( Chaine2, F2[ b1 ], F2[ b2 ] );
+                //vld1.test();
+                double error = vld1.difference( vld2 );
+                //cout<<endl<<it1<<" "<<it2<<" "<<dist1(a1,a2)<<" "<< dist2(b1,b2)<<" "<<error<<endl;
+                if (error < juge )
                 {
-                  VLD vld1( Chaine1, F1[ a1 ], F1[ a2 ] );
-                  VLD vld2( Chaine2, F2[ b1 ], F2[ b2 ] );
-                  //vld1.test();
-                  double error = vld1.difference( vld2 );
-                  //cout<<endl<<it1<<" "<<it2<<" "<<dist1(a1,a2)<<" "<< dist2(b1,b2)<<" "<<error<<endl;
-                  if (error < juge )
-                  {
-                    E( it1, it2 ) = ( float ) error;
-                    E( it2, it1 ) = ( float ) error;
-                    //cout<<E(it2,it1)<<endl;
-                  }
+                  E.set( it1, it2, ( float ) error );
                 }
               }
-              if (E( it1, it2 ) >= 0 )
-              {
-                result[ it1 ] += 1;
-                result[ it2 ] += 1;
-                scoretable[ it1 ] += double( E( it1, it2 ) );
-                scoretable[ it2 ] += double( E( it1, it2 ) );
-                if (result[ it1 ] >= max_connection )
-                  break;
-              }
+            }
+            const double e = E.get( it1, it2 );
+            if (e >= 0 )
+            {
+              result[ it1 ] += 1;
+              result[ it2 ] += 1;
+              scoretable[ it1 ] += e;
+              scoretable[ it2 ] += e;
+              if (result[ it1 ] >= max_connection )
+                break;
             }
           }
+        }
       }
     }
 
@@ -320,58 +491,46 @@ float KVLD( const Image<float>& I1,
     if (uniqueMatch )
       for (size_t it1 = 0; it1 < size - 1; it1++ )
         if (valide[ it1 ]) {
-          size_t a1 = matches[ it1 ].first;
-          size_t b1 = matches[ it1 ].second;
-
-          for (size_t it2 = it1 + 1; it2 < size; it2++ )
+          const std::vector<uint32_t> & conflicts1 = conflicts[ it1 ];
+          for (auto iter = std::upper_bound( conflicts1.begin(), conflicts1.end(), uint32_t( it1 ) );
+               iter != conflicts1.end(); ++iter )
+          {
+            const size_t it2 = *iter;
             if (valide[ it2 ] )
             {
-              size_t a2 = matches[ it2 ].first;
-              size_t b2 = matches[ it2 ].second;
-
-              if (a1 == a2 || b1 == b2
-                  || ( F1[ a1 ].x() == F1[ a2 ].x() && F1[ a1 ].y() == F1[ a2 ].y() &&
-                     ( F2[ b1 ].x() != F2[ b2 ].x() || F2[ b1 ].y() != F2[ b2 ].y() ) )
-                  || ( ( F1[ a1 ].x() != F1[ a2 ].x() || F1[ a1 ].y() != F1[ a2 ].y() ) &&
-                         F2[ b1 ].x() == F2[ b2 ].x() && F2[ b1 ].y() == F2[ b2 ].y() ) )
+              //cardinal comparison
+              if (result[ it1 ] > result[ it2 ] )
               {
-                //cardinal comparison
-                if (result[ it1 ] > result[ it2 ] )
-                {
-                  valide[ it2 ] = false;
-                  change = true;
-                }
-                else if (result[ it1 ] < result[ it2 ] )
+                valide[ it2 ] = false;
+                change = true;
+              }
+              else if (result[ it1 ] < result[ it2 ] )
+              {
+                valide[ it1 ] = false;
+                change = true;
+              }
+              else if (result[ it1 ] == result[ it2 ] )
+              {
+                //score comparison
+                if (scoretable[ it1 ] > scoretable[ it2 ] )
                 {
                   valide[ it1 ] = false;
                   change = true;
                 }
-                else if (result[ it1 ] == result[ it2 ] )
+                else if (scoretable[ it1 ] < scoretable[ it2 ] )
                 {
-                  //score comparison
-                  if (scoretable[ it1 ] > scoretable[ it2 ] )
-                  {
-                    valide[ it1 ] = false;
-                    change = true;
-                  }
-                  else if (scoretable[ it1 ] < scoretable[ it2 ] )
-                  {
-                    valide[ it2 ] = false;
-                    change = true;
-                  }
+                  valide[ it2 ] = false;
+                  change = true;
                 }
               }
             }
+          }
         }
     //========substep 4: ifgeometric verification is set, re-score matches by geometric-consistency, and remove poorly scored ones ============================//
     if (uniqueMatch && kvldParameters.geometry )
     {
-      for (size_t i = 0; i < size; i++ )
-        scoretable[ i ]=0;
-
-      std::vector<bool> switching;
-      for (size_t i = 0; i < size; i++ )
-        switching.push_back( false );
+      std::fill( scoretable.begin(), scoretable.end(), 0.0 );
+      std::vector<bool> switching( size, false );
 
       for (size_t it1 = 0; it1 < size; it1++ )
       {
@@ -380,28 +539,18 @@ float KVLD( const Image<float>& I1,
           size_t a1 = matches[ it1 ].first, b1 = matches[ it1 ].second;
           float index = 0.0f;
           int good_index = 0;
-          for (size_t it2 = 0; it2 < size; it2++ )
+          for (const uint32_t it2 : neighbors[ it1 ] )
           {
-            if (it1 != it2 && valide[ it2 ] )
+            if (valide[ it2 ] )
             {
               size_t a2 = matches[ it2 ].first;
               size_t b2 = matches[ it2 ].second;
 
-              bool bOk = false;
-              if (bPrecomputedDist )
-                bOk = ( dist1( a1, a2 ) > min_dist && dist2( b1, b2 ) > min_dist &&
-                      ( dist1( a1, a2 ) < range1   || dist2( b1, b2 ) < range2 ) );
-              else
-                bOk = ( point_distance( F1[ a1 ], F1[ a2 ] ) > min_dist && point_distance( F2[ b1 ], F2[ b2 ] ) > min_dist &&
-                      ( point_distance( F1[ a1 ], F1[ a2 ] ) < range1   || point_distance( F2[ b1 ], F2[ b2 ] ) < range2 ) );
-              if (bOk )
-              {
-                float d = consistent( F1[ a1 ], F1[ a2 ], F2[ b1 ], F2[ b2 ] );
-                scoretable[ it1 ] += d;
-                index += 1;
-                if (d < distance_thres )
-                  good_index++;
-              }
+              float d = consistent( F1[ a1 ], F1[ a2 ], F2[ b1 ], F2[ b2 ] );
+              scoretable[ it1 ] += d;
+              index += 1;
+              if (d < distance_thres )
+                good_index++;
             }
           }
           scoretable[ it1 ] /= index;
@@ -426,3 +575,137 @@ float KVLD( const Image<float>& I1,
     }
   return float( matchesFiltered.size() ) / matches.size();
 }
+
+} // namespace
+
+float KVLD( const Image<float>& I1,
+            const Image<float>& I2,
+            const std::vector<features::SIOPointFeature> & F1,
+            const std::vector<features::SIOPointFeature> & F2,
+            const std::vector<Pair>& matches,
+            std::vector<Pair>& matchesFiltered,
+            std::vector<double>& score,
+            openMVG::Mat& E,
+            std::vector<bool>& valide,
+            KvldParameters& kvldParameters )
+{
+  ImageScale Chaine1( I1 );
+  ImageScale Chaine2( I2 );
+
+  std::cout << "Image scale-space complete..." << std::endl;
+
+  return KVLD( Chaine1, Chaine2, F1, F2, matches, matchesFiltered, score, E, valide, kvldParameters );
+}
+
+float KVLD( const ImageScale& Chaine1,
+            const ImageScale& Chaine2,
+            const std::vector<features::SIOPointFeature> & F1,
+            const std::vector<features::SIOPointFeature> & F2,
+            const std::vector<Pair>& matches,
+            std::vector<Pair>& matchesFiltered,
+            std::vector<double>& score,
+            openMVG::Mat& E,
+            std::vector<bool>& valide,
+            KvldParameters& kvldParameters )
+{
+  DenseConsistency consistency( E );
+  return KVLD_impl( Chaine1, Chaine2, F1, F2, matches, matchesFiltered, score, consistency, valide, kvldParameters );
+}
+
+std::map<Pair, std::vector<Pair>> KVLDFilter(
+  const KvldImageProvider & image_provider,
+  const KvldFeaturesProvider & features_provider,
+  const std::map<Pair, std::vector<Pair>> & putative_matches,
+  const KvldParameters & kvldParameters,
+  const size_t max_iteration )
+{
+  // Scale-space and features of a view, loaded by the first pair that needs them and released by its last pair
+  struct ViewData
+  {
+    std::mutex mutex;
+    bool computed = false;
+    size_t remaining_pairs = 0;
+    std::shared_ptr<const ImageScale> scale;
+    std::shared_ptr<const std::vector<features::SIOPointFeature>> features;
+  };
+  std::map<IndexT, ViewData> views;
+  std::vector<Pair> pairs;
+  pairs.reserve( putative_matches.size() );
+  for (const auto & pair_it : putative_matches )
+  {
+    pairs.push_back( pair_it.first );
+    ++views[ pair_it.first.first ].remaining_pairs;
+    ++views[ pair_it.first.second ].remaining_pairs;
+  }
+
+  // Return false if the view data cannot be loaded
+  const auto acquire = [&](
+    const IndexT view_id,
+    std::shared_ptr<const ImageScale> & scale,
+    std::shared_ptr<const std::vector<features::SIOPointFeature>> & view_features )
+  {
+    ViewData & view = views.at( view_id );
+    std::lock_guard<std::mutex> lock( view.mutex );
+    if (!view.computed )
+    {
+      view.computed = true;
+      auto loaded_features = std::make_shared<std::vector<features::SIOPointFeature>>();
+      Image<float> image;
+      if (features_provider( view_id, *loaded_features ) && image_provider( view_id, image ) )
+      {
+        view.features = loaded_features;
+        view.scale = std::make_shared<const ImageScale>( image );
+      }
+    }
+    scale = view.scale;
+    view_features = view.features;
+    return scale && view_features;
+  };
+  const auto release = [&]( const IndexT view_id )
+  {
+    ViewData & view = views.at( view_id );
+    std::lock_guard<std::mutex> lock( view.mutex );
+    if (--view.remaining_pairs == 0 )
+    {
+      view.scale.reset();
+      view.features.reset();
+    }
+  };
+
+  std::vector<std::vector<Pair>> filtered_matches( pairs.size() );
+#ifdef OPENMVG_USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < static_cast<int>( pairs.size() ); ++i )
+  {
+    const Pair & pair = pairs[ i ];
+    const std::vector<Pair> & matches = putative_matches.at( pair );
+    std::shared_ptr<const ImageScale> Chaine1, Chaine2;
+    std::shared_ptr<const std::vector<features::SIOPointFeature>> features_I, features_J;
+    if (acquire( pair.first, Chaine1, features_I ) && acquire( pair.second, Chaine2, features_J )
+        && !matches.empty() )
+    {
+      SparseConsistency E;
+      std::vector<bool> valide( matches.size(), true );
+      std::vector<double> score;
+      KvldParameters parameters = kvldParameters;
+      size_t it_num = 0;
+      while (it_num < max_iteration &&
+        parameters.inlierRate > KVLD_impl( *Chaine1, *Chaine2, *features_I, *features_J,
+          matches, filtered_matches[ i ], score, E, valide, parameters ) )
+      {
+        parameters.inlierRate /= 2;
+        parameters.K = 2;
+        it_num++;
+      }
+    }
+    release( pair.first );
+    release( pair.second );
+  }
+
+  std::map<Pair, std::vector<Pair>> kvld_matches;
+  for (size_t i = 0; i < pairs.size(); ++i )
+    if (!filtered_matches[ i ].empty() )
+      kvld_matches[ pairs[ i ] ] = std::move( filtered_matches[ i ] );
+  return kvld_matches;
+}
@@ -10,7 +10,9 @@
 #define OPENMVG_MATCHING_KVLD_H
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <vector>
 
 #include "openMVG/numeric/eigen_alias_definition.hpp"
@@ -60,6 +62,9 @@ struct ImageScale
 
   ImageScale(const openMVG::image::Image<float>& I, double r = 5.0);
   int getIndex( const double r )const;
+  // size of the original scale image
+  int Width() const;
+  int Height() const;
 
 private:
   void GradAndNorm(
@@ -181,4 +186,46 @@ float KVLD(const openMVG::image::Image<float>& I1,
   std::vector<bool>& valide,
   KvldParameters& kvldParameters );
 
+// Same as above with precomputed scale-spaces of I1 and I2.
+// The gradient pyramids are the most expensive part of a KVLD call: computing them once allows to
+// share them between the calls of an image pair (re-selection with a lower inlierRate) and between
+// the pairs sharing an image.
+float KVLD(const ImageScale& Chaine1,
+  const ImageScale& Chaine2,
+  const std::vector<openMVG::features::SIOPointFeature> & F1,
+  const std::vector<openMVG::features::SIOPointFeature> & F2,
+  const std::vector<openMVG::Pair>& matches,
+  std::vector<openMVG::Pair>& matchesFiltered,
+  std::vector<double>& score,
+  openMVG::Mat& E,
+  std::vector<bool>& valide,
+  KvldParameters& kvldParameters );
+
+//==================KVLD batch filtering======================//
+// Filter the putative matches of a set of image pairs (i.e. as a geometric filter after the matching of a scene):
+// - the scale-space and the features of an image are loaded once and shared by all the pairs it belongs to
+//   (they are released as soon as the last of these pairs has been filtered),
+// - the pairs are filtered in parallel,
+// - as in the samples, KVLD is repeated with a halved inlierRate (and K = 2) while the rate of kept matches
+//   is lower than the inlier rate (at most max_iteration times),
+// - the gvld-consistency values are stored sparsely (only the evaluated neighbors).
+//
+//image_provider: fill the (gray level) image of a view, return false if it cannot be loaded (the pairs of this view are then discarded)
+//
+//features_provider: fill the keypoints of a view, return false if they cannot be loaded (the pairs of this view are then discarded)
+//
+//putative_matches: for each image pair, the list of putative matches (pairs of feature INDEX)
+//
+//Return the KVLD consistent matches of each pair (the pairs without any consistent matches are not listed)
+
+using KvldImageProvider = std::function<bool(openMVG::IndexT, openMVG::image::Image<float>&)>;
+using KvldFeaturesProvider = std::function<bool(openMVG::IndexT, std::vector<openMVG::features::SIOPointFeature>&)>;
+
+std::map<openMVG::Pair, std::vector<openMVG::Pair>> KVLDFilter(
+  const KvldImageProvider & image_provider,
+  const KvldFeaturesProvider & features_provider,
+  const std::map<openMVG::Pair, std::vector<openMVG::Pair>> & putative_matches,
+  const KvldParameters & kvldParameters = KvldParameters(),
+  const size_t max_iteration = 5 );
+
 #endif // OPENMVG_MATCHING_KVLD_H
@@ -0,0 +1,200 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/features/feature.hpp"
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/matching/kvld/kvld.h"
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::image;
+
+namespace {
+
+// Smooth texture of the scene (sum of random sinusoids)
+struct Texture
+{
+  std::vector<Vec4> waves_; // (frequency x, frequency y, phase, amplitude)
+
+  Texture()
+  {
+    std::mt19937 random_generator(0);
+    std::uniform_real_distribution<double> frequency(-0.3, 0.3), phase(0.0, 6.28);
+    for (int i = 0; i < 12; ++i)
+      waves_.emplace_back(frequency(random_generator), frequency(random_generator),
+        phase(random_generator), 10.0);
+  }
+
+  // Image of the view_id view: the scene translated by (5, 3) * view_id pixels
+  Image<float> Render(const IndexT view_id) const
+  {
+    Image<float> image(320, 240);
+    for (int y = 0; y < image.Height(); ++y)
+      for (int x = 0; x < image.Width(); ++x)
+      {
+        const Vec2 pos(x - 5.0 * view_id, y - 3.0 * view_id);
+        double value = 128.0;
+        for (const Vec4 & wave : waves_)
+          value += wave(3) * std::sin(wave(0) * pos(0) + wave(1) * pos(1) + wave(2));
+        image(y, x) = static_cast<float>(value);
+      }
+    return image;
+  }
+};
+
+} // namespace
+
+// The batch filter gives the same matches as KVLD run on each pair
+TEST(KVLD, KVLDFilter_Same_As_KVLD)
+{
+  const Texture texture;
+  const std::vector<IndexT> view_ids = {0, 1, 2};
+
+  // Scene points seen by all the views (same scale and orientation)
+  std::mt19937 random_generator(1);
+  std::uniform_real_distribution<float> position_x(30.f, 270.f), position_y(30.f, 190.f);
+  std::uniform_real_distribution<float> scale(2.f, 4.f);
+  const int point_count = 60, outlier_count = 15;
+  std::vector<SIOPointFeature> points;
+  for (int i = 0; i < point_count; ++i)
+    points.emplace_back(position_x(random_generator), position_y(random_generator),
+      scale(random_generator), 0.f);
+
+  std::map<IndexT, std::vector<SIOPointFeature>> features;
+  for (const IndexT view_id : view_ids)
+    for (const SIOPointFeature & point : points)
+      features[view_id].emplace_back(point.x() + 5.f * view_id, point.y() + 3.f * view_id,
+        point.scale(), point.orientation());
+
+  // Putative matches: the true correspondences and some outliers
+  std::map<Pair, std::vector<Pair>> putative_matches;
+  std::uniform_int_distribution<int> point_index(0, point_count - 1);
+  for (const Pair pair : {Pair(0, 1), Pair(0, 2), Pair(1, 2)})
+  {
+    std::vector<Pair> & matches = putative_matches[pair];
+    for (int i = 0; i < point_count; ++i)
+      matches.emplace_back(i, i);
+    for (int i = 0; i < outlier_count; ++i)
+    {
+      const int a = point_index(random_generator), b = point_index(random_generator);
+      if (a != b)
+        matches.emplace_back(a, b);
+    }
+  }
+
+  // The features of a view are loaded once
+  std::map<IndexT, int> features_load_count;
+  std::mutex features_load_mutex;
+  const std::map<Pair, std::vector<Pair>> kvld_matches = KVLDFilter(
+    [&](IndexT view_id, Image<float> & image)
+    {
+      image = texture.Render(view_id);
+      return true;
+    },
+    [&](IndexT view_id, std::vector<SIOPointFeature> & view_features)
+    {
+      std::lock_guard<std::mutex> lock(features_load_mutex);
+      ++features_load_count[view_id];
+      view_features = features.at(view_id);
+      return true;
+    },
+    putative_matches);
+  for (const IndexT view_id : view_ids)
+    EXPECT_EQ(1, features_load_count[view_id]);
+
+  for (const auto & pair_it : putative_matches)
+  {
+    const Pair & pair = pair_it.first;
+    const std::vector<Pair> & matches = pair_it.second;
+
+    // Per pair KVLD, as in the kvld sample
+    std::vector<Pair> matches_filtered;
+    std::vector<double> score;
+    Mat E = Mat::Ones(matches.size(), matches.size()) * (-1);
+    std::vector<bool> valide(matches.size(), true);
+    KvldParameters kvld_parameters;
+    size_t it_num = 0;
+    while (it_num < 5 &&
+      kvld_parameters.inlierRate > KVLD(texture.Render(pair.first), texture.Render(pair.second),
+        features.at(pair.first), features.at(pair.second),
+        matches, matches_filtered, score, E, valide, kvld_parameters))
+    {
+      kvld_parameters.inlierRate /= 2;
+      kvld_parameters.K = 2;
+      it_num++;
+    }
+
+    EXPECT_FALSE(matches_filtered.empty());
+    EXPECT_EQ(1, kvld_matches.count(pair));
+    if (kvld_matches.count(pair))
+    {
+      EXPECT_TRUE(matches_filtered == kvld_matches.at(pair));
+    }
+    // Only true correspondences are kept
+    for (const Pair & match : matches_filtered)
+      EXPECT_EQ(match.first, match.second);
+  }
+}
+
+// The pairs whose images cannot be loaded are discarded
+TEST(KVLD, KVLDFilter_Missing_Image)
+{
+  std::map<IndexT, std::vector<SIOPointFeature>> features;
+  std::map<Pair, std::vector<Pair>> putative_matches;
+  for (IndexT view_id = 0; view_id < 2; ++view_id)
+    for (int i = 0; i < 20; ++i)
+      features[view_id].emplace_back(40.f + 10.f * i + 5.f * view_id, 100.f + 3.f * view_id, 3.f, 0.f);
+  for (int i = 0; i < 20; ++i)
+    putative_matches[Pair(0, 1)].emplace_back(i, i);
+
+  const std::map<Pair, std::vector<Pair>> kvld_matches = KVLDFilter(
+    [](IndexT view_id, Image<float> & image)
+    {
+      return false;
+    },
+    [&](IndexT view_id, std::vector<SIOPointFeature> & view_features)
+    {
+      view_features = features.at(view_id);
+      return true;
+    },
+    putative_matches);
+  EXPECT_TRUE(kvld_matches.empty());
+}
+
+// The pairs whose features cannot be loaded are discarded
+TEST(KVLD, KVLDFilter_Missing_Features)
+{
+  const Texture texture;
+  std::map<Pair, std::vector<Pair>> putative_matches;
+  for (int i = 0; i < 20; ++i)
+    putative_matches[Pair(0, 1)].emplace_back(i, i);
+
+  const std::map<Pair, std::vector<Pair>> kvld_matches = KVLDFilter(
+    [&](IndexT view_id, Image<float> & image)
+    {
+      image = texture.Render(view_id);
+      return true;
+    },
+    [](IndexT view_id, std::vector<SIOPointFeature> & view_features)
+    {
+      return false;
+    },
+    putative_matches);
+  EXPECT_TRUE(kvld_matches.empty());
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
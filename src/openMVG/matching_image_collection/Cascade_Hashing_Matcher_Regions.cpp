@@ -13,6 +13,7 @@
 #include "openMVG/matching/matching_filters.hpp"
 #include "openMVG/matching/indMatchDecoratorXY.hpp"
 #include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 
 #include "third_party/progress/progress.hpp"
@@ -46,6 +47,8 @@ void Match
   if (!my_progress_bar)
     my_progress_bar = &C_Progress::dummy();
   my_progress_bar->restart(pairs.size(), "\n- Matching -\n");
+  system::ScopedTrace trace("Putative matching (cascade hashing)", "matching");
+  trace.AddCounter("pairs", pairs.size());
 
   // Collect used view indexes
   std::set<IndexT> used_index;
@@ -161,6 +164,10 @@ void Match
         continue;
       }
 
+      system::ScopedTrace pair_trace("Pair matching", "matching");
+      pair_trace.AddCounter("view_i", I);
+      pair_trace.AddCounter("view_j", J);
+
       // Matrix representation of the query input data;
       const ScalarT * tabJ = reinterpret_cast<const ScalarT*>(regionsJ->DescriptorRawData());
       Eigen::Map<BaseMat> mat_J( (ScalarT*)tabJ, regionsJ->RegionCount(), dimension);
@@ -205,6 +212,7 @@ void Match
       matching::IndMatchDecorator<float> matchDeduplicator(vec_putative_matches,
         pointFeaturesI, pointFeaturesJ);
       matchDeduplicator.getDeduplicated(vec_putative_matches);
+      pair_trace.AddCounter("matches", vec_putative_matches.size());
 
 #ifdef OPENMVG_USE_OPENMP
 #pragma omp critical
@@ -15,6 +15,7 @@
 
 #include "openMVG/features/feature.hpp"
 #include "openMVG/matching/indMatch.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include "third_party/progress/progress_display.hpp"
 
@@ -76,6 +77,8 @@ void ImageCollectionGeometricFilter::Robust_model_estimation
   if (!my_progress_bar)
     my_progress_bar = &C_Progress::dummy();
   my_progress_bar->restart( putative_matches.size(), "\n- Geometric filtering -\n" );
+  system::ScopedTrace trace("Geometric filtering", "matching");
+  trace.AddCounter("pairs", putative_matches.size());
 
 #ifdef OPENMVG_USE_OPENMP
 #pragma omp parallel for schedule(dynamic)
@@ -92,6 +95,10 @@ void ImageCollectionGeometricFilter::Robust_model_estimation
 
     //-- Apply the geometric filter (robust model estimation)
     {
+      system::ScopedTrace pair_trace("AC-RANSAC pair filtering", "robust_estimation");
+      pair_trace.AddCounter("view_i", current_pair.first);
+      pair_trace.AddCounter("view_j", current_pair.second);
+      pair_trace.AddCounter("putative_matches", vec_PutativeMatches.size());
       IndMatches putative_inliers;
       GeometryFunctor geometricFilter = functor; // use a copy since we are in a multi-thread context
       if (geometricFilter.Robust_estimation(
@@ -115,6 +122,7 @@ void ImageCollectionGeometricFilter::Robust_model_estimation
           // << "/" << guided_geometric_inliers.size() << std::endl;
           std::swap(putative_inliers, guided_geometric_inliers);
         }
+        pair_trace.AddCounter("inliers", putative_inliers.size());
 
 #ifdef OPENMVG_USE_OPENMP
 #pragma omp critical
@@ -10,6 +10,7 @@
 #include "openMVG/matching_image_collection/Matcher.hpp"
 #include "openMVG/matching/regions_matcher.hpp"
 #include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include "third_party/progress/progress.hpp"
 
@@ -38,6 +39,8 @@ void Matcher_Regions::Match(
 {
   if (!my_progress_bar)
     my_progress_bar = &C_Progress::dummy();
+  system::ScopedTrace trace("Putative matching", "matching");
+  trace.AddCounter("pairs", pairs.size());
 #ifdef OPENMVG_USE_OPENMP
   std::cout << "Using the OPENMP thread interface" << std::endl;
   const bool b_multithreaded_pair_search = (eMatcherType_ == CASCADE_HASHING_L2);
@@ -90,8 +93,12 @@ void Matcher_Regions::Match(
         continue;
       }
 
+      system::ScopedTrace pair_trace("Pair matching", "matching");
+      pair_trace.AddCounter("view_i", I);
+      pair_trace.AddCounter("view_j", J);
       IndMatches vec_putatives_matches;
       matcher->MatchDistanceRatio(f_dist_ratio_, *regionsJ.get(), vec_putatives_matches);
+      pair_trace.AddCounter("matches", vec_putatives_matches.size());
 
 #ifdef OPENMVG_USE_OPENMP
   #pragma omp critical
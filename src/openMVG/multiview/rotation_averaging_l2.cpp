@@ -15,6 +15,11 @@
 #include <ceres/ceres.h>
 #include <ceres/rotation.h>
 
+#include <Eigen/SparseCholesky>
+
+#include <iostream>
+#include <random>
+
 #ifdef _MSC_VER
 #pragma warning( once : 4267 ) //warning C4267: 'argument' : conversion from 'size_t' to 'const int', possible loss of data
 #endif
@@ -59,6 +64,129 @@ bool compare_first_abs(std::pair<double, Vec> const &x, std::pair<double, Vec> c
  return std::abs(x.first) < std::abs(y.first);
 }
 
+// Up to this number of cameras, the nullspace of AtA is computed with a
+//  dense eigen decomposition (cubic time and quadratic memory cost).
+static const size_t kDenseEigenSolverMaxCameras = 200;
+
+// Eigenvectors of the 3 eigenvalues of smallest magnitude of a symmetric
+//  matrix, computed from a dense eigen decomposition.
+static bool DenseSmallestEigenVectors
+(
+  const sMat & AtA,
+  Mat & nullspace
+)
+{
+  const Mat AtA_dense(AtA); // convert to dense
+  Eigen::SelfAdjointEigenSolver<Mat> es(AtA_dense, Eigen::ComputeEigenvectors);
+  if (es.info() != Eigen::Success)
+  {
+    return false;
+  }
+
+  // Sort abs(eigenvalues)
+  std::vector<std::pair<double, Vec>> eigs(AtA_dense.cols());
+  for (Mat::Index i = 0; i < AtA_dense.cols(); ++i)
+  {
+    eigs[i] = {es.eigenvalues()[i], es.eigenvectors().col(i)};
+  }
+  std::stable_sort(eigs.begin(), eigs.end(), &compare_first_abs);
+
+  nullspace.resize(AtA_dense.rows(), 3);
+  for (int k = 0; k < 3; ++k)
+  {
+    nullspace.col(k) = eigs[k].second;
+  }
+  return true;
+}
+
+// Eigenvectors of the 3 smallest eigenvalues of a sparse symmetric positive
+//  semi-definite matrix, computed by a shift-invert subspace iteration:
+//  - factorize (AtA + shift * I) once with a sparse Cholesky decomposition,
+//  - repeatedly apply its inverse to a small block of vectors, that quickly
+//    aligns with the eigenvectors of the smallest eigenvalues,
+//  - extract the eigenvectors with a Rayleigh-Ritz projection on the block.
+// Memory is linear in the number of non zeros of AtA.
+// Return false if the eigenvectors did not converge.
+static bool SparseSmallestEigenVectors
+(
+  const sMat & AtA,
+  Mat & nullspace
+)
+{
+  const Mat::Index n = AtA.rows();
+  // Extra vectors in the block speed up the convergence when the 4th
+  //  eigenvalue is close to the 3 smallest ones
+  const Mat::Index block_size = std::min<Mat::Index>(n, 8);
+  const int max_iterations = 200;
+
+  // A small shift makes the matrix positive definite without changing the
+  //  eigenvectors; it is relative to the scale of the matrix.
+  const double scale = std::max(AtA.diagonal().maxCoeff(), std::numeric_limits<double>::min());
+  const double shift = 1e-10 * scale;
+  sMat shifted(AtA);
+  for (Mat::Index i = 0; i < n; ++i)
+  {
+    shifted.coeffRef(i, i) += shift;
+  }
+  Eigen::SimplicialLDLT<sMat> solver(shifted);
+  if (solver.info() != Eigen::Success)
+  {
+    std::cerr << "Cholesky decomposition failed." << std::endl;
+    return false;
+  }
+
+  // Deterministic random start
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  std::normal_distribution<double> distribution;
+  Mat X(n, block_size);
+  for (Mat::Index k = 0; k < X.size(); ++k)
+  {
+    X.data()[k] = distribution(random_generator);
+  }
+
+  Mat AX;
+  Vec ritz_values;
+  bool converged = false;
+  for (int iter = 0; iter < max_iterations && !converged; ++iter)
+  {
+    // Inverse iteration on the block + orthonormalization
+    const Mat Y = solver.solve(X);
+    if (solver.info() != Eigen::Success)
+    {
+      return false;
+    }
+    const Mat Q = Eigen::HouseholderQR<Mat>(Y).householderQ() * Mat::Identity(n, block_size);
+
+    // Rayleigh-Ritz: eigen decomposition of the projected matrix
+    const Mat AQ = AtA * Q;
+    const Mat H = Q.transpose() * AQ;
+    Eigen::SelfAdjointEigenSolver<Mat> es(0.5 * (H + H.transpose()));
+    if (es.info() != Eigen::Success)
+    {
+      return false;
+    }
+    // Eigen values are sorted in increasing order
+    X = Q * es.eigenvectors();
+    AX = AQ * es.eigenvectors();
+    ritz_values = es.eigenvalues();
+
+    // Convergence of the 3 smallest Ritz pairs
+    double residual = 0.0;
+    for (int k = 0; k < 3; ++k)
+    {
+      residual = std::max(residual, (AX.col(k) - ritz_values(k) * X.col(k)).norm());
+    }
+    converged = (residual < 1e-10 * scale);
+  }
+  if (!converged)
+  {
+    std::cerr << "Sparse eigen solver did not converge." << std::endl;
+    return false;
+  }
+  nullspace = X.leftCols<3>();
+  return true;
+}
+
 //-- Solve the Global Rotation matrix registration for each camera given a list
 //    of relative orientation using matrix parametrization
 //    [1] formula 6.62 page 100. Dense formulation.
@@ -93,7 +221,8 @@ bool L2RotationAveraging
   size_t nCamera,
   const RelativeRotations& vec_relativeRot,
   // Output
-  std::vector<Mat3> & global_rotations
+  std::vector<Mat3> & global_rotations,
+  L2EigenSolver eigen_solver
 )
 {
   const size_t nRotationEstimation = vec_relativeRot.size();
@@ -129,37 +258,50 @@ bool L2RotationAveraging
   }
 
   // nCamera * 3 because each columns have 3 elements.
-  Mat AtA(3*nCamera,3*nCamera);
+  sMat AtA;
   {
     sMat A(nRotationEstimation*3, 3*nCamera);
     A.setFromTriplets(tripletList.begin(), tripletList.end());
     tripletList.clear();
     tripletList.shrink_to_fit();
 
-    const sMat AtAsparse = A.transpose() * A;
-    AtA = Mat(AtAsparse); // convert to dense
+    AtA = A.transpose() * A;
   }
 
   // Solve Ax=0 => eigen vectors
-  Eigen::SelfAdjointEigenSolver<Mat> es(AtA, Eigen::ComputeEigenvectors);
-
-  if (es.info() != Eigen::Success)
+  Mat nullspace;
+  bool solved = false;
+  switch (eigen_solver)
+  {
+    case L2EigenSolver::DENSE:
+      solved = DenseSmallestEigenVectors(AtA, nullspace);
+    break;
+    case L2EigenSolver::SPARSE:
+      solved = SparseSmallestEigenVectors(AtA, nullspace);
+    break;
+    case L2EigenSolver::AUTO:
+      // No dense fallback for large problems: it would allocate the dense
+      //  3n x 3n matrix that the sparse solver avoids.
+      if (nCamera <= kDenseEigenSolverMaxCameras)
+        solved = DenseSmallestEigenVectors(AtA, nullspace);
+      else
+      {
+        solved = SparseSmallestEigenVectors(AtA, nullspace);
+        if (!solved)
+          std::cerr << "L2 rotation averaging failed: " << nCamera
+            << " cameras are too many for the dense eigen solver." << std::endl;
+      }
+    break;
+  }
+  if (!solved)
   {
     return false;
   }
   // else
   {
-    // Sort abs(eigenvalues)
-    std::vector<std::pair<double, Vec>> eigs(AtA.cols());
-    for (Mat::Index i = 0; i < AtA.cols(); ++i)
-    {
-      eigs[i] = {es.eigenvalues()[i], es.eigenvectors().col(i)};
-    }
-    std::stable_sort(eigs.begin(), eigs.end(), &compare_first_abs);
-
-    const Vec & NullspaceVector0 = eigs[0].second;
-    const Vec & NullspaceVector1 = eigs[1].second;
-    const Vec & NullspaceVector2 = eigs[2].second;
+    const auto NullspaceVector0 = nullspace.col(0);
+    const auto NullspaceVector1 = nullspace.col(1);
+    const auto NullspaceVector2 = nullspace.col(2);
 
     //--
     // Search the closest matrix :
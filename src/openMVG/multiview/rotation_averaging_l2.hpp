@@ -58,10 +58,23 @@ Mat3 ClosestSVDRotationMatrix(const Mat3 & rotMat);
 // vector.add( RelativeRotation(1,2, R12) );
 // vector.add( RelativeRotation(0,2, R02) );
 //
+// The rotations are the 3 eigenvectors of the smallest eigenvalues of AtA:
+// - DENSE: full eigen decomposition of the dense 3n x 3n matrix,
+// - SPARSE: shift-invert subspace iteration on the sparse matrix (memory is
+//    linear in the number of relative rotations), fails if it does not converge,
+// - AUTO: DENSE for small problems, SPARSE otherwise (without dense fallback).
+enum class L2EigenSolver
+{
+  AUTO,
+  DENSE,
+  SPARSE
+};
+
 bool L2RotationAveraging( size_t nCamera,
   const RelativeRotations& vec_relativeRot,
   // Output
-  std::vector<Mat3> & vec_ApprRotMatrix);
+  std::vector<Mat3> & vec_ApprRotMatrix,
+  L2EigenSolver eigen_solver = L2EigenSolver::AUTO);
 
 // None linear refinement of the rotation using an angle-axis representation
 bool L2RotationAveraging_Refine(
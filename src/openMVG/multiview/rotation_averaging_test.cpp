@@ -17,6 +17,7 @@
 #include <iostream>
 #include <iterator>
 #include <numeric>
+#include <random>
 #include <vector>
 
 using namespace openMVG;
@@ -160,6 +161,80 @@ TEST ( rotation_averaging, RefineRotationsL2_CompleteGraph)
   }
 }
 
+TEST ( rotation_averaging, RotationLeastSquare_SparseSameAsDense)
+{
+  //-- Setup a circular camera rig
+  const int iNviews = 40;
+  const NViewDataSet d = NRealisticCamerasRing(iNviews, 5,
+    nViewDatasetConfigurator(1,1,0,0,5,0)); // Suppose a camera with Unit matrix as K
+
+  // Link each camera to the three next ones with noisy relative rotations
+  std::mt19937 random_generator(0);
+  std::normal_distribution<double> noise(0.0, 0.01);
+  RelativeRotations vec_relativeRotEstimate;
+  for (size_t i = 0; i < iNviews; ++i)
+  {
+    for (size_t k = 1; k <= 3; ++k)
+    {
+      const size_t j = (i + k) % iNviews;
+      Mat3 Rrel;
+      Vec3 trel;
+      RelativeCameraMotion(d._R[i], d._t[i], d._R[j], d._t[j], &Rrel, &trel);
+      const Vec3 perturbation(noise(random_generator), noise(random_generator), noise(random_generator));
+      Rrel = Rrel * Eigen::AngleAxisd(perturbation.norm(), perturbation.normalized()).toRotationMatrix();
+      vec_relativeRotEstimate.emplace_back(i, j, Rrel, 1.0);
+    }
+  }
+
+  std::vector<Mat3> vec_globalR_dense, vec_globalR_sparse;
+  EXPECT_TRUE(L2RotationAveraging(iNviews, vec_relativeRotEstimate, vec_globalR_dense, L2EigenSolver::DENSE));
+  EXPECT_TRUE(L2RotationAveraging(iNviews, vec_relativeRotEstimate, vec_globalR_sparse, L2EigenSolver::SPARSE));
+  CHECK_EQUAL(iNviews, vec_globalR_sparse.size());
+  for (size_t i = 0; i < iNviews; ++i)
+  {
+    EXPECT_MATRIX_NEAR(vec_globalR_dense[i], vec_globalR_sparse[i], 1e-6);
+  }
+}
+
+TEST ( rotation_averaging, RotationLeastSquare_SparseSameAsDense_LargeRing)
+{
+  //-- Setup a circular camera rig larger than the dense solver limit (200 cameras)
+  const int iNviews = 250;
+  const NViewDataSet d = NRealisticCamerasRing(iNviews, 5,
+    nViewDatasetConfigurator(1,1,0,0,5,0)); // Suppose a camera with Unit matrix as K
+
+  // Link each camera to the three next ones with noisy relative rotations
+  std::mt19937 random_generator(0);
+  std::normal_distribution<double> noise(0.0, 0.01);
+  RelativeRotations vec_relativeRotEstimate;
+  for (size_t i = 0; i < iNviews; ++i)
+  {
+    for (size_t k = 1; k <= 3; ++k)
+    {
+      const size_t j = (i + k) % iNviews;
+      Mat3 Rrel;
+      Vec3 trel;
+      RelativeCameraMotion(d._R[i], d._t[i], d._R[j], d._t[j], &Rrel, &trel);
+      const Vec3 perturbation(noise(random_generator), noise(random_generator), noise(random_generator));
+      Rrel = Rrel * Eigen::AngleAxisd(perturbation.norm(), perturbation.normalized()).toRotationMatrix();
+      vec_relativeRotEstimate.emplace_back(i, j, Rrel, 1.0);
+    }
+  }
+
+  // The sparse solver converges and AUTO (that selects it) gives the same rotations
+  std::vector<Mat3> vec_globalR_dense, vec_globalR_sparse, vec_globalR_auto;
+  EXPECT_TRUE(L2RotationAveraging(iNviews, vec_relativeRotEstimate, vec_globalR_dense, L2EigenSolver::DENSE));
+  EXPECT_TRUE(L2RotationAveraging(iNviews, vec_relativeRotEstimate, vec_globalR_sparse, L2EigenSolver::SPARSE));
+  EXPECT_TRUE(L2RotationAveraging(iNviews, vec_relativeRotEstimate, vec_globalR_auto));
+  CHECK_EQUAL(iNviews, vec_globalR_sparse.size());
+  CHECK_EQUAL(iNviews, vec_globalR_auto.size());
+  for (size_t i = 0; i < iNviews; ++i)
+  {
+    EXPECT_MATRIX_NEAR(vec_globalR_dense[i], vec_globalR_sparse[i], 1e-6);
+    EXPECT_MATRIX_NEAR(vec_globalR_sparse[i], vec_globalR_auto[i], 1e-12);
+  }
+}
+
 TEST ( rotation_averaging, RefineRotationsAvgL1IRLS_SimpleTriplet)
 {
   using namespace std;
@@ -28,6 +28,8 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "openMVG/multiview/solver_fundamental_kernel.hpp"
+
+#include <algorithm>
 #include "openMVG/numeric/numeric.h"
 #include "openMVG/numeric/poly.h"
 
@@ -190,6 +192,88 @@ double EpipolarDistanceError::Error
   return Square(F_x.dot(y.homogeneous())) /  F_x.head<2>().squaredNorm();
 }
 
+// Batched error evaluation:
+// The columns are processed by blocks so the epipolar lines of a block stay in
+//  cache, and the per column scalar products are written as Eigen array
+//  expressions the compiler can vectorize.
+
+namespace {
+
+/// Number of correspondences evaluated at once
+const Mat::Index kErrorBlockSize = 256;
+
+using RowArray = Eigen::Array<double, 1, Eigen::Dynamic>;
+
+/// Epipolar lines F.x of a block of points
+inline Mat3X EpipolarLines(const Mat3 &F, const Eigen::Ref<const Mat> &x, Mat::Index col, Mat::Index size)
+{
+  return (F.leftCols<2>() * x.middleCols(col, size)).colwise() + F.col(2);
+}
+
+/// Algebraic epipolar residual y^T.F.x of a block of points
+inline RowArray AlgebraicResiduals(const Mat3X &F_x, const Eigen::Ref<const Mat> &y, Mat::Index col, Mat::Index size)
+{
+  return (F_x.topRows<2>().array() * y.middleCols(col, size).array()).colwise().sum()
+    + F_x.row(2).array();
+}
+
+} // namespace
+
+void SampsonError::Errors
+(
+  const Mat3 &F, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors
+)
+{
+  errors.resize(x.cols());
+  const Mat3 Ft = F.transpose();
+  for (Mat::Index col = 0; col < x.cols(); col += kErrorBlockSize)
+  {
+    const Mat::Index size = std::min(kErrorBlockSize, x.cols() - col);
+    const Mat3X F_x = EpipolarLines(F, x, col, size);
+    const Mat3X Ft_y = EpipolarLines(Ft, y, col, size);
+    Eigen::Map<RowArray>(&errors[col], size) =
+      AlgebraicResiduals(F_x, y, col, size).square()
+      / (F_x.topRows<2>().colwise().squaredNorm()
+        + Ft_y.topRows<2>().colwise().squaredNorm()).array();
+  }
+}
+
+void SymmetricEpipolarDistanceError::Errors
+(
+  const Mat3 &F, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors
+)
+{
+  errors.resize(x.cols());
+  const Mat3 Ft = F.transpose();
+  for (Mat::Index col = 0; col < x.cols(); col += kErrorBlockSize)
+  {
+    const Mat::Index size = std::min(kErrorBlockSize, x.cols() - col);
+    const Mat3X F_x = EpipolarLines(F, x, col, size);
+    const Mat3X Ft_y = EpipolarLines(Ft, y, col, size);
+    Eigen::Map<RowArray>(&errors[col], size) =
+      AlgebraicResiduals(F_x, y, col, size).square()
+      * (F_x.topRows<2>().colwise().squaredNorm().array().inverse()
+        + Ft_y.topRows<2>().colwise().squaredNorm().array().inverse())
+      / 4.0;
+  }
+}
+
+void EpipolarDistanceError::Errors
+(
+  const Mat3 &F, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors
+)
+{
+  errors.resize(x.cols());
+  for (Mat::Index col = 0; col < x.cols(); col += kErrorBlockSize)
+  {
+    const Mat::Index size = std::min(kErrorBlockSize, x.cols() - col);
+    const Mat3X F_x = EpipolarLines(F, x, col, size);
+    Eigen::Map<RowArray>(&errors[col], size) =
+      AlgebraicResiduals(F_x, y, col, size).square()
+      / F_x.topRows<2>().colwise().squaredNorm().array();
+  }
+}
+
 }  // namespace kernel
 }  // namespace fundamental
 }  // namespace openMVG
@@ -95,14 +95,20 @@ inline void EncodeEpipolarEquation(const TMatX &x1, const TMatX &x2, TMatA *A) {
 /// Compute SampsonError related to the Fundamental matrix and 2 correspondences
 struct SampsonError {
   static double Error(const Mat3 &F, const Vec2 &x, const Vec2 &y);
+  /// Batched evaluation of the error for every column pair (x.col(i), y.col(i))
+  static void Errors(const Mat3 &F, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors);
 };
 
 struct SymmetricEpipolarDistanceError {
   static double Error(const Mat3 &F, const Vec2 &x, const Vec2 &y);
+  /// Batched evaluation of the error for every column pair (x.col(i), y.col(i))
+  static void Errors(const Mat3 &F, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors);
 };
 
 struct EpipolarDistanceError {
   static double Error(const Mat3 &F, const Vec2 &x, const Vec2 &y);
+  /// Batched evaluation of the error for every column pair (x.col(i), y.col(i))
+  static void Errors(const Mat3 &F, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors);
 };
 
 //-- Kernel solver for the 8pt Fundamental Matrix Estimation
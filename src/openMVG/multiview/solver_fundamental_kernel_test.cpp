@@ -141,6 +141,30 @@ TEST(EightPointTest_Normalized, EasyCase) {
   EXPECT_TRUE(ExpectKernelProperties<Kernel>(x1, x2));
 }
 
+TEST(FundamentalErrors, BatchedMatchesPerSample) {
+  // Enough samples to span several evaluation blocks
+  const int n = 1000;
+  const Mat x1 = Mat::Random(2, n) * 100.0;
+  const Mat x2 = Mat::Random(2, n) * 100.0;
+  const Mat3 F = Mat3::Random();
+
+  std::vector<double> sampson, symmetric, epipolar;
+  fundamental::kernel::SampsonError::Errors(F, x1, x2, sampson);
+  fundamental::kernel::SymmetricEpipolarDistanceError::Errors(F, x1, x2, symmetric);
+  fundamental::kernel::EpipolarDistanceError::Errors(F, x1, x2, epipolar);
+  CHECK_EQUAL(n, sampson.size());
+  CHECK_EQUAL(n, symmetric.size());
+  CHECK_EQUAL(n, epipolar.size());
+  for (int i = 0; i < n; ++i) {
+    const double e0 = fundamental::kernel::SampsonError::Error(F, x1.col(i), x2.col(i));
+    const double e1 = fundamental::kernel::SymmetricEpipolarDistanceError::Error(F, x1.col(i), x2.col(i));
+    const double e2 = fundamental::kernel::EpipolarDistanceError::Error(F, x1.col(i), x2.col(i));
+    EXPECT_NEAR(e0, sampson[i], 1e-8 * std::max(1.0, e0));
+    EXPECT_NEAR(e1, symmetric[i], 1e-8 * std::max(1.0, e1));
+    EXPECT_NEAR(e2, epipolar[i], 1e-8 * std::max(1.0, e2));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
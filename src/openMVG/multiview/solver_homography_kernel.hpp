@@ -60,6 +60,18 @@ struct AsymmetricError {
   static double Error(const Mat &H, const Vec2 &x, const Vec2 &y) {
     return (y - Vec3( H * x.homogeneous()).hnormalized() ).squaredNorm();
   }
+  /// Batched evaluation of the error for every column pair (x.col(i), y.col(i))
+  static void Errors(const Mat3 &H, const Eigen::Ref<const Mat> &x, const Eigen::Ref<const Mat> &y, std::vector<double> &errors) {
+    errors.resize(x.cols());
+    const Mat::Index block_size = 256;
+    for (Mat::Index col = 0; col < x.cols(); col += block_size) {
+      const Mat::Index size = std::min(block_size, x.cols() - col);
+      const Mat3X Hx = (H.leftCols<2>() * x.middleCols(col, size)).colwise() + H.col(2);
+      Eigen::Map<Eigen::Array<double, 1, Eigen::Dynamic>>(&errors[col], size) =
+        (y.middleCols(col, size).array()
+         - Hx.topRows<2>().array().rowwise() / Hx.row(2).array()).matrix().colwise().squaredNorm().array();
+    }
+  }
 };
 
 // Kernel that works on original data point
@@ -114,6 +114,23 @@ TEST(HomographyKernelTest, Fitting_Normalized) {
   }
 }
 
+TEST(HomographyKernelTest, AsymmetricError_Batched) {
+  const int n = 600;
+  const Mat x = Mat::Random(2, n) * 10.0;
+  const Mat y = Mat::Random(2, n) * 10.0;
+  Mat3 H;
+  H << 1.2, 0.1, 3.0,
+       -0.2, 0.9, -1.0,
+       0.01, 0.02, 1.0;
+  std::vector<double> errors;
+  homography::kernel::AsymmetricError::Errors(H, x, y, errors);
+  CHECK_EQUAL(n, errors.size());
+  for (int i = 0; i < n; ++i) {
+    const double e = homography::kernel::AsymmetricError::Error(H, x.col(i), y.col(i));
+    EXPECT_NEAR(e, errors[i], 1e-8 * std::max(1.0, e));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -9,6 +9,11 @@
 #ifndef OPENMVG_MULTIVIEW_RESECTION_METRICS_HPP
 #define OPENMVG_MULTIVIEW_RESECTION_METRICS_HPP
 
+#include <algorithm>
+#include <vector>
+
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+
 namespace openMVG {
 namespace resection {
 
@@ -36,6 +41,26 @@ struct SquaredPixelReprojectionError {
   {
     return (x - (P * X.homogeneous()).hnormalized()).squaredNorm();
   }
+  /// Batched evaluation of the error for every column pair (x.col(i), X.col(i))
+  static inline void Errors
+  (
+    const Mat34 & P,
+    const Eigen::Ref<const Mat> & x,
+    const Eigen::Ref<const Mat> & X,
+    std::vector<double> & errors
+  )
+  {
+    errors.resize(x.cols());
+    const Mat::Index block_size = 256;
+    for (Mat::Index col = 0; col < x.cols(); col += block_size)
+    {
+      const Mat::Index size = std::min(block_size, x.cols() - col);
+      const Mat3X PX = (P.leftCols<3>() * X.middleCols(col, size)).colwise() + P.col(3);
+      Eigen::Map<Eigen::Array<double, 1, Eigen::Dynamic>>(&errors[col], size) =
+        (x.middleCols(col, size).array()
+         - PX.topRows<2>().array().rowwise() / PX.row(2).array()).matrix().colwise().squaredNorm().array();
+    }
+  }
 };
 
 struct AngularReprojectionError {
@@ -66,6 +66,36 @@ solve_translations_problem_softl1
   const double d_l1_loss_threshold = 0.01
 );
 
+/**
+* @brief Registration of relative translations to global translations. It solves the LInf
+*  problem of [2] (the same as the linear program of lInfinityCV::Tifromtij_ConstraintBuilder:
+*  first translation at origin, one scale >= 1 per group, minimization of the max residual)
+*  with a sparse ADMM solver. The normal equations are factorized once and reused
+*  at every iteration, so it scales to large pose graphs.
+*  Poses must be indexed in [0, #poses[ and all relative motions must be 1 connected component.
+*
+* @param[in] vec_initial_estimates group of relative motion information
+*             Each group will have its own optimized scale
+* @param[out] translations found global camera translations
+* @param[out] gamma optional, the found LInf residual
+* @param[out] converged optional, false if the ADMM iterations were stopped by
+*  max_iterations before reaching the tolerance (the translations are then
+*  an approximate solution)
+* @param[in] max_iterations maximal number of ADMM iterations
+* @param[in] tolerance relative tolerance of the primal & dual residuals
+* @return True if the registration can be solved
+*/
+bool
+solve_translations_problem_linfinity_admm
+(
+  const std::vector<openMVG::RelativeInfo_Vec > & vec_initial_estimates,
+  std::vector<Eigen::Vector3d> & translations,
+  double * gamma = nullptr,
+  bool * converged = nullptr,
+  const int max_iterations = 20000,
+  const double tolerance = 1e-6
+);
+
 } // namespace openMVG
 
 #endif // OPENMVG_MULTIVIEW_TRANSLATION_AVERAGING_SOLVER_HPP
@@ -0,0 +1,285 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/multiview/translation_averaging_common.hpp"
+#include "openMVG/multiview/translation_averaging_solver.hpp"
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+#include "openMVG/types.hpp"
+
+#include <Eigen/Sparse>
+#ifdef EIGEN_MPL2_ONLY
+#include <Eigen/SparseLU>
+#else
+#include <Eigen/SparseCholesky>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace openMVG {
+
+namespace {
+
+// Proximal operator of the L-Infinity norm: argmin_z (kappa * ||z||_inf + 1/2 ||z - y||^2)
+// By the Moreau decomposition it is y minus the projection of y onto the
+// L1 ball of radius kappa, i.e. y clamped to [-theta, theta].
+void ProxLInfinity
+(
+  const Eigen::VectorXd & y,
+  const double kappa,
+  Eigen::VectorXd & z,
+  std::vector<double> & buffer
+)
+{
+  const double l1_norm = y.lpNorm<1>();
+  if (l1_norm <= kappa)
+  {
+    z.setZero(y.size());
+    return;
+  }
+  // Find the threshold theta such that sum(max(|y_i| - theta, 0)) = kappa
+  buffer.resize(y.size());
+  Eigen::Map<Eigen::VectorXd>(buffer.data(), y.size()) = y.cwiseAbs();
+  std::sort(buffer.begin(), buffer.end(), std::greater<double>());
+  double cumulative_sum = 0.0, theta = 0.0;
+  for (size_t k = 0; k < buffer.size(); ++k)
+  {
+    cumulative_sum += buffer[k];
+    const double candidate = (cumulative_sum - kappa) / (k + 1);
+    if (buffer[k] <= candidate)
+      break;
+    theta = candidate;
+  }
+  z = y.cwiseMax(-theta).cwiseMin(theta);
+}
+
+} // namespace
+
+bool
+solve_translations_problem_linfinity_admm
+(
+  const std::vector<openMVG::RelativeInfo_Vec > & vec_relative_group_estimates,
+  std::vector<Eigen::Vector3d> & translations,
+  double * gamma,
+  bool * converged,
+  const int max_iterations,
+  const double tolerance
+)
+{
+  //-- Count:
+  //- #poses are used by the relative position estimates
+  //- #relative estimates we will use
+  std::set<IndexT> count_set;
+  IndexT relative_info_count = 0;
+  for (const openMVG::RelativeInfo_Vec & iter : vec_relative_group_estimates)
+  {
+    for (const relativeInfo & it_relative_motion : iter)
+    {
+      ++relative_info_count;
+      count_set.insert(it_relative_motion.first.first);
+      count_set.insert(it_relative_motion.first.second);
+    }
+  }
+  const IndexT nb_poses = count_set.size();
+  const IndexT nb_scales = vec_relative_group_estimates.size();
+  if (nb_poses < 2 || relative_info_count == 0)
+    return false;
+
+  //--
+  // Unknowns: x = [T_1, ..., T_{N-1}, lambda_0, ..., lambda_{G-1}]
+  //  T_0 is fixed to the origin (gauge freedom), so it is not a variable.
+  //
+  // The linear program of lInfinityCV::EncodeTi_from_tij:
+  //   min gamma
+  //   s.t. | T_j - R_ij T_i - lambda_g t_ij |_inf <= gamma,  lambda_g >= 1
+  // is written as:  min ||M x||_inf + indicator(E x >= 1)
+  //  with M the stacked residual rows and E the selector of the lambdas.
+  // It is solved by ADMM with the splitting z = M x, w = E x. The x-update
+  //  solves with the fixed matrix (M'M + E'E), that is factorized once, since
+  //  rho cancels in this normal equation it can be adapted freely.
+  //--
+  const Eigen::Index nb_translation_var = 3 * (nb_poses - 1);
+  const Eigen::Index nb_var = nb_translation_var + nb_scales;
+  const Eigen::Index nb_rows = 3 * relative_info_count;
+
+  const auto translation_var = [](IndexT i, int axis) -> Eigen::Index
+  {
+    return 3 * (static_cast<Eigen::Index>(i) - 1) + axis;
+  };
+
+  using SpMat = Eigen::SparseMatrix<double>;
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(nb_rows * 5);
+  {
+    Eigen::Index row = 0;
+    IndexT group_id = 0;
+    for (const openMVG::RelativeInfo_Vec & iter : vec_relative_group_estimates)
+    {
+      for (const relativeInfo & rel : iter)
+      {
+        const IndexT i = rel.first.first;
+        const IndexT j = rel.first.second;
+        const Mat3 & Rij = rel.second.first;
+        const Vec3 & tij = rel.second.second;
+        if (std::max(i, j) >= nb_poses)
+        {
+          std::cerr << "Translation averaging: pose indexes must be in [0, #poses[" << std::endl;
+          return false;
+        }
+        // T_j - R_ij T_i - Lambda_ij t_ij, for X, Y, Z axis
+        for (int l = 0; l < 3; ++l, ++row)
+        {
+          if (j != 0)
+            triplets.emplace_back(row, translation_var(j, l), 1.0);
+          if (i != 0)
+            for (int c = 0; c < 3; ++c)
+              triplets.emplace_back(row, translation_var(i, c), -Rij(l, c));
+          triplets.emplace_back(row, nb_translation_var + group_id, -tij(l));
+        }
+      }
+      ++group_id;
+    }
+  }
+  SpMat M(nb_rows, nb_var);
+  M.setFromTriplets(triplets.begin(), triplets.end());
+  const SpMat Mt = M.transpose();
+
+  // Normal matrix M'M + E'E (E'E is the identity over the lambda block)
+  SpMat normal_matrix = Mt * M;
+  for (IndexT g = 0; g < nb_scales; ++g)
+    normal_matrix.coeffRef(nb_translation_var + g, nb_translation_var + g) += 1.0;
+  normal_matrix.makeCompressed();
+
+#ifdef EIGEN_MPL2_ONLY
+  Eigen::SparseLU<SpMat> linear_solver;
+#else
+  Eigen::SimplicialLDLT<SpMat> linear_solver;
+#endif
+  linear_solver.compute(normal_matrix);
+  if (linear_solver.info() != Eigen::Success)
+  {
+    std::cerr << "Translation averaging: cannot factorize the normal equations"
+      << " (is the relative motion graph connected?)" << std::endl;
+    return false;
+  }
+
+  const auto solve_x = [&](const Eigen::VectorXd & z, const Eigen::VectorXd & w)
+  {
+    Eigen::VectorXd rhs = Mt * z;
+    rhs.tail(nb_scales) += w;
+    return Eigen::VectorXd(linear_solver.solve(rhs));
+  };
+
+  // Initialization: least square solution of M x = 0, lambda = 1
+  Eigen::VectorXd w = Eigen::VectorXd::Ones(nb_scales);
+  Eigen::VectorXd x = solve_x(Eigen::VectorXd::Zero(nb_rows), w);
+  Eigen::VectorXd Mx = M * x;
+  Eigen::VectorXd z = Mx, z_old(nb_rows), w_old(nb_scales);
+  Eigen::VectorXd u = Eigen::VectorXd::Zero(nb_rows), v = Eigen::VectorXd::Zero(nb_scales);
+  Eigen::VectorXd Ex(nb_scales), y(nb_rows), dual(nb_var);
+  std::vector<double> buffer;
+
+  // Since the L-Infinity subgradients have a unit L1 norm, the duals scale as 1/#rows
+  double rho = 1.0 / std::max(Mx.cwiseAbs().maxCoeff(), 1e-12) / nb_rows;
+  const double absolute_tolerance = tolerance * 1e-2;
+  const double primal_abs_eps = std::sqrt(double(nb_rows + nb_scales)) * absolute_tolerance;
+  const double dual_abs_eps = std::sqrt(double(nb_var)) * absolute_tolerance;
+
+  bool has_converged = false;
+  int iteration = 0;
+  for (; iteration < max_iterations && !has_converged; ++iteration)
+  {
+    // Update x (solve with the cached factorization)
+    z_old = z - u;
+    w_old = w - v;
+    x = solve_x(z_old, w_old);
+    Mx.noalias() = M * x;
+    Ex = x.tail(nb_scales);
+
+    // Update z (prox of the L-Infinity norm) and w (projection on lambda >= 1)
+    z_old = z;
+    w_old = w;
+    y = Mx + u;
+    ProxLInfinity(y, 1.0 / rho, z, buffer);
+    w = (Ex + v).cwiseMax(1.0);
+
+    // Update the scaled dual variables
+    u += Mx - z;
+    v += Ex - w;
+
+    // Convergence terms (primal and dual residuals)
+    const double r_norm =
+      std::sqrt((Mx - z).squaredNorm() + (Ex - w).squaredNorm());
+    dual.noalias() = Mt * (z - z_old);
+    dual.tail(nb_scales) += w - w_old;
+    const double s_norm = rho * dual.norm();
+
+    const double primal_eps = primal_abs_eps + tolerance *
+      std::max(std::sqrt(Mx.squaredNorm() + Ex.squaredNorm()),
+               std::sqrt(z.squaredNorm() + w.squaredNorm()));
+    dual.noalias() = Mt * u;
+    dual.tail(nb_scales) += v;
+    const double dual_eps = dual_abs_eps + tolerance * rho * dual.norm();
+
+    has_converged = (r_norm < primal_eps && s_norm < dual_eps);
+
+    // Residual balancing: keep the primal and dual residuals of the same order
+    //  (the factorization does not depend on rho, so it is kept as is).
+    // Rho is adapted periodically and frozen later on to ensure convergence.
+    if (iteration % 10 != 0 || iteration > max_iterations / 2)
+      continue;
+    if (r_norm > 10.0 * s_norm)
+    {
+      rho *= 2.0;
+      u *= 0.5;
+      v *= 0.5;
+    }
+    else if (s_norm > 10.0 * r_norm)
+    {
+      rho *= 0.5;
+      u *= 2.0;
+      v *= 2.0;
+    }
+  }
+
+  // Make the solution feasible (lambda >= 1): the problem is positively
+  //  homogeneous so a uniform rescaling keeps the same solution shape.
+  const double min_lambda = x.tail(nb_scales).minCoeff();
+  if (!std::isfinite(min_lambda) || min_lambda <= 0.0)
+  {
+    std::cerr << "Translation averaging: ADMM solver failed" << std::endl;
+    return false;
+  }
+  if (min_lambda < 1.0)
+    x /= min_lambda;
+
+  if (!has_converged)
+  {
+    std::cerr << "Translation averaging: ADMM solver reached the maximum number of iterations ("
+      << max_iterations << ")" << std::endl;
+  }
+  if (converged)
+    *converged = has_converged;
+  if (gamma)
+    *gamma = (M * x).cwiseAbs().maxCoeff();
+
+  // Fill the global translations array
+  translations.resize(nb_poses);
+  translations[0].setZero();
+  for (IndexT i = 1; i < nb_poses; ++i)
+  {
+    translations[i] = x.segment<3>(translation_var(i, 0));
+  }
+  return true;
+}
+
+} // namespace openMVG
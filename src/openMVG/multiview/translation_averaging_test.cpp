@@ -205,6 +205,151 @@ TEST(translation_averaging, globalTi_from_tijs_l2_chordal) {
   }
 }
 
+TEST(translation_averaging, globalTi_from_tijs_Triplets_linfinity_ADMM) {
+
+  const int focal = 1000;
+  const int principal_Point = 500;
+  //-- Setup a circular camera rig or "cardioid".
+  const int iNviews = 12;
+  const int iNbPoints = 6;
+
+  const bool bCardiod = true;
+  const bool bRelative_Translation_PerTriplet = true;
+  std::vector<RelativeInfo_Vec > vec_relative_estimates;
+
+  const NViewDataSet d =
+    Setup_RelativeTranslations_AndNviewDataset
+    (
+      vec_relative_estimates,
+      focal, principal_Point, iNviews, iNbPoints,
+      bCardiod, bRelative_Translation_PerTriplet
+    );
+
+  // Solve the translation averaging problem:
+  std::vector<Vec3> vec_translations;
+  double gamma = -1.0;
+  EXPECT_TRUE(solve_translations_problem_linfinity_admm(
+    vec_relative_estimates, vec_translations, &gamma));
+
+  EXPECT_EQ(iNviews, vec_translations.size());
+  // Perfect data: the LInf residual is null
+  EXPECT_NEAR(0.0, gamma, 1e-6);
+
+  // Check accuracy of the found translations
+  for (unsigned i = 0; i < iNviews; ++i)
+  {
+    const Vec3 t = vec_translations[i];
+    const Mat3 & Ri = d._R[i];
+    const Vec3 C_computed = - Ri.transpose() * t;
+
+    const Vec3 C_GT = d._C[i] - d._C[0];
+
+    //-- Check that found camera position is equal to GT value
+    if (i==0)  {
+      EXPECT_MATRIX_NEAR(C_computed, C_GT, 1e-6);
+    }
+    else  {
+     EXPECT_NEAR(0.0, DistanceLInfinity(C_computed.normalized(), C_GT.normalized()), 1e-6);
+    }
+  }
+}
+
+TEST(translation_averaging, globalTi_from_tijs_linfinity_ADMM) {
+
+  const int focal = 1000;
+  const int principal_Point = 500;
+  //-- Setup a circular camera rig or "cardiod".
+  const int iNviews = 12;
+  const int iNbPoints = 6;
+
+  const bool bCardiod = true;
+  const bool bRelative_Translation_PerTriplet = false;
+  std::vector<RelativeInfo_Vec > vec_relative_estimates;
+
+  const NViewDataSet d =
+    Setup_RelativeTranslations_AndNviewDataset
+    (
+      vec_relative_estimates,
+      focal, principal_Point, iNviews, iNbPoints,
+      bCardiod, bRelative_Translation_PerTriplet
+    );
+
+  // Perturb the relative translation directions
+  for (RelativeInfo_Vec & iter : vec_relative_estimates)
+  {
+    for (relativeInfo & rel : iter)
+    {
+      rel.second.second = (rel.second.second + Vec3::Random() * 0.01).normalized();
+    }
+  }
+
+  // Solve the translation averaging problem:
+  std::vector<Vec3> vec_translations;
+  double gamma = -1.0;
+  EXPECT_TRUE(solve_translations_problem_linfinity_admm(
+    vec_relative_estimates, vec_translations, &gamma));
+
+  EXPECT_EQ(iNviews, vec_translations.size());
+  EXPECT_MATRIX_NEAR(vec_translations[0], Vec3::Zero(), 1e-8);
+
+  // The residual of the noisy measurements cannot be null
+  EXPECT_TRUE(gamma > 0.0);
+
+  // Check that the camera positions are close to the GT ones
+  const double scale =
+    (-d._R[1].transpose() * vec_translations[1]).norm() / (d._C[1] - d._C[0]).norm();
+  for (unsigned i = 1; i < iNviews; ++i)
+  {
+    const Vec3 C_computed = - d._R[i].transpose() * vec_translations[i] / scale;
+    const Vec3 C_GT = d._C[i] - d._C[0];
+    EXPECT_NEAR(0.0, DistanceLInfinity(C_computed, C_GT), 0.1 * C_GT.norm());
+  }
+}
+
+TEST(translation_averaging, globalTi_from_tijs_linfinity_ADMM_MaxIterations) {
+
+  const int focal = 1000;
+  const int principal_Point = 500;
+  //-- Setup a circular camera rig or "cardiod".
+  const int iNviews = 12;
+  const int iNbPoints = 6;
+
+  const bool bCardiod = true;
+  const bool bRelative_Translation_PerTriplet = false;
+  std::vector<RelativeInfo_Vec > vec_relative_estimates;
+
+  Setup_RelativeTranslations_AndNviewDataset
+  (
+    vec_relative_estimates,
+    focal, principal_Point, iNviews, iNbPoints,
+    bCardiod, bRelative_Translation_PerTriplet
+  );
+
+  // Perturb the relative translation directions
+  for (RelativeInfo_Vec & iter : vec_relative_estimates)
+  {
+    for (relativeInfo & rel : iter)
+    {
+      rel.second.second = (rel.second.second + Vec3::Random() * 0.01).normalized();
+    }
+  }
+
+  // The iteration cap is reached: an approximate solution is returned
+  std::vector<Vec3> vec_translations;
+  double gamma = -1.0;
+  bool converged = true;
+  EXPECT_TRUE(solve_translations_problem_linfinity_admm(
+    vec_relative_estimates, vec_translations, &gamma, &converged, 5));
+  EXPECT_FALSE(converged);
+  EXPECT_EQ(iNviews, vec_translations.size());
+  EXPECT_TRUE(gamma > 0.0);
+
+  // The solver converges with enough iterations
+  EXPECT_TRUE(solve_translations_problem_linfinity_admm(
+    vec_relative_estimates, vec_translations, &gamma, &converged, 200000));
+  EXPECT_TRUE(converged);
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
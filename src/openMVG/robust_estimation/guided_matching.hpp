@@ -10,7 +10,9 @@
 #define OPENMVG_ROBUST_ESTIMATION_GUIDED_MATCHING_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 #include "openMVG/cameras/Camera_Intrinsics.hpp"
@@ -19,8 +21,314 @@
 #include "openMVG/numeric/numeric.h"
 
 namespace openMVG{
+namespace fundamental { namespace kernel {
+  struct EpipolarDistanceError;
+  struct SymmetricEpipolarDistanceError;
+}}
+namespace homography { namespace kernel {
+  struct AsymmetricError;
+}}
+
 namespace geometry_aware{
 
+/// Uniform grid over a 2D point set used to restrict guided matching to the
+///  candidates that lie close to an epipolar line or a transferred point.
+/// Point indexes are stored cell by cell in a single array (compressed row
+///  storage), so a query only reads the cells covered by its search area.
+/// Queries are conservative: every point inside the area is reported, but
+///  some points close to it may be reported too.
+class PointGrid
+{
+public:
+  /// Build the grid. The cell size is chosen so that a cell holds a few
+  ///  points on average, but is never smaller than min_cell_size.
+  PointGrid
+  (
+    const std::vector<Vec2> & points,
+    double min_cell_size
+  ):
+    cell_size_(1.0), cols_(0), rows_(0)
+  {
+    if (points.empty())
+      return;
+
+    Vec2 min_pt = points.front(), max_pt = points.front();
+    for (const Vec2 & pt : points)
+    {
+      min_pt = min_pt.cwiseMin(pt);
+      max_pt = max_pt.cwiseMax(pt);
+    }
+    if (!min_pt.allFinite() || !max_pt.allFinite())
+      return;
+
+    const Vec2 extent = (max_pt - min_pt).cwiseMax(Vec2::Ones());
+    // ~4 points per cell for a uniform distribution
+    const double density_cell_size =
+      std::sqrt(4.0 * extent(0) * extent(1) / points.size());
+    cell_size_ = std::max({density_cell_size, min_cell_size, 1e-6});
+    origin_ = min_pt;
+    cols_ = static_cast<int>(extent(0) / cell_size_) + 1;
+    rows_ = static_cast<int>(extent(1) / cell_size_) + 1;
+
+    // Counting sort of the points by cell
+    std::vector<int> point_cells(points.size());
+    cell_offsets_.assign(cols_ * rows_ + 1, 0);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      point_cells[i] = cell_index(points[i]);
+      ++cell_offsets_[point_cells[i] + 1];
+    }
+    for (size_t c = 1; c < cell_offsets_.size(); ++c)
+      cell_offsets_[c] += cell_offsets_[c - 1];
+    indexes_.resize(points.size());
+    std::vector<uint32_t> cursor(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    for (size_t i = 0; i < points.size(); ++i)
+      indexes_[cursor[point_cells[i]]++] = static_cast<uint32_t>(i);
+  }
+
+  /// Report the points that may lie at a distance below radius of center
+  template <typename Functor>
+  void ForEachInDisk
+  (
+    const Vec2 & center,
+    double radius,
+    Functor && functor
+  ) const
+  {
+    int col_min, col_max, row_min, row_max;
+    if (indexes_.empty()
+        || !cell_range(center(0) - radius, center(0) + radius, 0, col_min, col_max)
+        || !cell_range(center(1) - radius, center(1) + radius, 1, row_min, row_max))
+      return;
+    for (int row = row_min; row <= row_max; ++row)
+      visit_cells(row, col_min, col_max, functor);
+  }
+
+  /// Report the points that may lie at a distance below half_width of the
+  ///  line a*x + b*y + c = 0 (the line does not need to be normalized)
+  template <typename Functor>
+  void ForEachInBand
+  (
+    const Vec3 & line,
+    double half_width,
+    Functor && functor
+  ) const
+  {
+    const double norm = line.head<2>().norm();
+    if (indexes_.empty() || !(norm > 0.0) || !line.allFinite())
+      return;
+    const Vec3 l = line / norm;
+    // Walk along the grid axis that is the most parallel to the line and
+    //  report, for each column (or row), the cell span covered by the band
+    const int walk_axis = (std::abs(l(1)) >= std::abs(l(0))) ? 0 : 1;
+    const int span_axis = 1 - walk_axis;
+    const int nb_steps = (walk_axis == 0) ? cols_ : rows_;
+    // Thickness of the band measured along the span axis
+    const double span_half_width = half_width / std::abs(l(span_axis));
+    for (int step = 0; step < nb_steps; ++step)
+    {
+      const double w0 = origin_(walk_axis) + step * cell_size_;
+      const double w1 = w0 + cell_size_;
+      // Span coordinate of the line at both ends of the cell column (or row)
+      const double s0 = -(l(walk_axis) * w0 + l(2)) / l(span_axis);
+      const double s1 = -(l(walk_axis) * w1 + l(2)) / l(span_axis);
+      int first, last;
+      if (!cell_range(std::min(s0, s1) - span_half_width,
+                      std::max(s0, s1) + span_half_width,
+                      span_axis, first, last))
+        continue;
+      if (walk_axis == 0)
+        for (int row = first; row <= last; ++row)
+          visit_cells(row, step, step, functor);
+      else
+        visit_cells(step, first, last, functor);
+    }
+  }
+
+private:
+  int cell_index(const Vec2 & pt) const
+  {
+    const int col = std::min(cols_ - 1, static_cast<int>((pt(0) - origin_(0)) / cell_size_));
+    const int row = std::min(rows_ - 1, static_cast<int>((pt(1) - origin_(1)) / cell_size_));
+    return row * cols_ + col;
+  }
+
+  // Range of cells overlapped by the [lo, hi] interval along the given axis.
+  // Return false if the interval does not overlap the grid.
+  bool cell_range(double lo, double hi, int axis, int & first, int & last) const
+  {
+    const int count = (axis == 0) ? cols_ : rows_;
+    const double first_cell = std::floor((lo - origin_(axis)) / cell_size_);
+    const double last_cell = std::floor((hi - origin_(axis)) / cell_size_);
+    // written to be false on NaN
+    if (!(last_cell >= 0.0 && first_cell < count))
+      return false;
+    first = (first_cell < 0.0) ? 0 : static_cast<int>(first_cell);
+    last = (last_cell >= count) ? count - 1 : static_cast<int>(last_cell);
+    return true;
+  }
+
+  // Visit the cells [col_min, col_max] of a grid row (contiguous in memory)
+  template <typename Functor>
+  void visit_cells(int row, int col_min, int col_max, Functor && functor) const
+  {
+    const int first_cell = row * cols_ + col_min, last_cell = row * cols_ + col_max;
+    for (uint32_t k = cell_offsets_[first_cell]; k < cell_offsets_[last_cell + 1]; ++k)
+      functor(indexes_[k]);
+  }
+
+  Vec2 origin_;
+  double cell_size_;
+  int cols_, rows_;
+  std::vector<uint32_t> cell_offsets_; // size: cols_ * rows_ + 1
+  std::vector<uint32_t> indexes_;      // point indexes sorted by cell
+};
+
+/// Search area of the right image candidates of a left point for a given
+///  model and error metric. The default is an exhaustive search; metrics that
+///  bound the position of the right point provide a spatial query.
+template <typename ErrorArg>
+struct GuidedMatchingSearchArea
+{
+  static constexpr bool available = false;
+};
+
+/// Squared distance to the epipolar line F*x: band of half width sqrt(th)
+template <>
+struct GuidedMatchingSearchArea<fundamental::kernel::EpipolarDistanceError>
+{
+  static constexpr bool available = true;
+  static double Radius(double errorTh) { return std::sqrt(errorTh); }
+  template <typename ModelArg, typename Functor>
+  static void Query
+  (
+    const PointGrid & grid, const ModelArg & F, const Vec2 & x,
+    double errorTh, Functor && functor
+  )
+  {
+    grid.ForEachInBand(Vec3(F * x.homogeneous()), Radius(errorTh), functor);
+  }
+};
+
+/// Mean of the two squared epipolar distances divided by 2:
+///  the distance to the epipolar line F*x is bounded by 2*sqrt(th)
+template <>
+struct GuidedMatchingSearchArea<fundamental::kernel::SymmetricEpipolarDistanceError>
+{
+  static constexpr bool available = true;
+  static double Radius(double errorTh) { return 2.0 * std::sqrt(errorTh); }
+  template <typename ModelArg, typename Functor>
+  static void Query
+  (
+    const PointGrid & grid, const ModelArg & F, const Vec2 & x,
+    double errorTh, Functor && functor
+  )
+  {
+    grid.ForEachInBand(Vec3(F * x.homogeneous()), Radius(errorTh), functor);
+  }
+};
+
+/// Squared transfer error: disk of radius sqrt(th) around H*x
+template <>
+struct GuidedMatchingSearchArea<homography::kernel::AsymmetricError>
+{
+  static constexpr bool available = true;
+  static double Radius(double errorTh) { return std::sqrt(errorTh); }
+  template <typename ModelArg, typename Functor>
+  static void Query
+  (
+    const PointGrid & grid, const ModelArg & H, const Vec2 & x,
+    double errorTh, Functor && functor
+  )
+  {
+    grid.ForEachInDisk(Vec3(H * x.homogeneous()).hnormalized(), Radius(errorTh), functor);
+  }
+};
+
+/// List the right points that are compatible with a left point and a model:
+///  the ones having an error below the threshold, sorted by index.
+/// Use a PointGrid when the error metric provides a search area, and an
+///  exhaustive scan otherwise.
+template<
+  typename ModelArg, // The used model type
+  typename ErrorArg> // The metric to compute distance to the model
+class GuidedMatchingCandidates
+{
+  using SearchArea = GuidedMatchingSearchArea<ErrorArg>;
+  using HasSearchArea = std::integral_constant<bool, SearchArea::available>;
+
+public:
+  GuidedMatchingCandidates
+  (
+    const ModelArg & mod,                 // The model
+    const std::vector<Vec2> & xRight,     // The right data points
+    double errorTh                        // Maximal authorized error threshold
+  ):
+    mod_(mod), xRight_(xRight), errorTh_(errorTh),
+    grid_(BuildGrid(xRight, errorTh, HasSearchArea()))
+  { }
+
+  void operator()
+  (
+    const Vec2 & xLeft,
+    std::vector<uint32_t> & indexes,
+    std::vector<double> & errors
+  ) const
+  {
+    indexes.clear();
+    Collect(xLeft, indexes, HasSearchArea());
+    std::sort(indexes.begin(), indexes.end());
+    // Keep the candidates that satisfy the exact error
+    errors.clear();
+    size_t count = 0;
+    for (const uint32_t j : indexes)
+    {
+      const double err = ErrorArg::Error(mod_, xLeft, xRight_[j]);
+      if (err < errorTh_)
+      {
+        indexes[count++] = j;
+        errors.push_back(err);
+      }
+    }
+    indexes.resize(count);
+  }
+
+private:
+  static PointGrid BuildGrid
+  (
+    const std::vector<Vec2> & xRight, double errorTh, std::true_type
+  )
+  {
+    return PointGrid(xRight, 2.0 * SearchArea::Radius(errorTh));
+  }
+
+  static PointGrid BuildGrid
+  (
+    const std::vector<Vec2> &, double, std::false_type
+  )
+  {
+    return PointGrid({}, 0.0);
+  }
+
+  void Collect(const Vec2 & xLeft, std::vector<uint32_t> & indexes, std::true_type) const
+  {
+    SearchArea::Query(grid_, mod_, xLeft, errorTh_,
+      [&indexes](uint32_t j) { indexes.push_back(j); });
+  }
+
+  void Collect(const Vec2 &, std::vector<uint32_t> & indexes, std::false_type) const
+  {
+    indexes.resize(xRight_.size());
+    for (size_t j = 0; j < xRight_.size(); ++j)
+      indexes[j] = static_cast<uint32_t>(j);
+  }
+
+  const ModelArg & mod_;
+  const std::vector<Vec2> & xRight_;
+  const double errorTh_;
+  const PointGrid grid_;
+};
+
 /// Guided Matching (features only):
 ///  Use a model to find valid correspondences:
 ///   Keep the best corresponding points for the given model under the
@@ -40,19 +348,23 @@ void GuidedMatching(
   // Looking for the corresponding points that have
   //  the smallest distance (smaller than the provided Threshold)
 
+  std::vector<Vec2> xRightPos(xRight.cols());
+  for (size_t j = 0; j < xRightPos.size(); ++j)
+    xRightPos[j] = xRight.col(j);
+  const GuidedMatchingCandidates<ModelArg, ErrorArg> candidates(mod, xRightPos, errorTh);
+
+  std::vector<uint32_t> candidate_indexes;
+  std::vector<double> candidate_errors;
   for (size_t i = 0; i < xLeft.cols(); ++i) {
 
+    candidates(xLeft.col(i), candidate_indexes, candidate_errors);
     double min = std::numeric_limits<double>::max();
     matching::IndMatch match;
-    for (size_t j = 0; j < xRight.cols(); ++j) {
-      // Compute the geometric error: error to the model
-      const double err = ErrorArg::Error(
-        mod,  // The model
-        xLeft.col(i), xRight.col(j)); // The corresponding points
+    for (size_t k = 0; k < candidate_indexes.size(); ++k) {
       // if smaller error update corresponding index
-      if (err < errorTh && err < min) {
-        min = err;
-        match = matching::IndMatch(i,j);
+      if (candidate_errors[k] < min) {
+        min = candidate_errors[k];
+        match = matching::IndMatch(i, candidate_indexes[k]);
       }
     }
     if (min < errorTh)  {
@@ -139,20 +451,23 @@ void GuidedMatching(
   //   1. a geometric distance below the provided Threshold
   //   2. a distance ratio between descriptors of valid geometric correspondencess
 
+  std::vector<Vec2> xRightPos(xRight.cols());
+  for (size_t j = 0; j < xRightPos.size(); ++j)
+    xRightPos[j] = xRight.col(j);
+  const GuidedMatchingCandidates<ModelArg, ErrorArg> candidates(mod, xRightPos, errorTh);
+
+  std::vector<uint32_t> candidate_indexes;
+  std::vector<double> candidate_errors;
   for (size_t i = 0; i < xLeft.cols(); ++i) {
 
+    // Right points that agree with the model
+    candidates(xLeft.col(i), candidate_indexes, candidate_errors);
     distanceRatio<typename MetricT::ResultType > dR;
-    for (size_t j = 0; j < xRight.cols(); ++j) {
-      // Compute the geometric error: error to the model
-      const double geomErr = ErrorArg::Error(
-        mod,  // The model
-        xLeft.col(i), xRight.col(j)); // The corresponding points
-      if (geomErr < errorTh) {
-        const typename MetricT::ResultType descDist =
-          metric( lDescriptors[i].getData(), rDescriptors[j].getData(), DescriptorT::static_size );
-        // Update the corresponding points & distance (if required)
-        dR.update(j, descDist);
-      }
+    for (const uint32_t j : candidate_indexes) {
+      const typename MetricT::ResultType descDist =
+        metric( lDescriptors[i].getData(), rDescriptors[j].getData(), DescriptorT::static_size );
+      // Update the corresponding points & distance (if required)
+      dR.update(j, descDist);
     }
     // Add correspondence only iff the distance ratio is valid
     if (dR.isValid(distRatio))  {
@@ -198,20 +513,20 @@ void GuidedMatching(
     rRegionsPos[i] = camR ? camR->get_ud_pixel(rRegions.GetRegionPosition(i)) : rRegions.GetRegionPosition(i);
   }
 
+  const GuidedMatchingCandidates<ModelArg, ErrorArg> candidates(mod, rRegionsPos, errorTh);
+
+  std::vector<uint32_t> candidate_indexes;
+  std::vector<double> candidate_errors, candidate_distances;
   for (size_t i = 0; i < lRegions.RegionCount(); ++i) {
 
+    // Right regions that agree with the model
+    candidates(lRegionsPos[i], candidate_indexes, candidate_errors);
+    // Compare the descriptors of all the candidates at once
+    lRegions.SquaredDescriptorDistances(i, &rRegions, candidate_indexes, candidate_distances);
     distanceRatio<double> dR;
-    for (size_t j = 0; j < rRegions.RegionCount(); ++j) {
-      // Compute the geometric error: error to the model
-      const double geomErr = ErrorArg::Error(
-        mod,  // The model
-        // The corresponding points
-        lRegionsPos[i],
-        rRegionsPos[j]);
-      if (geomErr < errorTh) {
-        // Update the corresponding points & distance (if required)
-        dR.update(j, lRegions.SquaredDescriptorDistance(i, &rRegions, j));
-      }
+    for (size_t k = 0; k < candidate_indexes.size(); ++k) {
+      // Update the corresponding points & distance (if required)
+      dR.update(candidate_indexes[k], candidate_distances[k]);
     }
     // Add correspondence only iff the distance ratio is valid
     if (dR.isValid(distRatio))  {
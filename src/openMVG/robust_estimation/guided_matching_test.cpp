@@ -0,0 +1,149 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/multiview/solver_fundamental_kernel.hpp"
+#include "openMVG/multiview/solver_homography_kernel.hpp"
+#include "openMVG/robust_estimation/guided_matching.hpp"
+
+#include "testing/testing.h"
+
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::geometry_aware;
+
+namespace {
+
+// Random points in a 640x480 image
+Mat RandomPoints(int count, std::mt19937 & rng)
+{
+  std::uniform_real_distribution<double> dist_x(0.0, 640.0), dist_y(0.0, 480.0);
+  Mat x(2, count);
+  for (int i = 0; i < count; ++i)
+    x.col(i) << dist_x(rng), dist_y(rng);
+  return x;
+}
+
+// Reference exhaustive implementation: the smallest error below the threshold
+template <typename ErrorArg>
+matching::IndMatches BruteForceGuidedMatching
+(
+  const Mat3 & model,
+  const Mat & xLeft,
+  const Mat & xRight,
+  double errorTh
+)
+{
+  matching::IndMatches matches;
+  for (int i = 0; i < xLeft.cols(); ++i)
+  {
+    double min = std::numeric_limits<double>::max();
+    matching::IndMatch match;
+    for (int j = 0; j < xRight.cols(); ++j)
+    {
+      const double err = ErrorArg::Error(model, xLeft.col(i), xRight.col(j));
+      if (err < errorTh && err < min)
+      {
+        min = err;
+        match = matching::IndMatch(i, j);
+      }
+    }
+    if (min < errorTh)
+      matches.push_back(match);
+  }
+  matching::IndMatch::getDeduplicated(matches);
+  return matches;
+}
+
+} // namespace
+
+TEST(PointGrid, BandAndDiskAreConservative)
+{
+  std::mt19937 rng(0);
+  const Mat x = RandomPoints(2000, rng);
+  std::vector<Vec2> points(x.cols());
+  for (int i = 0; i < x.cols(); ++i)
+    points[i] = x.col(i);
+  const PointGrid grid(points, 4.0);
+
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (int trial = 0; trial < 50; ++trial)
+  {
+    // Lines of any orientation passing through the image
+    const Vec2 pt = points[trial];
+    const Vec2 dir(dist(rng), dist(rng));
+    const Vec3 line(dir(1), -dir(0), dir(0) * pt(1) - dir(1) * pt(0));
+    const double half_width = 3.0;
+    std::vector<bool> reported(points.size(), false);
+    grid.ForEachInBand(line * 10.0, half_width,
+      [&reported](uint32_t j) { reported[j] = true; });
+    for (size_t j = 0; j < points.size(); ++j)
+    {
+      const double dist_to_line =
+        std::abs(line.dot(points[j].homogeneous())) / line.head<2>().norm();
+      if (dist_to_line < half_width)
+        EXPECT_TRUE(reported[j]);
+    }
+
+    std::fill(reported.begin(), reported.end(), false);
+    const double radius = 12.0;
+    grid.ForEachInDisk(pt, radius,
+      [&reported](uint32_t j) { reported[j] = true; });
+    for (size_t j = 0; j < points.size(); ++j)
+    {
+      if ((points[j] - pt).norm() < radius)
+        EXPECT_TRUE(reported[j]);
+    }
+  }
+}
+
+TEST(GuidedMatching, Fundamental_SameAsExhaustive)
+{
+  std::mt19937 rng(1);
+  const Mat xLeft = RandomPoints(500, rng), xRight = RandomPoints(800, rng);
+  Mat3 F;
+  F << 0, -1e-3, 0.2,
+       1e-3, 0, -0.4,
+       -0.25, 0.35, 1;
+
+  const double errorTh = Square(2.0);
+  matching::IndMatches matches;
+  GuidedMatching<Mat3, fundamental::kernel::EpipolarDistanceError>(
+    F, xLeft, xRight, errorTh, matches);
+  EXPECT_TRUE(!matches.empty());
+  EXPECT_TRUE(matches ==
+    BruteForceGuidedMatching<fundamental::kernel::EpipolarDistanceError>(F, xLeft, xRight, errorTh));
+
+  matches.clear();
+  GuidedMatching<Mat3, fundamental::kernel::SymmetricEpipolarDistanceError>(
+    F, xLeft, xRight, errorTh, matches);
+  EXPECT_TRUE(matches ==
+    BruteForceGuidedMatching<fundamental::kernel::SymmetricEpipolarDistanceError>(F, xLeft, xRight, errorTh));
+}
+
+TEST(GuidedMatching, Homography_SameAsExhaustive)
+{
+  std::mt19937 rng(2);
+  const Mat xLeft = RandomPoints(1000, rng), xRight = RandomPoints(1000, rng);
+  Mat3 H;
+  H << 1.1, 0.05, 12.0,
+       -0.03, 0.95, -8.0,
+       1e-4, -2e-4, 1.0;
+
+  const double errorTh = Square(6.0);
+  matching::IndMatches matches;
+  GuidedMatching<Mat3, homography::kernel::AsymmetricError>(
+    H, xLeft, xRight, errorTh, matches);
+  EXPECT_TRUE(!matches.empty());
+  EXPECT_TRUE(matches ==
+    BruteForceGuidedMatching<homography::kernel::AsymmetricError>(H, xLeft, xRight, errorTh));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
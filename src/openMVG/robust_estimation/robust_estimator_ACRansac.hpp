@@ -35,6 +35,10 @@
 //  Adaptive Structure from Motion with a contrario mode estimation.
 //  In 11th Asian Conference on Computer Vision (ACCV 2012)
 //--
+//  [4] David P. Capel.
+//  An Effective Bail-out Test for RANSAC Consensus Scoring.
+//  British Machine Vision Conference (BMVC 2005)
+//--
 
 #include <algorithm>
 #include <cmath>
@@ -43,6 +47,7 @@
 #include <limits>
 #include <numeric>
 #include <random>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -52,6 +57,30 @@
 namespace openMVG {
 namespace robust{
 
+/**
+ * @brief Options of the ACRANSAC hypothesis evaluation.
+ * The default values give the exhaustive and sequential evaluation.
+ */
+struct ACRansacEvaluationOptions
+{
+  /// Preemptive verification [4]:
+  ///  Once a meaningful model is known, the residuals of a new hypothesis are
+  ///  evaluated by blocks (in a random order) and the evaluation stops as soon
+  ///  as the number of residuals under the current best threshold is
+  ///  significantly lower than the one of the best model.
+  ///  Rejected hypotheses are not scored, so the returned (threshold, NFA)
+  ///  keeps the same meaning but the search is no longer exhaustive.
+  bool bail_out = false;
+  /// Number of residuals evaluated between two bail-out tests
+  unsigned int bail_out_block_size = 64;
+  /// Confidence of the bail-out test (number of binomial standard deviations)
+  double bail_out_sigma = 3.0;
+  /// Evaluate the residuals of an hypothesis with several threads
+  ///  if the datum size is at least this value (0: disabled).
+  /// The result is identical to the sequential evaluation.
+  unsigned int parallel_min_samples = 0;
+};
+
 namespace acransac_nfa_internal {
 
 /// logarithm (base 10) of binomial coefficient
@@ -303,6 +332,155 @@ NFA_Interface<Kernel>::ComputeNFA_and_inliers
   }
   return false;
 }
+
+/// Trait telling if a kernel provides the batched evaluation of a datum subset:
+///  void Errors(const Model &, const std::vector<uint32_t> & samples, std::vector<double> &) const
+template <typename Kernel>
+class has_subset_errors
+{
+  template <typename T>
+  static auto check(int) -> decltype(
+    std::declval<const T &>().Errors(std::declval<const typename T::Model &>(),
+                                     std::declval<const std::vector<uint32_t> &>(),
+                                     std::declval<std::vector<double> &>()),
+    std::true_type());
+  template <typename T>
+  static std::false_type check(...);
+public:
+  static constexpr bool value = decltype(check<Kernel>(0))::value;
+};
+
+template <typename Kernel>
+void ComputeSubsetResiduals
+(
+  const Kernel & kernel,
+  const typename Kernel::Model & model,
+  const std::vector<uint32_t> & samples,
+  std::vector<double> & residuals,
+  std::true_type // batched evaluation
+)
+{
+  kernel.Errors(model, samples, residuals);
+}
+
+template <typename Kernel>
+void ComputeSubsetResiduals
+(
+  const Kernel & kernel,
+  const typename Kernel::Model & model,
+  const std::vector<uint32_t> & samples,
+  std::vector<double> & residuals,
+  std::false_type // per sample evaluation
+)
+{
+  residuals.resize(samples.size());
+  for (size_t i = 0; i < samples.size(); ++i)
+    residuals[i] = kernel.Error(samples[i], model);
+}
+
+/// Compute the residual errors of the given datum subset
+///  (residuals[i] is the residual of samples[i]), using the batched
+///  evaluation of the kernel if available.
+template <typename Kernel>
+void ComputeSubsetResiduals
+(
+  const Kernel & kernel,
+  const typename Kernel::Model & model,
+  const std::vector<uint32_t> & samples,
+  std::vector<double> & residuals
+)
+{
+  ComputeSubsetResiduals(kernel, model, samples, residuals,
+    std::integral_constant<bool, has_subset_errors<Kernel>::value>());
+}
+
+/// Compute the residual errors of every datum for the given model.
+template <typename Kernel>
+void ComputeResiduals
+(
+  const Kernel & kernel,
+  const typename Kernel::Model & model,
+  const bool b_parallel,
+  std::vector<double> & residuals
+)
+{
+  if (!b_parallel)
+  {
+    kernel.Errors(model, residuals);
+    return;
+  }
+  // Each thread evaluates blocks of consecutive datum
+  const int nData = static_cast<int>(residuals.size());
+  const int block_size = 256;
+  const int nb_blocks = (nData + block_size - 1) / block_size;
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int block = 0; block < nb_blocks; ++block)
+  {
+    std::vector<uint32_t> samples(std::min(block_size, nData - block * block_size));
+    std::iota(samples.begin(), samples.end(), block * block_size);
+    std::vector<double> block_residuals;
+    ComputeSubsetResiduals(kernel, model, samples, block_residuals);
+    std::copy(block_residuals.cbegin(), block_residuals.cend(),
+      residuals.begin() + block * block_size);
+  }
+}
+
+/**
+ * @brief Compute the residual errors by blocks and stop the evaluation if
+ *  the hypothesis is unlikely to have as much support as the best model.
+ *
+ * @param[in] evaluation_order Order of the datum evaluation (random permutation)
+ * @param[in] best_threshold Residual threshold of the best model
+ * @param[in] best_inlier_ratio Inlier ratio of the best model
+ *
+ * @return false if the hypothesis was rejected (residuals are then partially computed)
+ */
+template <typename Kernel>
+bool ComputeResidualsWithBailOut
+(
+  const Kernel & kernel,
+  const typename Kernel::Model & model,
+  const std::vector<uint32_t> & evaluation_order,
+  const double best_threshold,
+  const double best_inlier_ratio,
+  const ACRansacEvaluationOptions & options,
+  std::vector<double> & residuals
+)
+{
+  const size_t nData = evaluation_order.size();
+  const size_t block_size = std::max(1u, options.bail_out_block_size);
+  size_t nb_evaluated = 0, nb_supporting = 0;
+  std::vector<uint32_t> block_samples;
+  std::vector<double> block_residuals;
+  while (nb_evaluated < nData)
+  {
+    const size_t block_end = std::min(nData, nb_evaluated + block_size);
+    block_samples.assign(evaluation_order.cbegin() + nb_evaluated,
+                         evaluation_order.cbegin() + block_end);
+    ComputeSubsetResiduals(kernel, model, block_samples, block_residuals);
+    for (size_t i = 0; i < block_samples.size(); ++i)
+    {
+      residuals[block_samples[i]] = block_residuals[i];
+      if (block_residuals[i] <= best_threshold)
+        ++nb_supporting;
+    }
+    nb_evaluated = block_end;
+    if (nb_evaluated < nData)
+    {
+      // Support of the partial evaluation follows a binomial distribution
+      //  if the hypothesis is as good as the best model.
+      const double expected_support = best_inlier_ratio * nb_evaluated;
+      const double sigma =
+        std::sqrt(nb_evaluated * best_inlier_ratio * (1.0 - best_inlier_ratio));
+      if (nb_supporting < expected_support - options.bail_out_sigma * sigma)
+        return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace acransac_nfa_internal
 
 /**
@@ -318,6 +496,8 @@ NFA_Interface<Kernel>::ComputeNFA_and_inliers
  * @param[out] model returned model if found
  * @param[in] precision upper bound of the precision (squared error)
  * @param[in] bVerbose display console log
+ * @param[in] evaluation_options hypothesis evaluation strategy
+ *  (preemptive verification, parallel residual evaluation)
  *
  * @return (errorMax, minNFA)
  */
@@ -329,7 +509,8 @@ std::pair<double, double> ACRANSAC
   const unsigned int num_max_iteration = 1024,
   typename Kernel::Model * model = nullptr,
   double precision = std::numeric_limits<double>::infinity(),
-  bool bVerbose = false
+  bool bVerbose = false,
+  const ACRansacEvaluationOptions & evaluation_options = ACRansacEvaluationOptions()
 )
 {
   vec_inliers.clear();
@@ -377,6 +558,22 @@ std::pair<double, double> ACRANSAC
   // Random number generation
   std::mt19937 random_generator(std::mt19937::default_seed);
 
+  //--
+  // Hypothesis evaluation strategy
+  const bool b_parallel_evaluation =
+    evaluation_options.parallel_min_samples > 0 &&
+    nData >= evaluation_options.parallel_min_samples;
+  // Random evaluation order used by the bail-out test
+  //  (use its own generator to keep the sampling sequence unchanged)
+  std::vector<uint32_t> vec_evaluation_order;
+  if (evaluation_options.bail_out)
+  {
+    vec_evaluation_order.resize(nData);
+    std::iota(vec_evaluation_order.begin(), vec_evaluation_order.end(), 0);
+    std::mt19937 order_generator(std::mt19937::default_seed);
+    std::shuffle(vec_evaluation_order.begin(), vec_evaluation_order.end(), order_generator);
+  }
+
   //--
   // Main estimation loop.
   for (unsigned int iter = 0; iter < nIter && iter < num_max_iteration; ++iter)
@@ -396,7 +593,20 @@ std::pair<double, double> ACRANSAC
     for (const auto& model_it : vec_models)
     {
       // Compute residual values
-      kernel.Errors(model_it, nfa_interface.residuals());
+      if (evaluation_options.bail_out && bACRansacMode && minNFA < 0 && !vec_inliers.empty())
+      {
+        // Preemptive verification against the best model found so far
+        if (!acransac_nfa_internal::ComputeResidualsWithBailOut(
+              kernel, model_it, vec_evaluation_order,
+              errorMax, vec_inliers.size() / static_cast<double>(nData),
+              evaluation_options, nfa_interface.residuals()))
+          continue;
+      }
+      else
+      {
+        acransac_nfa_internal::ComputeResiduals(
+          kernel, model_it, b_parallel_evaluation, nfa_interface.residuals());
+      }
 
       if (!bACRansacMode)
       {
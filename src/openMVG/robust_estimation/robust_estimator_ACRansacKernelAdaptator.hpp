@@ -26,6 +26,8 @@
 //  by the ACRANSAC algorithm.
 //
 
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "openMVG/multiview/conditioning.hpp"
@@ -35,6 +37,73 @@
 namespace openMVG {
 namespace robust{
 
+/// Trait telling if an error functor provides a batched evaluation:
+///  static void Errors(const Model &, const Mat & x1, const Mat & x2, std::vector<double> &)
+/// Kernel adaptors use it (if available) to evaluate all the residuals at once.
+template <typename ErrorT, typename ModelT>
+class has_batch_errors
+{
+  template <typename T>
+  static auto check(int) -> decltype(
+    T::Errors(std::declval<const ModelT &>(),
+              std::declval<const Mat &>(),
+              std::declval<const Mat &>(),
+              std::declval<std::vector<double> &>()),
+    std::true_type());
+  template <typename T>
+  static std::false_type check(...);
+public:
+  static constexpr bool value = decltype(check<ErrorT>(0))::value;
+};
+
+namespace kernel_adaptor_internal {
+
+template <typename ErrorT, typename ModelT, typename MatT1, typename MatT2>
+inline void ComputeErrors
+(
+  const ModelT & model,
+  const MatT1 & x1,
+  const MatT2 & x2,
+  std::vector<double> & vec_errors,
+  std::true_type // batched evaluation
+)
+{
+  ErrorT::Errors(model, x1, x2, vec_errors);
+}
+
+template <typename ErrorT, typename ModelT, typename MatT1, typename MatT2>
+inline void ComputeErrors
+(
+  const ModelT & model,
+  const MatT1 & x1,
+  const MatT2 & x2,
+  std::vector<double> & vec_errors,
+  std::false_type // per sample evaluation
+)
+{
+  vec_errors.resize(x1.cols());
+  for (uint32_t sample = 0; sample < x1.cols(); ++sample)
+    vec_errors[sample] = ErrorT::Error(model, x1.col(sample), x2.col(sample));
+}
+
+} // namespace kernel_adaptor_internal
+
+/// Evaluate the ErrorT residual of every column pair (x1.col(i), x2.col(i)),
+///  using the batched error evaluation if the functor provides it.
+template <typename ErrorT, typename ModelT, typename MatT1, typename MatT2>
+inline void ComputeErrors
+(
+  const ModelT & model,
+  const MatT1 & x1,
+  const MatT2 & x2,
+  std::vector<double> & vec_errors
+)
+{
+  kernel_adaptor_internal::ComputeErrors<ErrorT>(
+    model, x1, x2, vec_errors,
+    std::integral_constant<bool, has_batch_errors<ErrorT, ModelT>::value>());
+}
+
 enum AContrarioParametrizationType
 {
   POINT_TO_LINE = 0,
@@ -164,9 +233,18 @@ public:
     std::vector<double> & vec_errors
   ) const
   {
-    vec_errors.resize(x1_.cols());
-    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
-      vec_errors[sample] = ErrorT::Error(model, x1_.col(sample), x2_.col(sample));
+    ComputeErrors<ErrorT>(model, x1_, x2_, vec_errors);
+  }
+
+  void Errors
+  (
+    const Model & model,
+    const std::vector<uint32_t> & samples,
+    std::vector<double> & vec_errors
+  ) const
+  {
+    ComputeErrors<ErrorT>(model,
+      ExtractColumns(x1_, samples), ExtractColumns(x2_, samples), vec_errors);
   }
 
   size_t NumSamples() const
@@ -262,9 +340,18 @@ public:
     std::vector<double> & vec_errors
   ) const
   {
-    vec_errors.resize(x2d_.cols());
-    for (uint32_t sample = 0; sample < x2d_.cols(); ++sample)
-      vec_errors[sample] = ErrorT::Error(model, x2d_.col(sample), x3D_.col(sample));
+    ComputeErrors<ErrorT>(model, x2d_, x3D_, vec_errors);
+  }
+
+  void Errors
+  (
+    const Model & model,
+    const std::vector<uint32_t> & samples,
+    std::vector<double> & vec_errors
+  ) const
+  {
+    ComputeErrors<ErrorT>(model,
+      ExtractColumns(x2d_, samples), ExtractColumns(x3D_, samples), vec_errors);
   }
 
   size_t NumSamples() const { return x2d_.cols(); }
@@ -355,9 +442,20 @@ public:
   {
     Mat3 F;
     FundamentalFromEssential(model, K1_, K2_, &F);
-    vec_errors.resize(x1_.cols());
-    for (uint32_t sample = 0; sample < x1_.cols(); ++sample)
-      vec_errors[sample] = ErrorT::Error(F, this->x1_.col(sample), this->x2_.col(sample));
+    ComputeErrors<ErrorT>(F, x1_, x2_, vec_errors);
+  }
+
+  void Errors
+  (
+    const Model & model,
+    const std::vector<uint32_t> & samples,
+    std::vector<double> & vec_errors
+  ) const
+  {
+    Mat3 F;
+    FundamentalFromEssential(model, K1_, K2_, &F);
+    ComputeErrors<ErrorT>(F,
+      ExtractColumns(x1_, samples), ExtractColumns(x2_, samples), vec_errors);
   }
 
   size_t NumSamples() const { return x1_.cols(); }
@@ -7,7 +7,9 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 
+#include "openMVG/multiview/solver_homography_kernel.hpp"
 #include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
 #include "openMVG/robust_estimation/robust_estimator_lineKernel_test.hpp"
 #include "openMVG/numeric/extract_columns.hpp"
 
@@ -364,6 +366,134 @@ TEST(RansacLineFitter, ACRANSACSimu) {
   }
 }
 
+// Check that the alternative hypothesis evaluation strategies
+//  (parallel residual evaluation, preemptive verification)
+//  provide the same model on a large contaminated dataset.
+TEST(RansacLineFitter, EvaluationOptions) {
+
+  const int S = 1000;
+  const int W = S, H = S;
+  const size_t nbPoints = 10000;
+  Mat points;
+  generateLine(points, nbPoints, W, H, 1.0f, .5f);
+
+  ACRANSACOneViewKernel<LineSolver, pointToLineError, Vec2> lineKernel(points, W, H);
+
+  // Reference: exhaustive sequential evaluation
+  std::vector<uint32_t> vec_inliers;
+  Vec2 line;
+  const std::pair<double,double> ret = ACRANSAC(lineKernel, vec_inliers, 1000, &line);
+  EXPECT_TRUE(!vec_inliers.empty());
+  EXPECT_NEAR(0.3, line[1], 1e-2);
+
+  // Parallel evaluation must give exactly the same result
+  {
+    ACRansacEvaluationOptions options;
+    options.parallel_min_samples = 1;
+    std::vector<uint32_t> vec_inliers_parallel;
+    Vec2 line_parallel;
+    const std::pair<double,double> ret_parallel = ACRANSAC(
+      lineKernel, vec_inliers_parallel, 1000, &line_parallel,
+      std::numeric_limits<double>::infinity(), false, options);
+    EXPECT_EQ(ret.first, ret_parallel.first);
+    EXPECT_EQ(ret.second, ret_parallel.second);
+    EXPECT_EQ(vec_inliers.size(), vec_inliers_parallel.size());
+    EXPECT_MATRIX_NEAR(line, line_parallel, 1e-12);
+  }
+
+  // Preemptive verification must give a model of similar quality
+  {
+    ACRansacEvaluationOptions options;
+    options.bail_out = true;
+    std::vector<uint32_t> vec_inliers_bail_out;
+    Vec2 line_bail_out;
+    const std::pair<double,double> ret_bail_out = ACRANSAC(
+      lineKernel, vec_inliers_bail_out, 1000, &line_bail_out,
+      std::numeric_limits<double>::infinity(), false, options);
+    EXPECT_TRUE(ret_bail_out.second < 0);
+    EXPECT_NEAR(ret.first, ret_bail_out.first, 0.5);
+    EXPECT_NEAR(vec_inliers.size(), vec_inliers_bail_out.size(), nbPoints * 0.02);
+    EXPECT_NEAR(0.3, line_bail_out[1], 1e-2);
+  }
+}
+
+TEST(RansacHomographyFitter, EvaluationOptions) {
+  Mat3 H_gt;
+  H_gt << 1.1, 0.05, 20.0,
+          -0.03, 0.95, -10.0,
+          1e-4, -2e-4, 1.0;
+
+  // 1000 correspondences: 60% inliers (with noise) and 40% outliers
+  const int n = 1000;
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<double> position(0.0, 1000.0);
+  std::normal_distribution<double> noise(0.0, 0.2);
+  Mat x(2, n), y(2, n);
+  for (int i = 0; i < n; ++i) {
+    x.col(i) << position(random_generator), position(random_generator);
+    if (i % 5 < 3)
+      y.col(i) = (H_gt * x.col(i).homogeneous()).hnormalized()
+        + Vec2(noise(random_generator), noise(random_generator));
+    else
+      y.col(i) << position(random_generator), position(random_generator);
+  }
+
+  using KernelType =
+    robust::ACKernelAdaptor<
+      homography::kernel::FourPointSolver,
+      homography::kernel::AsymmetricError,
+      UnnormalizerI,
+      Mat3>;
+  const KernelType kernel(x, 1000, 1000, y, 1000, 1000, false);
+
+  // The batched evaluation of a datum subset gives the per sample residuals
+  {
+    const std::vector<uint32_t> samples = {7, 3, 999, 0, 512};
+    std::vector<double> errors;
+    kernel.Errors(H_gt, samples, errors);
+    CHECK_EQUAL(samples.size(), errors.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const double e = kernel.Error(samples[i], H_gt);
+      EXPECT_NEAR(e, errors[i], 1e-8 * std::max(1.0, e));
+    }
+  }
+
+  // Reference: exhaustive sequential evaluation
+  std::vector<uint32_t> vec_inliers;
+  Mat3 H;
+  const std::pair<double, double> ret =
+    robust::ACRANSAC(kernel, vec_inliers, 1024, &H, Square(4.0));
+  CHECK(!vec_inliers.empty());
+  EXPECT_NEAR(n * 0.6, vec_inliers.size(), n * 0.05);
+
+  // Parallel evaluation gives exactly the same result
+  {
+    robust::ACRansacEvaluationOptions options;
+    options.parallel_min_samples = 1;
+    std::vector<uint32_t> vec_inliers_parallel;
+    Mat3 H_parallel;
+    const std::pair<double, double> ret_parallel = robust::ACRANSAC(
+      kernel, vec_inliers_parallel, 1024, &H_parallel, Square(4.0), false, options);
+    EXPECT_EQ(ret.first, ret_parallel.first);
+    EXPECT_EQ(ret.second, ret_parallel.second);
+    EXPECT_TRUE(vec_inliers == vec_inliers_parallel);
+    EXPECT_MATRIX_NEAR(H, H_parallel, 1e-12);
+  }
+
+  // Preemptive verification gives a model of similar quality
+  {
+    robust::ACRansacEvaluationOptions options;
+    options.bail_out = true;
+    std::vector<uint32_t> vec_inliers_bail_out;
+    Mat3 H_bail_out;
+    const std::pair<double, double> ret_bail_out = robust::ACRANSAC(
+      kernel, vec_inliers_bail_out, 1024, &H_bail_out, Square(4.0), false, options);
+    EXPECT_TRUE(ret_bail_out.second < 0);
+    EXPECT_NEAR(vec_inliers.size(), vec_inliers_bail_out.size(), n * 0.02);
+    EXPECT_NEAR(ret.first, ret_bail_out.first, 0.5);
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -30,6 +30,7 @@
 #include "openMVG/sfm/sfm_filters.hpp"
 #include "openMVG/stl/stl.hpp"
 #include "openMVG/system/timer.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include <vector>
 
@@ -82,6 +83,8 @@ bool GlobalSfM_Translation_AveragingSolver::Translation_averaging(
   sfm::SfM_Data & sfm_data,
   const Hash_Map<IndexT, Mat3> & map_globalR)
 {
+  OPENMVG_TRACE_SCOPE("Translation averaging");
+
   //-------------------
   //-- GLOBAL TRANSLATIONS ESTIMATION from initial triplets t_ij guess
   //-------------------
@@ -221,6 +224,38 @@ bool GlobalSfM_Translation_AveragingSolver::Translation_averaging(
       }
       break;
 
+      case TRANSLATION_AVERAGING_L1_ADMM:
+      {
+        std::vector<Vec3> vec_translations;
+        double gamma = -1.0;
+        bool converged = false;
+        if (!solve_translations_problem_linfinity_admm(
+          vec_relative_motion_cpy, vec_translations, &gamma, &converged))
+        {
+          std::cerr << "Compute global translations: failed" << std::endl;
+          return false;
+        }
+
+        std::cout
+          << "-------------------------------" << "\n"
+          << "-- #relative estimates: " << vec_relative_motion_cpy.size()
+          << (converged ? " converge with gamma: " : " stopped before convergence with gamma: ")
+          << gamma << ".\n"
+          << " timing (s): " << timerLP_translation.elapsed() << ".\n"
+          << "-------------------------------" << std::endl;
+
+        // A valid solution was found:
+        // - Update the view poses according the found camera translations
+        for (size_t i = 0; i < iNview; ++i)
+        {
+          const Vec3 & t = vec_translations[i];
+          const IndexT pose_id = reindex_backward[i];
+          const Mat3 & Ri = map_globalR.at(pose_id);
+          sfm_data.poses[pose_id] = Pose3(Ri, -Ri.transpose()*t);
+        }
+      }
+      break;
+
       case TRANSLATION_AVERAGING_L2_DISTANCE_CHORDAL:
       {
         std::vector<int> vec_edges;
@@ -328,6 +363,7 @@ void GlobalSfM_Translation_AveragingSolver::ComputePutativeTranslation_EdgesCove
 )
 {
   openMVG::system::Timer timerLP_triplet;
+  OPENMVG_TRACE_SCOPE("Triplet relative translations");
 
   //--
   // Compute the relative translations using triplets of rotations over the rotation graph.
@@ -601,6 +637,11 @@ bool GlobalSfM_Translation_AveragingSolver::Estimate_T_triplet
   const std::string & sOutDirectory
 ) const
 {
+  system::ScopedTrace trace("Triplet translation");
+  trace.AddCounter("pose_i", poses_id.i);
+  trace.AddCounter("pose_j", poses_id.j);
+  trace.AddCounter("pose_k", poses_id.k);
+
   // List matches that belong to the triplet of poses
   PairWiseMatches map_triplet_matches;
   const std::set<IndexT> set_pose_ids {poses_id.i, poses_id.j, poses_id.k};
@@ -28,7 +28,8 @@ enum ETranslationAveragingMethod
 {
   TRANSLATION_AVERAGING_L1 = 1,
   TRANSLATION_AVERAGING_L2_DISTANCE_CHORDAL = 2,
-  TRANSLATION_AVERAGING_SOFTL1 = 3
+  TRANSLATION_AVERAGING_SOFTL1 = 3,
+  TRANSLATION_AVERAGING_L1_ADMM = 4 // Same problem as L1, solved with a sparse ADMM solver
 };
 
 struct SfM_Data;
@@ -24,6 +24,7 @@
 #include "openMVG/sfm/sfm_filters.hpp"
 #include "openMVG/stl/stl.hpp"
 #include "openMVG/system/timer.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/tracks/tracks.hpp"
 #include "openMVG/types.hpp"
 
@@ -107,8 +108,18 @@ void GlobalSfMReconstructionEngine_RelativeMotions::SetTranslationAveragingMetho
   eTranslation_averaging_method_ = eTranslationAveragingMethod;
 }
 
+void GlobalSfMReconstructionEngine_RelativeMotions::SetRelativePoseEvaluationOptions
+(
+  const robust::ACRansacEvaluationOptions & options
+)
+{
+  relative_pose_evaluation_options_ = options;
+}
+
 bool GlobalSfMReconstructionEngine_RelativeMotions::Process() {
 
+  OPENMVG_TRACE_SCOPE("Global SfM");
+
   //-------------------
   // Keep only the largest biedge connected subgraph
   //-------------------
@@ -181,6 +192,7 @@ bool GlobalSfMReconstructionEngine_RelativeMotions::Compute_Global_Rotations
 {
   if (relatives_R.empty())
     return false;
+  OPENMVG_TRACE_SCOPE("Rotation averaging");
   // Log statistics about the relative rotation graph
   {
     std::set<IndexT> set_pose_ids;
@@ -316,6 +328,8 @@ bool GlobalSfMReconstructionEngine_RelativeMotions::Compute_Initial_Structure
   matching::PairWiseMatches & tripletWise_matches
 )
 {
+  OPENMVG_TRACE_SCOPE("Initial structure");
+
   // Build tracks from selected triplets (Union of all the validated triplet tracks (_tripletWise_matches))
   {
     using namespace openMVG::tracks;
@@ -413,6 +427,8 @@ bool GlobalSfMReconstructionEngine_RelativeMotions::Compute_Initial_Structure
 // Adjust the scene (& remove outliers)
 bool GlobalSfMReconstructionEngine_RelativeMotions::Adjust()
 {
+  OPENMVG_TRACE_SCOPE("Global bundle adjustment");
+
   // Refine sfm_scene (in a 3 iteration process (free the parameters regarding their incertainty order)):
 
   Bundle_Adjustment_Ceres bundle_adjustment_obj;
@@ -536,6 +552,7 @@ void GlobalSfMReconstructionEngine_RelativeMotions::Compute_Relative_Rotations
   const Relative_Pose_Engine::Relative_Pair_Poses relative_poses = [&]
   {
     Relative_Pose_Engine relative_pose_engine;
+    relative_pose_engine.SetACRansacEvaluationOptions(relative_pose_evaluation_options_);
     if (!relative_pose_engine.Process(sfm_data_,
         matches_provider_,
         features_provider_))
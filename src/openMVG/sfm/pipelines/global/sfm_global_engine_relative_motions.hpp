@@ -14,6 +14,7 @@
 
 #include "openMVG/sfm/pipelines/global/GlobalSfM_rotation_averaging.hpp"
 #include "openMVG/sfm/pipelines/global/GlobalSfM_translation_averaging.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/sfm/pipelines/sfm_engine.hpp"
 
 namespace htmlDocument { class htmlDocumentStream; }
@@ -44,6 +45,9 @@ public:
   void SetRotationAveragingMethod(ERotationAveragingMethod eRotationAveragingMethod);
   void SetTranslationAveragingMethod(ETranslationAveragingMethod eTranslation_averaging_method_);
 
+  /// Configure the hypothesis evaluation strategy of the relative pose robust estimation
+  void SetRelativePoseEvaluationOptions(const robust::ACRansacEvaluationOptions & options);
+
   bool Process() override;
 
 protected:
@@ -88,6 +92,7 @@ private:
   // Parameter
   ERotationAveragingMethod eRotation_averaging_method_;
   ETranslationAveragingMethod eTranslation_averaging_method_;
+  robust::ACRansacEvaluationOptions relative_pose_evaluation_options_;
 
   //-- Data provider
   Features_Provider  * features_provider_;
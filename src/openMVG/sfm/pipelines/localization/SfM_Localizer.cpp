@@ -20,6 +20,7 @@
 #include "openMVG/sfm/sfm_landmark.hpp"
 #include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include <memory>
 #include <utility>
@@ -63,6 +64,20 @@ public:
                   models); // Found model hypothesis
   }
 
+  double Error(uint32_t sample, const Model & model) const
+  {
+    // Convert the found model into a Pose3
+    const Vec3 t = model.block(0, 3, 3, 1);
+    const geometry::Pose3 pose(model.block(0, 0, 3, 3),
+                               - model.block(0, 0, 3, 3).transpose() * t);
+
+    const bool ignore_distortion = true; // We ignore distortion since we are using undistorted bearing vector as input
+
+    return (camera_->residual(pose(x3D_.col(sample)),
+              x2d_.col(sample),
+              ignore_distortion) * N1_(0,0)).squaredNorm();
+  }
+
   void Errors(const Model & model, std::vector<double> & vec_errors) const
   {
     // Convert the found model into a Pose3
@@ -82,6 +97,30 @@ public:
     }
   }
 
+  void Errors
+  (
+    const Model & model,
+    const std::vector<uint32_t> & samples,
+    std::vector<double> & vec_errors
+  ) const
+  {
+    // Convert the found model into a Pose3
+    const Vec3 t = model.block(0, 3, 3, 1);
+    const geometry::Pose3 pose(model.block(0, 0, 3, 3),
+                               - model.block(0, 0, 3, 3).transpose() * t);
+
+    vec_errors.resize(samples.size());
+
+    const bool ignore_distortion = true; // We ignore distortion since we are using undistorted bearing vector as input
+
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+      vec_errors[i] = (camera_->residual(pose(x3D_.col(samples[i])),
+                         x2d_.col(samples[i]),
+                         ignore_distortion) * N1_(0,0)).squaredNorm();
+    }
+  }
+
   size_t NumSamples() const { return x2d_.cols(); }
 
   void Unnormalize(Model * model) const {
@@ -117,6 +156,8 @@ namespace sfm {
     // --
     // Compute the camera pose (resectioning)
     // --
+    system::ScopedTrace trace("AC-RANSAC resection", "robust_estimation");
+    trace.AddCounter("correspondences", resection_data.pt2D.cols());
     Mat34 P;
     resection_data.vec_inliers.clear();
 
@@ -153,7 +194,8 @@ namespace sfm {
                                     resection_data.max_iteration,
                                     &P,
                                     dPrecision,
-                                    true);
+                                    true,
+                                    resection_data.evaluation_options);
         // Update the upper bound precision of the model found by AC-RANSAC
         resection_data.error_max = ACRansacOut.first;
       }
@@ -183,7 +225,8 @@ namespace sfm {
                                     resection_data.max_iteration,
                                     &P,
                                     dPrecision,
-                                    true);
+                                    true,
+                                    resection_data.evaluation_options);
         // Update the upper bound precision of the model found by AC-RANSAC
         resection_data.error_max = ACRansacOut.first;
       }
@@ -213,7 +256,8 @@ namespace sfm {
                                     resection_data.max_iteration,
                                     &P,
                                     dPrecision,
-                                    true);
+                                    true,
+                                    resection_data.evaluation_options);
         // Update the upper bound precision of the model found by AC-RANSAC
         resection_data.error_max = ACRansacOut.first;
       }
@@ -244,7 +288,8 @@ namespace sfm {
                                     resection_data.max_iteration,
                                     &P,
                                     dPrecision,
-                                    true);
+                                    true,
+                                    resection_data.evaluation_options);
         // Update the upper bound precision of the model found by AC-RANSAC
         resection_data.error_max = ACRansacOut.first;
       }
@@ -275,7 +320,8 @@ namespace sfm {
                                     resection_data.max_iteration,
                                     &P,
                                     dPrecision,
-                                    true);
+                                    true,
+                                    resection_data.evaluation_options);
         // Update the upper bound precision of the model found by AC-RANSAC
         resection_data.error_max = ACRansacOut.first;
       }
@@ -289,6 +335,7 @@ namespace sfm {
 
     // Test if the mode support some points (more than those required for estimation)
     const bool bResection = (resection_data.vec_inliers.size() > 2.5 * MINIMUM_SAMPLES);
+    trace.AddCounter("inliers", resection_data.vec_inliers.size());
 
     if (bResection)
     {
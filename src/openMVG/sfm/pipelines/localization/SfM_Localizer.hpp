@@ -14,6 +14,7 @@
 
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 #include "openMVG/multiview/solver_resection.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/types.hpp"
 
 namespace openMVG { namespace cameras { struct IntrinsicBase; } }
@@ -34,6 +35,8 @@ struct Image_Localizer_Match_Data
   // Upper bound pixel(s) tolerance for residual errors
   double error_max = std::numeric_limits<double>::infinity();
   uint32_t max_iteration = 4096;
+  // Hypothesis evaluation strategy of the robust estimation
+  robust::ACRansacEvaluationOptions evaluation_options;
 };
 
 class SfM_Localizer
@@ -101,6 +101,7 @@ namespace sfm {
     if (resection_data_ptr)
     {
       resection_data.error_max = resection_data_ptr->error_max;
+      resection_data.evaluation_options = resection_data_ptr->evaluation_options;
     }
     resection_data.pt3D.resize(3, vec_putative_matches.size());
     resection_data.pt2D.resize(2, vec_putative_matches.size());
@@ -0,0 +1,87 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/sfm/pipelines/localization/SfM_Localizer.hpp"
+#include "openMVG/cameras/Camera_Pinhole.hpp"
+#include "openMVG/geometry/pose3.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+
+#include "testing/testing.h"
+
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::cameras;
+using namespace openMVG::sfm;
+
+namespace {
+
+// 2D-3D correspondences of the first camera of a ring scene:
+//  noisy projections, with one correspondence out of four replaced by an outlier.
+Image_Localizer_Match_Data MakeResectionData
+(
+  const NViewDataSet & d
+)
+{
+  Image_Localizer_Match_Data resection_data;
+  resection_data.pt3D = d._X;
+  resection_data.pt2D = d._x[0];
+  resection_data.max_iteration = 1024;
+
+  std::mt19937 random_generator(0);
+  std::normal_distribution<double> noise(0.0, 0.5);
+  std::uniform_real_distribution<double> position(0.0, 1000.0);
+  for (Mat::Index i = 0; i < resection_data.pt2D.cols(); ++i)
+  {
+    if (i % 4 == 3)
+      resection_data.pt2D.col(i) << position(random_generator), position(random_generator);
+    else
+      resection_data.pt2D.col(i) += Vec2(noise(random_generator), noise(random_generator));
+  }
+  return resection_data;
+}
+
+} // namespace
+
+// The parallel residual evaluation gives the same pose, threshold and inliers
+//  as the sequential evaluation, with and without known intrinsics.
+TEST(SfM_Localizer, Localize_ParallelEvaluation)
+{
+  const int n = 5000;
+  const NViewDataSet d = NRealisticCamerasRing(1, n);
+  const Pinhole_Intrinsic intrinsic(1000, 1000, 1000, 500, 500);
+
+  for (const resection::SolverType solver_type :
+    {resection::SolverType::DLT_6POINTS, resection::SolverType::P3P_KE_CVPR17})
+  {
+    const IntrinsicBase * optional_intrinsic =
+      (solver_type == resection::SolverType::DLT_6POINTS) ? nullptr : &intrinsic;
+
+    // Reference: exhaustive sequential evaluation
+    Image_Localizer_Match_Data resection_data = MakeResectionData(d);
+    geometry::Pose3 pose;
+    EXPECT_TRUE(SfM_Localizer::Localize(
+      solver_type, {1000, 1000}, optional_intrinsic, resection_data, pose));
+    EXPECT_NEAR(n * 0.75, resection_data.vec_inliers.size(), n * 0.05);
+    EXPECT_MATRIX_NEAR(d._C[0], pose.center(), 1e-2);
+
+    Image_Localizer_Match_Data resection_data_parallel = MakeResectionData(d);
+    resection_data_parallel.evaluation_options.parallel_min_samples = 1;
+    geometry::Pose3 pose_parallel;
+    EXPECT_TRUE(SfM_Localizer::Localize(
+      solver_type, {1000, 1000}, optional_intrinsic, resection_data_parallel, pose_parallel));
+    EXPECT_EQ(resection_data.error_max, resection_data_parallel.error_max);
+    EXPECT_TRUE(resection_data.vec_inliers == resection_data_parallel.vec_inliers);
+    EXPECT_MATRIX_NEAR(resection_data.projection_matrix,
+      resection_data_parallel.projection_matrix, 1e-12);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -18,6 +18,7 @@
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/sfm/sfm_data_triangulation.hpp"
 #include "openMVG/system/timer.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include "ceres/ceres.h"
 
@@ -76,6 +77,8 @@ bool Relative_Pose_Engine::Relative_Pose_Engine::Process(
   }
 
   system::Timer t;
+  system::ScopedTrace trace("Relative pose computation");
+  trace.AddCounter("pairs", posewise_matches.size());
 
   std::unique_ptr<C_Progress> progress_status
     (new C_Progress_display(posewise_matches.size(),
@@ -114,6 +117,10 @@ bool Relative_Pose_Engine::Relative_Pose_Engine::Process(
         I = current_pair.first,
         J = current_pair.second;
 
+      system::ScopedTrace pair_trace("Relative pose");
+      pair_trace.AddCounter("view_i", I);
+      pair_trace.AddCounter("view_j", J);
+
       const View
         * view_I = sfm_data_.views.at(I).get(),
         * view_J = sfm_data_.views.at(J).get();
@@ -142,6 +149,7 @@ bool Relative_Pose_Engine::Relative_Pose_Engine::Process(
 
       RelativePose_Info relativePose_info;
       relativePose_info.initial_residual_tolerance = Square(2.5);
+      relativePose_info.evaluation_options = evaluation_options_;
       if (!robustRelativePose(cam_I, cam_J,
                               x1, x2, relativePose_info,
                               {cam_I->w(), cam_I->h()},
@@ -150,6 +158,7 @@ bool Relative_Pose_Engine::Relative_Pose_Engine::Process(
       {
         continue;
       }
+      pair_trace.AddCounter("inliers", relativePose_info.vec_inliers.size());
       const bool bRefine_using_BA = true;
       if (bRefine_using_BA)
       {
@@ -12,6 +12,7 @@
 #include "openMVG/types.hpp"
 #include "openMVG/geometry/pose3.hpp"
 #include "openMVG/multiview/triangulation_method.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 
 namespace openMVG {
 namespace sfm {
@@ -52,10 +53,17 @@ public:
     triangulation_method_ = method;
   }
 
+  /// Configure the hypothesis evaluation strategy of the relative pose robust estimation
+  void SetACRansacEvaluationOptions(const robust::ACRansacEvaluationOptions & options)
+  {
+    evaluation_options_ = options;
+  }
+
 private:
   Relative_Pair_Poses relative_poses_;
 
   ETriangulationMethod triangulation_method_ = ETriangulationMethod::DEFAULT;
+  robust::ACRansacEvaluationOptions evaluation_options_;
 };
 
 } // namespace sfm
@@ -20,6 +20,7 @@
 #include "openMVG/sfm/sfm_data_filters.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/stl/stl.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include "third_party/histogram/histogram.hpp"
 #include "third_party/htmlDoc/htmlDoc.hpp"
@@ -92,6 +93,8 @@ void SequentialSfMReconstructionEngine::SetMatchesProvider(Matches_Provider * pr
 
 bool SequentialSfMReconstructionEngine::Process() {
 
+  OPENMVG_TRACE_SCOPE("Incremental SfM");
+
   //-------------------
   //-- Incremental reconstruction
   //-------------------
@@ -102,6 +105,7 @@ bool SequentialSfMReconstructionEngine::Process() {
   // Initial pair choice
   if (initial_pair_ == Pair(0,0))
   {
+    OPENMVG_TRACE_SCOPE("Initial pair choice");
     if (!AutomaticInitialPairChoice(initial_pair_))
     {
       // Cannot find a valid initial pair, try to set it by hand?
@@ -123,6 +127,8 @@ bool SequentialSfMReconstructionEngine::Process() {
   std::vector<uint32_t> vec_possible_resection_indexes;
   while (FindImagesWithPossibleResection(vec_possible_resection_indexes))
   {
+    system::ScopedTrace group_trace("Resection group");
+    group_trace.AddCounter("views", vec_possible_resection_indexes.size());
     bool bImageAdded = false;
     // Add images to the 3D reconstruction
     for (const auto & iter : vec_possible_resection_indexes)
@@ -134,9 +140,12 @@ bool SequentialSfMReconstructionEngine::Process() {
     if (bImageAdded)
     {
       // Scene logging as ply for visual debug
-      std::ostringstream os;
-      os << std::setw(8) << std::setfill('0') << resectionGroupIndex << "_Resection";
-      Save(sfm_data_, stlplus::create_filespec(sOut_directory_, os.str(), ".ply"), ESfM_Data(ALL));
+      {
+        OPENMVG_TRACE_SCOPE("Save ply");
+        std::ostringstream os;
+        os << std::setw(8) << std::setfill('0') << resectionGroupIndex << "_Resection";
+        Save(sfm_data_, stlplus::create_filespec(sOut_directory_, os.str(), ".ply"), ESfM_Data(ALL));
+      }
 
       // Perform BA until all point are under the given precision
       do
@@ -291,6 +300,8 @@ bool SequentialSfMReconstructionEngine::ChooseInitialPair(Pair & initialPairInde
 
 bool SequentialSfMReconstructionEngine::InitLandmarkTracks()
 {
+  OPENMVG_TRACE_SCOPE("Track building");
+
   // Compute tracks from matches
   tracks::TracksBuilder tracksBuilder;
 
@@ -477,6 +488,8 @@ bool SequentialSfMReconstructionEngine::AutomaticInitialPairChoice(Pair & initia
 /// Compute the initial 3D seed (First camera t=0; R=Id, second estimated by 5 point algorithm)
 bool SequentialSfMReconstructionEngine::MakeInitialPair3D(const Pair & current_pair)
 {
+  OPENMVG_TRACE_SCOPE("Initial pair reconstruction");
+
   // Compute robust Essential matrix for ImageId [I,J]
   // use min max to have I < J
   const uint32_t
@@ -878,6 +891,9 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
 {
   using namespace tracks;
 
+  system::ScopedTrace trace("Resection");
+  trace.AddCounter("view", viewIndex);
+
   // A. Compute 2D/3D matches
   // A1. list tracks ids used by the view
   openMVG::tracks::STLMAPTracks map_tracksCommon;
@@ -918,6 +934,7 @@ bool SequentialSfMReconstructionEngine::Resection(const uint32_t viewIndex)
 
   // Localize the image inside the SfM reconstruction
   Image_Localizer_Match_Data resection_data;
+  resection_data.evaluation_options = resection_evaluation_options_;
   resection_data.pt2D.resize(2, set_trackIdForResection.size());
   resection_data.pt3D.resize(3, set_trackIdForResection.size());
 
@@ -17,6 +17,7 @@
 #include "openMVG/cameras/cameras.hpp"
 #include "openMVG/multiview/solver_resection.hpp"
 #include "openMVG/multiview/triangulation_method.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/tracks/tracks.hpp"
 
 namespace htmlDocument { class htmlDocumentStream; }
@@ -85,6 +86,12 @@ public:
     resection_method_ = method;
   }
 
+  /// Configure the hypothesis evaluation strategy of the robust resection
+  void SetResectionEvaluationOptions(const robust::ACRansacEvaluationOptions & options)
+  {
+    resection_evaluation_options_ = options;
+  }
+
 protected:
 
 
@@ -134,6 +141,7 @@ private:
   ETriangulationMethod triangulation_method_ = ETriangulationMethod::DEFAULT;
 
   resection::SolverType resection_method_ = resection::SolverType::DEFAULT;
+  robust::ACRansacEvaluationOptions resection_evaluation_options_;
 };
 
 } // namespace sfm
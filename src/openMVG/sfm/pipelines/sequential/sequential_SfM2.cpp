@@ -264,7 +264,55 @@ bool SequentialSfMReconstructionEngine2::InitTracksAndLandmarks()
 
 bool SequentialSfMReconstructionEngine2::Triangulation()
 {
-  sfm_data_.structure = landmarks_;
+  // Collect the views that have a pose
+  std::set<IndexT> posed_views;
+  for (const auto & view_it : sfm_data_.GetViews())
+  {
+    if (sfm_data_.GetPoses().count(view_it.second->id_pose))
+      posed_views.insert(view_it.first);
+  }
+
+  ++triangulation_round_;
+  const bool full_triangulation =
+    triangulated_views_.empty() ||
+    (full_triangulation_period_ > 0 && triangulation_round_ % full_triangulation_period_ == 0);
+
+  // Landmarks that are not affected by the new poses (kept as they are)
+  Landmarks untouched_landmarks;
+  if (full_triangulation)
+  {
+    sfm_data_.structure = landmarks_;
+  }
+  else
+  {
+    // Only the tracks seen by the newly posed views can change:
+    //  re-triangulate them with all their observations.
+    std::set<IndexT> new_views;
+    std::set_difference(posed_views.cbegin(), posed_views.cend(),
+      triangulated_views_.cbegin(), triangulated_views_.cend(),
+      std::inserter(new_views, new_views.begin()));
+
+    std::set<IndexT> dirty_track_ids;
+    for (const IndexT view_id : new_views)
+    {
+      openMVG::tracks::STLMAPTracks view_tracks;
+      shared_track_visibility_helper_->GetTracksInImages({view_id}, view_tracks);
+      for (const auto & track_it : view_tracks)
+        dirty_track_ids.insert(track_it.first);
+    }
+
+    untouched_landmarks = std::move(sfm_data_.structure);
+    sfm_data_.structure.clear();
+    for (const IndexT track_id : dirty_track_ids)
+    {
+      sfm_data_.structure[track_id] = landmarks_.at(track_id);
+      untouched_landmarks.erase(track_id);
+    }
+    std::cout
+      << "Incremental triangulation: " << new_views.size() << " new view(s), "
+      << dirty_track_ids.size() << " track(s) to triangulate." << std::endl;
+  }
+  triangulated_views_ = std::move(posed_views);
 
   //--
   // Triangulation
@@ -284,6 +332,9 @@ bool SequentialSfMReconstructionEngine2::Triangulation()
 
   triangulation_engine.triangulate(sfm_data_);
 
+  // Restore the landmarks that have not been re-triangulated
+  sfm_data_.structure.insert(untouched_landmarks.begin(), untouched_landmarks.end());
+
   return !sfm_data_.structure.empty();
 }
 
@@ -309,6 +360,11 @@ bool SequentialSfMReconstructionEngine2::AddingMissingView
     return idx;
   }();
 
+  // The views whose pose has been removed (unstable poses) are no longer
+  //  triangulated: their tracks are triangulated again if they are localized again
+  for (const IndexT view_id : view_with_no_pose)
+    triangulated_views_.erase(view_id);
+
   const IndexT pose_before = sfm_data_.GetPoses().size();
 
   // Get the track ids of the reconstructed landmarks
@@ -366,6 +422,7 @@ bool SequentialSfMReconstructionEngine2::AddingMissingView
 
         // Localize the image inside the SfM reconstruction
         Image_Localizer_Match_Data resection_data;
+        resection_data.evaluation_options = resection_evaluation_options_;
         resection_data.pt2D.resize(2, track_id_for_resection.size());
         resection_data.pt3D.resize(3, track_id_for_resection.size());
 
@@ -17,6 +17,7 @@
 #include "openMVG/cameras/cameras.hpp"
 #include "openMVG/multiview/solver_resection.hpp"
 #include "openMVG/multiview/triangulation_method.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/tracks/tracks.hpp"
 
 namespace htmlDocument { class htmlDocumentStream; }
@@ -51,6 +52,8 @@ public:
   bool InitTracksAndLandmarks();
 
   /// Triangulate tracks
+  /// Only the tracks observed by the views posed since the previous call are
+  ///  (re)triangulated, the other landmarks are kept as they are.
   bool Triangulation();
 
   /// Adding missing view (Try to find the pose of the missing camera)
@@ -76,12 +79,26 @@ public:
     triangulation_method_ = method;
   }
 
+  /// Configure how often all the tracks are re-triangulated from scratch
+  /// (every n-th call of Triangulation). 0 means never: only the tracks seen
+  ///  by the newly posed views are triangulated.
+  void SetFullTriangulationPeriod(const unsigned int period)
+  {
+    full_triangulation_period_ = period;
+  }
+
   /// Configure the resetcion method method used by the Localization engine
   void SetResectionMethod(const resection::SolverType method)
   {
     resection_method_ = method;
   }
 
+  /// Configure the hypothesis evaluation strategy of the robust resection
+  void SetResectionEvaluationOptions(const robust::ACRansacEvaluationOptions & options)
+  {
+    resection_evaluation_options_ = options;
+  }
+
 private:
 
   //----
@@ -113,6 +130,12 @@ private:
   ETriangulationMethod triangulation_method_ = ETriangulationMethod::DEFAULT;
 
   resection::SolverType resection_method_ = resection::SolverType::DEFAULT;
+  robust::ACRansacEvaluationOptions resection_evaluation_options_;
+
+  /// Incremental triangulation
+  std::set<IndexT> triangulated_views_; // Posed views at the last triangulation (still posed)
+  unsigned int full_triangulation_period_ = 0;
+  unsigned int triangulation_round_ = 0;
 };
 
 } // namespace sfm
@@ -91,6 +91,77 @@ TEST(SEQUENTIAL_SFM2_STELLAR, Known_Intrinsics) {
   EXPECT_TRUE( IsTracksOneCC(sfmEngine.Get_SfM_Data()));
 }
 
+// Engine giving access to its scene, in order to simulate an unstable pose removal
+class SequentialSfMReconstructionEngine2_Test : public SequentialSfMReconstructionEngine2
+{
+public:
+  using SequentialSfMReconstructionEngine2::SequentialSfMReconstructionEngine2;
+  SfM_Data & Scene() { return sfm_data_; }
+};
+
+// Test that a view whose pose has been removed and then localized again
+//  has its tracks triangulated again
+TEST(SEQUENTIAL_SFM2_STELLAR, Relocalized_View_Triangulation) {
+
+  const int nviews = 6;
+  const int npoints = 32;
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  // Translate the input dataset to a SfM_Data scene
+  const SfM_Data sfm_data = getInputScene(d, config, PINHOLE_CAMERA);
+
+  // Remove poses and structure
+  SfM_Data sfm_data_2 = sfm_data;
+  sfm_data_2.poses.clear();
+  sfm_data_2.structure.clear();
+
+  // Configure the features_provider & the matches_provider from the synthetic dataset
+  std::shared_ptr<Features_Provider> feats_provider =
+    std::make_shared<Synthetic_Features_Provider>();
+  std::normal_distribution<double> distribution(0.0, 0.0);
+  dynamic_cast<Synthetic_Features_Provider*>(feats_provider.get())->load(d,distribution);
+
+  std::shared_ptr<Matches_Provider> matches_provider =
+    std::make_shared<Synthetic_Matches_Provider>();
+  dynamic_cast<Synthetic_Matches_Provider*>(matches_provider.get())->load(d);
+
+  std::unique_ptr<SfMSceneInitializer> scene_initializer;
+  scene_initializer.reset(new SfMSceneInitializerStellar(sfm_data_2,
+    feats_provider.get(),
+    matches_provider.get()));
+
+  SequentialSfMReconstructionEngine2_Test sfmEngine(
+    scene_initializer.get(),
+    sfm_data_2,
+    "./",
+    stlplus::create_filespec("./", "Reconstruction_Report.html"));
+
+  sfmEngine.SetFeaturesProvider(feats_provider.get());
+  sfmEngine.SetMatchesProvider(matches_provider.get());
+  sfmEngine.Set_Intrinsics_Refinement_Type(cameras::Intrinsic_Parameter_Type::NONE);
+
+  EXPECT_TRUE (sfmEngine.Process());
+  EXPECT_TRUE( sfmEngine.Get_SfM_Data().GetPoses().size() == nviews);
+
+  // Remove the pose of a view and its observations (as an unstable pose)
+  SfM_Data & scene = sfmEngine.Scene();
+  const IndexT removed_view_id = scene.GetViews().cbegin()->first;
+  scene.poses.erase(scene.GetViews().at(removed_view_id)->id_pose);
+  for (auto & landmark_it : scene.structure)
+    landmark_it.second.obs.erase(removed_view_id);
+
+  // Localize it again: the tracks it observes are triangulated with its observations
+  EXPECT_TRUE( sfmEngine.AddingMissingView(0.0f));
+  EXPECT_TRUE( sfmEngine.Triangulation());
+  EXPECT_TRUE( sfmEngine.Get_SfM_Data().GetPoses().size() == nviews);
+  EXPECT_TRUE( sfmEngine.Get_SfM_Data().GetLandmarks().size() == npoints);
+  for (const auto & landmark_it : sfmEngine.Get_SfM_Data().GetLandmarks())
+  {
+    EXPECT_EQ(1, landmark_it.second.obs.count(removed_view_id));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -16,6 +16,7 @@
 #include "openMVG/features/feature_container.hpp"
 #include "openMVG/features/regions.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 
 #include "third_party/progress/progress_display.hpp"
@@ -38,6 +39,8 @@ struct Features_Provider
     const std::string & feat_directory,
     std::unique_ptr<features::Regions>& region_type)
   {
+    system::ScopedTrace trace("Features loading", "io");
+    trace.AddCounter("views", sfm_data.GetViews().size());
     C_Progress_display my_progress_bar( sfm_data.GetViews().size(),
       std::cout, "\n- Features Loading -\n" );
     // Read for each view the corresponding features and store them as PointFeatures
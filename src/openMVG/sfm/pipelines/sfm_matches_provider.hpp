@@ -14,6 +14,7 @@
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/matching/indMatch_utils.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
@@ -31,6 +32,7 @@ struct Matches_Provider
   // Load matches from the provided matches file
   virtual bool load(const SfM_Data & sfm_data, const std::string & matchesfile)
   {
+    system::ScopedTrace trace("Matches loading", "io");
     if (!stlplus::is_file(matchesfile))
     {
       return false;
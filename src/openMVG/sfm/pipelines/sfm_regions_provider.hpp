@@ -16,6 +16,7 @@
 #include "openMVG/features/image_describer.hpp"
 #include "openMVG/features/regions_factory.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 
 #include "third_party/progress/progress.hpp"
@@ -96,6 +97,8 @@ public:
       my_progress_bar = &C_Progress::dummy();
     region_type_.reset(region_type->EmptyClone());
 
+    system::ScopedTrace trace("Regions loading", "io");
+    trace.AddCounter("views", sfm_data.GetViews().size());
     my_progress_bar->restart(sfm_data.GetViews().size(), "\n- Regions Loading -\n");
     // Read for each view the corresponding regions and store them
     std::atomic<bool> bContinue(true);
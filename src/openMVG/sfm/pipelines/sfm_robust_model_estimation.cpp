@@ -19,6 +19,7 @@
 #include "openMVG/numeric/numeric.h"
 #include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 #include "openMVG/robust_estimation/robust_estimator_ACRansacKernelAdaptator.hpp"
+#include "openMVG/system/trace.hpp"
 
 using namespace openMVG::cameras;
 using namespace openMVG::geometry;
@@ -41,6 +42,9 @@ bool robustRelativePose
   if (!intrinsics1 || !intrinsics2)
     return false;
 
+  system::ScopedTrace trace("AC-RANSAC relative pose", "robust_estimation");
+  trace.AddCounter("correspondences", x1.cols());
+
   // Compute the bearing vectors
   const Mat3X
     bearing1 = (*intrinsics1)(x1),
@@ -63,7 +67,8 @@ bool robustRelativePose
     const auto ac_ransac_output = robust::ACRANSAC(
       kernel, relativePose_info.vec_inliers,
       max_iteration_count, &relativePose_info.essential_matrix,
-      relativePose_info.initial_residual_tolerance, false);
+      relativePose_info.initial_residual_tolerance, false,
+      relativePose_info.evaluation_options);
 
     relativePose_info.found_residual_precision = ac_ransac_output.first;
 
@@ -93,7 +98,8 @@ bool robustRelativePose
     const auto ac_ransac_output =
       ACRANSAC(kernel, relativePose_info.vec_inliers,
         max_iteration_count, &relativePose_info.essential_matrix,
-        upper_bound_precision, false);
+        upper_bound_precision, false,
+        relativePose_info.evaluation_options);
 
     const double & threshold = ac_ransac_output.first;
     relativePose_info.found_residual_precision = R2D(threshold); // Degree
@@ -105,6 +111,8 @@ bool robustRelativePose
     }
   }
 
+  trace.AddCounter("inliers", relativePose_info.vec_inliers.size());
+
   // estimation of the relative poses based on the cheirality test
   Pose3 relative_pose;
   if (!RelativePoseFromEssential(
@@ -15,6 +15,7 @@
 
 #include "openMVG/geometry/pose3.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
+#include "openMVG/robust_estimation/robust_estimator_ACRansac.hpp"
 
 namespace openMVG { namespace cameras { struct IntrinsicBase; } }
 
@@ -28,6 +29,8 @@ struct RelativePose_Info
   std::vector<uint32_t> vec_inliers;
   double initial_residual_tolerance;
   double found_residual_precision;
+  /// Hypothesis evaluation strategy of the robust estimation
+  robust::ACRansacEvaluationOptions evaluation_options;
 
   RelativePose_Info()
     :initial_residual_tolerance(std::numeric_limits<double>::infinity()),
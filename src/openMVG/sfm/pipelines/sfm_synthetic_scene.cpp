@@ -0,0 +1,333 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/sfm/pipelines/sfm_synthetic_scene.hpp"
+#include "openMVG/cameras/Camera_Pinhole.hpp"
+#include "openMVG/features/regions_factory_io.hpp"
+#include "openMVG/matching/indMatch_utils.hpp"
+#include "openMVG/numeric/numeric.h"
+#include "openMVG/sfm/sfm_data_io.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include <cereal/archives/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openMVG {
+namespace sfm {
+
+namespace {
+
+// Spatial hashing of the camera centers (cubic cells)
+class CameraGrid
+{
+public:
+  CameraGrid(const double cell_size) : cell_size_(cell_size) {}
+
+  void Insert(const Vec3 & center, const IndexT view_id)
+  {
+    cells_[Key(Cell(center))].push_back(view_id);
+  }
+
+  // Call the functor for each camera of the cells around the point
+  template <typename Functor>
+  void ForEachNeighbor(const Vec3 & point, Functor functor) const
+  {
+    const Eigen::Vector3i cell = Cell(point);
+    for (int dx = -1; dx <= 1; ++dx)
+      for (int dy = -1; dy <= 1; ++dy)
+        for (int dz = -1; dz <= 1; ++dz)
+        {
+          const auto it = cells_.find(Key(cell + Eigen::Vector3i(dx, dy, dz)));
+          if (it == cells_.end())
+            continue;
+          for (const IndexT view_id : it->second)
+            functor(view_id);
+        }
+  }
+
+private:
+  Eigen::Vector3i Cell(const Vec3 & point) const
+  {
+    return (point / cell_size_).array().floor().cast<int>();
+  }
+
+  static uint64_t Key(const Eigen::Vector3i & cell)
+  {
+    // 21 bits per axis
+    const uint64_t mask = (uint64_t(1) << 21) - 1;
+    return ((uint64_t(cell(0)) & mask) << 42) |
+           ((uint64_t(cell(1)) & mask) << 21) |
+            (uint64_t(cell(2)) & mask);
+  }
+
+  double cell_size_;
+  std::unordered_map<uint64_t, std::vector<IndexT>> cells_;
+};
+
+// Camera center and looking direction (with its up vector) of the i-th view
+void TrajectoryPose
+(
+  const SyntheticSceneOptions & options,
+  const IndexT i,
+  Vec3 & center,
+  Vec3 & look_direction,
+  Vec3 & up
+)
+{
+  up = Vec3::UnitY();
+  switch (options.trajectory)
+  {
+    case ESyntheticTrajectory::RING:
+    {
+      // The radius is set to keep the asked spacing between the cameras
+      const double radius = std::max(
+        options.view_count * options.camera_spacing / (2.0 * M_PI),
+        options.max_depth);
+      const double theta = i * 2.0 * M_PI / options.view_count;
+      center << radius * sin(theta), 0.0, radius * cos(theta);
+      look_direction = -center;
+    }
+    break;
+    case ESyntheticTrajectory::LINE:
+    {
+      center << i * options.camera_spacing, 0.0, 0.0;
+      look_direction = Vec3::UnitZ();
+    }
+    break;
+    case ESyntheticTrajectory::GRID:
+    {
+      const IndexT column_count =
+        static_cast<IndexT>(std::ceil(std::sqrt(static_cast<double>(options.view_count))));
+      center << (i % column_count) * options.camera_spacing,
+                0.0,
+                (i / column_count) * options.camera_spacing;
+      look_direction = -Vec3::UnitY();
+      up = Vec3::UnitZ();
+    }
+    break;
+  }
+}
+
+} // namespace
+
+bool GenerateSyntheticScene
+(
+  const SyntheticSceneOptions & options,
+  SyntheticScene & scene
+)
+{
+  if (options.view_count < 2 ||
+      options.max_track_length < 2 ||
+      options.min_depth <= 0.0 ||
+      options.max_depth < options.min_depth ||
+      options.outlier_ratio < 0.0 || options.outlier_ratio >= 1.0 ||
+      options.focal <= 0.0 || options.image_width == 0 || options.image_height == 0)
+  {
+    std::cerr << "Invalid synthetic scene options." << std::endl;
+    return false;
+  }
+
+  scene = SyntheticScene();
+  SfM_Data & sfm_data = scene.sfm_data;
+  auto & features = scene.features_provider.feats_per_view;
+  matching::PairWiseMatches & matches = scene.matches_provider.pairWise_matches_;
+
+  std::mt19937 random_generator(options.seed);
+  std::uniform_real_distribution<double> jitter_distribution(
+    -options.rotation_jitter, options.rotation_jitter);
+  std::normal_distribution<double> noise_distribution(0.0, options.observation_noise);
+
+  const double w = options.image_width, h = options.image_height;
+  const auto intrinsic = std::make_shared<cameras::Pinhole_Intrinsic>
+    (options.image_width, options.image_height, options.focal, w / 2.0, h / 2.0);
+  sfm_data.intrinsics[0] = intrinsic;
+
+  // A camera sees the points at a distance lower than the frustum corner
+  //  distance at the max depth, so the grid cell size allows to find all the
+  //  cameras that can see a point in its 27 neighbor cells.
+  const double max_view_distance = options.max_depth *
+    std::sqrt(1.0 + Square(w / (2.0 * options.focal)) + Square(h / (2.0 * options.focal)));
+  CameraGrid camera_grid(max_view_distance);
+
+  //-- Views, poses & camera grid
+  std::vector<geometry::Pose3> poses(options.view_count);
+  for (IndexT i = 0; i < options.view_count; ++i)
+  {
+    Vec3 center, look_direction, up;
+    TrajectoryPose(options, i, center, look_direction, up);
+    const Mat3 R =
+      RotationAroundX(jitter_distribution(random_generator)) *
+      RotationAroundY(jitter_distribution(random_generator)) *
+      RotationAroundZ(jitter_distribution(random_generator)) *
+      LookAt(look_direction, up);
+    poses[i] = geometry::Pose3(R, center);
+
+    std::ostringstream os;
+    os << std::setw(8) << std::setfill('0') << i << ".jpg";
+    sfm_data.views[i] = std::make_shared<View>
+      (os.str(), i, 0, i, options.image_width, options.image_height);
+    sfm_data.poses[i] = poses[i];
+    features[i] = features::PointFeatures();
+    camera_grid.Insert(center, i);
+  }
+
+  //-- Landmarks, observations & matches
+  std::uniform_int_distribution<IndexT> view_distribution(0, options.view_count - 1);
+  std::uniform_real_distribution<double>
+    x_distribution(0.0, w), y_distribution(0.0, h),
+    depth_distribution(options.min_depth, options.max_depth);
+
+  std::vector<std::pair<double, IndexT>> visible_views;
+  IndexT landmark_id = 0;
+  // Stop if the scene is too sparse to get the asked number of landmarks
+  const uint64_t max_attempt_count = 10 * static_cast<uint64_t>(options.landmark_count);
+  for (uint64_t attempt = 0;
+       attempt < max_attempt_count && landmark_id < options.landmark_count;
+       ++attempt)
+  {
+    // Spawn a point in the frustum of a random camera
+    const geometry::Pose3 & anchor_pose = poses[view_distribution(random_generator)];
+    const Vec3 ray = intrinsic->ima2cam(
+      Vec2(x_distribution(random_generator), y_distribution(random_generator))).homogeneous();
+    const Vec3 X = anchor_pose.center() +
+      anchor_pose.rotation().transpose() * ray * depth_distribution(random_generator);
+
+    // Find the closest cameras that see it
+    visible_views.clear();
+    camera_grid.ForEachNeighbor(X, [&](const IndexT view_id)
+    {
+      const Vec3 Xc = poses[view_id](X);
+      if (Xc(2) <= 0.0 || Xc(2) > options.max_depth)
+        return;
+      const Vec2 x = intrinsic->project(Xc);
+      if (x(0) < 0.0 || x(0) >= w || x(1) < 0.0 || x(1) >= h)
+        return;
+      visible_views.emplace_back((poses[view_id].center() - X).squaredNorm(), view_id);
+    });
+    if (visible_views.size() < 2)
+      continue;
+    if (visible_views.size() > options.max_track_length)
+    {
+      std::partial_sort(visible_views.begin(),
+        visible_views.begin() + options.max_track_length, visible_views.end());
+      visible_views.resize(options.max_track_length);
+    }
+
+    Landmark & landmark = sfm_data.structure[landmark_id++];
+    landmark.X = X;
+    for (const auto & visible_view : visible_views)
+    {
+      const IndexT view_id = visible_view.second;
+      features::PointFeatures & view_features = features[view_id];
+      const Vec2 x = intrinsic->project(poses[view_id](X)) +
+        Vec2(noise_distribution(random_generator), noise_distribution(random_generator));
+      landmark.obs[view_id] = Observation(x, view_features.size());
+      view_features.emplace_back(x(0), x(1));
+    }
+    // Inlier matches: all the observation pairs
+    for (auto obs_i = landmark.obs.cbegin(); obs_i != landmark.obs.cend(); ++obs_i)
+      for (auto obs_j = std::next(obs_i); obs_j != landmark.obs.cend(); ++obs_j)
+      {
+        if (obs_i->first < obs_j->first)
+          matches[{obs_i->first, obs_j->first}].emplace_back(
+            obs_i->second.id_feat, obs_j->second.id_feat);
+        else
+          matches[{obs_j->first, obs_i->first}].emplace_back(
+            obs_j->second.id_feat, obs_i->second.id_feat);
+      }
+  }
+  if (landmark_id < options.landmark_count)
+  {
+    std::cerr << "The synthetic scene contains " << landmark_id << " landmarks only"
+      << " (the cameras do not overlap enough)." << std::endl;
+  }
+
+  //-- Outlier matches: random feature pairs
+  if (options.outlier_ratio > 0.0)
+  {
+    const double outlier_per_inlier = options.outlier_ratio / (1.0 - options.outlier_ratio);
+    for (auto & pair_matches : matches)
+    {
+      const IndexT outlier_count =
+        static_cast<IndexT>(std::round(pair_matches.second.size() * outlier_per_inlier));
+      std::uniform_int_distribution<IndexT>
+        feature_i(0, features[pair_matches.first.first].size() - 1),
+        feature_j(0, features[pair_matches.first.second].size() - 1);
+      for (IndexT k = 0; k < outlier_count; ++k)
+        pair_matches.second.emplace_back(
+          feature_i(random_generator), feature_j(random_generator));
+    }
+  }
+  return true;
+}
+
+bool ExportSyntheticScene
+(
+  const SyntheticScene & scene,
+  const std::string & directory
+)
+{
+  if (!stlplus::folder_exists(directory) && !stlplus::folder_create(directory))
+  {
+    std::cerr << "Cannot create the output directory: " << directory << std::endl;
+    return false;
+  }
+
+  // The scene (pipeline input: views & intrinsic) and its ground truth
+  if (!Save(scene.sfm_data, stlplus::create_filespec(directory, "sfm_data.json"),
+            ESfM_Data(VIEWS | INTRINSICS)) ||
+      !Save(scene.sfm_data, stlplus::create_filespec(directory, "sfm_data_gt.bin"),
+            ESfM_Data(ALL)))
+  {
+    return false;
+  }
+
+  // The regions type used to read the features
+  {
+    std::ofstream stream(stlplus::create_filespec(directory, "image_describer.json"));
+    if (!stream.is_open())
+      return false;
+    cereal::JSONOutputArchive archive(stream);
+    std::unique_ptr<features::Regions> regions_type(new features::SIFT_Regions);
+    archive(cereal::make_nvp("regions_type", regions_type));
+  }
+
+  // The features, as SIFT keypoints
+  for (const auto & view_it : scene.sfm_data.GetViews())
+  {
+    const features::PointFeatures & point_features =
+      scene.features_provider.getFeatures(view_it.first);
+    features::SIOPointFeatures sio_features;
+    sio_features.reserve(point_features.size());
+    for (const features::PointFeature & feature : point_features)
+      sio_features.emplace_back(feature.x(), feature.y(), 1.0f, 0.0f);
+    const std::string feat_file = stlplus::create_filespec(directory,
+      stlplus::basename_part(view_it.second->s_Img_path), ".feat");
+    if (!features::saveFeatsToFile(feat_file, sio_features))
+    {
+      std::cerr << "Cannot write the feature file: " << feat_file << std::endl;
+      return false;
+    }
+  }
+
+  return matching::Save(scene.matches_provider.pairWise_matches_,
+                        stlplus::create_filespec(directory, "matches.f.bin"));
+}
+
+} // namespace sfm
+} // namespace openMVG
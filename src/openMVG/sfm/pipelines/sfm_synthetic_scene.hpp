@@ -0,0 +1,105 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SFM_PIPELINES_SFM_SYNTHETIC_SCENE_HPP
+#define OPENMVG_SFM_PIPELINES_SFM_SYNTHETIC_SCENE_HPP
+
+#include "openMVG/sfm/pipelines/sfm_features_provider.hpp"
+#include "openMVG/sfm/pipelines/sfm_matches_provider.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+
+#include <random>
+#include <string>
+
+namespace openMVG {
+namespace sfm {
+
+/// Camera trajectories of the synthetic scene generator
+enum class ESyntheticTrajectory
+{
+  RING, // cameras on a circle, looking at its center (object capture)
+  LINE, // cameras on a line, looking sideways (street capture)
+  GRID  // cameras on a regular grid, looking down (aerial capture)
+};
+
+struct SyntheticSceneOptions
+{
+  ESyntheticTrajectory trajectory = ESyntheticTrajectory::LINE;
+  IndexT view_count = 100;
+  IndexT landmark_count = 10000;
+
+  // Scene geometry (world unit)
+  double camera_spacing = 1.0; // distance between two neighbor cameras
+  double min_depth = 2.0;      // depth range of the landmarks
+  double max_depth = 6.0;      //  (i.e. the feature detection range)
+  double rotation_jitter = 0.02; // random orientation perturbation (radian)
+
+  // Camera (shared pinhole intrinsic)
+  unsigned int image_width = 1600;
+  unsigned int image_height = 1200;
+  double focal = 1600.0;
+
+  // Observations
+  IndexT max_track_length = 6;    // observations are kept for the closest cameras
+  double observation_noise = 0.5; // gaussian noise (pixel standard deviation)
+  double outlier_ratio = 0.05;    // ratio of wrong matches of each pair [0;1[
+
+  unsigned int seed = std::mt19937::default_seed;
+};
+
+/// A synthetic scene and the data needed to reconstruct it:
+/// - sfm_data: the ground truth (views, intrinsic, poses and landmarks,
+///   the landmark observations are the noisy features),
+/// - features_provider: the noisy features of each view,
+/// - matches_provider: the putative matches (inliers and outliers) of the
+///   view pairs that share some landmarks.
+struct SyntheticScene
+{
+  SfM_Data sfm_data;
+  Features_Provider features_provider;
+  Matches_Provider matches_provider;
+};
+
+/**
+* @brief Generate a synthetic scene of any size.
+*  Each landmark is spawned in the view frustum of a random camera and is
+*  observed by the closest cameras that see it. The camera neighborhoods are
+*  found with a spatial hashing of the camera centers, so the generation time
+*  is linear in the number of landmarks.
+*
+* @param[in] options The scene configuration
+* @param[out] scene The generated scene
+* @return False if the options are invalid
+*/
+bool GenerateSyntheticScene
+(
+  const SyntheticSceneOptions & options,
+  SyntheticScene & scene
+);
+
+/**
+* @brief Export a synthetic scene as the openMVG SfM pipelines input:
+*  - sfm_data.json: views and intrinsic,
+*  - sfm_data_gt.bin: the ground truth scene,
+*  - image_describer.json and one .feat file per view (SIFT regions type),
+*  - matches.f.bin: the putative matches.
+*
+* @param[in] scene The scene to export
+* @param[in] directory The output directory (created if needed)
+* @return True if all the files were written
+*/
+bool ExportSyntheticScene
+(
+  const SyntheticScene & scene,
+  const std::string & directory
+);
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // OPENMVG_SFM_PIPELINES_SFM_SYNTHETIC_SCENE_HPP
@@ -0,0 +1,131 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/sfm/pipelines/sfm_synthetic_scene.hpp"
+
+#include "testing/testing.h"
+
+using namespace openMVG;
+using namespace openMVG::sfm;
+
+TEST(SyntheticScene, InvalidOptions)
+{
+  SyntheticScene scene;
+  SyntheticSceneOptions options;
+  options.view_count = 1;
+  EXPECT_FALSE(GenerateSyntheticScene(options, scene));
+
+  options = SyntheticSceneOptions();
+  options.outlier_ratio = 1.0;
+  EXPECT_FALSE(GenerateSyntheticScene(options, scene));
+
+  options = SyntheticSceneOptions();
+  options.min_depth = 10.0;
+  EXPECT_FALSE(GenerateSyntheticScene(options, scene));
+}
+
+TEST(SyntheticScene, NoiseFreeObservations)
+{
+  for (const ESyntheticTrajectory trajectory :
+    {ESyntheticTrajectory::RING, ESyntheticTrajectory::LINE, ESyntheticTrajectory::GRID})
+  {
+    SyntheticSceneOptions options;
+    options.trajectory = trajectory;
+    options.view_count = 25;
+    options.landmark_count = 2000;
+    options.observation_noise = 0.0;
+    options.outlier_ratio = 0.0;
+
+    SyntheticScene scene;
+    EXPECT_TRUE(GenerateSyntheticScene(options, scene));
+    const SfM_Data & sfm_data = scene.sfm_data;
+    EXPECT_EQ(options.view_count, sfm_data.GetViews().size());
+    EXPECT_EQ(options.view_count, sfm_data.GetPoses().size());
+    EXPECT_EQ(options.landmark_count, sfm_data.GetLandmarks().size());
+
+    // The observations are the projections of the landmarks and their
+    //  feature ids point to the same image positions.
+    size_t observation_count = 0;
+    for (const auto & landmark_it : sfm_data.GetLandmarks())
+    {
+      const Landmark & landmark = landmark_it.second;
+      EXPECT_TRUE(landmark.obs.size() >= 2);
+      EXPECT_TRUE(landmark.obs.size() <= options.max_track_length);
+      for (const auto & obs_it : landmark.obs)
+      {
+        const View * view = sfm_data.GetViews().at(obs_it.first).get();
+        const geometry::Pose3 pose = sfm_data.GetPoseOrDie(view);
+        const Vec2 x = sfm_data.GetIntrinsics().at(view->id_intrinsic)->project(pose(landmark.X));
+        EXPECT_NEAR(0.0, (x - obs_it.second.x).norm(), 1e-8);
+        const features::PointFeature & feature =
+          scene.features_provider.getFeatures(obs_it.first)[obs_it.second.id_feat];
+        EXPECT_NEAR(0.0, (feature.coords().cast<double>() - x).norm(), 1e-2);
+        ++observation_count;
+      }
+    }
+
+    // Each landmark of length n brings n*(n-1)/2 matches
+    size_t match_count = 0, expected_match_count = 0;
+    for (const auto & landmark_it : sfm_data.GetLandmarks())
+    {
+      const size_t n = landmark_it.second.obs.size();
+      expected_match_count += n * (n - 1) / 2;
+    }
+    for (const auto & pair_matches : scene.matches_provider.pairWise_matches_)
+    {
+      EXPECT_TRUE(pair_matches.first.first < pair_matches.first.second);
+      match_count += pair_matches.second.size();
+    }
+    EXPECT_EQ(expected_match_count, match_count);
+    EXPECT_TRUE(observation_count > 2 * options.landmark_count);
+  }
+}
+
+TEST(SyntheticScene, OutlierMatches)
+{
+  SyntheticSceneOptions options;
+  options.view_count = 20;
+  options.landmark_count = 5000;
+
+  SyntheticScene scene;
+  EXPECT_TRUE(GenerateSyntheticScene(options, scene));
+
+  // Count the matches that do not link two observations of the same landmark
+  size_t match_count = 0, outlier_count = 0;
+  for (const auto & pair_matches : scene.matches_provider.pairWise_matches_)
+  {
+    std::map<IndexT, IndexT> feature_to_landmark_i, feature_to_landmark_j;
+    for (const auto & landmark_it : scene.sfm_data.GetLandmarks())
+    {
+      const Observations & obs = landmark_it.second.obs;
+      const auto obs_i = obs.find(pair_matches.first.first);
+      const auto obs_j = obs.find(pair_matches.first.second);
+      if (obs_i != obs.end())
+        feature_to_landmark_i[obs_i->second.id_feat] = landmark_it.first;
+      if (obs_j != obs.end())
+        feature_to_landmark_j[obs_j->second.id_feat] = landmark_it.first;
+    }
+    for (const matching::IndMatch & match : pair_matches.second)
+    {
+      if (feature_to_landmark_i.at(match.i_) != feature_to_landmark_j.at(match.j_))
+        ++outlier_count;
+    }
+    match_count += pair_matches.second.size();
+  }
+  EXPECT_NEAR(options.outlier_ratio, outlier_count / static_cast<double>(match_count), 0.01);
+
+  // The same seed produces the same scene
+  SyntheticScene scene_bis;
+  EXPECT_TRUE(GenerateSyntheticScene(options, scene_bis));
+  EXPECT_TRUE(scene.matches_provider.pairWise_matches_ ==
+              scene_bis.matches_provider.pairWise_matches_);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
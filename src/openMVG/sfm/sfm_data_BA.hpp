@@ -9,7 +9,10 @@
 #ifndef OPENMVG_SFM_SFM_DATA_BA_HPP
 #define OPENMVG_SFM_SFM_DATA_BA_HPP
 
+#include <set>
+
 #include "openMVG/cameras/Camera_Common.hpp"
+#include "openMVG/types.hpp"
 
 namespace openMVG {
 namespace sfm {
@@ -54,6 +57,7 @@ struct Optimize_Options
   Structure_Parameter_Type structure_opt;
   Control_Point_Parameter control_point_opt;
   bool use_motion_priors_opt;
+  std::set<IndexT> constant_poses_opt; // Poses held as constant whatever extrinsics_opt
 
   Optimize_Options
   (
@@ -23,6 +23,7 @@
 #include "openMVG/sfm/sfm_data_BA_ceres_camera_functor.hpp"
 #include "openMVG/sfm/sfm_data_transform.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 
 #include <ceres/rotation.h>
@@ -168,6 +169,8 @@ bool Bundle_Adjustment_Ceres::Adjust
   const Optimize_Options & options
 )
 {
+  OPENMVG_TRACE_SCOPE("Bundle adjustment");
+
   //----------
   // Add camera parameters
   // - intrinsics
@@ -257,7 +260,8 @@ bool Bundle_Adjustment_Ceres::Adjust
 
     double * parameter_block = &map_poses.at(indexPose)[0];
     problem.AddParameterBlock(parameter_block, 6);
-    if (options.extrinsics_opt == Extrinsic_Parameter_Type::NONE)
+    if (options.extrinsics_opt == Extrinsic_Parameter_Type::NONE
+        || options.constant_poses_opt.count(indexPose))
     {
       // set the whole parameter block as constant for best performance
       problem.SetParameterBlockConstant(parameter_block);
@@ -472,7 +476,13 @@ bool Bundle_Adjustment_Ceres::Adjust
 
   // Solve BA
   ceres::Solver::Summary summary;
-  ceres::Solve(ceres_config_options, &problem, &summary);
+  {
+    system::ScopedTrace trace("Ceres solve", "ba");
+    ceres::Solve(ceres_config_options, &problem, &summary);
+    trace.AddCounter("residuals", summary.num_residuals);
+    trace.AddCounter("parameter_blocks", summary.num_parameter_blocks);
+    trace.AddCounter("iterations", summary.iterations.size());
+  }
   if (ceres_options_.bCeres_summary_)
     std::cout << summary.FullReport() << std::endl;
 
@@ -306,6 +306,44 @@ TEST(BUNDLE_ADJUSTMENT, EffectiveMinimization_Pinhole_PosePriors) {
 }
 
 
+TEST(BUNDLE_ADJUSTMENT, EffectiveMinimization_Pinhole_ConstantPoses) {
+
+  const int nviews = 4;
+  const int npoints = 20;
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  // Translate the input dataset to a SfM_Data scene
+  SfM_Data sfm_data = getInputScene(d, config, PINHOLE_CAMERA);
+  const Poses poses_before = sfm_data.poses;
+
+  const double dResidual_before = RMSE(sfm_data);
+
+  // Refine the structure and the last poses, the first two poses are held as constant
+  const bool bVerbose = true;
+  const bool bMultithread = false;
+  std::shared_ptr<Bundle_Adjustment> ba_object =
+    std::make_shared<Bundle_Adjustment_Ceres>(
+      Bundle_Adjustment_Ceres::BA_Ceres_options(bVerbose, bMultithread));
+  Optimize_Options ba_refine_options(
+    Intrinsic_Parameter_Type::NONE,
+    Extrinsic_Parameter_Type::ADJUST_ALL,
+    Structure_Parameter_Type::ADJUST_ALL);
+  ba_refine_options.constant_poses_opt = {0, 1};
+  EXPECT_TRUE( ba_object->Adjust(sfm_data, ba_refine_options) );
+
+  const double dResidual_after = RMSE(sfm_data);
+  EXPECT_TRUE( dResidual_before > dResidual_after);
+
+  for (const IndexT pose_id : {0, 1})
+  {
+    EXPECT_MATRIX_NEAR(poses_before.at(pose_id).rotation(), sfm_data.poses.at(pose_id).rotation(), 1e-12);
+    EXPECT_MATRIX_NEAR(poses_before.at(pose_id).center(), sfm_data.poses.at(pose_id).center(), 1e-12);
+  }
+  EXPECT_TRUE( (poses_before.at(3).center() - sfm_data.poses.at(3).center()).norm() > 0.0 );
+}
+
+
 /// Compute the Root Mean Square Error of the residuals
 double RMSE(const SfM_Data & sfm_data)
 {
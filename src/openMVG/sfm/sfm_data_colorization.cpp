@@ -13,129 +13,222 @@
 #include "openMVG/image/image_io.hpp"
 #include "openMVG/image/pixel_types.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
-#include "openMVG/stl/stl.hpp"
 
 #include "third_party/progress/progress_display.hpp"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <queue>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace openMVG {
 namespace sfm {
 
-/// Find the color of the SfM_Data Landmarks/structure
+namespace {
+
+/// A pixel to sample in a view and the slot where its color must be stored
+struct ColorSample
+{
+  IndexT slot;
+  Vec2 x;
+};
+
+/// A view to decode and the samples it has to provide
+struct ColorizationJob
+{
+  IndexT view_id;
+  std::vector<ColorSample> samples;
+};
+
+/// Read an image as RGB.
+/// JPEG images can be decoded at a reduced resolution (image_scale returns
+///  the factor that is actually applied).
+bool ReadColorImage
+(
+  const std::string & filename,
+  const int jpeg_downscale,
+  image::Image<image::RGBColor> * image_rgb,
+  int * image_scale
+)
+{
+  const bool b_downscale =
+    (jpeg_downscale == 2 || jpeg_downscale == 4 || jpeg_downscale == 8)
+    && image::GetFormat(filename.c_str()) == image::Jpg;
+  *image_scale = b_downscale ? jpeg_downscale : 1;
+
+  if (image::ReadImage(filename.c_str(), image_rgb, *image_scale))
+    return true;
+  //try Gray level
+  image::Image<unsigned char> image_gray;
+  if (!image::ReadImage(filename.c_str(), &image_gray, *image_scale))
+    return false;
+  image::ConvertPixelType(image_gray, image_rgb);
+  return true;
+}
+
+} // namespace
+
 bool ColorizeTracks(
   const SfM_Data & sfm_data,
   std::vector<Vec3> & vec_3dPoints,
-  std::vector<Vec3> & vec_tracksColor)
+  std::vector<Vec3> & vec_tracksColor,
+  const Colorization_Options & options)
 {
-  // Colorize each track
-  // Start with the most representative image
-  //   and iterate to provide a color to each 3D point
-
-  {
-    C_Progress_display my_progress_bar(sfm_data.GetLandmarks().size(),
-                                       std::cout,
-                                       "\nCompute scene structure color\n");
+  const Landmarks & landmarks = sfm_data.GetLandmarks();
 
-    vec_tracksColor.resize(sfm_data.GetLandmarks().size());
-    vec_3dPoints.resize(sfm_data.GetLandmarks().size());
+  vec_tracksColor.assign(landmarks.size(), Vec3::Zero());
+  vec_3dPoints.resize(landmarks.size());
 
-    //Build a list of contiguous index for the trackIds
-    std::map<IndexT, IndexT> trackIds_to_contiguousIndexes;
+  // Build a list of contiguous index for the trackIds and the range of color
+  //  slots that belongs to each track:
+  //  - one slot per track if a single view is used to color it,
+  //  - one slot per observation if the observation colors are averaged.
+  std::vector<IndexT> slot_offsets(landmarks.size() + 1, 0);
+  std::map<IndexT, std::vector<ColorSample>> samples_per_view;
+  {
     IndexT cpt = 0;
-    for (Landmarks::const_iterator it = sfm_data.GetLandmarks().begin();
-      it != sfm_data.GetLandmarks().end(); ++it, ++cpt)
+    for (const auto & landmark_it : landmarks)
     {
-      trackIds_to_contiguousIndexes[it->first] = cpt;
-      vec_3dPoints[cpt] = it->second.X;
+      vec_3dPoints[cpt] = landmark_it.second.X;
+      const Observations & obs = landmark_it.second.obs;
+      IndexT slot = slot_offsets[cpt];
+      for (const auto & obs_it : obs)
+      {
+        samples_per_view[obs_it.first].push_back({slot, obs_it.second.x});
+        if (options.average_observations)
+          ++slot;
+      }
+      slot_offsets[cpt + 1] = options.average_observations
+        ? slot
+        : slot_offsets[cpt] + (obs.empty() ? 0 : 1);
+      ++cpt;
     }
+  }
 
-    // The track list that will be colored (point removed during the process)
-    std::set<IndexT> remainingTrackToColor;
-    std::transform(sfm_data.GetLandmarks().begin(), sfm_data.GetLandmarks().end(),
-      std::inserter(remainingTrackToColor, remainingTrackToColor.begin()),
-      stl::RetrieveKey());
-
-    while ( !remainingTrackToColor.empty() )
+  // Build the list of views to decode
+  std::vector<ColorizationJob> jobs;
+  if (options.average_observations)
+  {
+    // Every observation is sampled
+    for (auto & view_it : samples_per_view)
     {
-      // Find the most representative image (for the remaining 3D points)
-      //  a. Count the number of observation per view for each 3Dpoint Index
-      //  b. Sort to find the most representative view index
-
-      std::map<IndexT, IndexT> map_IndexCardinal; // ViewId, Cardinal
-      for (const auto & track_to_color_it : remainingTrackToColor)
+      jobs.push_back({view_it.first, std::move(view_it.second)});
+    }
+    std::sort(jobs.begin(), jobs.end(),
+      [](const ColorizationJob & a, const ColorizationJob & b)
       {
-        const auto trackId = track_to_color_it;
-        const Observations & obs = sfm_data.GetLandmarks().at(trackId).obs;
-        for (const auto & obs_it : obs)
-        {
-          const auto viewId = obs_it.first;
-          if (map_IndexCardinal.find(viewId) == map_IndexCardinal.end())
-            map_IndexCardinal[viewId] = 1;
-          else
-            ++map_IndexCardinal[viewId];
-        }
-      }
-
-      // Find the View index that is the most represented
-      std::vector<IndexT> vec_cardinal;
-      std::transform(map_IndexCardinal.begin(),
-        map_IndexCardinal.end(),
-        std::back_inserter(vec_cardinal),
-        stl::RetrieveValue());
-      using namespace stl::indexed_sort;
-      std::vector<sort_index_packet_descend<IndexT, IndexT>> packet_vec(vec_cardinal.size());
-      sort_index_helper(packet_vec, &vec_cardinal[0], 1);
-
-      // First image index with the most of occurence
-      std::map<IndexT, IndexT>::const_iterator iterTT = map_IndexCardinal.begin();
-      std::advance(iterTT, packet_vec[0].index);
-      const size_t view_index = iterTT->first;
-      const View * view = sfm_data.GetViews().at(view_index).get();
-      const std::string sView_filename = stlplus::create_filespec(sfm_data.s_root_path,
-        view->s_Img_path);
-      image::Image<image::RGBColor> image_rgb;
-      image::Image<unsigned char> image_gray;
-      const bool b_rgb_image = ReadImage(sView_filename.c_str(), &image_rgb);
-      if (!b_rgb_image) //try Gray level
+        return a.samples.size() > b.samples.size();
+      });
+  }
+  else
+  {
+    // Greedy selection of the views:
+    //  Start with the most representative image and iterate to provide a color
+    //  to each remaining 3D point. The selection is done before any image
+    //  decoding, the number of uncolored tracks of a view can only decrease,
+    //  so a lazy priority queue is used to avoid re-counting every view.
+    std::vector<bool> colored(slot_offsets.back(), false);
+    using Candidate = std::pair<IndexT, IndexT>; // #uncolored tracks, ViewId
+    const auto candidate_cmp = [](const Candidate & a, const Candidate & b)
+    {
+      return (a.first < b.first) || (a.first == b.first && a.second > b.second);
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(candidate_cmp)>
+      candidates(candidate_cmp);
+    for (const auto & view_it : samples_per_view)
+    {
+      candidates.emplace(view_it.second.size(), view_it.first);
+    }
+    while (!candidates.empty())
+    {
+      const Candidate candidate = candidates.top();
+      candidates.pop();
+      const std::vector<ColorSample> & view_samples = samples_per_view.at(candidate.second);
+      const IndexT uncolored_count = std::count_if(view_samples.cbegin(), view_samples.cend(),
+        [&colored](const ColorSample & sample) { return !colored[sample.slot]; });
+      if (uncolored_count == 0)
+        continue;
+      if (uncolored_count < candidate.first)
       {
-        const bool b_gray_image = ReadImage(sView_filename.c_str(), &image_gray);
-        if (!b_gray_image)
-        {
-          std::cerr << "Cannot open provided the image." << std::endl;
-          return false;
-        }
+        // The score is outdated, postpone this view
+        candidates.emplace(uncolored_count, candidate.second);
+        continue;
       }
-
-      // Iterate through the remaining track to color
-      // - look if the current view is present to color the track
-      std::set<IndexT> set_toRemove;
-      for (const auto & track_to_color_it : remainingTrackToColor)
+      ColorizationJob job;
+      job.view_id = candidate.second;
+      job.samples.reserve(uncolored_count);
+      for (const ColorSample & sample : view_samples)
       {
-        const auto trackId = track_to_color_it;
-        const Observations & obs = sfm_data.GetLandmarks().at(trackId).obs;
-        Observations::const_iterator it = obs.find(view_index);
-
-        if (it != obs.end())
+        if (!colored[sample.slot])
         {
-          // Color the track
-          const Vec2 & pt = it->second.x;
-          const image::RGBColor color =
-            b_rgb_image
-            ? image_rgb(pt.y(), pt.x())
-            : image::RGBColor(image_gray(pt.y(), pt.x()));
-
-          vec_tracksColor[trackIds_to_contiguousIndexes.at(trackId)] =
-            Vec3(color.r(), color.g(), color.b());
-          set_toRemove.insert(trackId);
-          ++my_progress_bar;
+          colored[sample.slot] = true;
+          job.samples.push_back(sample);
         }
       }
-      // Remove colored track
-      for (const auto & to_remove_it : set_toRemove)
-      {
-        remainingTrackToColor.erase(to_remove_it);
-      }
+      jobs.push_back(std::move(job));
+    }
+  }
+  samples_per_view.clear();
+
+  // Decode the selected views in parallel and sample the pixel colors.
+  // Each slot is written by a single job, so no synchronization is required.
+  std::vector<Vec3> slot_colors(slot_offsets.back());
+  C_Progress_display my_progress_bar(slot_colors.size(),
+                                     std::cout,
+                                     "\nCompute scene structure color\n");
+  std::atomic<bool> bOk(true);
+#ifdef OPENMVG_USE_OPENMP
+  const unsigned int nb_max_thread =
+    (options.max_images_in_flight > 0)
+    ? std::min(options.max_images_in_flight, static_cast<unsigned int>(omp_get_max_threads()))
+    : omp_get_max_threads();
+  #pragma omp parallel for schedule(dynamic) num_threads(nb_max_thread)
+#endif
+  for (int i = 0; i < static_cast<int>(jobs.size()); ++i)
+  {
+    if (!bOk)
+      continue;
+
+    const ColorizationJob & job = jobs[i];
+    const View * view = sfm_data.GetViews().at(job.view_id).get();
+    const std::string sView_filename = stlplus::create_filespec(sfm_data.s_root_path,
+      view->s_Img_path);
+    image::Image<image::RGBColor> image_rgb;
+    int image_scale = 1;
+    if (!ReadColorImage(sView_filename, options.jpeg_downscale, &image_rgb, &image_scale))
+    {
+      std::cerr << "Cannot open provided the image: " << sView_filename << std::endl;
+      bOk = false;
+      continue;
+    }
+
+    for (const ColorSample & sample : job.samples)
+    {
+      const int x = std::min(std::max(static_cast<int>(sample.x.x() / image_scale), 0), image_rgb.Width() - 1);
+      const int y = std::min(std::max(static_cast<int>(sample.x.y() / image_scale), 0), image_rgb.Height() - 1);
+      const image::RGBColor & color = image_rgb(y, x);
+      slot_colors[sample.slot] = Vec3(color.r(), color.g(), color.b());
     }
+    my_progress_bar += job.samples.size();
+  }
+
+  if (!bOk)
+    return false;
+
+  // Compute the final track colors
+  for (size_t i = 0; i < vec_tracksColor.size(); ++i)
+  {
+    const IndexT nb_slots = slot_offsets[i + 1] - slot_offsets[i];
+    if (nb_slots == 0)
+      continue;
+    Vec3 color = Vec3::Zero();
+    for (IndexT slot = slot_offsets[i]; slot < slot_offsets[i + 1]; ++slot)
+      color += slot_colors[slot];
+    vec_tracksColor[i] = color / nb_slots;
   }
   return true;
 }
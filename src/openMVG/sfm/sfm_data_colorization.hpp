@@ -17,10 +17,29 @@ namespace sfm {
 
 struct SfM_Data;
 
+/// Parameters of the SfM_Data structure colorization
+struct Colorization_Options
+{
+  /// If true, a track color is the mean color of all its observations,
+  ///  else a track is colored by a single view (the views covering the most
+  ///  remaining tracks are chosen first).
+  bool average_observations = false;
+  /// Downscaling factor allowed for the JPEG decoding (1, 2, 4 or 8).
+  /// The reduction is done in the DCT domain, so decoding is faster but the
+  ///  sampled color is the mean color of a scale x scale pixel block.
+  int jpeg_downscale = 1;
+  /// Maximal number of images decoded at the same time
+  ///  (0 means one image per available thread).
+  unsigned int max_images_in_flight = 0;
+};
+
+/// Find the color of the SfM_Data Landmarks/structure
+/// Views are decoded in parallel, each thread holding at most one image.
 bool ColorizeTracks(
   const SfM_Data & sfm_data,
   std::vector<Vec3> & vec_3dPoints,
-  std::vector<Vec3> & vec_tracksColor);
+  std::vector<Vec3> & vec_tracksColor,
+  const Colorization_Options & options = Colorization_Options());
 
 } // namespace sfm
 } // namespace openMVG
@@ -0,0 +1,97 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/image/image_io.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_colorization.hpp"
+
+#include "testing/testing.h"
+
+#include <sstream>
+
+using namespace openMVG;
+using namespace openMVG::image;
+using namespace openMVG::sfm;
+
+// Create a scene with 3 views, each image being filled with a constant color:
+// - view 0: red, view 1: green, view 2: blue
+//
+// TrackId 0 -> 0-1-2
+// TrackId 1 -> 0-1
+// TrackId 2 -> 1-2
+// TrackId 3 -> 2
+SfM_Data init_scene()
+{
+  SfM_Data sfm_data;
+  const RGBColor colors[3] = {RGBColor(255, 0, 0), RGBColor(0, 255, 0), RGBColor(0, 0, 255)};
+  for (IndexT i = 0; i < 3; ++i)
+  {
+    std::ostringstream os;
+    os << "colorization_" << i << ".png";
+    Image<RGBColor> image(32, 16, true, colors[i]);
+    WriteImage(os.str().c_str(), image);
+    sfm_data.views[i] = std::make_shared<View>(os.str(), i, 0, i, 32, 16);
+  }
+  const std::vector<std::vector<IndexT>> tracks = {{0, 1, 2}, {0, 1}, {1, 2}, {2}};
+  for (IndexT i = 0; i < tracks.size(); ++i)
+  {
+    for (const IndexT view_id : tracks[i])
+      sfm_data.structure[i].obs[view_id] = Observation(Vec2(5 + i, 10), i);
+    sfm_data.structure[i].X = Vec3(i, i, i);
+  }
+  return sfm_data;
+}
+
+TEST(SFM_DATA_COLORIZATION, MostRepresentativeView)
+{
+  const SfM_Data sfm_data = init_scene();
+
+  std::vector<Vec3> vec_3dPoints, vec_tracksColor;
+  EXPECT_TRUE(ColorizeTracks(sfm_data, vec_3dPoints, vec_tracksColor));
+  EXPECT_EQ(4, vec_3dPoints.size());
+  EXPECT_EQ(4, vec_tracksColor.size());
+  // The view 1 (green) is seen by 3 tracks, the remaining one is colored by view 2
+  EXPECT_MATRIX_NEAR(Vec3(0, 255, 0), vec_tracksColor[0], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(0, 255, 0), vec_tracksColor[1], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(0, 255, 0), vec_tracksColor[2], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(0, 0, 255), vec_tracksColor[3], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(3, 3, 3), vec_3dPoints[3], 1e-8);
+}
+
+TEST(SFM_DATA_COLORIZATION, AverageObservations)
+{
+  const SfM_Data sfm_data = init_scene();
+
+  Colorization_Options options;
+  options.average_observations = true;
+  options.max_images_in_flight = 1;
+
+  std::vector<Vec3> vec_3dPoints, vec_tracksColor;
+  EXPECT_TRUE(ColorizeTracks(sfm_data, vec_3dPoints, vec_tracksColor, options));
+  EXPECT_EQ(4, vec_tracksColor.size());
+  EXPECT_MATRIX_NEAR(Vec3(85, 85, 85), vec_tracksColor[0], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(127.5, 127.5, 0), vec_tracksColor[1], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(0, 127.5, 127.5), vec_tracksColor[2], 1e-8);
+  EXPECT_MATRIX_NEAR(Vec3(0, 0, 255), vec_tracksColor[3], 1e-8);
+}
+
+TEST(SFM_DATA_COLORIZATION, MissingImage)
+{
+  SfM_Data sfm_data = init_scene();
+  sfm_data.views[0]->s_Img_path = "colorization_missing.png";
+
+  Colorization_Options options;
+  options.average_observations = true;
+
+  std::vector<Vec3> vec_3dPoints, vec_tracksColor;
+  EXPECT_FALSE(ColorizeTracks(sfm_data, vec_3dPoints, vec_tracksColor, options));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
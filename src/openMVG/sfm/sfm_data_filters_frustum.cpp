@@ -16,9 +16,13 @@
 
 #include "third_party/progress/progress_display.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <numeric>
 
 namespace openMVG {
 namespace sfm {
@@ -84,6 +88,115 @@ void Frustum_Filter::initFrustum
   }
 }
 
+namespace {
+
+using AABB = Eigen::AlignedBox<double, 3>;
+
+/// Bounding volume hierarchy over axis aligned bounding boxes (boxes can be unbounded).
+/// Used as a broad phase: it lists the boxes that overlap a query box.
+class AABB_Tree
+{
+public:
+  explicit AABB_Tree(const std::vector<AABB> & boxes)
+    : boxes_(boxes), indexes_(boxes.size())
+  {
+    std::iota(indexes_.begin(), indexes_.end(), 0);
+    // Finite representative point of each box (used to split the boxes)
+    centers_.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const double min = boxes[i].min()(axis), max = boxes[i].max()(axis);
+        centers_[i](axis) =
+          std::isfinite(min) ? (std::isfinite(max) ? (min + max) / 2. : min)
+                             : (std::isfinite(max) ? max : 0.);
+      }
+    }
+    if (!boxes.empty())
+    {
+      nodes_.reserve(4 * boxes.size() / kLeafSize + 1);
+      build(0, boxes.size());
+    }
+  }
+
+  /// Call the functor on the index of every box that overlaps the query box
+  template <typename Functor>
+  void query(const AABB & box, Functor functor) const
+  {
+    if (nodes_.empty())
+      return;
+    std::vector<uint32_t> stack(1, 0);
+    while (!stack.empty())
+    {
+      const Node & node = nodes_[stack.back()];
+      stack.pop_back();
+      if (!node.box.intersects(box))
+        continue;
+      if (node.left == 0) // leaf
+      {
+        for (uint32_t k = node.begin; k < node.end; ++k)
+        {
+          if (boxes_[indexes_[k]].intersects(box))
+            functor(indexes_[k]);
+        }
+      }
+      else
+      {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+  }
+
+private:
+  static const uint32_t kLeafSize = 4;
+
+  struct Node
+  {
+    AABB box;
+    uint32_t left, right; // children indexes (0 for a leaf: the root cannot be a child)
+    uint32_t begin, end; // range of the boxes of a leaf
+  };
+
+  // Median split along the axis with the largest extent of the box centers
+  uint32_t build(const uint32_t begin, const uint32_t end)
+  {
+    const uint32_t node_id = nodes_.size();
+    nodes_.push_back(Node{AABB(), 0, 0, begin, end});
+    AABB box, center_box;
+    for (uint32_t k = begin; k < end; ++k)
+    {
+      box.extend(boxes_[indexes_[k]]);
+      center_box.extend(centers_[indexes_[k]]);
+    }
+    nodes_[node_id].box = box;
+    if (end - begin <= kLeafSize)
+      return node_id;
+
+    int axis;
+    center_box.sizes().maxCoeff(&axis);
+    const uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(indexes_.begin() + begin, indexes_.begin() + middle, indexes_.begin() + end,
+      [&](const uint32_t a, const uint32_t b)
+      {
+        return centers_[a](axis) < centers_[b](axis);
+      });
+    const uint32_t left = build(begin, middle);
+    const uint32_t right = build(middle, end);
+    nodes_[node_id].left = left;
+    nodes_[node_id].right = right;
+    return node_id;
+  }
+
+  const std::vector<AABB> & boxes_;
+  std::vector<Vec3> centers_;
+  std::vector<uint32_t> indexes_;
+  std::vector<Node> nodes_;
+};
+
+} // namespace
+
 Pair_Set Frustum_Filter::getFrustumIntersectionPairs
 (
   const std::vector<HalfPlaneObject>& bounding_volume
@@ -93,17 +206,46 @@ const
   Pair_Set pairs;
   // List active view Id
   std::vector<IndexT> viewIds;
-  viewIds.reserve(z_near_z_far_perView.size());
-  std::transform(z_near_z_far_perView.cbegin(), z_near_z_far_perView.cend(),
+  viewIds.reserve(frustum_perView.size());
+  std::transform(frustum_perView.cbegin(), frustum_perView.cend(),
     std::back_inserter(viewIds), stl::RetrieveKey());
+  std::sort(viewIds.begin(), viewIds.end());
+
+  // Keep only the frustums that intersect the bounding volume:
+  //  a pair can intersect inside the volume only if both of its frustums do.
+  if (!bounding_volume.empty())
+  {
+    std::vector<char> inside(viewIds.size());
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i < (int)viewIds.size(); ++i)
+    {
+      std::vector<HalfPlaneObject> objects = bounding_volume;
+      objects.push_back(frustum_perView.at(viewIds[i]));
+      inside[i] = intersect(objects);
+    }
+    std::vector<IndexT> kept_viewIds;
+    for (size_t i = 0; i < viewIds.size(); ++i)
+      if (inside[i])
+        kept_viewIds.push_back(viewIds[i]);
+    viewIds.swap(kept_viewIds);
+  }
+
+  // Broad phase: only the frustums with overlapping bounding boxes can intersect
+  std::vector<AABB> boxes(viewIds.size());
+  for (size_t i = 0; i < viewIds.size(); ++i)
+    boxes[i] = frustum_perView.at(viewIds[i]).bounding_box();
+  const AABB_Tree tree(boxes);
 
   C_Progress_display my_progress_bar(
-    viewIds.size() * (viewIds.size()-1)/2,
+    viewIds.size(),
     std::cout, "\nCompute frustum intersection\n");
 
-  // Exhaustive comparison (use the fact that the intersect function is symmetric)
+  // Narrow phase: exact intersection test of the candidate pairs
+  //  (use the fact that the intersect function is symmetric)
 #ifdef OPENMVG_USE_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for schedule(dynamic)
 #endif
   for (int i = 0; i < (int)viewIds.size(); ++i)
   {
@@ -113,21 +255,30 @@ const
     objects.insert(objects.end(),
                    { frustum_perView.at(viewIds[i]), HalfPlaneObject() });
 
-    for (size_t j = i+1; j < viewIds.size(); ++j)
+    std::vector<uint32_t> candidates;
+    tree.query(boxes[i], [&](const uint32_t j)
+    {
+      if (j > static_cast<uint32_t>(i))
+        candidates.push_back(j);
+    });
+
+    std::vector<Pair> view_pairs;
+    for (const uint32_t j : candidates)
     {
       objects.back() = frustum_perView.at(viewIds[j]);
       if (intersect(objects))
       {
+        view_pairs.emplace_back(viewIds[i], viewIds[j]);
+      }
+    }
 #ifdef OPENMVG_USE_OPENMP
-        #pragma omp critical
+    #pragma omp critical
 #endif
-        {
-          pairs.insert({viewIds[i], viewIds[j]});
-        }
-      }
-      // Progress bar update
-      ++my_progress_bar;
+    {
+      pairs.insert(view_pairs.cbegin(), view_pairs.cend());
     }
+    // Progress bar update
+    ++my_progress_bar;
   }
   return pairs;
 }
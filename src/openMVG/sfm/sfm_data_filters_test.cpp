@@ -9,9 +9,13 @@
 #include "openMVG/cameras/Camera_Pinhole.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_filters.hpp"
+#include "openMVG/sfm/sfm_data_filters_frustum.hpp"
+#include "openMVG/geometry/box.hpp"
 
 #include "testing/testing.h"
 
+#include <random>
+
 using namespace openMVG;
 using namespace openMVG::cameras;
 using namespace openMVG::geometry;
@@ -165,6 +169,62 @@ TEST(SFM_DATA_FILTERS, eraseUnstablePosesAndObservations)
 }
 
 
+// Check that the broad phase does not change the intersecting frustum pairs
+TEST(SFM_DATA_FILTERS, FrustumIntersectionPairs)
+{
+  // Cameras spread on a grid with random orientations
+  SfM_Data sfm_data;
+  const IndexT viewsCount = 200;
+  init_scene(sfm_data, viewsCount);
+  sfm_data.intrinsics[0] = std::make_shared<Pinhole_Intrinsic>(1000, 1000, 1000, 500, 500);
+  std::mt19937 random_generator(std::mt19937::default_seed);
+  std::uniform_real_distribution<double> position(0., 50.), angle(-M_PI, M_PI);
+  for (IndexT i = 0; i < viewsCount; ++i)
+  {
+    const Mat3 R = RotationAroundY(angle(random_generator)) * RotationAroundX(angle(random_generator) / 4.);
+    sfm_data.poses[i] = Pose3(R, Vec3(position(random_generator), 0., position(random_generator)));
+  }
+  const Pinhole_Intrinsic * cam = dynamic_cast<const Pinhole_Intrinsic*>(sfm_data.intrinsics[0].get());
+
+  const Box bounding_box(10., -10., 10., 40., 10., 40.);
+  for (const double z_far : {-1., 8.})
+  {
+    for (const bool use_bounding_volume : {false, true})
+    {
+      const Frustum_Filter frustum_filter(sfm_data, z_far > 0 ? 0.1 : -1., z_far);
+      std::vector<HalfPlaneObject> bounding_volume;
+      if (use_bounding_volume)
+        bounding_volume.push_back(bounding_box);
+      const Pair_Set pairs = frustum_filter.getFrustumIntersectionPairs(bounding_volume);
+
+      // Exhaustive comparison
+      std::vector<Frustum> frustums;
+      for (IndexT i = 0; i < viewsCount; ++i)
+      {
+        const Pose3 & pose = sfm_data.poses[i];
+        frustums.push_back(z_far > 0 ?
+          Frustum(cam->w(), cam->h(), cam->K(), pose.rotation(), pose.center(), 0.1, z_far) :
+          Frustum(cam->w(), cam->h(), cam->K(), pose.rotation(), pose.center()));
+      }
+      Pair_Set expected_pairs;
+      for (IndexT i = 0; i < viewsCount; ++i)
+      {
+        for (IndexT j = i + 1; j < viewsCount; ++j)
+        {
+          std::vector<HalfPlaneObject> objects = bounding_volume;
+          objects.push_back(frustums[i]);
+          objects.push_back(frustums[j]);
+          if (intersect(objects))
+            expected_pairs.insert({i, j});
+        }
+      }
+      EXPECT_TRUE(!expected_pairs.empty());
+      EXPECT_TRUE(expected_pairs.size() < viewsCount * (viewsCount - 1) / 2);
+      EXPECT_TRUE(expected_pairs == pairs);
+    }
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -17,6 +17,7 @@
 #include "openMVG/sfm/sfm_data_io_cereal.hpp"
 #include "openMVG/sfm/sfm_data_io_ply.hpp"
 #include "openMVG/stl/stlMap.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
@@ -71,6 +72,7 @@ bool ValidIds(const SfM_Data & sfm_data, ESfM_Data flags_part)
 
 bool Load(SfM_Data & sfm_data, const std::string & filename, ESfM_Data flags_part)
 {
+  system::ScopedTrace trace("Load " + stlplus::filename_part(filename), "io");
   bool bStatus = false;
   const std::string ext = stlplus::extension_part(filename);
   if (ext == "json")
@@ -98,6 +100,7 @@ bool Load(SfM_Data & sfm_data, const std::string & filename, ESfM_Data flags_par
 
 bool Save(const SfM_Data & sfm_data, const std::string & filename, ESfM_Data flags_part)
 {
+  system::ScopedTrace trace("Save " + stlplus::filename_part(filename), "io");
   const std::string ext = stlplus::extension_part(filename);
   if (ext == "json")
     return Save_Cereal<cereal::JSONOutputArchive>(sfm_data, filename, flags_part);
@@ -0,0 +1,359 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/sfm/sfm_data_merge.hpp"
+#include "openMVG/cameras/Camera_Intrinsics.hpp"
+#include "openMVG/geometry/rigid_transformation3D_srt.hpp"
+#include "openMVG/geometry/Similarity3.hpp"
+#include "openMVG/geometry/Similarity3_Kernel.hpp"
+#include "openMVG/robust_estimation/robust_estimator_LMeds.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_transform.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+
+namespace openMVG {
+namespace sfm {
+
+namespace {
+
+/// Map a 2D observation (view_id, feat_id) to the track that contains it
+using FeatureToTrack = Hash_Map<uint64_t, IndexT>;
+
+inline uint64_t ObservationKey(const IndexT view_id, const IndexT feat_id)
+{
+  return (static_cast<uint64_t>(view_id) << 32) | static_cast<uint64_t>(feat_id);
+}
+
+FeatureToTrack BuildFeatureToTrack(const SfM_Data & sfm_data)
+{
+  FeatureToTrack feature_to_track;
+  for (const auto & landmark_it : sfm_data.GetLandmarks())
+  {
+    for (const auto & obs_it : landmark_it.second.obs)
+    {
+      feature_to_track[ObservationKey(obs_it.first, obs_it.second.id_feat)] = landmark_it.first;
+    }
+  }
+  return feature_to_track;
+}
+
+bool ComputeSubmapSimilarity
+(
+  const SfM_Data & reference,
+  const FeatureToTrack & feature_to_track,
+  const SfM_Data & submap,
+  geometry::Similarity3 & sim,
+  IndexT * inlier_count
+)
+{
+  // Collect the 3D-3D correspondences
+  std::vector<Vec3> X_submap, X_reference;
+  for (const auto & view_it : submap.GetViews())
+  {
+    const View * view = view_it.second.get();
+    const auto reference_view_it = reference.GetViews().find(view_it.first);
+    if (reference_view_it != reference.GetViews().end() &&
+        submap.IsPoseAndIntrinsicDefined(view) &&
+        reference.IsPoseAndIntrinsicDefined(reference_view_it->second.get()))
+    {
+      X_submap.push_back(submap.GetPoses().at(view->id_pose).center());
+      X_reference.push_back(reference.GetPoses().at(reference_view_it->second->id_pose).center());
+    }
+  }
+  for (const auto & landmark_it : submap.GetLandmarks())
+  {
+    for (const auto & obs_it : landmark_it.second.obs)
+    {
+      const auto track_it =
+        feature_to_track.find(ObservationKey(obs_it.first, obs_it.second.id_feat));
+      if (track_it != feature_to_track.end())
+      {
+        X_submap.push_back(landmark_it.second.X);
+        X_reference.push_back(reference.GetLandmarks().at(track_it->second).X);
+        break;
+      }
+    }
+  }
+
+  if (inlier_count)
+    *inlier_count = 0;
+  // LMedS requires more samples than the minimal ones to be run
+  if (X_submap.size() <= geometry::kernel::Similarity3Solver::MINIMUM_SAMPLES)
+    return false;
+
+  const Mat X_submap_mat = Eigen::Map<Mat>(X_submap[0].data(), 3, X_submap.size());
+  const Mat X_reference_mat = Eigen::Map<Mat>(X_reference[0].data(), 3, X_reference.size());
+
+  // Robust estimation of the similarity
+  geometry::kernel::Similarity3_Kernel kernel(X_submap_mat, X_reference_mat);
+  double outlier_threshold = 0.0;
+  const double lmeds_median =
+    robust::LeastMedianOfSquares(kernel, &sim, &outlier_threshold);
+  if (lmeds_median == std::numeric_limits<double>::max())
+    return false;
+
+  // Keep a tiny threshold for noise free correspondences (zero median)
+  const double squared_extent =
+    (X_reference_mat.colwise() - X_reference_mat.rowwise().mean()).colwise().squaredNorm().maxCoeff();
+  outlier_threshold = std::max(outlier_threshold,
+    std::numeric_limits<double>::epsilon() * std::max(squared_extent, 1.0));
+
+  std::vector<Mat::Index> inliers;
+  for (Mat::Index i = 0; i < X_submap_mat.cols(); ++i)
+  {
+    if (geometry::kernel::Similarity3ErrorSquaredMetric::Error
+          (sim, X_submap_mat.col(i), X_reference_mat.col(i)) <= outlier_threshold)
+    {
+      inliers.push_back(i);
+    }
+  }
+  if (inliers.size() < geometry::kernel::Similarity3Solver::MINIMUM_SAMPLES)
+    return false;
+
+  // Least square refinement of the similarity on the inliers
+  Mat X_submap_inliers(3, inliers.size()), X_reference_inliers(3, inliers.size());
+  for (size_t i = 0; i < inliers.size(); ++i)
+  {
+    X_submap_inliers.col(i) = X_submap_mat.col(inliers[i]);
+    X_reference_inliers.col(i) = X_reference_mat.col(inliers[i]);
+  }
+  Vec3 t;
+  Mat3 R;
+  double S;
+  if (!geometry::FindRTS(X_submap_inliers, X_reference_inliers, &S, &t, &R))
+    return false;
+
+  // Encode the transformation as a 3D Similarity transformation matrix // S * R * X + t
+  sim = geometry::Similarity3(geometry::Pose3(R, -R.transpose() * t / S), S);
+  if (inlier_count)
+    *inlier_count = inliers.size();
+  return true;
+}
+
+IndexT MergeSubmap
+(
+  SfM_Data & sfm_data,
+  FeatureToTrack & feature_to_track,
+  const SfM_Data & submap
+)
+{
+  // Views, intrinsics & poses (keep the existing ones)
+  for (const auto & view_it : submap.GetViews())
+  {
+    sfm_data.views.insert(view_it);
+  }
+  for (const auto & intrinsic_it : submap.GetIntrinsics())
+  {
+    if (sfm_data.intrinsics.count(intrinsic_it.first) == 0)
+    {
+      sfm_data.intrinsics[intrinsic_it.first] =
+        std::shared_ptr<cameras::IntrinsicBase>(intrinsic_it.second->clone());
+    }
+  }
+  for (const auto & pose_it : submap.GetPoses())
+  {
+    sfm_data.poses.insert(pose_it);
+  }
+
+  IndexT next_landmark_id = 0;
+  for (const auto & landmark_it : sfm_data.GetLandmarks())
+  {
+    next_landmark_id = std::max(next_landmark_id, landmark_it.first + 1);
+  }
+
+  // Tracks
+  IndexT fused_count = 0;
+  for (const auto & landmark_it : submap.GetLandmarks())
+  {
+    const Landmark & landmark = landmark_it.second;
+
+    // Count the observations shared with the existing tracks
+    std::map<IndexT, IndexT> shared_tracks;
+    for (const auto & obs_it : landmark.obs)
+    {
+      const auto track_it =
+        feature_to_track.find(ObservationKey(obs_it.first, obs_it.second.id_feat));
+      if (track_it != feature_to_track.end())
+        ++shared_tracks[track_it->second];
+    }
+
+    if (shared_tracks.empty())
+    {
+      // A new track
+      for (const auto & obs_it : landmark.obs)
+      {
+        feature_to_track[ObservationKey(obs_it.first, obs_it.second.id_feat)] = next_landmark_id;
+      }
+      sfm_data.structure[next_landmark_id++] = landmark;
+      continue;
+    }
+
+    // Fuse with the track that shares the most observations
+    const IndexT track_id = std::max_element(shared_tracks.cbegin(), shared_tracks.cend(),
+      [](const std::pair<IndexT, IndexT> & a, const std::pair<IndexT, IndexT> & b)
+      {
+        return a.second < b.second;
+      })->first;
+    Landmark & track = sfm_data.structure.at(track_id);
+
+    // The other shared tracks are the same 3D point: fuse them if they do not conflict
+    for (const auto & shared_track_it : shared_tracks)
+    {
+      if (shared_track_it.first == track_id)
+        continue;
+      const Observations & other_obs = sfm_data.structure.at(shared_track_it.first).obs;
+      const bool conflict = std::any_of(other_obs.cbegin(), other_obs.cend(),
+        [&track](const Observations::value_type & obs_it)
+        {
+          return track.obs.count(obs_it.first) != 0;
+        });
+      if (conflict)
+        continue;
+      for (const auto & obs_it : other_obs)
+      {
+        track.obs[obs_it.first] = obs_it.second;
+        feature_to_track[ObservationKey(obs_it.first, obs_it.second.id_feat)] = track_id;
+      }
+      sfm_data.structure.erase(shared_track_it.first);
+    }
+
+    // Append the new observations
+    for (const auto & obs_it : landmark.obs)
+    {
+      const uint64_t key = ObservationKey(obs_it.first, obs_it.second.id_feat);
+      if (feature_to_track.count(key) != 0 || track.obs.count(obs_it.first) != 0)
+        continue;
+      track.obs[obs_it.first] = obs_it.second;
+      feature_to_track[key] = track_id;
+    }
+    ++fused_count;
+  }
+  return fused_count;
+}
+
+} // namespace
+
+bool ComputeSubmapSimilarity
+(
+  const SfM_Data & reference,
+  const SfM_Data & submap,
+  geometry::Similarity3 & sim,
+  IndexT * inlier_count
+)
+{
+  return ComputeSubmapSimilarity(
+    reference, BuildFeatureToTrack(reference), submap, sim, inlier_count);
+}
+
+IndexT MergeSubmap
+(
+  SfM_Data & sfm_data,
+  const SfM_Data & submap
+)
+{
+  FeatureToTrack feature_to_track = BuildFeatureToTrack(sfm_data);
+  return MergeSubmap(sfm_data, feature_to_track, submap);
+}
+
+std::vector<IndexT> MergeSubmaps
+(
+  std::vector<SfM_Data> & submaps,
+  SfM_Data & sfm_data,
+  const IndexT min_inlier_count
+)
+{
+  std::vector<IndexT> merged_submaps;
+  if (submaps.empty())
+    return merged_submaps;
+
+  // List the submaps that contain each posed view
+  Hash_Map<IndexT, std::vector<IndexT>> view_to_submaps;
+  for (IndexT i = 0; i < submaps.size(); ++i)
+  {
+    for (const auto & view_it : submaps[i].GetViews())
+    {
+      if (submaps[i].IsPoseAndIntrinsicDefined(view_it.second.get()))
+        view_to_submaps[view_it.first].push_back(i);
+    }
+  }
+
+  // Number of posed views shared by each pending submap and the merged scene.
+  // A registration that failed is tried again only once the overlap grew.
+  std::vector<IndexT> shared_views(submaps.size(), 0);
+  std::vector<IndexT> failed_shared_views(submaps.size(), 0);
+  std::vector<bool> pending(submaps.size(), true);
+
+  FeatureToTrack feature_to_track;
+  const auto merge = [&](const IndexT i)
+  {
+    for (const auto & view_it : submaps[i].GetViews())
+    {
+      if (!submaps[i].IsPoseAndIntrinsicDefined(view_it.second.get()) ||
+          sfm_data.IsPoseAndIntrinsicDefined(view_it.second.get()))
+        continue;
+      for (const IndexT other : view_to_submaps[view_it.first])
+        ++shared_views[other];
+    }
+    if (merged_submaps.empty())
+    {
+      sfm_data = std::move(submaps[i]);
+      feature_to_track = BuildFeatureToTrack(sfm_data);
+    }
+    else
+    {
+      MergeSubmap(sfm_data, feature_to_track, submaps[i]);
+    }
+    submaps[i] = SfM_Data(); // release the memory
+    pending[i] = false;
+    merged_submaps.push_back(i);
+  };
+
+  // The largest submap defines the coordinate system
+  merge(std::distance(submaps.cbegin(), std::max_element(submaps.cbegin(), submaps.cend(),
+    [](const SfM_Data & a, const SfM_Data & b)
+    {
+      return a.GetPoses().size() < b.GetPoses().size();
+    })));
+
+  while (true)
+  {
+    // Register the pending submap with the largest overlap
+    IndexT best_submap = UndefinedIndexT;
+    for (IndexT i = 0; i < submaps.size(); ++i)
+    {
+      if (pending[i] && shared_views[i] > failed_shared_views[i] &&
+          (best_submap == UndefinedIndexT || shared_views[i] > shared_views[best_submap]))
+        best_submap = i;
+    }
+    if (best_submap == UndefinedIndexT)
+      break;
+
+    geometry::Similarity3 sim;
+    IndexT inlier_count = 0;
+    if (!ComputeSubmapSimilarity(sfm_data, feature_to_track, submaps[best_submap], sim, &inlier_count)
+        || inlier_count < min_inlier_count)
+    {
+      failed_shared_views[best_submap] = shared_views[best_submap];
+      continue;
+    }
+    std::cout
+      << "Submap " << best_submap << " registered with " << inlier_count << " correspondences"
+      << " (scale: " << sim.scale_ << ")" << std::endl;
+    ApplySimilarity(sim, submaps[best_submap]);
+    merge(best_submap);
+  }
+  return merged_submaps;
+}
+
+} // namespace sfm
+} // namespace openMVG
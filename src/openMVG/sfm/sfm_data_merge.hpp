@@ -0,0 +1,90 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SFM_SFM_DATA_MERGE_HPP
+#define OPENMVG_SFM_SFM_DATA_MERGE_HPP
+
+#include "openMVG/types.hpp"
+
+#include <vector>
+
+namespace openMVG {
+namespace geometry
+{
+  struct Similarity3;
+} // namespace geometry
+
+namespace sfm {
+
+struct SfM_Data;
+
+/**
+* @brief Compute the similarity that registers a submap onto a reference scene.
+*  Submaps are reconstructions of subsets of the same views (i.e. the clusters
+*  of openMVG_main_ComputeClusters), so they share the view ids and feature ids.
+*  The 3D-3D correspondences are:
+*  - the camera centers of the views that are posed in both scenes,
+*  - the landmarks that share at least one 2D observation (view_id, feat_id).
+*  The similarity is robustly estimated (LMedS) and refined on the inliers (FindRTS).
+*
+* @param[in] reference The scene defining the target coordinate system
+* @param[in] submap The scene to register
+* @param[out] sim The found similarity (reference ~= sim(submap))
+* @param[out] inlier_count optional, the number of correspondences that fit the similarity
+* @return True if enough correspondences were found to compute the registration
+*/
+bool ComputeSubmapSimilarity
+(
+  const SfM_Data & reference,
+  const SfM_Data & submap,
+  geometry::Similarity3 & sim,
+  IndexT * inlier_count = nullptr
+);
+
+/**
+* @brief Merge a submap (expressed in the reference coordinate system) into a scene.
+*  - views, intrinsics & poses that are not yet in the scene are added
+*    (the existing ones are kept unchanged),
+*  - tracks are deduplicated: a submap track that shares an observation with some
+*    scene tracks is fused with them, its other observations are appended if they
+*    do not conflict (one observation per view and a feature used by one track only),
+*  - the other tracks are added with new landmark ids.
+*
+* @param[in,out] sfm_data The scene to complete
+* @param[in] submap The submap to merge
+* @return The number of submap tracks that were fused with existing tracks
+*/
+IndexT MergeSubmap
+(
+  SfM_Data & sfm_data,
+  const SfM_Data & submap
+);
+
+/**
+* @brief Register and merge a collection of submaps into a single scene.
+*  The largest submap defines the coordinate system, then the submap sharing
+*  the most correspondences with the current scene is registered and merged,
+*  until no more submap can be registered.
+*
+* @param[in] submaps The submaps to merge (they are moved into the merged scene)
+* @param[out] sfm_data The merged scene
+* @param[in] min_inlier_count The minimal number of inlier correspondences required
+*  to register a submap
+* @return The indexes of the submaps that were merged
+*/
+std::vector<IndexT> MergeSubmaps
+(
+  std::vector<SfM_Data> & submaps,
+  SfM_Data & sfm_data,
+  const IndexT min_inlier_count = 6
+);
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // OPENMVG_SFM_SFM_DATA_MERGE_HPP
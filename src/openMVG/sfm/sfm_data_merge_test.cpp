@@ -0,0 +1,209 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/cameras/Camera_Pinhole.hpp"
+#include "openMVG/geometry/Similarity3.hpp"
+#include "openMVG/multiview/test_data_sets.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_merge.hpp"
+#include "openMVG/sfm/sfm_data_transform.hpp"
+
+#include "testing/testing.h"
+
+#include <set>
+
+using namespace openMVG;
+using namespace openMVG::cameras;
+using namespace openMVG::geometry;
+using namespace openMVG::sfm;
+
+// Create a submap of the synthetic scene: the views [first_view, last_view],
+//  with landmark ids starting at landmark_id_offset (submaps are independent
+//  reconstructions, so their track ids are not related).
+SfM_Data getSubmap
+(
+  const NViewDataSet & d,
+  const nViewDatasetConfigurator & config,
+  const IndexT first_view,
+  const IndexT last_view,
+  const IndexT landmark_id_offset
+)
+{
+  SfM_Data sfm_data;
+  for (IndexT i = first_view; i <= last_view; ++i)
+  {
+    sfm_data.views[i] = std::make_shared<View>("", i, 0, i, config._cx *2, config._cy *2);
+    sfm_data.poses[i] = Pose3(d._R[i], d._C[i]);
+  }
+  sfm_data.intrinsics[0] = std::make_shared<Pinhole_Intrinsic>
+    (config._cx *2, config._cy *2, config._fx, config._cx, config._cy);
+
+  for (IndexT j = 0; j < d._X.cols(); ++j)
+  {
+    Landmark & landmark = sfm_data.structure[landmark_id_offset + j];
+    landmark.X = d._X.col(j);
+    for (IndexT i = first_view; i <= last_view; ++i)
+    {
+      landmark.obs[i] = Observation(d._x[i].col(j), j);
+    }
+  }
+  return sfm_data;
+}
+
+TEST(SfM_Data_Merge, Similarity)
+{
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(8, 32, config);
+
+  const SfM_Data reference = getSubmap(d, config, 0, 4, 0);
+  SfM_Data submap = getSubmap(d, config, 3, 7, 1000);
+
+  // Move the submap in another coordinate system
+  const Similarity3 sim_gt(Pose3(RotationAroundX(0.3) * RotationAroundZ(-0.7), Vec3(1., -2., 3.)), 2.5);
+  ApplySimilarity(sim_gt, submap);
+
+  // Corrupt some landmarks: they must be detected as outliers
+  for (IndexT j = 0; j < 6; ++j)
+  {
+    submap.structure.at(1000 + j).X += Vec3(1., 1., 1.);
+  }
+
+  Similarity3 sim;
+  IndexT inlier_count = 0;
+  EXPECT_TRUE(ComputeSubmapSimilarity(reference, submap, sim, &inlier_count));
+  // 2 shared camera centers + 32 shared landmarks - 6 outliers
+  EXPECT_EQ(28, inlier_count);
+
+  // The found similarity is the inverse of the applied one
+  EXPECT_NEAR(1.0 / sim_gt.scale_, sim.scale_, 1e-8);
+  for (IndexT i = 3; i <= 4; ++i)
+  {
+    EXPECT_MATRIX_NEAR(reference.GetPoses().at(i).center(), sim(submap.GetPoses().at(i)).center(), 1e-8);
+    EXPECT_MATRIX_NEAR(reference.GetPoses().at(i).rotation(), sim(submap.GetPoses().at(i)).rotation(), 1e-8);
+  }
+}
+
+TEST(SfM_Data_Merge, NoOverlap)
+{
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(8, 32, config);
+
+  const SfM_Data reference = getSubmap(d, config, 0, 3, 0);
+  SfM_Data submap = getSubmap(d, config, 4, 7, 1000);
+  // Do not share any feature
+  for (auto & landmark_it : submap.structure)
+  {
+    for (auto & obs_it : landmark_it.second.obs)
+      obs_it.second.id_feat += 1000;
+  }
+
+  Similarity3 sim;
+  EXPECT_FALSE(ComputeSubmapSimilarity(reference, submap, sim));
+}
+
+TEST(SfM_Data_Merge, TrackDeduplication)
+{
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(8, 32, config);
+
+  SfM_Data sfm_data = getSubmap(d, config, 0, 4, 0);
+  const SfM_Data submap = getSubmap(d, config, 3, 7, 1000);
+  // Add a track that is not seen by the scene
+  SfM_Data submap_extended = submap;
+  submap_extended.structure[5000].X = Vec3(0., 0., 0.);
+  submap_extended.structure[5000].obs[6] = Observation(Vec2(0., 0.), 999);
+  submap_extended.structure[5000].obs[7] = Observation(Vec2(0., 0.), 999);
+
+  EXPECT_EQ(32, MergeSubmap(sfm_data, submap_extended));
+
+  EXPECT_EQ(8, sfm_data.GetViews().size());
+  EXPECT_EQ(8, sfm_data.GetPoses().size());
+  EXPECT_EQ(1, sfm_data.GetIntrinsics().size());
+  EXPECT_EQ(33, sfm_data.GetLandmarks().size());
+  for (IndexT j = 0; j < 32; ++j)
+  {
+    const Observations & obs = sfm_data.GetLandmarks().at(j).obs;
+    EXPECT_EQ(8, obs.size());
+    for (const auto & obs_it : obs)
+      EXPECT_EQ(j, obs_it.second.id_feat);
+  }
+  // The new track got a new unique id
+  EXPECT_EQ(1, sfm_data.GetLandmarks().count(32));
+  EXPECT_EQ(2, sfm_data.GetLandmarks().at(32).obs.size());
+
+  // Merging again the same submap does not duplicate anything
+  EXPECT_EQ(33, MergeSubmap(sfm_data, submap_extended));
+  EXPECT_EQ(33, sfm_data.GetLandmarks().size());
+}
+
+TEST(SfM_Data_Merge, TrackFusion)
+{
+  // Two scene tracks that are the same 3D point (split in the scene)
+  //  are fused thanks to a submap track that links them.
+  SfM_Data sfm_data;
+  sfm_data.structure[0].obs[0] = Observation(Vec2(0., 0.), 0);
+  sfm_data.structure[0].obs[1] = Observation(Vec2(0., 0.), 0);
+  sfm_data.structure[1].obs[2] = Observation(Vec2(0., 0.), 0);
+  sfm_data.structure[1].obs[3] = Observation(Vec2(0., 0.), 0);
+  // A conflicting track (same view, different feature): it must be kept apart
+  sfm_data.structure[2].obs[0] = Observation(Vec2(0., 0.), 1);
+  sfm_data.structure[2].obs[4] = Observation(Vec2(0., 0.), 0);
+
+  SfM_Data submap;
+  submap.structure[0].obs[1] = Observation(Vec2(0., 0.), 0);
+  submap.structure[0].obs[2] = Observation(Vec2(0., 0.), 0);
+  submap.structure[0].obs[4] = Observation(Vec2(0., 0.), 0);
+  submap.structure[0].obs[5] = Observation(Vec2(0., 0.), 0);
+
+  EXPECT_EQ(1, MergeSubmap(sfm_data, submap));
+  EXPECT_EQ(2, sfm_data.GetLandmarks().size());
+  const Landmark & fused_track = sfm_data.GetLandmarks().begin()->first == 2 ?
+    std::next(sfm_data.GetLandmarks().begin())->second : sfm_data.GetLandmarks().begin()->second;
+  EXPECT_EQ(5, fused_track.obs.size());
+  EXPECT_EQ(2, sfm_data.GetLandmarks().at(2).obs.size());
+}
+
+TEST(SfM_Data_Merge, MergeSubmaps)
+{
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(12, 32, config);
+
+  // 4 overlapping submaps, each one expressed in its own coordinate system
+  std::vector<SfM_Data> submaps;
+  submaps.push_back(getSubmap(d, config, 3, 6, 1000));
+  submaps.push_back(getSubmap(d, config, 0, 4, 0));
+  submaps.push_back(getSubmap(d, config, 8, 11, 3000));
+  submaps.push_back(getSubmap(d, config, 5, 9, 2000));
+  ApplySimilarity(Similarity3(Pose3(RotationAroundY(0.5), Vec3(1., 0., 0.)), 0.5), submaps[0]);
+  ApplySimilarity(Similarity3(Pose3(RotationAroundZ(1.5), Vec3(0., 1., 0.)), 3.0), submaps[2]);
+  ApplySimilarity(Similarity3(Pose3(RotationAroundX(-1.), Vec3(0., 0., 1.)), 7.0), submaps[3]);
+
+  SfM_Data sfm_data;
+  const std::vector<IndexT> merged_submaps = MergeSubmaps(submaps, sfm_data);
+  EXPECT_EQ(4, merged_submaps.size());
+  // The largest submap defines the coordinate system
+  EXPECT_EQ(1, merged_submaps[0]);
+
+  EXPECT_EQ(12, sfm_data.GetPoses().size());
+  EXPECT_EQ(32, sfm_data.GetLandmarks().size());
+  for (const auto & landmark_it : sfm_data.GetLandmarks())
+  {
+    EXPECT_EQ(12, landmark_it.second.obs.size());
+    const IndexT feat_id = landmark_it.second.obs.begin()->second.id_feat;
+    EXPECT_MATRIX_NEAR(d._X.col(feat_id), landmark_it.second.X, 1e-6);
+  }
+  for (const auto & pose_it : sfm_data.GetPoses())
+  {
+    EXPECT_MATRIX_NEAR(d._C[pose_it.first], pose_it.second.center(), 1e-6);
+    EXPECT_MATRIX_NEAR(d._R[pose_it.first], pose_it.second.rotation(), 1e-6);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
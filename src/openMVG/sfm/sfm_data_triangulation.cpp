@@ -8,8 +8,9 @@
 
 #include "openMVG/sfm/sfm_data_triangulation.hpp"
 
-#include <deque>
-#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <random>
 
 #include "openMVG/geometry/pose3.hpp"
 #include "openMVG/multiview/triangulation_nview.hpp"
@@ -42,127 +43,414 @@ SfM_Data_Structure_Computation_Blind::SfM_Data_Structure_Computation_Blind
 {
 }
 
-/// Triangulate a given set of observations
-bool track_triangulation
+namespace {
+
+/// Number of tracks processed by a parallel work unit
+const IndexT kTriangulationChunkSize = 512;
+
+/// Camera data shared by all the observations of a view
+struct TriangulationCamera
+{
+  const IntrinsicBase * intrinsic;
+  Pose3 pose;
+  Mat34 P;
+  Mat4 PtP; // P^T.P, used to accumulate the N-view algebraic normal equations
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// Track observations packed in contiguous arrays.
+/// The observations of the track i are stored in the
+///  [track_offsets[i], track_offsets[i+1]) range of the obs_* arrays,
+///  in the iteration order of the track Observations container.
+struct TriangulationBatch
+{
+  std::vector<TriangulationCamera, Eigen::aligned_allocator<TriangulationCamera>> cameras;
+  Hash_Map<IndexT, IndexT> view_to_camera;
+
+  std::vector<IndexT> track_offsets = {0};
+  std::vector<IndexT> obs_camera; // UndefinedIndexT if the view pose or intrinsic is undefined
+  std::vector<Vec2> obs_x;
+  std::vector<Vec3> obs_bearing; // normalized, computed when the track is processed
+  std::vector<unsigned char> obs_inlier;
+
+  IndexT track_count() const { return track_offsets.size() - 1; }
+
+  IndexT camera_index(const SfM_Data & sfm_data, const IndexT view_id)
+  {
+    const auto it = view_to_camera.find(view_id);
+    if (it != view_to_camera.end())
+      return it->second;
+
+    IndexT camera_id = UndefinedIndexT;
+    const View * view = sfm_data.views.at(view_id).get();
+    if (sfm_data.IsPoseAndIntrinsicDefined(view))
+    {
+      TriangulationCamera camera;
+      camera.intrinsic = sfm_data.GetIntrinsics().at(view->id_intrinsic).get();
+      camera.pose = sfm_data.GetPoseOrDie(view);
+      camera.P = camera.pose.asMatrix();
+      camera.PtP = camera.P.transpose() * camera.P;
+      camera_id = cameras.size();
+      cameras.push_back(camera);
+    }
+    view_to_camera[view_id] = camera_id;
+    return camera_id;
+  }
+
+  void add_track(const SfM_Data & sfm_data, const Observations & obs)
+  {
+    for (const auto & obs_it : obs)
+    {
+      obs_camera.push_back(camera_index(sfm_data, obs_it.first));
+      obs_x.push_back(obs_it.second.x);
+    }
+    track_offsets.push_back(obs_x.size());
+  }
+
+  void finalize()
+  {
+    obs_bearing.resize(obs_x.size());
+    obs_inlier.assign(obs_x.size(), 0);
+  }
+};
+
+/// Compute the bearing vectors of the [begin, end) observation range
+void compute_bearings
 (
-  const SfM_Data & sfm_data,
-  const Observations & obs,
-  Vec3 & X,
-  const ETriangulationMethod & etri_method = ETriangulationMethod::DEFAULT
+  TriangulationBatch & batch,
+  const IndexT begin,
+  const IndexT end
+)
+{
+  for (IndexT i = begin; i < end; ++i)
+  {
+    if (batch.obs_camera[i] == UndefinedIndexT)
+      continue;
+    const IntrinsicBase & cam = *batch.cameras[batch.obs_camera[i]].intrinsic;
+    batch.obs_bearing[i] = cam(cam.get_ud_pixel(batch.obs_x[i])).normalized();
+  }
+}
+
+/// Triangulate the given observations (indexes in the batch arrays)
+/// - two observations: use the requested two view triangulation method,
+/// - more observations: use the algebraic N-view triangulation.
+///   For a normalized bearing b, (P - b.b^T.P)^T.(P - b.b^T.P) = P^T.P - (P^T.b).(P^T.b)^T,
+///   so the 4x4 normal equations are accumulated without building the 3x4 cost.
+bool triangulate_observations
+(
+  const TriangulationBatch & batch,
+  const IndexT * obs_ids,
+  const IndexT nb_obs,
+  const ETriangulationMethod etri_method,
+  Vec3 & X
+)
+{
+  if (nb_obs < 2)
+    return false;
+  for (IndexT i = 0; i < nb_obs; ++i)
+  {
+    if (batch.obs_camera[obs_ids[i]] == UndefinedIndexT)
+      return false;
+  }
+  if (nb_obs == 2)
+  {
+    const TriangulationCamera & cam0 = batch.cameras[batch.obs_camera[obs_ids[0]]];
+    const TriangulationCamera & cam1 = batch.cameras[batch.obs_camera[obs_ids[1]]];
+    return Triangulate2View
+    (
+      cam0.pose.rotation(),
+      cam0.pose.translation(),
+      batch.obs_bearing[obs_ids[0]],
+      cam1.pose.rotation(),
+      cam1.pose.translation(),
+      batch.obs_bearing[obs_ids[1]],
+      X,
+      etri_method
+    );
+  }
+  Mat4 AtA = Mat4::Zero();
+  for (IndexT i = 0; i < nb_obs; ++i)
+  {
+    const TriangulationCamera & cam = batch.cameras[batch.obs_camera[obs_ids[i]]];
+    const Vec4 Ptb = cam.P.transpose() * batch.obs_bearing[obs_ids[i]];
+    AtA += cam.PtP;
+    AtA.noalias() -= Ptb * Ptb.transpose();
+  }
+  const Eigen::SelfAdjointEigenSolver<Mat4> eigen_solver(AtA);
+  if (eigen_solver.info() != Eigen::Success)
+    return false;
+  X = eigen_solver.eigenvectors().col(0).hnormalized();
+  return true;
+}
+
+/// Cheirality test of an observation (always true for undefined cameras)
+inline bool cheirality_predicate
+(
+  const TriangulationBatch & batch,
+  const IndexT obs_id,
+  const Vec3 & X
+)
+{
+  if (batch.obs_camera[obs_id] == UndefinedIndexT)
+    return true;
+  const TriangulationCamera & cam = batch.cameras[batch.obs_camera[obs_id]];
+  return CheiralityTest(batch.obs_bearing[obs_id], cam.pose, X);
+}
+
+/// Cheirality and residual error test of an observation.
+/// Return false for undefined cameras, residual_sq is set if the point is in front of the camera.
+inline bool residual_and_cheirality_predicate
+(
+  const TriangulationBatch & batch,
+  const IndexT obs_id,
+  const Vec3 & X,
+  const double squared_pixel_threshold,
+  double & residual_sq
+)
+{
+  if (batch.obs_camera[obs_id] == UndefinedIndexT)
+    return false;
+  const TriangulationCamera & cam = batch.cameras[batch.obs_camera[obs_id]];
+  const Vec3 X_cam = cam.pose(X);
+  if (batch.obs_bearing[obs_id].dot(X_cam) <= 0.0)
+    return false;
+  residual_sq = cam.intrinsic->residual(X_cam, batch.obs_x[obs_id]).squaredNorm();
+  return residual_sq < squared_pixel_threshold;
+}
+
+/// Triangulate a track using all its observations.
+/// The track is valid if the point is in front of every camera.
+bool blind_track_triangulation
+(
+  TriangulationBatch & batch,
+  const IndexT track_id,
+  std::vector<IndexT> & obs_ids,
+  Vec3 & X
+)
+{
+  const IndexT begin = batch.track_offsets[track_id];
+  const IndexT end = batch.track_offsets[track_id + 1];
+  obs_ids.resize(end - begin);
+  std::iota(obs_ids.begin(), obs_ids.end(), begin);
+  if (!triangulate_observations(batch, obs_ids.data(), obs_ids.size(),
+                                ETriangulationMethod::DEFAULT, X))
+    return false;
+  for (IndexT i = begin; i < end; ++i)
+  {
+    if (!cheirality_predicate(batch, i, X))
+      return false;
+  }
+  return true;
+}
+
+/// Robustly triangulate a track using a ransac scheme.
+/// Inlier observations are flagged in batch.obs_inlier.
+bool robust_track_triangulation
+(
+  TriangulationBatch & batch,
+  const IndexT track_id,
+  const double squared_pixel_threshold,
+  const IndexT min_required_inliers,
+  const IndexT min_sample_index,
+  const ETriangulationMethod etri_method,
+  std::mt19937 & random_generator,
+  std::vector<IndexT> & obs_ids,
+  Vec3 & X
 )
 {
-  if (obs.size() >= 2)
+  const IndexT begin = batch.track_offsets[track_id];
+  const IndexT end = batch.track_offsets[track_id + 1];
+  const IndexT nb_obs = end - begin;
+  if (nb_obs < min_required_inliers || nb_obs < min_sample_index)
   {
-    std::vector<Vec3> bearing;
-    std::vector<Mat34> poses;
-    std::vector<Pose3> poses_;
-    bearing.reserve(obs.size());
-    poses.reserve(obs.size());
-    for (const auto& observation : obs)
+    return false;
+  }
+
+  // Handle the case where all observations must be used
+  if (min_required_inliers == min_sample_index &&
+      nb_obs == min_required_inliers)
+  {
+    // Generate the 3D point hypothesis by triangulating all the observations
+    obs_ids.resize(nb_obs);
+    std::iota(obs_ids.begin(), obs_ids.end(), begin);
+    if (!triangulate_observations(batch, obs_ids.data(), nb_obs, etri_method, X))
+      return false;
+    double residual_sq;
+    for (IndexT i = begin; i < end; ++i)
     {
-      const View * view = sfm_data.views.at(observation.first).get();
-      if (!sfm_data.IsPoseAndIntrinsicDefined(view))
+      if (batch.obs_camera[i] != UndefinedIndexT &&
+          !residual_and_cheirality_predicate(batch, i, X, squared_pixel_threshold, residual_sq))
         return false;
-      const IntrinsicBase * cam = sfm_data.GetIntrinsics().at(view->id_intrinsic).get();
-      const Pose3 pose = sfm_data.GetPoseOrDie(view);
-      bearing.emplace_back((*cam)(cam->get_ud_pixel(observation.second.x)));
-      poses.emplace_back(pose.asMatrix());
-      poses_.emplace_back(pose);
     }
-    if (bearing.size() > 2)
+    std::fill(batch.obs_inlier.begin() + begin, batch.obs_inlier.begin() + end, 1);
+    return true;
+  }
+
+  // else we perform a robust estimation since
+  //  there is more observations than the minimal number of required sample.
+
+  const IndexT nbIter = nb_obs * 2; // TODO: automatic computation of the number of iterations?
+
+  // - Ransac variables
+  Vec3 best_model = Vec3::Zero();
+  IndexT best_inlier_count = 0;
+  double best_error = std::numeric_limits<double>::max();
+  std::vector<unsigned char> best_inliers, inliers(nb_obs);
+
+  std::vector<uint32_t> samples;
+  // - Ransac loop
+  for (IndexT iter = 0; iter < nbIter; ++iter)
+  {
+    robust::UniformSample(min_sample_index, nb_obs, random_generator, &samples);
+    // Keep the observation ordering of the track
+    std::sort(samples.begin(), samples.end());
+    obs_ids.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+      obs_ids[i] = begin + samples[i];
+
+    // Hypothesis generation
+    Vec3 X_hypothesis;
+    if (!triangulate_observations(batch, obs_ids.data(), obs_ids.size(), etri_method, X_hypothesis))
+      continue;
+
+    // Test validity of the hypothesis
+    double residual_sq;
+    bool b_valid_sample = true;
+    for (const IndexT obs_id : obs_ids)
     {
-      const Eigen::Map<const Mat3X> bearing_matrix(bearing[0].data(), 3, bearing.size());
-      Vec4 Xhomogeneous;
-      if (TriangulateNViewAlgebraic
-      (
-        bearing_matrix,
-        poses,
-        &Xhomogeneous))
+      b_valid_sample &= residual_and_cheirality_predicate(
+        batch, obs_id, X_hypothesis, squared_pixel_threshold, residual_sq);
+    }
+    if (!b_valid_sample)
+      continue;
+
+    IndexT inlier_count = 0;
+    double current_error = 0.0;
+    // inlier/outlier classification according pixel residual errors.
+    for (IndexT i = 0; i < nb_obs; ++i)
+    {
+      inliers[i] = 0;
+      residual_sq = -1.0; // set only if the cheirality test succeeds
+      if (residual_and_cheirality_predicate(
+            batch, begin + i, X_hypothesis, squared_pixel_threshold, residual_sq))
+      {
+        inliers[i] = 1;
+        ++inlier_count;
+        current_error += residual_sq;
+      }
+      else if (residual_sq >= 0.0)
       {
-        X = Xhomogeneous.hnormalized();
-        return true;
+        current_error += squared_pixel_threshold;
       }
     }
-    else
+    // Does the hypothesis:
+    // - is the best one we have seen so far.
+    // - has sufficient inliers.
+    if (current_error < best_error &&
+        inlier_count >= min_required_inliers)
     {
-      return Triangulate2View
-      (
-        poses_.front().rotation(),
-        poses_.front().translation(),
-        bearing.front(),
-        poses_.back().rotation(),
-        poses_.back().translation(),
-        bearing.back(),
-        X,
-        etri_method
-      );
+      best_model = X_hypothesis;
+      best_inliers = inliers;
+      best_inlier_count = inlier_count;
+      best_error = current_error;
     }
   }
-  return false;
+  if (best_inlier_count == 0)
+    return false;
+
+  // Update information (3D landmark position & valid observations)
+  X = best_model;
+  std::copy(best_inliers.cbegin(), best_inliers.cend(), batch.obs_inlier.begin() + begin);
+  return true;
 }
 
-// Test if a predicate is true for each observation
-// i.e: predicate could be:
-// - cheirality test (depth test): cheirality_predicate
-// - cheirality and residual error: ResidualAndCheiralityPredicate::predicate
-bool track_check_predicate
+/// Keep only the observations flagged as inlier
+void keep_inlier_observations
 (
-  const Observations & obs,
-  const SfM_Data & sfm_data,
-  const Vec3 & X,
-  std::function<bool(
-    const IntrinsicBase&,
-    const Pose3&,
-    const Vec2&,
-    const Vec3&)> predicate
+  const TriangulationBatch & batch,
+  const IndexT track_id,
+  Observations & obs
 )
 {
-  bool visibility = false; // assume that no observation has been looked yet
-  for (const auto & obs_it : obs)
+  IndexT i = batch.track_offsets[track_id];
+  for (auto obs_it = obs.begin(); obs_it != obs.end(); ++i)
   {
-    const View * view = sfm_data.views.at(obs_it.first).get();
-    if (!sfm_data.IsPoseAndIntrinsicDefined(view))
-      continue;
-    visibility = true; // at least an observation is evaluated
-    const IntrinsicBase * cam = sfm_data.intrinsics.at(view->id_intrinsic).get();
-    const Pose3 pose = sfm_data.GetPoseOrDie(view);
-    if (!predicate(*cam, pose, obs_it.second.x, X))
-      return false;
+    if (batch.obs_inlier[i])
+      ++obs_it;
+    else
+      obs_it = obs.erase(obs_it);
   }
-  return visibility;
 }
 
-bool cheirality_predicate
+/// Triangulate all the tracks of the SfM_Data structure.
+/// Tracks are packed in contiguous arrays and processed by fixed size chunks,
+///  so the result does not depend on the number of threads.
+/// The functor is called for every track of a chunk as
+///   bool(batch, track_id, random_generator, obs_ids, X).
+template <typename TrackTriangulationFunctor>
+void triangulate_structure
 (
-  const IntrinsicBase& cam,
-  const Pose3& pose,
-  const Vec2& x,
-  const Vec3& X
+  SfM_Data & sfm_data,
+  const TrackTriangulationFunctor & track_triangulation,
+  const bool b_update_observations,
+  C_Progress * progress
 )
 {
-  return CheiralityTest(cam(x), pose, X);
-}
+  // Pack the tracks
+  TriangulationBatch batch;
+  std::vector<Landmarks::iterator> landmarks;
+  landmarks.reserve(sfm_data.structure.size());
+  batch.track_offsets.reserve(sfm_data.structure.size() + 1);
+  for (auto tracks_it = sfm_data.structure.begin();
+    tracks_it != sfm_data.structure.end(); ++tracks_it)
+  {
+    landmarks.push_back(tracks_it);
+    batch.add_track(sfm_data, tracks_it->second.obs);
+  }
+  batch.finalize();
 
-struct ResidualAndCheiralityPredicate
-{
-  const double squared_pixel_threshold_;
-
-  ResidualAndCheiralityPredicate(const double squared_pixel_threshold)
-    :squared_pixel_threshold_(squared_pixel_threshold){}
-
-  bool predicate
-  (
-    const IntrinsicBase& cam,
-    const Pose3& pose,
-    const Vec2& x,
-    const Vec3& X
-  )
+  // Triangulate the tracks by chunks and scatter back the results
+  std::vector<unsigned char> track_valid(batch.track_count(), 0);
+  const IndexT chunk_count =
+    (batch.track_count() + kTriangulationChunkSize - 1) / kTriangulationChunkSize;
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int chunk_id = 0; chunk_id < static_cast<int>(chunk_count); ++chunk_id)
   {
-    const Vec2 residual = cam.residual(pose(X), x);
-    return CheiralityTest(cam(x), pose, X) &&
-           residual.squaredNorm() < squared_pixel_threshold_;
+    const IndexT track_begin = chunk_id * kTriangulationChunkSize;
+    const IndexT track_end = std::min(track_begin + kTriangulationChunkSize, batch.track_count());
+    compute_bearings(batch, batch.track_offsets[track_begin], batch.track_offsets[track_end]);
+
+    // Deterministic random stream per chunk
+    std::mt19937 random_generator(std::mt19937::default_seed + chunk_id);
+    std::vector<IndexT> obs_ids;
+    for (IndexT track_id = track_begin; track_id < track_end; ++track_id)
+    {
+      Vec3 X;
+      if (track_triangulation(batch, track_id, random_generator, obs_ids, X))
+      {
+        Landmark & landmark = landmarks[track_id]->second;
+        landmark.X = X;
+        if (b_update_observations)
+          keep_inlier_observations(batch, track_id, landmark.obs);
+        track_valid[track_id] = 1;
+      }
+    }
+    if (progress)
+      (*progress) += track_end - track_begin;
   }
-};
+
+  // Erase the unsuccessful triangulated tracks
+  for (IndexT track_id = 0; track_id < batch.track_count(); ++track_id)
+  {
+    if (!track_valid[track_id])
+      sfm_data.structure.erase(landmarks[track_id]);
+  }
+}
+
+} // namespace
 
 void SfM_Data_Structure_Computation_Blind::triangulate
 (
@@ -170,7 +458,6 @@ void SfM_Data_Structure_Computation_Blind::triangulate
 )
 const
 {
-  std::deque<IndexT> rejectedId;
   std::unique_ptr<C_Progress> my_progress_bar;
   if (bConsole_verbose_)
     my_progress_bar.reset(
@@ -178,49 +465,16 @@ const
         sfm_data.structure.size(),
         std::cout,
         "Blind triangulation progress:\n" ));
-#ifdef OPENMVG_USE_OPENMP
-  #pragma omp parallel
-#endif
-  for (auto& tracks_it :sfm_data.structure)
-  {
-#ifdef OPENMVG_USE_OPENMP
-  #pragma omp single nowait
-#endif
-    {
-      if (bConsole_verbose_)
-      {
-        ++(*my_progress_bar);
-      }
 
-      const Observations & obs = tracks_it.second.obs;
-      bool bKeep = false;
-      {
-        // Generate the track 3D hypothesis
-        Vec3 X;
-        if (track_triangulation(sfm_data, obs, X))
-        {
-          // Keep the point only if it has a positive depth for all obs
-          if (track_check_predicate(obs, sfm_data, X, cheirality_predicate))
-          {
-            tracks_it.second.X = X;
-            bKeep = true;
-          }
-        }
-      }
-      if (!bKeep)
-      {
-#ifdef OPENMVG_USE_OPENMP
-        #pragma omp critical
-#endif
-        rejectedId.push_front(tracks_it.first);
-      }
-    }
-  }
-  // Erase the unsuccessful triangulated tracks
-  for (auto& it : rejectedId)
-  {
-    sfm_data.structure.erase(it);
-  }
+  triangulate_structure(
+    sfm_data,
+    [](TriangulationBatch & batch, const IndexT track_id, std::mt19937 &,
+       std::vector<IndexT> & obs_ids, Vec3 & X)
+    {
+      return blind_track_triangulation(batch, track_id, obs_ids, X);
+    },
+    false,
+    my_progress_bar.get());
 }
 
 SfM_Data_Structure_Computation_Robust::SfM_Data_Structure_Computation_Robust
@@ -257,63 +511,27 @@ void SfM_Data_Structure_Computation_Robust::robust_triangulation
 )
 const
 {
-  std::deque<IndexT> rejectedId;
-  std::unique_ptr<C_Progress_display> my_progress_bar;
+  std::unique_ptr<C_Progress> my_progress_bar;
   if (bConsole_verbose_)
     my_progress_bar.reset(
       new C_Progress_display(
         sfm_data.structure.size(),
         std::cout,
         "Robust triangulation progress:\n" ));
-#ifdef OPENMVG_USE_OPENMP
-  #pragma omp parallel
-#endif
-  for (auto& tracks_it :sfm_data.structure)
-  {
-#ifdef OPENMVG_USE_OPENMP
-  #pragma omp single nowait
-#endif
-    {
-      if (bConsole_verbose_)
-      {
-        ++(*my_progress_bar);
-      }
-      Landmark landmark;
-      if (robust_triangulation(sfm_data, tracks_it.second.obs, landmark))
-      {
-        tracks_it.second = landmark;
-      }
-      else
-      {
-        // Track must be deleted
-#ifdef OPENMVG_USE_OPENMP
-        #pragma omp critical
-#endif
-        rejectedId.push_front(tracks_it.first);
-      }
-    }
-  }
-  // Erase the unsuccessful triangulated tracks
-  for (auto& it : rejectedId)
-  {
-    sfm_data.structure.erase(it);
-  }
-}
 
-Observations ObservationsSampler
-(
-  const Observations & obs,
-  const std::vector<std::uint32_t> & samples
-)
-{
-  Observations sampled_obs;
-  for (const auto& idx : samples)
-  {
-    Observations::const_iterator obs_it = obs.cbegin();
-    std::advance(obs_it, idx);
-    sampled_obs.insert(*obs_it);
-  }
-  return sampled_obs;
+  const double dSquared_pixel_threshold = Square(max_reprojection_error_);
+  triangulate_structure(
+    sfm_data,
+    [&](TriangulationBatch & batch, const IndexT track_id, std::mt19937 & random_generator,
+        std::vector<IndexT> & obs_ids, Vec3 & X)
+    {
+      return robust_track_triangulation(
+        batch, track_id, dSquared_pixel_threshold,
+        min_required_inliers_, min_sample_index_, etri_method_,
+        random_generator, obs_ids, X);
+    },
+    true,
+    my_progress_bar.get());
 }
 
 /// Robustly try to estimate the best 3D point using a ransac scheme
@@ -327,113 +545,24 @@ bool SfM_Data_Structure_Computation_Robust::robust_triangulation
 )
 const
 {
-  if (obs.size() < min_required_inliers_ || obs.size() < min_sample_index_)
-  {
-    return false;
-  }
-
-  const double dSquared_pixel_threshold = Square(max_reprojection_error_);
-
-  // Predicate to validate a sample (cheirality and residual error)
-  ResidualAndCheiralityPredicate predicate(dSquared_pixel_threshold);
-  auto predicate_binding = std::bind(&ResidualAndCheiralityPredicate::predicate,
-                                     predicate,
-                                     std::placeholders::_1,
-                                     std::placeholders::_2,
-                                     std::placeholders::_3,
-                                     std::placeholders::_4);
+  TriangulationBatch batch;
+  batch.add_track(sfm_data, obs);
+  batch.finalize();
+  compute_bearings(batch, 0, batch.obs_x.size());
 
-  // Handle the case where all observations must be used
-  if (min_required_inliers_ == min_sample_index_ &&
-      obs.size() == min_required_inliers_)
-  {
-    // Generate the 3D point hypothesis by triangulating all the observations
-    Vec3 X;
-    if (track_triangulation(sfm_data, obs, X, etri_method_) &&
-        track_check_predicate(obs, sfm_data, X, predicate_binding))
-    {
-      landmark.X = X;
-      landmark.obs = obs;
-      return true;
-    }
-    return false;
-  }
-
-  // else we perform a robust estimation since
-  //  there is more observations than the minimal number of required sample.
-
-  const IndexT nbIter = obs.size() * 2; // TODO: automatic computation of the number of iterations?
-
-  // - Ransac variables
-  Vec3 best_model = Vec3::Zero();
-  std::deque<IndexT> best_inlier_set;
-  double best_error = std::numeric_limits<double>::max();
-
-  //--
-  // Random number generation
   std::mt19937 random_generator(std::mt19937::default_seed);
+  std::vector<IndexT> obs_ids;
+  Vec3 X;
+  if (!robust_track_triangulation(
+        batch, 0, Square(max_reprojection_error_),
+        min_required_inliers_, min_sample_index_, etri_method_,
+        random_generator, obs_ids, X))
+    return false;
 
-  // - Ransac loop
-  for (IndexT i = 0; i < nbIter; ++i)
-  {
-    std::vector<uint32_t> samples;
-    robust::UniformSample(min_sample_index_, obs.size(), random_generator, &samples);
-
-    Vec3 X;
-    // Hypothesis generation
-    const auto minimal_sample = ObservationsSampler(obs, samples);
-
-    if (!track_triangulation(sfm_data, minimal_sample, X, etri_method_))
-      continue;
-
-    // Test validity of the hypothesis
-    if (!track_check_predicate(minimal_sample, sfm_data, X, predicate_binding))
-      continue;
-
-    std::deque<IndexT> inlier_set;
-    double current_error = 0.0;
-    // inlier/outlier classification according pixel residual errors.
-    for (const auto & obs_it : obs)
-    {
-      const View * view = sfm_data.views.at(obs_it.first).get();
-      if (!sfm_data.IsPoseAndIntrinsicDefined(view))
-        continue;
-      const IntrinsicBase & cam =  *sfm_data.GetIntrinsics().at(view->id_intrinsic).get();
-      const Pose3 pose = sfm_data.GetPoseOrDie(view);
-      if (!CheiralityTest(cam(obs_it.second.x), pose, X))
-        continue;
-      const double residual_sq = cam.residual(pose(X), obs_it.second.x).squaredNorm();
-      if (residual_sq < dSquared_pixel_threshold)
-      {
-        inlier_set.push_front(obs_it.first);
-        current_error += residual_sq;
-      }
-      else
-      {
-        current_error += dSquared_pixel_threshold;
-      }
-    }
-    // Does the hypothesis:
-    // - is the best one we have seen so far.
-    // - has sufficient inliers.
-    if (current_error < best_error &&
-      inlier_set.size() >= min_required_inliers_)
-    {
-      best_model = X;
-      best_inlier_set = inlier_set;
-      best_error = current_error;
-    }
-  }
-  if (!best_inlier_set.empty() && best_inlier_set.size() >= min_required_inliers_)
-  {
-    // Update information (3D landmark position & valid observations)
-    landmark.X = best_model;
-    for (const IndexT & val : best_inlier_set)
-    {
-      landmark.obs[val] = obs.at(val);
-    }
-  }
-  return !best_inlier_set.empty();
+  landmark.X = X;
+  landmark.obs = obs;
+  keep_inlier_observations(batch, 0, landmark.obs);
+  return true;
 }
 
 } // namespace sfm
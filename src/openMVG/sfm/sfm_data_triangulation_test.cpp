@@ -17,6 +17,10 @@
 
 #include "testing/testing.h"
 
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace openMVG;
 using namespace openMVG::sfm;
 
@@ -110,6 +114,55 @@ TEST(SFM_DATA_TRIANGULATION, ROBUST) {
 
 }
 
+TEST(SFM_DATA_TRIANGULATION, ROBUST_THREAD_COUNT_INDEPENDENT) {
+
+  // Use enough points to get many triangulation chunks
+  const int nviews = 6;
+  const int npoints = 2048;
+  const nViewDatasetConfigurator config;
+  const NViewDataSet d = NRealisticCamerasRing(nviews, npoints, config);
+
+  const SfM_Data sfm_data = getInputScene(d, config, cameras::PINHOLE_CAMERA);
+
+  // Corrupt some observations to exercise the random sampling
+  SfM_Data sfm_data_noisy = sfm_data;
+  for (auto& landmark: sfm_data_noisy.structure)
+  {
+    if (landmark.first % 3 == 0)
+      landmark.second.obs.begin()->second.x += Vec2(50, -50);
+  }
+
+  SfM_Data_Structure_Computation_Robust triangulation_engine;
+
+  SfM_Data sfm_data_single_thread = sfm_data_noisy;
+#ifdef OPENMVG_USE_OPENMP
+  const int nb_max_thread = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  triangulation_engine.triangulate(sfm_data_single_thread);
+#ifdef OPENMVG_USE_OPENMP
+  omp_set_num_threads(std::max(4, nb_max_thread));
+#endif
+  SfM_Data sfm_data_multi_thread = sfm_data_noisy;
+  triangulation_engine.triangulate(sfm_data_multi_thread);
+#ifdef OPENMVG_USE_OPENMP
+  omp_set_num_threads(nb_max_thread);
+#endif
+
+  EXPECT_EQ(npoints, sfm_data_single_thread.structure.size());
+  EXPECT_EQ(sfm_data_single_thread.structure.size(), sfm_data_multi_thread.structure.size());
+  for (const auto& landmark: sfm_data_single_thread.structure)
+  {
+    const Landmark & other = sfm_data_multi_thread.structure.at(landmark.first);
+    EXPECT_EQ(landmark.second.obs.size(), other.obs.size());
+    EXPECT_MATRIX_NEAR(landmark.second.X, other.X, 1e-12);
+    EXPECT_MATRIX_NEAR(sfm_data.structure.at(landmark.first).X, landmark.second.X, 1e-8);
+    // The corrupted observation must be rejected
+    if (landmark.first % 3 == 0)
+      EXPECT_EQ(nviews - 1, landmark.second.obs.size());
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,134 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SYSTEM_BOUNDED_QUEUE_HPP
+#define OPENMVG_SYSTEM_BOUNDED_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace openMVG
+{
+namespace system
+{
+
+/**
+* @brief Thread safe FIFO queue bounded by the accumulated cost of its items.
+* It is the link between the stages of a producer/consumer pipeline:
+*  - Push blocks while the queue would exceed its capacity (back-pressure),
+*    an item is always accepted by an empty queue (even if too expensive),
+*  - Pop blocks until an item is available or the queue is closed.
+* The cost of an item is user defined (i.e. a memory footprint in bytes,
+*  or 1 to bound the number of items).
+*/
+template <typename T>
+class BoundedQueue
+{
+public:
+
+  /**
+  * @brief Constructor
+  * @param capacity Maximal accumulated cost of the queued items
+  * @param producer_count Number of producers, the queue is closed once all of
+  *  them have called ProducerDone
+  */
+  explicit BoundedQueue
+  (
+    std::size_t capacity,
+    unsigned int producer_count = 1
+  ):
+    capacity_(capacity),
+    size_(0),
+    producer_count_(producer_count),
+    closed_(producer_count == 0)
+  {
+  }
+
+  /**
+  * @brief Add an item at the end of the queue (wait for enough room).
+  * @param item The item to add
+  * @param cost The cost of the item
+  * @return false if the queue is closed (the item is discarded)
+  */
+  bool Push(T item, std::size_t cost = 1)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&]
+      { return closed_ || queue_.empty() || size_ + cost <= capacity_; });
+    if (closed_)
+      return false;
+    queue_.emplace_back(std::move(item), cost);
+    size_ += cost;
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+  * @brief Remove the item at the front of the queue (wait for one).
+  * @param[out] item The removed item
+  * @return false if the queue is closed and empty
+  */
+  bool Pop(T & item)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [&]{ return closed_ || !queue_.empty(); });
+    if (queue_.empty())
+      return false;
+    item = std::move(queue_.front().first);
+    size_ -= queue_.front().second;
+    queue_.pop_front();
+    not_full_.notify_all();
+    return true;
+  }
+
+  /// Signal that a producer will not push anymore items
+  void ProducerDone()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (producer_count_ > 0 && --producer_count_ == 0)
+      CloseLocked();
+  }
+
+  /// Close the queue: pending and future Push fail, Pop drains the queue
+  void Close()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CloseLocked();
+  }
+
+  /// Accumulated cost of the queued items
+  std::size_t Size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+private:
+  void CloseLocked()
+  {
+    closed_ = true;
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_, not_full_;
+  std::deque<std::pair<T, std::size_t>> queue_;
+  const std::size_t capacity_;
+  std::size_t size_;
+  unsigned int producer_count_;
+  bool closed_;
+};
+
+} // namespace system
+} // namespace openMVG
+
+#endif // OPENMVG_SYSTEM_BOUNDED_QUEUE_HPP
@@ -0,0 +1,105 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/system/bounded_queue.hpp"
+
+#include "testing/testing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace openMVG::system;
+
+TEST(BoundedQueue, Fifo)
+{
+  BoundedQueue<int> queue(10);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_TRUE(queue.Push(i, 2));
+  EXPECT_EQ(10, queue.Size());
+  queue.ProducerDone();
+  // Once closed, no more push but the remaining items can be popped
+  EXPECT_FALSE(queue.Push(5));
+  int item;
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_TRUE(queue.Pop(item));
+    EXPECT_EQ(i, item);
+  }
+  EXPECT_FALSE(queue.Pop(item));
+  EXPECT_EQ(0, queue.Size());
+}
+
+TEST(BoundedQueue, OversizedItemInEmptyQueue)
+{
+  BoundedQueue<int> queue(4);
+  EXPECT_TRUE(queue.Push(1, 100));
+  int item;
+  EXPECT_TRUE(queue.Pop(item));
+  EXPECT_EQ(1, item);
+}
+
+TEST(BoundedQueue, ProducersConsumers)
+{
+  const int item_count = 10000, producer_count = 3, consumer_count = 4;
+  const std::size_t capacity = 8;
+  BoundedQueue<int> queue(capacity, producer_count);
+
+  std::atomic<int> next(0);
+  std::atomic<bool> capacity_exceeded(false);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producer_count; ++i)
+  {
+    threads.emplace_back([&]{
+      for (int value = next++; value < item_count; value = next++)
+      {
+        queue.Push(value);
+        if (queue.Size() > capacity)
+          capacity_exceeded = true;
+      }
+      queue.ProducerDone();
+    });
+  }
+  std::vector<std::vector<int>> popped(consumer_count);
+  for (int i = 0; i < consumer_count; ++i)
+  {
+    threads.emplace_back([&, i]{
+      int value;
+      while (queue.Pop(value))
+        popped[i].push_back(value);
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  // Every item is consumed exactly once
+  std::vector<int> all;
+  for (const auto & values : popped)
+    all.insert(all.end(), values.begin(), values.end());
+  std::sort(all.begin(), all.end());
+  EXPECT_EQ(item_count, all.size());
+  for (int i = 0; i < static_cast<int>(all.size()); ++i)
+    EXPECT_EQ(i, all[i]);
+  EXPECT_FALSE(capacity_exceeded);
+}
+
+TEST(BoundedQueue, CloseUnblocksProducer)
+{
+  BoundedQueue<int> queue(1);
+  EXPECT_TRUE(queue.Push(0));
+  bool pushed = true;
+  std::thread producer([&]{ pushed = queue.Push(1); });
+  queue.Close();
+  producer.join();
+  EXPECT_FALSE(pushed);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -0,0 +1,104 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/system/memory_usage.hpp"
+
+#if defined(__linux__)
+#include <fstream>
+#include <string>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace openMVG {
+namespace system {
+
+#if defined(__linux__)
+namespace {
+
+// Read a memory field (i.e. "VmRSS:") of /proc/self/status (given in kB)
+uint64_t ReadProcStatusField(const std::string & field)
+{
+  std::ifstream stream("/proc/self/status");
+  std::string token;
+  while (stream >> token)
+  {
+    if (token == field)
+    {
+      uint64_t value_kb = 0;
+      stream >> value_kb;
+      return value_kb * 1024;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+#endif
+
+uint64_t CurrentMemoryUsage()
+{
+#if defined(__linux__)
+  return ReadProcStatusField("VmRSS:");
+#elif defined(__APPLE__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    return 0;
+  return info.resident_size;
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return counters.WorkingSetSize;
+#else
+  return 0;
+#endif
+}
+
+uint64_t PeakMemoryUsage()
+{
+#if defined(__linux__)
+  return ReadProcStatusField("VmHWM:");
+#elif defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return usage.ru_maxrss; // bytes on macOS
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return counters.PeakWorkingSetSize;
+#else
+  return 0;
+#endif
+}
+
+bool ResetPeakMemoryUsage()
+{
+#if defined(__linux__)
+  // Writing 5 to clear_refs resets the high water mark (Linux >= 4.0)
+  std::ofstream stream("/proc/self/clear_refs");
+  if (!stream)
+    return false;
+  stream << "5";
+  stream.close();
+  return !stream.fail();
+#else
+  return false;
+#endif
+}
+
+} // namespace system
+} // namespace openMVG
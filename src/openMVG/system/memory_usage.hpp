@@ -0,0 +1,43 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SYSTEM_MEMORY_USAGE_HPP
+#define OPENMVG_SYSTEM_MEMORY_USAGE_HPP
+
+#include <cstdint>
+
+namespace openMVG
+{
+namespace system
+{
+
+/**
+* @brief Get the resident memory used by the process.
+* @return Resident memory size in bytes (0 if not available on this platform)
+*/
+uint64_t CurrentMemoryUsage();
+
+/**
+* @brief Get the peak resident memory used by the process (high water mark).
+* @return Peak resident memory size in bytes (0 if not available on this platform)
+*/
+uint64_t PeakMemoryUsage();
+
+/**
+* @brief Reset the peak resident memory to the current resident memory,
+*  in order to measure the peak of a given processing step.
+*  (only supported on Linux, on the other platforms the peak is the one of the
+*  whole process lifetime)
+* @return True if the peak has been reset
+*/
+bool ResetPeakMemoryUsage();
+
+} // namespace system
+} // namespace openMVG
+
+#endif // OPENMVG_SYSTEM_MEMORY_USAGE_HPP
@@ -0,0 +1,46 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/system/memory_usage.hpp"
+
+#include "testing/testing.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace openMVG::system;
+
+TEST(MemoryUsage, PeakTracksAllocations)
+{
+  if (CurrentMemoryUsage() == 0 || PeakMemoryUsage() == 0)
+  {
+    std::cout << "Memory usage is not available on this platform." << std::endl;
+    return;
+  }
+  EXPECT_TRUE(PeakMemoryUsage() >= CurrentMemoryUsage());
+
+  const uint64_t peak_before = PeakMemoryUsage();
+  const uint64_t buffer_size = 64 << 20;
+  {
+    // Touch the memory in order to make it resident
+    std::vector<char> buffer(buffer_size, 1);
+    EXPECT_TRUE(CurrentMemoryUsage() >= buffer_size);
+  }
+  EXPECT_TRUE(PeakMemoryUsage() >= buffer_size);
+  EXPECT_TRUE(PeakMemoryUsage() >= peak_before);
+
+  // Once reset, the peak no longer accounts for the released buffer
+  if (ResetPeakMemoryUsage())
+  {
+    EXPECT_TRUE(PeakMemoryUsage() < peak_before + buffer_size);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
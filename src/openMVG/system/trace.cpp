@@ -0,0 +1,257 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/system/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace openMVG {
+namespace system {
+
+namespace internal
+{
+std::atomic<bool> tracing_enabled(false);
+} // namespace internal
+
+namespace {
+
+struct TraceEvent
+{
+  char phase; // 'X': complete span, 'C': counter
+  std::string name;
+  const char * category;
+  uint64_t timestamp_us;
+  uint64_t duration_us;
+  std::vector<std::pair<const char *, double>> args;
+};
+
+// The events of one thread (the buffer outlives its thread)
+struct ThreadBuffer
+{
+  std::mutex mutex;
+  uint32_t thread_id;
+  std::vector<TraceEvent> events;
+};
+
+struct TraceRegistry
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+TraceRegistry & Registry()
+{
+  static TraceRegistry registry;
+  return registry;
+}
+
+uint64_t NowUs()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - Registry().origin).count();
+}
+
+ThreadBuffer & LocalBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer)
+  {
+    buffer = std::make_shared<ThreadBuffer>();
+    TraceRegistry & registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    buffer->thread_id = registry.buffers.size();
+    registry.buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+void Record(TraceEvent && event)
+{
+  ThreadBuffer & buffer = LocalBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.events.push_back(std::move(event));
+}
+
+void WriteJSONString(std::ostream & os, const std::string & str)
+{
+  os << '"';
+  for (const char c : str)
+  {
+    switch (c)
+    {
+      case '"': os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\n': os << "\\n"; break;
+      case '\t': os << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+             << std::dec << std::setfill(' ');
+        else
+          os << c;
+    }
+  }
+  os << '"';
+}
+
+} // namespace
+
+void EnableTracing(bool enable)
+{
+  // Set the time origin before the first event
+  Registry();
+  internal::tracing_enabled.store(enable, std::memory_order_relaxed);
+}
+
+void ClearTrace()
+{
+  TraceRegistry & registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto & buffer : registry.buffers)
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    buffer->events.clear();
+  }
+}
+
+void TraceCounter(const std::string & name, double value)
+{
+  if (!IsTracingEnabled())
+    return;
+  Record({'C', name, "openMVG", NowUs(), 0, {{"value", value}}});
+}
+
+ScopedTrace::ScopedTrace(const char * name, const char * category)
+  : active_(IsTracingEnabled())
+{
+  if (active_)
+    Begin(name, category);
+}
+
+ScopedTrace::ScopedTrace(const std::string & name, const char * category)
+  : active_(IsTracingEnabled())
+{
+  if (active_)
+    Begin(name.c_str(), category);
+}
+
+void ScopedTrace::Begin(const char * name, const char * category)
+{
+  name_ = name;
+  category_ = category;
+  start_us_ = NowUs();
+}
+
+ScopedTrace::~ScopedTrace()
+{
+  if (!active_)
+    return;
+  const uint64_t end_us = NowUs();
+  Record({'X', std::move(name_), category_, start_us_, end_us - start_us_,
+          std::move(counters_)});
+}
+
+void ExportChromeTrace(std::ostream & os)
+{
+  TraceRegistry & registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first_event = true;
+  for (const auto & buffer : registry.buffers)
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    // Name the thread track
+    os << (first_event ? "\n" : ",\n")
+       << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+       << ",\"name\":\"thread_name\",\"args\":{\"name\":\""
+       << (buffer->thread_id == 0 ? "main" : "worker ") ;
+    if (buffer->thread_id != 0)
+      os << buffer->thread_id;
+    os << "\"}}";
+    first_event = false;
+
+    // Sort the events by starting time (parents before their children).
+    //  A span is recorded when it ends, so the reverse recording order puts
+    //  the parents first when the timestamps are equal.
+    std::vector<const TraceEvent *> events;
+    events.reserve(buffer->events.size());
+    for (auto it = buffer->events.crbegin(); it != buffer->events.crend(); ++it)
+      events.push_back(&(*it));
+    std::stable_sort(events.begin(), events.end(),
+      [](const TraceEvent * a, const TraceEvent * b)
+      {
+        return a->timestamp_us < b->timestamp_us ||
+          (a->timestamp_us == b->timestamp_us && a->duration_us > b->duration_us);
+      });
+
+    for (const TraceEvent * event : events)
+    {
+      os << ",\n{\"ph\":\"" << event->phase << "\",\"pid\":1,\"tid\":" << buffer->thread_id
+         << ",\"name\":";
+      WriteJSONString(os, event->name);
+      os << ",\"cat\":";
+      WriteJSONString(os, event->category);
+      os << ",\"ts\":" << event->timestamp_us;
+      if (event->phase == 'X')
+        os << ",\"dur\":" << event->duration_us;
+      if (!event->args.empty())
+      {
+        os << ",\"args\":{";
+        for (size_t i = 0; i < event->args.size(); ++i)
+        {
+          if (i > 0)
+            os << ',';
+          WriteJSONString(os, event->args[i].first);
+          os << ':' << std::setprecision(17) << event->args[i].second;
+        }
+        os << '}';
+      }
+      os << '}';
+    }
+  }
+  os << "\n]}" << std::endl;
+}
+
+bool ExportChromeTrace(const std::string & filename)
+{
+  std::ofstream stream(filename);
+  if (!stream.is_open())
+    return false;
+  ExportChromeTrace(stream);
+  return stream.good();
+}
+
+ScopedTraceSession::ScopedTraceSession(const std::string & filename)
+  : filename_(filename)
+{
+  if (!filename_.empty())
+    EnableTracing(true);
+}
+
+ScopedTraceSession::~ScopedTraceSession()
+{
+  if (filename_.empty())
+    return;
+  EnableTracing(false);
+  if (ExportChromeTrace(filename_))
+    std::cout << "Trace saved to: " << filename_ << std::endl;
+  else
+    std::cerr << "Cannot write the trace file: " << filename_ << std::endl;
+}
+
+} // namespace system
+} // namespace openMVG
@@ -0,0 +1,164 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef OPENMVG_SYSTEM_TRACE_HPP
+#define OPENMVG_SYSTEM_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openMVG
+{
+namespace system
+{
+
+/**
+* Hierarchical stage tracing.
+*
+* The traced spans (scopes) are recorded in a per thread buffer and can be
+*  exported as a Chrome trace (JSON Trace Event Format), to be displayed in
+*  chrome://tracing or https://ui.perfetto.dev. Nested spans of a thread are
+*  displayed as a call stack.
+*
+* The tracing is disabled by default: a disabled span only costs an atomic
+*  flag read.
+*
+* Usage:
+* @code
+*  system::EnableTracing(true);
+*  {
+*    OPENMVG_TRACE_SCOPE("Bundle adjustment");
+*    ...
+*    {
+*      system::ScopedTrace trace("Solve", "ba");
+*      ...
+*      trace.AddCounter("iterations", summary.iterations.size());
+*    }
+*  }
+*  system::ExportChromeTrace("trace.json");
+* @endcode
+*/
+
+namespace internal
+{
+extern std::atomic<bool> tracing_enabled;
+} // namespace internal
+
+/**
+* @brief Enable or disable the recording of the traced spans
+* @param enable New tracing state
+*/
+void EnableTracing(bool enable);
+
+/**
+* @brief Tell if the traced spans are recorded
+*/
+inline bool IsTracingEnabled()
+{
+  return internal::tracing_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+* @brief Remove all the recorded events (of all the threads)
+*/
+void ClearTrace();
+
+/**
+* @brief Record a counter value (displayed as a graph over time)
+* @param name Counter name
+* @param value Counter value
+*/
+void TraceCounter(const std::string & name, double value);
+
+/**
+* @brief Traced span: record the lifetime of the object (if the tracing is
+*  enabled at its construction) with the counters added to it.
+*/
+class ScopedTrace
+{
+public:
+  /**
+  * @param name Span name (i.e. the processing stage)
+  * @param category Span category (used to filter the spans in the viewer)
+  */
+  explicit ScopedTrace(const char * name, const char * category = "openMVG");
+  ScopedTrace(const std::string & name, const char * category = "openMVG");
+  ~ScopedTrace();
+
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace & operator=(const ScopedTrace &) = delete;
+
+  /**
+  * @brief Attach a value to the span (i.e. a number of processed items)
+  * @param name Counter name
+  * @param value Counter value
+  */
+  void AddCounter(const char * name, double value)
+  {
+    if (active_)
+      counters_.emplace_back(name, value);
+  }
+
+private:
+  void Begin(const char * name, const char * category);
+
+  bool active_;
+  uint64_t start_us_;
+  std::string name_;
+  const char * category_;
+  std::vector<std::pair<const char *, double>> counters_;
+};
+
+/**
+* @brief Export the recorded events as a Chrome trace (JSON object format)
+* @param os Output stream
+*/
+void ExportChromeTrace(std::ostream & os);
+
+/**
+* @brief Export the recorded events as a Chrome trace JSON file
+* @param filename Output file
+* @return True if the file has been written
+*/
+bool ExportChromeTrace(const std::string & filename);
+
+/**
+* @brief Tracing of an application run: enable the tracing if a trace file is
+*  given and export the recorded events to it when the session ends.
+*/
+class ScopedTraceSession
+{
+public:
+  /**
+  * @param filename Chrome trace output file (no tracing if empty)
+  */
+  explicit ScopedTraceSession(const std::string & filename);
+  ~ScopedTraceSession();
+
+  ScopedTraceSession(const ScopedTraceSession &) = delete;
+  ScopedTraceSession & operator=(const ScopedTraceSession &) = delete;
+
+private:
+  std::string filename_;
+};
+
+} // namespace system
+} // namespace openMVG
+
+#define OPENMVG_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENMVG_TRACE_CONCAT(a, b) OPENMVG_TRACE_CONCAT_IMPL(a, b)
+
+/// Trace the enclosing scope
+#define OPENMVG_TRACE_SCOPE(name) \
+  openMVG::system::ScopedTrace OPENMVG_TRACE_CONCAT(openmvg_trace_scope_, __LINE__)(name)
+
+#endif // OPENMVG_SYSTEM_TRACE_HPP
@@ -0,0 +1,107 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/system/trace.hpp"
+
+#include "testing/testing.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace openMVG::system;
+
+namespace {
+
+size_t CountOccurrences(const std::string & str, const std::string & pattern)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + pattern.size()))
+    ++count;
+  return count;
+}
+
+std::string ExportToString()
+{
+  std::ostringstream os;
+  ExportChromeTrace(os);
+  return os.str();
+}
+
+} // namespace
+
+TEST(Trace, Disabled)
+{
+  ClearTrace();
+  EnableTracing(false);
+  {
+    OPENMVG_TRACE_SCOPE("disabled_span");
+    TraceCounter("disabled_counter", 1.0);
+  }
+  const std::string trace = ExportToString();
+  EXPECT_EQ(0, CountOccurrences(trace, "disabled_span"));
+  EXPECT_EQ(0, CountOccurrences(trace, "disabled_counter"));
+}
+
+TEST(Trace, NestedSpans)
+{
+  ClearTrace();
+  EnableTracing(true);
+  {
+    ScopedTrace parent("parent");
+    {
+      ScopedTrace child(std::string("child \"quoted\""), "test");
+      child.AddCounter("items", 42);
+    }
+    TraceCounter("counter", 3.5);
+  }
+  EnableTracing(false);
+
+  const std::string trace = ExportToString();
+  EXPECT_EQ(1, CountOccurrences(trace, "\"name\":\"parent\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"name\":\"child \\\"quoted\\\"\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"cat\":\"test\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"items\":42"));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"ph\":\"C\""));
+  // The parent span is exported before its child
+  EXPECT_TRUE(trace.find("\"name\":\"parent\"") < trace.find("\"name\":\"child"));
+}
+
+TEST(Trace, Threads)
+{
+  ClearTrace();
+  EnableTracing(true);
+  {
+    OPENMVG_TRACE_SCOPE("main_span");
+    std::thread worker([]
+    {
+      OPENMVG_TRACE_SCOPE("worker_span");
+    });
+    worker.join();
+  }
+  EnableTracing(false);
+
+  // The worker span is still exported once its thread has ended,
+  //  and on another thread track
+  const std::string trace = ExportToString();
+  const size_t main_pos = trace.find("\"name\":\"main_span\"");
+  const size_t worker_pos = trace.find("\"name\":\"worker_span\"");
+  EXPECT_TRUE(main_pos != std::string::npos);
+  EXPECT_TRUE(worker_pos != std::string::npos);
+  const std::string main_tid = trace.substr(trace.rfind("\"tid\":", main_pos), 8);
+  const std::string worker_tid = trace.substr(trace.rfind("\"tid\":", worker_pos), 8);
+  EXPECT_TRUE(main_tid != worker_tid);
+
+  ClearTrace();
+  EXPECT_EQ(0, CountOccurrences(ExportToString(), "_span"));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
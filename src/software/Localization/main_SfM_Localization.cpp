@@ -27,6 +27,7 @@ using namespace openMVG::sfm;
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 
 #ifdef OPENMVG_USE_OPENMP
@@ -68,6 +69,7 @@ int main(int argc, char **argv)
   bool bUseSingleIntrinsics = false;
   bool bExportStructure = false;
   int resection_method  = static_cast<int>(resection::SolverType::DEFAULT);
+  int acransac_parallel_min_samples = 0;
 
 #ifdef OPENMVG_USE_OPENMP
   int iNumThreads = 0;
@@ -83,6 +85,8 @@ int main(int argc, char **argv)
   cmd.add( make_switch('s', "single_intrinsics"));
   cmd.add( make_switch('e', "export_structure"));
   cmd.add( make_option('R', resection_method, "resection_method"));
+  cmd.add( make_switch('B', "acransac_bail_out") );
+  cmd.add( make_option('E', acransac_parallel_min_samples, "acransac_parallel_min_samples") );
 
 #ifdef OPENMVG_USE_OPENMP
   cmd.add( make_option('n', iNumThreads, "numThreads") );
@@ -123,6 +127,10 @@ int main(int argc, char **argv)
       << "\t" << static_cast<int>(resection::SolverType::P3P_KNEIP_CVPR11) << ": P3P_KNEIP_CVPR11\n"
       << "\t" << static_cast<int>(resection::SolverType::P3P_NORDBERG_ECCV18) << ": P3P_NORDBERG_ECCV18\n"
       << "\t" << static_cast<int>(resection::SolverType::UP2P_KUKELOVA_ACCV10)  << ": UP2P_KUKELOVA_ACCV10 | 2Points | upright camera\n"
+    << "[-B|--acransac_bail_out] Enable the preemptive verification of the resection hypotheses\n"
+      << "\t (faster robust estimation, the search is no longer exhaustive)\n"
+    << "[-E|--acransac_parallel_min_samples] Evaluate the resection hypotheses with several threads\n"
+      << "\t if there are at least this number of correspondences (default=0: disabled)\n"
 #ifdef OPENMVG_USE_OPENMP
     << "[-n|--numThreads] number of thread(s)\n"
 #endif
@@ -385,6 +393,8 @@ int main(int argc, char **argv)
     geometry::Pose3 pose;
     sfm::Image_Localizer_Match_Data matching_data;
     matching_data.error_max = dMaxResidualError;
+    matching_data.evaluation_options.bail_out = cmd.used('B');
+    matching_data.evaluation_options.parallel_min_samples = std::max(0, acransac_parallel_min_samples);
 
     bool bSuccessfulLocalization = false;
 
@@ -0,0 +1,344 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_BA.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+#include "openMVG/sfm/sfm_data_filters.hpp"
+#include "openMVG/sfm/sfm_data_io.hpp"
+#include "openMVG/sfm/sfm_data_merge.hpp"
+#include "openMVG/sfm/sfm_report.hpp"
+#include "openMVG/system/timer.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include <ceres/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::cameras;
+using namespace openMVG::sfm;
+
+/**
+* @brief Prepare the input scene of a cluster reconstruction:
+*  keep the views & intrinsics of the cluster, drop the poses & structure
+*  since the cluster is reconstructed from scratch from the matches.
+* @param cluster_filename The cluster scene (openMVG_main_ComputeClusters output)
+* @param out_filename Output file name
+* @retval true if success
+* @retval false if failure
+*/
+bool exportClusterViews
+(
+  const std::string & cluster_filename,
+  const std::string & out_filename
+)
+{
+  SfM_Data sfm_data;
+  if (!Load(sfm_data, cluster_filename, ESfM_Data(VIEWS|INTRINSICS)))
+    return false;
+  return Save(sfm_data, out_filename, ESfM_Data(VIEWS|INTRINSICS));
+}
+
+int main( int argc, char **argv )
+{
+  std::cout << "Partitioned reconstruction: reconstruct & merge view clusters" << std::endl
+            << std::endl;
+
+  CmdLine cmd;
+
+  std::string sClustersDir = "";
+  std::string sMatchesDir = "";
+  std::string sMatchFilename = "";
+  std::string sOutDir = "";
+  std::string sSfMEngine = "INCREMENTAL";
+  std::string sBinDir = stlplus::folder_part(argv[0]);
+  int iNumJobs = 0;
+  int iMinCorrespondences = 6;
+
+  cmd.add( make_option( 'i', sClustersDir, "input_dir" ) );
+  cmd.add( make_option( 'm', sMatchesDir, "matchdir" ) );
+  cmd.add( make_option( 'M', sMatchFilename, "match_file" ) );
+  cmd.add( make_option( 'o', sOutDir, "outdir" ) );
+  cmd.add( make_option( 's', sSfMEngine, "sfm_engine" ) );
+  cmd.add( make_option( 'b', sBinDir, "bin_dir" ) );
+  cmd.add( make_option( 'n', iNumJobs, "jobs" ) );
+  cmd.add( make_option( 'c', iMinCorrespondences, "min_correspondences" ) );
+
+  try
+  {
+    if ( argc == 1 )
+      throw std::string( "Invalid command line parameter." );
+    cmd.process( argc, argv );
+  }
+  catch ( const std::string &s )
+  {
+    std::cerr << "Usage: " << argv[ 0 ] << "\n"
+              << "[-i|--input_dir] path to the clusters (sfm_dataXXXX.bin files of openMVG_main_ComputeClusters)\n"
+              << "[-m|--matchdir] path to the matches that corresponds to the clustered SfM_Data scene\n"
+              << "[-o|--outdir] path where the output data will be stored\n"
+              << "\n[Optional]\n"
+              << "[-M|--match_file] path to the match file to use (forwarded to the reconstruction)\n"
+              << "[-s|--sfm_engine] reconstruction engine used for each cluster:\n"
+              << "\t INCREMENTAL: openMVG_main_IncrementalSfM (default)\n"
+              << "\t GLOBAL: openMVG_main_GlobalSfM\n"
+              << "[-b|--bin_dir] path to the openMVG binaries (default: this executable folder)\n"
+              << "[-n|--jobs] number of cluster reconstructions run in parallel (default: #cores / 4)\n"
+              << "  the cores are shared by the jobs (OMP_NUM_THREADS of each job: #cores / #jobs)\n"
+              << "[-c|--min_correspondences] minimal number of 3D correspondences to register a cluster (default: "
+              << iMinCorrespondences << ")\n"
+              << std::endl;
+
+    std::cerr << s << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string sSfMBinary;
+  if ( sSfMEngine == "INCREMENTAL" )
+    sSfMBinary = "openMVG_main_IncrementalSfM";
+  else if ( sSfMEngine == "GLOBAL" )
+    sSfMBinary = "openMVG_main_GlobalSfM";
+  else
+  {
+    std::cerr << "\nUnknown SfM engine: " << sSfMEngine << std::endl;
+    return EXIT_FAILURE;
+  }
+  sSfMBinary = stlplus::create_filespec( sBinDir, sSfMBinary );
+
+  // Each reconstruction is multi-threaded: the cores are shared by the jobs
+  //  in order to avoid the oversubscription of the CPU
+  const unsigned int nb_cores = std::max( 1u, std::thread::hardware_concurrency() );
+  const unsigned int nb_jobs = iNumJobs > 0 ? iNumJobs : std::max( 1u, nb_cores / 4 );
+  const unsigned int nb_job_threads = std::max( 1u, nb_cores / nb_jobs );
+
+  std::cout << "Params: " << argv[ 0 ]  << std::endl
+            << "[Input dir]       = " << sClustersDir << std::endl
+            << "[Matches dir]     = " << sMatchesDir << std::endl
+            << "[Outdir path]     = " << sOutDir << std::endl
+            << "[SfM engine]      = " << sSfMBinary << std::endl
+            << "[Parallel jobs]   = " << nb_jobs << std::endl
+            << "[Threads per job] = " << nb_job_threads << std::endl;
+
+  if ( sOutDir.empty() || sMatchesDir.empty() )
+  {
+    std::cerr << "\nInvalid matches or output directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // List the clusters
+  std::vector<std::string> vec_cluster_files =
+    stlplus::folder_wildcard( sClustersDir, "sfm_data*.bin", false, true );
+  std::sort( vec_cluster_files.begin(), vec_cluster_files.end() );
+  if ( vec_cluster_files.empty() )
+  {
+    std::cerr << "\nNo cluster found in: " << sClustersDir << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Number of clusters = " << vec_cluster_files.size() << std::endl;
+
+  // Prepare output folder
+  if ( !stlplus::folder_exists( sOutDir ) )
+    if ( !stlplus::folder_create( sOutDir ))
+    {
+      std::cerr << "Cannot create: " << sOutDir << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  //---------------------------------------
+  // Reconstruct the clusters: one process per cluster, nb_jobs at a time
+  //---------------------------------------
+  openMVG::system::Timer timer;
+  std::vector<std::string> vec_cluster_dirs( vec_cluster_files.size() );
+  // Only the clusters whose reconstruction succeeded are merged
+  std::vector<char> vec_cluster_reconstructed( vec_cluster_files.size(), 0 );
+  {
+    std::atomic<size_t> next_cluster( 0 );
+    std::mutex log_mutex;
+    std::vector<std::thread> threads;
+    for ( unsigned int t = 0; t < std::min<size_t>( nb_jobs, vec_cluster_files.size() ); ++t )
+    {
+      threads.emplace_back( [&]
+      {
+        for ( size_t i = next_cluster++; i < vec_cluster_files.size(); i = next_cluster++ )
+        {
+          const std::string sClusterDir = stlplus::create_filespec( sOutDir,
+            stlplus::basename_part( vec_cluster_files[ i ] ) );
+          vec_cluster_dirs[ i ] = sClusterDir;
+          const std::string sClusterViews =
+            stlplus::create_filespec( sClusterDir, "sfm_data_views", "bin" );
+          // Remove the reconstruction of a previous run
+          const std::string sClusterSubmap =
+            stlplus::create_filespec( sClusterDir, "sfm_data", "bin" );
+          if ( stlplus::file_exists( sClusterSubmap ) && !stlplus::file_delete( sClusterSubmap ) )
+          {
+            std::lock_guard<std::mutex> lock( log_mutex );
+            std::cerr << "Cannot remove the previous reconstruction: " << sClusterSubmap << std::endl;
+            continue;
+          }
+
+          if ( ( !stlplus::folder_exists( sClusterDir ) && !stlplus::folder_create( sClusterDir ) ) ||
+               !exportClusterViews( stlplus::create_filespec( sClustersDir, vec_cluster_files[ i ] ),
+                                    sClusterViews ) )
+          {
+            std::lock_guard<std::mutex> lock( log_mutex );
+            std::cerr << "Cannot prepare the cluster: " << vec_cluster_files[ i ] << std::endl;
+            continue;
+          }
+
+          std::ostringstream command;
+#ifdef _WIN32
+          command << "set OMP_NUM_THREADS=" << nb_job_threads << "&& ";
+#else
+          command << "OMP_NUM_THREADS=" << nb_job_threads << " ";
+#endif
+          command
+            << "\"" << sSfMBinary << "\""
+            << " -i \"" << sClusterViews << "\""
+            << " -m \"" << sMatchesDir << "\""
+            << " -o \"" << sClusterDir << "\"";
+          if ( !sMatchFilename.empty() )
+            command << " -M \"" << sMatchFilename << "\"";
+          command << " > \"" << stlplus::create_filespec( sClusterDir, "log", "txt" ) << "\" 2>&1";
+
+          const int status = std::system( command.str().c_str() );
+          vec_cluster_reconstructed[ i ] = ( status == 0 );
+
+          std::lock_guard<std::mutex> lock( log_mutex );
+          std::cout << "Cluster " << i << " (" << vec_cluster_files[ i ] << ") "
+            << ( status == 0 ? "reconstructed" : "failed" ) << std::endl;
+        }
+      } );
+    }
+    for ( auto & thread : threads )
+      thread.join();
+  }
+  std::cout << "Clusters reconstruction took (s): " << timer.elapsed() << std::endl;
+
+  //---------------------------------------
+  // Register & merge the submaps
+  //---------------------------------------
+  timer.reset();
+  std::vector<SfM_Data> submaps;
+  std::vector<size_t> submap_cluster_ids;
+  for ( size_t i = 0; i < vec_cluster_dirs.size(); ++i )
+  {
+    if ( !vec_cluster_reconstructed[ i ] )
+    {
+      std::cerr << "Skip cluster " << i << ": its reconstruction failed" << std::endl;
+      continue;
+    }
+    const std::string sSubmap = stlplus::create_filespec( vec_cluster_dirs[ i ], "sfm_data", "bin" );
+    SfM_Data submap;
+    if ( !stlplus::file_exists( sSubmap ) || !Load( submap, sSubmap, ESfM_Data( ALL ) ) )
+    {
+      std::cerr << "Cannot load the reconstruction of cluster " << i << std::endl;
+      continue;
+    }
+    submaps.emplace_back( std::move( submap ) );
+    submap_cluster_ids.push_back( i );
+  }
+  if ( submaps.empty() )
+  {
+    std::cerr << "\nNo cluster was reconstructed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  SfM_Data sfm_data;
+  const std::vector<IndexT> merged_submaps =
+    MergeSubmaps( submaps, sfm_data, static_cast<IndexT>( std::max( 3, iMinCorrespondences ) ) );
+  {
+    // The submaps are saved with the cluster root path
+    SfM_Data cluster_root;
+    if ( Load( cluster_root, stlplus::create_filespec( sClustersDir, vec_cluster_files[ 0 ] ),
+               ESfM_Data( VIEWS ) ) )
+      sfm_data.s_root_path = cluster_root.s_root_path;
+  }
+
+  std::cout << "Merged " << merged_submaps.size() << " / " << submaps.size() << " submaps" << std::endl;
+  if ( merged_submaps.size() != submaps.size() )
+  {
+    std::vector<bool> merged( submaps.size(), false );
+    for ( const IndexT i : merged_submaps )
+      merged[ i ] = true;
+    std::cout << "Cluster(s) that cannot be registered:";
+    for ( size_t i = 0; i < submaps.size(); ++i )
+      if ( !merged[ i ] )
+        std::cout << " " << submap_cluster_ids[ i ];
+    std::cout << std::endl;
+  }
+  std::cout << "Submaps merging took (s): " << timer.elapsed() << std::endl;
+
+  //---------------------------------------
+  // Final global bundle adjustment
+  //---------------------------------------
+  timer.reset();
+  Bundle_Adjustment_Ceres::BA_Ceres_options options;
+  if ( sfm_data.GetPoses().size() > 100 &&
+      (ceres::IsSparseLinearAlgebraLibraryTypeAvailable(ceres::SUITE_SPARSE) ||
+       ceres::IsSparseLinearAlgebraLibraryTypeAvailable(ceres::CX_SPARSE) ||
+       ceres::IsSparseLinearAlgebraLibraryTypeAvailable(ceres::EIGEN_SPARSE))
+    )
+  // Enable sparse BA only if a sparse lib is available and if there more than 100 poses
+  {
+    options.preconditioner_type_ = ceres::JACOBI;
+    options.linear_solver_type_ = ceres::SPARSE_SCHUR;
+  }
+  else
+  {
+    options.linear_solver_type_ = ceres::DENSE_SCHUR;
+  }
+
+  std::cout << "Bundle adjustment..." << std::endl;
+  Bundle_Adjustment_Ceres bundle_adjustment_obj( options );
+  const Optimize_Options ba_refine_options(
+    Intrinsic_Parameter_Type::ADJUST_ALL,
+    Extrinsic_Parameter_Type::ADJUST_ALL,
+    Structure_Parameter_Type::ADJUST_ALL );
+  if ( !bundle_adjustment_obj.Adjust( sfm_data, ba_refine_options ) )
+  {
+    std::cerr << "Bundle adjustment failed" << std::endl;
+  }
+  else
+  {
+    // Remove the tracks that are not consistent with the merged scene & refine again
+    const IndexT nb_outliers = RemoveOutliers_PixelResidualError( sfm_data, 4.0 );
+    std::cout << "Removed " << nb_outliers << " outlier tracks" << std::endl;
+    if ( nb_outliers > 0 )
+      bundle_adjustment_obj.Adjust( sfm_data, ba_refine_options );
+  }
+  std::cout << "Final bundle adjustment took (s): " << timer.elapsed() << std::endl;
+
+  std::cout
+    << "Found a sfm_data scene with:\n"
+    << " #views: " << sfm_data.GetViews().size() << "\n"
+    << " #poses: " << sfm_data.GetPoses().size() << "\n"
+    << " #intrinsics: " << sfm_data.GetIntrinsics().size() <<  "\n"
+    << " #tracks: " << sfm_data.GetLandmarks().size()
+    << std::endl;
+
+  Generate_SfM_Report( sfm_data,
+    stlplus::create_filespec( sOutDir, "SfMReconstruction_Report.html" ) );
+
+  if ( !Save( sfm_data, stlplus::create_filespec( sOutDir, "sfm_data", ".bin" ), ESfM_Data( ALL ) ) ||
+       !Save( sfm_data, stlplus::create_filespec( sOutDir, "cloud_and_poses", ".ply" ), ESfM_Data( ALL ) ) )
+  {
+    std::cerr << "Cannot save the merged scene" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,6 +16,7 @@
 #include "openMVG/features/regions_factory_io.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
+#include "openMVG/system/bounded_queue.hpp"
 #include "openMVG/system/timer.hpp"
 
 #include "third_party/cmdLine/cmdLine.h"
@@ -26,10 +27,13 @@
 
 #include <cereal/details/helpers.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef OPENMVG_USE_OPENMP
 #include <omp.h>
@@ -57,6 +61,123 @@ features::EDESCRIBER_PRESET stringToEnum(const std::string & sPreset)
   return preset;
 }
 
+/// An image (and its optional feature mask) waiting to be described
+struct DecodedView
+{
+  std::string sView_filename, sFeat, sDesc;
+  Image<unsigned char> image, mask;
+  bool b_use_mask = false;
+  int scale = 1; // Downscaling applied by the image decoder
+};
+
+/// The regions of an image waiting to be exported
+struct DescribedView
+{
+  std::string sView_filename, sFeat, sDesc;
+  std::unique_ptr<Regions> regions;
+};
+
+/// Load the image of a view and look if there is an occlusion feature mask.
+/// JPEG images are decoded at 1/decode_scale resolution (DCT scaling),
+///  the mask is then subsampled to the decoded image size.
+/// An invalid mask sets preemptive_exit to stop the feature extraction.
+bool ReadView
+(
+  const std::string & sRoot_path,
+  const int decode_scale,
+  DecodedView & decoded_view,
+  std::atomic<bool> & preemptive_exit
+)
+{
+  if (!ReadImage(decoded_view.sView_filename.c_str(), &decoded_view.image, decode_scale))
+    return false;
+
+  // Only the JPEG decoder applies the downscaling (size: ceil(size / decode_scale))
+  ImageHeader header;
+  decoded_view.scale =
+    (decode_scale > 1 &&
+     ReadImageHeader(decoded_view.sView_filename.c_str(), &header) &&
+     header.width != decoded_view.image.Width()) ? decode_scale : 1;
+
+  const std::string
+    mask_filename_local =
+      stlplus::create_filespec(sRoot_path,
+        stlplus::basename_part(decoded_view.sView_filename) + "_mask", "png"),
+    mask__filename_global =
+      stlplus::create_filespec(sRoot_path, "mask", "png");
+
+  // Try to read the local mask, else the global one
+  const std::string & mask_filename =
+    stlplus::file_exists(mask_filename_local) ? mask_filename_local : mask__filename_global;
+  if (stlplus::file_exists(mask_filename))
+  {
+    if (!ReadImage(mask_filename.c_str(), &decoded_view.mask))
+    {
+      std::cerr << "Invalid mask: " << mask_filename << std::endl
+                << "Stopping feature extraction." << std::endl;
+      preemptive_exit = true;
+      return false;
+    }
+    // Bring the mask to the decoded image resolution
+    if (decoded_view.scale > 1)
+    {
+      const int scale = decoded_view.scale;
+      Image<unsigned char> mask(
+        (decoded_view.mask.Width() + scale - 1) / scale,
+        (decoded_view.mask.Height() + scale - 1) / scale);
+      for (int y = 0; y < mask.Height(); ++y)
+        for (int x = 0; x < mask.Width(); ++x)
+          mask(y, x) = decoded_view.mask(
+            std::min(y * scale + scale / 2, decoded_view.mask.Height() - 1),
+            std::min(x * scale + scale / 2, decoded_view.mask.Width() - 1));
+      decoded_view.mask = std::move(mask);
+    }
+    // Use the mask only if it fits the current image size
+    decoded_view.b_use_mask =
+      decoded_view.mask.Width() == decoded_view.image.Width() &&
+      decoded_view.mask.Height() == decoded_view.image.Height();
+    if (!decoded_view.b_use_mask)
+      decoded_view.mask = Image<unsigned char>();
+  }
+  return true;
+}
+
+/// Features of the regions types that can be brought back to the full
+///  image resolution (nullptr for the other regions types)
+std::vector<SIOPointFeature> * GetOrientedFeatures
+(
+  Regions * regions
+)
+{
+  if (auto * sift_regions = dynamic_cast<SIFT_Regions *>(regions))
+    return &sift_regions->Features();
+  if (auto * akaze_float_regions = dynamic_cast<AKAZE_Float_Regions *>(regions))
+    return &akaze_float_regions->Features();
+  if (auto * akaze_liop_regions = dynamic_cast<AKAZE_Liop_Regions *>(regions))
+    return &akaze_liop_regions->Features();
+  if (auto * akaze_binary_regions = dynamic_cast<AKAZE_Binary_Regions *>(regions))
+    return &akaze_binary_regions->Features();
+  return nullptr;
+}
+
+/// Express the regions computed on an image decoded at 1/scale resolution
+///  in the full resolution image (a decoded pixel covers scale x scale pixels)
+void UpscaleRegions
+(
+  const int scale,
+  Regions * regions
+)
+{
+  std::vector<SIOPointFeature> * features = GetOrientedFeatures(regions);
+  if (scale == 1 || !features)
+    return;
+  for (SIOPointFeature & feature : *features)
+  {
+    feature.coords() = (feature.coords().array() + 0.5f) * scale - 0.5f;
+    feature.scale() *= scale;
+  }
+}
+
 /// - Compute view image description (feature & descriptor extraction)
 /// - Export computed data
 int main(int argc, char **argv)
@@ -69,9 +190,13 @@ int main(int argc, char **argv)
   std::string sImage_Describer_Method = "SIFT";
   bool bForce = false;
   std::string sFeaturePreset = "";
-#ifdef OPENMVG_USE_OPENMP
   int iNumThreads = 0;
-#endif
+  int iNumReadThreads = 2;
+  int iNumWriteThreads = 1;
+  int iMaxBufferedMemory = 1024;
+  int iMaxFeatures = 0;
+  int iDecodeScale = 1;
+  std::string sFeatureSelection = "GRID";
 
   // required
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
@@ -81,10 +206,13 @@ int main(int argc, char **argv)
   cmd.add( make_option('u', bUpRight, "upright") );
   cmd.add( make_option('f', bForce, "force") );
   cmd.add( make_option('p', sFeaturePreset, "describerPreset") );
-
-#ifdef OPENMVG_USE_OPENMP
   cmd.add( make_option('n', iNumThreads, "numThreads") );
-#endif
+  cmd.add( make_option('r', iNumReadThreads, "numReadThreads") );
+  cmd.add( make_option('w', iNumWriteThreads, "numWriteThreads") );
+  cmd.add( make_option('b', iMaxBufferedMemory, "maxBufferedMemory") );
+  cmd.add( make_option('M', iMaxFeatures, "maxFeatures") );
+  cmd.add( make_option('d', iDecodeScale, "decodeScale") );
+  cmd.add( make_option('s', sFeatureSelection, "featureSelection") );
 
   try {
       if (argc == 1) throw std::string("Invalid command line parameter.");
@@ -107,9 +235,22 @@ int main(int argc, char **argv)
       << "   NORMAL (default),\n"
       << "   HIGH,\n"
       << "   ULTRA: !!Can take long time!!\n"
-#ifdef OPENMVG_USE_OPENMP
-      << "[-n|--numThreads] number of parallel computations\n"
-#endif
+      << "[-n|--numThreads] number of images described in parallel\n"
+      << "  (default: 0, one image at a time; the cores that are not used\n"
+      << "  by the parallel images are used by the computation of each image)\n"
+      << "  Note: each parallel image holds its whole scale space in memory.\n"
+      << "[-r|--numReadThreads] number of parallel image loadings (default: 2)\n"
+      << "[-w|--numWriteThreads] number of parallel regions exports (default: 1)\n"
+      << "[-b|--maxBufferedMemory] memory of the loaded images waiting to be\n"
+      << "  described in MB (default: 1024)\n"
+      << "[-M|--maxFeatures] maximal number of regions per image\n"
+      << "  (default: 0, no limit)\n"
+      << "[-s|--featureSelection]\n"
+      << "  (used to spread the kept regions over the image if maxFeatures is set):\n"
+      << "   GRID (default): strongest regions of the image cells in turn,\n"
+      << "   ANMS: adaptive non maximal suppression\n"
+      << "[-d|--decodeScale] describe the JPEG images decoded at 1/d resolution\n"
+      << "  (1 (default), 2, 4 or 8; the regions are saved at full resolution)\n"
       << std::endl;
 
       std::cerr << s << std::endl;
@@ -124,12 +265,29 @@ int main(int argc, char **argv)
             << "--upright " << bUpRight << std::endl
             << "--describerPreset " << (sFeaturePreset.empty() ? "NORMAL" : sFeaturePreset) << std::endl
             << "--force " << bForce << std::endl
-#ifdef OPENMVG_USE_OPENMP
             << "--numThreads " << iNumThreads << std::endl
-#endif
+            << "--numReadThreads " << iNumReadThreads << std::endl
+            << "--numWriteThreads " << iNumWriteThreads << std::endl
+            << "--maxBufferedMemory " << iMaxBufferedMemory << std::endl
+            << "--maxFeatures " << iMaxFeatures << std::endl
+            << "--decodeScale " << iDecodeScale << std::endl
+            << "--featureSelection " << sFeatureSelection << std::endl
             << std::endl;
 
 
+  EFeatureSelection feature_selection;
+  if (!StringToEnum_EFeatureSelection(sFeatureSelection, feature_selection))
+  {
+    std::cerr << "\nInvalid feature selection: " << sFeatureSelection << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (iDecodeScale != 1 && iDecodeScale != 2 && iDecodeScale != 4 && iDecodeScale != 8)
+  {
+    std::cerr << "\nInvalid decode scale: " << iDecodeScale << std::endl;
+    return EXIT_FAILURE;
+  }
+
   if (sOutDir.empty())  {
     std::cerr << "\nIt is an invalid output directory" << std::endl;
     return EXIT_FAILURE;
@@ -239,102 +397,148 @@ int main(int argc, char **argv)
     }
   }
 
+  // The regions budget is a run setting: it applies to a loaded Image_describer too
+  image_describer->Set_max_features(std::max(0, iMaxFeatures), feature_selection);
+
+  if (iDecodeScale > 1 && !GetOrientedFeatures(image_describer->Allocate().get()))
+  {
+    std::cerr << "\nThe decode scale requires oriented regions (SIFT or AKAZE)." << std::endl;
+    return EXIT_FAILURE;
+  }
+
   // Feature extraction routines
   // For each View of the SfM_Data container:
   // - if regions file exists continue,
   // - if no file, compute features
+  //
+  // The extraction is a pipeline of three stages linked by bounded queues:
+  // - readers: load the images and masks (limited by the decoded memory),
+  // - describers: compute the regions,
+  // - writers: export the regions to files.
+  // It allows to overlap the disk accesses with the computations.
   {
     system::Timer timer;
-    Image<unsigned char> imageGray;
 
     C_Progress_display my_progress_bar(sfm_data.GetViews().size(),
       std::cout, "\n- EXTRACT FEATURES -\n" );
 
+    // The cores are shared between the describers (one view each) and the
+    //  parallel loops of the describers (OpenMP), that use the remaining cores.
+    // Each describer holds the whole scale space of its view, so by default
+    //  (iNumThreads == 0) a single describer is used to bound the peak memory.
+    const unsigned int
+      nb_core = std::max(1u, std::thread::hardware_concurrency()),
+      nb_describe_thread = std::max<unsigned int>(1, std::min<size_t>(
+        std::max(1, iNumThreads), sfm_data.GetViews().size())),
+      nb_describe_omp_thread = std::max(1u, nb_core / nb_describe_thread),
+      nb_read_thread = std::max(1, iNumReadThreads),
+      nb_write_thread = std::max(1, iNumWriteThreads);
+
     // Use a boolean to track if we must stop feature extraction
     std::atomic<bool> preemptive_exit(false);
-#ifdef OPENMVG_USE_OPENMP
-    const unsigned int nb_max_thread = omp_get_max_threads();
 
-    if (iNumThreads > 0) {
-        omp_set_num_threads(iNumThreads);
-    } else {
-        omp_set_num_threads(nb_max_thread);
-    }
+    // Read -> Describe queue, bounded by the decoded images memory footprint
+    system::BoundedQueue<DecodedView> decoded_views(
+      static_cast<size_t>(std::max(1, iMaxBufferedMemory)) << 20, nb_read_thread);
+    // Describe -> Write queue, bounded by a number of regions
+    system::BoundedQueue<DescribedView> described_views(
+      2 * nb_describe_thread, nb_describe_thread);
 
-    #pragma omp parallel for schedule(dynamic) if (iNumThreads > 0) private(imageGray)
-#endif
-    for (int i = 0; i < static_cast<int>(sfm_data.views.size()); ++i)
+    std::vector<std::thread> threads;
+
+    std::atomic<int> next_view(0);
+    for (unsigned int i = 0; i < nb_read_thread; ++i)
     {
-      Views::const_iterator iterViews = sfm_data.views.begin();
-      std::advance(iterViews, i);
-      const View * view = iterViews->second.get();
-      const std::string
-        sView_filename = stlplus::create_filespec(sfm_data.s_root_path, view->s_Img_path),
-        sFeat = stlplus::create_filespec(sOutDir, stlplus::basename_part(sView_filename), "feat"),
-        sDesc = stlplus::create_filespec(sOutDir, stlplus::basename_part(sView_filename), "desc");
-
-      // If features or descriptors file are missing, compute them
-      if (!preemptive_exit && (bForce || !stlplus::file_exists(sFeat) || !stlplus::file_exists(sDesc)))
+      threads.emplace_back([&]
       {
-        if (!ReadImage(sView_filename.c_str(), &imageGray))
-          continue;
-
-        //
-        // Look if there is occlusion feature mask
-        //
-        Image<unsigned char> * mask = nullptr; // The mask is null by default
-
-        const std::string
-          mask_filename_local =
-            stlplus::create_filespec(sfm_data.s_root_path,
-              stlplus::basename_part(sView_filename) + "_mask", "png"),
-          mask__filename_global =
-            stlplus::create_filespec(sfm_data.s_root_path, "mask", "png");
-
-        Image<unsigned char> imageMask;
-        // Try to read the local mask
-        if (stlplus::file_exists(mask_filename_local))
+        for (int view_index = next_view++;
+             view_index < static_cast<int>(sfm_data.views.size()) && !preemptive_exit;
+             view_index = next_view++)
         {
-          if (!ReadImage(mask_filename_local.c_str(), &imageMask))
+          Views::const_iterator iterViews = sfm_data.views.begin();
+          std::advance(iterViews, view_index);
+          const View * view = iterViews->second.get();
+
+          DecodedView decoded_view;
+          decoded_view.sView_filename = stlplus::create_filespec(sfm_data.s_root_path, view->s_Img_path);
+          decoded_view.sFeat = stlplus::create_filespec(sOutDir, stlplus::basename_part(decoded_view.sView_filename), "feat");
+          decoded_view.sDesc = stlplus::create_filespec(sOutDir, stlplus::basename_part(decoded_view.sView_filename), "desc");
+
+          // If features or descriptors file are missing, compute them
+          if (!bForce && stlplus::file_exists(decoded_view.sFeat) && stlplus::file_exists(decoded_view.sDesc))
           {
-            std::cerr << "Invalid mask: " << mask_filename_local << std::endl
-                      << "Stopping feature extraction." << std::endl;
-            preemptive_exit = true;
+            ++my_progress_bar;
             continue;
           }
-          // Use the local mask only if it fits the current image size
-          if (imageMask.Width() == imageGray.Width() && imageMask.Height() == imageGray.Height())
-            mask = &imageMask;
+          if (!ReadView(sfm_data.s_root_path, iDecodeScale, decoded_view, preemptive_exit))
+            continue;
+
+          const size_t cost =
+            decoded_view.image.Width() * decoded_view.image.Height() +
+            decoded_view.mask.Width() * decoded_view.mask.Height();
+          if (!decoded_views.Push(std::move(decoded_view), cost))
+            break;
         }
-        else
+        decoded_views.ProducerDone();
+      });
+    }
+
+    for (unsigned int i = 0; i < nb_describe_thread; ++i)
+    {
+      threads.emplace_back([&]
+      {
+#ifdef OPENMVG_USE_OPENMP
+        omp_set_num_threads(nb_describe_omp_thread);
+#endif
+        DecodedView decoded_view;
+        while (decoded_views.Pop(decoded_view))
         {
-          // Try to read the global mask
-          if (stlplus::file_exists(mask__filename_global))
-          {
-            if (!ReadImage(mask__filename_global.c_str(), &imageMask))
-            {
-              std::cerr << "Invalid mask: " << mask__filename_global << std::endl
-                        << "Stopping feature extraction." << std::endl;
-              preemptive_exit = true;
-              continue;
-            }
-            // Use the global mask only if it fits the current image size
-            if (imageMask.Width() == imageGray.Width() && imageMask.Height() == imageGray.Height())
-              mask = &imageMask;
-          }
+          if (preemptive_exit)
+            continue;
+          // Compute features and descriptors
+          DescribedView described_view;
+          described_view.sView_filename = std::move(decoded_view.sView_filename);
+          described_view.sFeat = std::move(decoded_view.sFeat);
+          described_view.sDesc = std::move(decoded_view.sDesc);
+          described_view.regions = image_describer->Describe(
+            decoded_view.image, decoded_view.b_use_mask ? &decoded_view.mask : nullptr);
+          if (described_view.regions)
+            UpscaleRegions(decoded_view.scale, described_view.regions.get());
+          // Release the image memory before waiting for the writers
+          decoded_view = DecodedView();
+          if (!described_views.Push(std::move(described_view)))
+            break;
         }
+        described_views.ProducerDone();
+      });
+    }
 
-        // Compute features and descriptors and export them to files
-        auto regions = image_describer->Describe(imageGray, mask);
-        if (regions && !image_describer->Save(regions.get(), sFeat, sDesc)) {
-          std::cerr << "Cannot save regions for images: " << sView_filename << std::endl
-                    << "Stopping feature extraction." << std::endl;
-          preemptive_exit = true;
-          continue;
+    for (unsigned int i = 0; i < nb_write_thread; ++i)
+    {
+      threads.emplace_back([&]
+      {
+        DescribedView described_view;
+        while (described_views.Pop(described_view))
+        {
+          if (preemptive_exit)
+            continue;
+          // Export the regions to files
+          if (described_view.regions &&
+              !image_describer->Save(described_view.regions.get(), described_view.sFeat, described_view.sDesc))
+          {
+            std::cerr << "Cannot save regions for images: " << described_view.sView_filename << std::endl
+                      << "Stopping feature extraction." << std::endl;
+            preemptive_exit = true;
+            continue;
+          }
+          ++my_progress_bar;
         }
-      }
-      ++my_progress_bar;
+      });
     }
+
+    for (auto & thread : threads)
+      thread.join();
+
     std::cout << "Task done in (s): " << timer.elapsed() << std::endl;
   }
   return EXIT_SUCCESS;
@@ -11,8 +11,11 @@
 #include "openMVG/features/akaze/image_describer_akaze.hpp"
 #include "openMVG/features/descriptor.hpp"
 #include "openMVG/features/feature.hpp"
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/image/image_io.hpp"
 #include "openMVG/matching/indMatch.hpp"
 #include "openMVG/matching/indMatch_utils.hpp"
+#include "openMVG/matching/kvld/kvld.h"
 #include "openMVG/matching_image_collection/Matcher_Regions.hpp"
 #include "openMVG/matching_image_collection/Cascade_Hashing_Matcher_Regions.hpp"
 #include "openMVG/matching_image_collection/GeometricFilter.hpp"
@@ -30,6 +33,7 @@
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/stl/stl.hpp"
 #include "openMVG/system/timer.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
@@ -63,6 +67,94 @@ enum EPairMode
   PAIR_FROM_FILE  = 2
 };
 
+/// Get the features of oriented regions (SIFT & AKAZE regions)
+/// Return false if the regions do not store the scale and orientation of their features
+bool GetOrientedFeatures
+(
+  const features::Regions * regions,
+  std::vector<features::SIOPointFeature> & feats
+)
+{
+  using namespace openMVG::features;
+  if (const auto * sift_regions = dynamic_cast<const SIFT_Regions *>(regions))
+    feats = sift_regions->Features();
+  else if (const auto * akaze_float_regions = dynamic_cast<const AKAZE_Float_Regions *>(regions))
+    feats = akaze_float_regions->Features();
+  else if (const auto * akaze_liop_regions = dynamic_cast<const AKAZE_Liop_Regions *>(regions))
+    feats = akaze_liop_regions->Features();
+  else if (const auto * akaze_binary_regions = dynamic_cast<const AKAZE_Binary_Regions *>(regions))
+    feats = akaze_binary_regions->Features();
+  else
+    return false;
+  return true;
+}
+
+/// Keep the matches that are consistent with their neighbor matches (KVLD filter)
+bool KVLD_Filtering
+(
+  const SfM_Data & sfm_data,
+  const Regions_Provider & regions_provider,
+  PairWiseMatches & map_Matches
+)
+{
+  // The regions type must store the scale and orientation of the features
+  std::vector<features::SIOPointFeature> type_feats;
+  if (!GetOrientedFeatures(regions_provider.getRegionsType(), type_feats))
+  {
+    std::cerr << "The KVLD filter requires oriented regions (SIFT or AKAZE)." << std::endl;
+    return false;
+  }
+
+  std::map<Pair, std::vector<Pair>> putative_matches;
+  for (const auto & pairwisematches_it : map_Matches)
+  {
+    std::vector<Pair> & matches = putative_matches[pairwisematches_it.first];
+    matches.reserve(pairwisematches_it.second.size());
+    for (const IndMatch & match : pairwisematches_it.second)
+      matches.emplace_back(match.i_, match.j_);
+  }
+
+  // The features are loaded by the filter when they are needed
+  //  (through the regions provider: they are loaded from disk if a cache is used)
+  const auto features_provider = [&](IndexT view_id, std::vector<features::SIOPointFeature> & view_feats)
+  {
+    const std::shared_ptr<features::Regions> regions = regions_provider.get(view_id);
+    if (!regions || !GetOrientedFeatures(regions.get(), view_feats))
+    {
+      std::cerr << "Cannot get the regions of the view: " << view_id << std::endl;
+      return false;
+    }
+    return true;
+  };
+
+  // The images are loaded by the filter when they are needed
+  const auto image_provider = [&](IndexT view_id, image::Image<float> & image)
+  {
+    const std::string sView_filename = stlplus::create_filespec(sfm_data.s_root_path,
+      sfm_data.GetViews().at(view_id)->s_Img_path);
+    image::Image<unsigned char> gray_image;
+    if (!image::ReadImage(sView_filename.c_str(), &gray_image))
+    {
+      std::cerr << "Cannot read the image: " << sView_filename << std::endl;
+      return false;
+    }
+    image = gray_image.GetMat().cast<float>();
+    return true;
+  };
+
+  const std::map<Pair, std::vector<Pair>> kvld_matches =
+    KVLDFilter(image_provider, features_provider, putative_matches);
+
+  map_Matches.clear();
+  for (const auto & kvld_matches_it : kvld_matches)
+  {
+    IndMatches & matches = map_Matches[kvld_matches_it.first];
+    for (const Pair & match : kvld_matches_it.second)
+      matches.emplace_back(match.first, match.second);
+  }
+  return true;
+}
+
 /// Compute corresponding features between a series of views:
 /// - Load view images description (regions: features & descriptors)
 /// - Compute putative local feature matches (descriptors matching)
@@ -83,6 +175,8 @@ int main(int argc, char **argv)
   bool bGuided_matching = false;
   int imax_iteration = 2048;
   unsigned int ui_max_cache_size = 0;
+  bool bKVLD_filter = false;
+  std::string sTraceFile;
 
   //required
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
@@ -97,6 +191,8 @@ int main(int argc, char **argv)
   cmd.add( make_option('m', bGuided_matching, "guided_matching") );
   cmd.add( make_option('I', imax_iteration, "max_iteration") );
   cmd.add( make_option('c', ui_max_cache_size, "cache_size") );
+  cmd.add( make_option('k', bKVLD_filter, "kvld_filter") );
+  cmd.add( make_option('x', sTraceFile, "trace_file") );
 
 
   try {
@@ -140,7 +236,13 @@ int main(int argc, char **argv)
       << "  use the found model to improve the pairwise correspondences.\n"
       << "[-c|--cache_size]\n"
       << "  Use a regions cache (only cache_size regions will be stored in memory)\n"
-      << "  If not used, all regions will be load in memory."
+      << "  If not used, all regions will be load in memory.\n"
+      << "[-k|--kvld_filter]\n"
+      << "  keep only the geometric matches that are KVLD consistent\n"
+      << "  (photometric & geometric consistency with the neighbor matches).\n"
+      << "  It requires the images and oriented regions (SIFT or AKAZE).\n"
+      << "[-x|--trace_file]\n"
+      << "  export a Chrome trace (JSON) of the processing stages."
       << std::endl;
 
       std::cerr << s << std::endl;
@@ -159,6 +261,7 @@ int main(int argc, char **argv)
             << "--pair_list " << sPredefinedPairList << "\n"
             << "--nearest_matching_method " << sNearestMatchingMethod << "\n"
             << "--guided_matching " << bGuided_matching << "\n"
+            << "--kvld_filter " << bKVLD_filter << "\n"
             << "--cache_size " << ((ui_max_cache_size == 0) ? "unlimited" : std::to_string(ui_max_cache_size)) << std::endl;
 
   EPairMode ePairmode = (iMatchingVideoMode == -1 ) ? PAIR_EXHAUSTIVE : PAIR_CONTIGUOUS;
@@ -216,6 +319,8 @@ int main(int argc, char **argv)
   // + Export some statistics
   // -----------------------------
 
+  const openMVG::system::ScopedTraceSession trace_session(sTraceFile);
+
   //---------------------------------------
   // Read SfM Scene (image view & intrinsics data)
   //---------------------------------------
@@ -503,6 +608,16 @@ int main(int argc, char **argv)
       break;
     }
 
+    //---------------------------------------
+    //-- KVLD filtering of the geometric matches
+    //---------------------------------------
+    if (bKVLD_filter)
+    {
+      std::cout << "\n - KVLD filtering -" << std::endl;
+      if (!KVLD_Filtering(sfm_data, *regions_provider, map_GeometricMatches))
+        return EXIT_FAILURE;
+    }
+
     //---------------------------------------
     //-- Export geometric filtered matches
     //---------------------------------------
@@ -39,8 +39,15 @@ int main(int argc, char **argv)
     sSfM_Data_Filename_In,
     sOutputPLY_Out;
 
+  Colorization_Options colorization_options;
+  int iJpegDownscale = colorization_options.jpeg_downscale;
+  int iNumThreads = 0;
+
   cmd.add(make_option('i', sSfM_Data_Filename_In, "input_file"));
   cmd.add(make_option('o', sOutputPLY_Out, "output_file"));
+  cmd.add(make_switch('a', "average_observations"));
+  cmd.add(make_option('d', iJpegDownscale, "jpeg_downscale"));
+  cmd.add(make_option('n', iNumThreads, "numThreads"));
 
   try {
       if (argc == 1) throw std::string("Invalid command line parameter.");
@@ -49,12 +56,20 @@ int main(int argc, char **argv)
       std::cerr << "Usage: " << argv[0] << '\n'
         << "[-i|--input_file] path to the input SfM_Data scene\n"
         << "[-o|--output_file] path to the output PLY file\n"
+        << "\n[Optional]\n"
+        << "[-a|--average_observations] color a track with the mean color of all its observations\n"
+        << "[-d|--jpeg_downscale] JPEG decoding reduction factor (1, 2, 4 or 8), default: 1\n"
+        << "[-n|--numThreads] number of images decoded in parallel (0 = all available threads)\n"
         << std::endl;
 
       std::cerr << s << std::endl;
       return EXIT_FAILURE;
   }
 
+  colorization_options.average_observations = cmd.used('a');
+  colorization_options.jpeg_downscale = iJpegDownscale;
+  colorization_options.max_images_in_flight = std::max(0, iNumThreads);
+
   if (sOutputPLY_Out.empty())
   {
     std::cerr << std::endl
@@ -73,7 +88,7 @@ int main(int argc, char **argv)
 
   // Compute the scene structure color
   std::vector<Vec3> vec_3dPoints, vec_tracksColor, vec_camPosition;
-  if (ColorizeTracks(sfm_data, vec_3dPoints, vec_tracksColor))
+  if (ColorizeTracks(sfm_data, vec_3dPoints, vec_tracksColor, colorization_options))
   {
     GetCameraPositions(sfm_data, vec_camPosition);
 
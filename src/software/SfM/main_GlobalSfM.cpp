@@ -17,10 +17,12 @@
 #include "openMVG/sfm/sfm_data_io.hpp"
 #include "openMVG/sfm/sfm_report.hpp"
 #include "openMVG/system/timer.hpp"
+#include "openMVG/system/trace.hpp"
 
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -53,6 +55,8 @@ int main(int argc, char **argv)
   int iTranslationAveragingMethod = int (TRANSLATION_AVERAGING_SOFTL1);
   std::string sIntrinsic_refinement_options = "ADJUST_ALL";
   bool b_use_motion_priors = false;
+  int acransac_parallel_min_samples = 0;
+  std::string sTraceFile;
 
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
   cmd.add( make_option('m', sMatchesDir, "matchdir") );
@@ -62,6 +66,9 @@ int main(int argc, char **argv)
   cmd.add( make_option('t', iTranslationAveragingMethod, "translationAveraging") );
   cmd.add( make_option('f', sIntrinsic_refinement_options, "refineIntrinsics") );
   cmd.add( make_switch('P', "prior_usage") );
+  cmd.add( make_switch('b', "acransac_bail_out") );
+  cmd.add( make_option('E', acransac_parallel_min_samples, "acransac_parallel_min_samples") );
+  cmd.add( make_option('x', sTraceFile, "trace_file") );
 
   try {
     if (argc == 1) throw std::string("Invalid parameter.");
@@ -79,6 +86,7 @@ int main(int argc, char **argv)
       << "\t 1 -> L1 minimization\n"
       << "\t 2 -> L2 minimization of sum of squared Chordal distances\n"
       << "\t 3 -> SoftL1 minimization (default)\n"
+      << "\t 4 -> L1 minimization with a sparse ADMM solver (scalable alternative to 1)\n"
     << "[-f|--refineIntrinsics] Intrinsic parameters refinement option\n"
       << "\t ADJUST_ALL -> refine all existing parameters (default) \n"
       << "\t NONE -> intrinsic parameters are held as constant\n"
@@ -93,7 +101,12 @@ int main(int argc, char **argv)
       << "\t ADJUST_PRINCIPAL_POINT|ADJUST_DISTORTION\n"
       <<      "\t\t-> refine the principal point position & the distortion coefficient(s) (if any)\n"
     << "[-P|--prior_usage] Enable usage of motion priors (i.e GPS positions)\n"
+    << "[-b|--acransac_bail_out] Enable the preemptive verification of the relative pose hypotheses\n"
+      << "\t (faster robust estimation, the search is no longer exhaustive)\n"
+    << "[-E|--acransac_parallel_min_samples] Evaluate the relative pose hypotheses with several threads\n"
+      << "\t if there are at least this number of correspondences (default=0: disabled)\n"
     << "[-M|--match_file] path to the match file to use.\n"
+    << "[-x|--trace_file] export a Chrome trace (JSON) of the processing stages\n"
     << std::endl;
 
     std::cerr << s << std::endl;
@@ -115,11 +128,13 @@ int main(int argc, char **argv)
   }
 
   if (iTranslationAveragingMethod < TRANSLATION_AVERAGING_L1 ||
-      iTranslationAveragingMethod > TRANSLATION_AVERAGING_SOFTL1 )  {
+      iTranslationAveragingMethod > TRANSLATION_AVERAGING_L1_ADMM )  {
     std::cerr << "\n Translation averaging method is invalid" << std::endl;
     return EXIT_FAILURE;
   }
 
+  const openMVG::system::ScopedTraceSession trace_session(sTraceFile);
+
   // Load input SfM_Data scene
   SfM_Data sfm_data;
   if (!Load(sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS|INTRINSICS))) {
@@ -191,6 +206,12 @@ int main(int argc, char **argv)
   sfmEngine.Set_Intrinsics_Refinement_Type(intrinsic_refinement_options);
   b_use_motion_priors = cmd.used('P');
   sfmEngine.Set_Use_Motion_Prior(b_use_motion_priors);
+  {
+    robust::ACRansacEvaluationOptions evaluation_options;
+    evaluation_options.bail_out = cmd.used('b');
+    evaluation_options.parallel_min_samples = std::max(0, acransac_parallel_min_samples);
+    sfmEngine.SetRelativePoseEvaluationOptions(evaluation_options);
+  }
 
   // Configure motion averaging method
   sfmEngine.SetRotationAveragingMethod(
@@ -18,11 +18,13 @@
 #include "openMVG/sfm/sfm_report.hpp"
 #include "openMVG/sfm/sfm_view.hpp"
 #include "openMVG/system/timer.hpp"
+#include "openMVG/system/trace.hpp"
 #include "openMVG/types.hpp"
 
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -71,12 +73,15 @@ int main(int argc, char **argv)
   std::string sSfM_Data_Filename;
   std::string sMatchesDir, sMatchFilename;
   std::string sOutDir = "";
+  std::string sTraceFile;
   std::string sIntrinsic_refinement_options = "ADJUST_ALL";
   std::string sSfMInitializer_method = "STELLAR";
   int i_User_camera_model = PINHOLE_CAMERA_RADIAL3;
   bool b_use_motion_priors = false;
   int triangulation_method = static_cast<int>(ETriangulationMethod::DEFAULT);
   int resection_method  = static_cast<int>(resection::SolverType::DEFAULT);
+  int acransac_parallel_min_samples = 0;
+  int full_triangulation_period = 0;
 
   cmd.add( make_option('i', sSfM_Data_Filename, "input_file") );
   cmd.add( make_option('m', sMatchesDir, "matchdir") );
@@ -88,6 +93,10 @@ int main(int argc, char **argv)
   cmd.add( make_switch('P', "prior_usage") );
   cmd.add( make_option('t', triangulation_method, "triangulation_method"));
   cmd.add( make_option('r', resection_method, "resection_method"));
+  cmd.add( make_switch('B', "acransac_bail_out") );
+  cmd.add( make_option('E', acransac_parallel_min_samples, "acransac_parallel_min_samples") );
+  cmd.add( make_option('T', full_triangulation_period, "full_triangulation_period"));
+  cmd.add( make_option('x', sTraceFile, "trace_file"));
 
   try {
     if (argc == 1) throw std::string("Invalid parameter.");
@@ -135,6 +144,13 @@ int main(int argc, char **argv)
     << "\t" << static_cast<int>(resection::SolverType::P3P_KNEIP_CVPR11) << ": P3P_KNEIP_CVPR11\n"
     << "\t" << static_cast<int>(resection::SolverType::P3P_NORDBERG_ECCV18) << ": P3P_NORDBERG_ECCV18\n"
     << "\t" << static_cast<int>(resection::SolverType::UP2P_KUKELOVA_ACCV10)  << ": UP2P_KUKELOVA_ACCV10 | 2Points | upright camera\n"
+    << "[-B|--acransac_bail_out] Enable the preemptive verification of the resection hypotheses\n"
+      << "\t (faster robust estimation, the search is no longer exhaustive)\n"
+    << "[-E|--acransac_parallel_min_samples] Evaluate the resection hypotheses with several threads\n"
+      << "\t if there are at least this number of correspondences (default=0: disabled)\n"
+    << "[-T|--full_triangulation_period] re-triangulate all the tracks every n resection rounds\n"
+    << "\t (default=0: only the tracks seen by the newly posed views are triangulated)\n"
+    << "[-x|--trace_file] export a Chrome trace (JSON) of the processing stages\n"
     << std::endl;
 
     std::cerr << s << std::endl;
@@ -166,6 +182,8 @@ int main(int argc, char **argv)
     return EXIT_FAILURE;
   }
 
+  const openMVG::system::ScopedTraceSession trace_session(sTraceFile);
+
   // Load input SfM_Data scene
   SfM_Data sfm_data;
   if (!Load(sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS|INTRINSICS|EXTRINSICS))) {
@@ -273,6 +291,13 @@ int main(int argc, char **argv)
   sfmEngine.Set_Use_Motion_Prior(b_use_motion_priors);
   sfmEngine.SetTriangulationMethod(static_cast<ETriangulationMethod>(triangulation_method));
   sfmEngine.SetResectionMethod(static_cast<resection::SolverType>(resection_method));
+  sfmEngine.SetFullTriangulationPeriod(std::max(0, full_triangulation_period));
+  {
+    robust::ACRansacEvaluationOptions evaluation_options;
+    evaluation_options.bail_out = cmd.used('B');
+    evaluation_options.parallel_min_samples = std::max(0, acransac_parallel_min_samples);
+    sfmEngine.SetResectionEvaluationOptions(evaluation_options);
+  }
 
   if (sfmEngine.Process())
   {
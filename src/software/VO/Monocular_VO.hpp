@@ -9,15 +9,26 @@
 #ifndef MONOCULAR_VO_HPP
 #define MONOCULAR_VO_HPP
 
+#include <algorithm>
 #include <deque>
-#include <iostream>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <set>
 
+#include "openMVG/cameras/Camera_Intrinsics.hpp"
 #include "openMVG/features/feature.hpp"
+#include "openMVG/geometry/pose3.hpp"
+#include "openMVG/geometry/Similarity3.hpp"
 #include "openMVG/image/image_container.hpp"
+#include "openMVG/multiview/triangulation.hpp"
 #include "openMVG/numeric/eigen_alias_definition.hpp"
 
+#include "openMVG/sfm/pipelines/localization/SfM_Localizer.hpp"
+#include "openMVG/sfm/pipelines/sfm_robust_model_estimation.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_BA_ceres.hpp"
+#include "openMVG/sfm/sfm_data_transform.hpp"
 #include "openMVG/sfm/sfm_landmark.hpp"
 
 #include "software/VO/Abstract_Tracker.hpp"
@@ -43,9 +54,22 @@ struct Measurement
 /// A 3D point with it's associated image observations
 struct Landmark
 {
-  Landmark():pt_(-1,-1,-1) {}
+  Landmark():pt_(-1,-1,-1), triangulated_(false) {}
+
+  /// Return the observation of the landmark in the frameId frame (nullptr if none)
+  const Measurement * observation(const uint32_t frameId) const
+  {
+    // observations are sorted by frameId
+    for (auto it = obs_.crbegin(); it != obs_.crend() && it->frameId_ >= frameId; ++it)
+    {
+      if (it->frameId_ == frameId)
+        return &(*it);
+    }
+    return nullptr;
+  }
 
   Vec3 pt_;
+  bool triangulated_; // Tell if pt_ is a valid 3D position
   std::deque<Measurement> obs_;
 };
 
@@ -60,6 +84,7 @@ inline bool ConvertVOLandmarkToSfMDataLandmark
   {
     // Create a sfm_landmark
     sfm::Landmark landmark;
+    landmark.X = vo_landmark.at(idx).pt_;
     sfm::Observations & obs = landmark.obs;
 
     for (const auto & track_it : vo_landmark.at(idx).obs_)
@@ -72,6 +97,16 @@ inline bool ConvertVOLandmarkToSfMDataLandmark
 }
 
 /// Monocular test interface
+/// - if a camera model is provided, the camera motion is estimated:
+///  - initialization by robust essential matrix estimation between the first
+///     keyframe and the first frame with enough parallax,
+///  - the frames are then localized by robust P3P resection on the
+///     triangulated landmarks,
+///  - new keyframes are inserted when the parallax w.r.t. the last keyframe
+///     is large enough or when too many of its tracks are lost,
+///  - each new keyframe triangulates the new landmarks and triggers a
+///     bundle adjustment over a sliding window of the last keyframes,
+///     anchored by the fixed poses of the previous keyframes.
 struct VO_Monocular
 {
   // Structure and visibility
@@ -87,14 +122,32 @@ struct VO_Monocular
   std::vector<features::PointFeature> pt_to_track_, pt_tracked_;
   std::vector<bool> tracking_status_;
 
+  // Camera model & motion (if no camera model is provided only tracking is performed)
+  std::shared_ptr<cameras::IntrinsicBase> intrinsic_;
+  std::map<uint32_t, geometry::Pose3> poses_; // Estimated pose per frameId
+  std::vector<uint32_t> keyframeIds_;
+  bool initialized_;
+
+  // Keyframe & motion estimation parameters
+  float keyframe_parallax_;       // Median parallax (pixels) that triggers a keyframe
+  float keyframe_track_ratio_;    // Ratio of the last keyframe landmarks still tracked, under which a keyframe is inserted
+  uint32_t min_pose_landmarks_;   // Min count of 2D-3D (or 2D-2D) correspondences for a pose estimation
+  uint32_t ba_window_size_;       // Number of keyframes in the sliding window bundle adjustment
+
   VO_Monocular
   (
     Abstract_Tracker * tracker,
-    const uint32_t maxTrackedFeatures = 1500
-    // Add an abstract camera model here
+    const uint32_t maxTrackedFeatures = 1500,
+    const std::shared_ptr<cameras::IntrinsicBase> & intrinsic = nullptr
   )
   : tracker_(tracker),
-  maxTrackedFeatures_(maxTrackedFeatures)
+  maxTrackedFeatures_(maxTrackedFeatures),
+  intrinsic_(intrinsic),
+  initialized_(false),
+  keyframe_parallax_(20.f),
+  keyframe_track_ratio_(.7f),
+  min_pose_landmarks_(30),
+  ba_window_size_(5)
   {
   }
 
@@ -104,8 +157,16 @@ struct VO_Monocular
     const size_t frameId
   )
   {
-    const bool bTrackerStatus = tracker_->track(ima, pt_to_track_, pt_tracked_, tracking_status_);
-    std::cout << (int) bTrackerStatus  << " : tracker status" << std::endl;
+    // The untracked slots (waiting for new points) must stay untracked
+    const std::vector<bool> active_slots = tracking_status_;
+    bool bTrackerStatus = tracker_->track(ima, pt_to_track_, pt_tracked_, tracking_status_);
+    for (size_t i = 0; i < std::min(active_slots.size(), tracking_status_.size()); ++i)
+    {
+      if (!active_slots[i])
+        tracking_status_[i] = false;
+    }
+    bTrackerStatus = bTrackerStatus &&
+      std::find(tracking_status_.cbegin(), tracking_status_.cend(), true) != tracking_status_.cend();
     landmarkListPerFrame_.emplace_back(std::set<uint32_t>());
     if (landmarkListPerFrame_.size()==1 || bTrackerStatus)
     {
@@ -150,19 +211,11 @@ struct VO_Monocular
 
       // Count the number of tracked features
       const size_t countTracked = std::accumulate(tracking_status_.cbegin(), tracking_status_.cend(), 0);
-      std::cout << "#tracked: " << countTracked << std::endl;
 
       // try compute pose and decide if it's a Keyframe
-      if (frameId > 0 && landmarkListPerFrame_.size() > 1)
+      if (intrinsic_)
       {
-        size_t lastKf = frameId-1;
-        std::vector<uint32_t> ids;
-        ids.reserve(std::min(landmarkListPerFrame_[lastKf].size(), landmarkListPerFrame_[frameId].size()));
-        std::set_intersection(
-          landmarkListPerFrame_[lastKf].cbegin(), landmarkListPerFrame_[lastKf].cend(),
-          landmarkListPerFrame_[frameId].cbegin(), landmarkListPerFrame_[frameId].cend(),
-          std::back_inserter(ids));
-        std::cout << "Track in common with the last Keyframe: " << ids.size() << std::endl;
+        computePoseAndKeyframe(frameId);
       }
 
       // Update tracking point set (if necessary)
@@ -183,9 +236,10 @@ struct VO_Monocular
         new_pt.reserve(maxTrackedFeatures_);
         if (tracker_->detect(ima, new_pt, count))
         {
-          std::cout << "#features added: " << new_pt.size() << std::endl;
+          // Fill the untracked slots with the new points
+          //  (the remaining slots stay untracked if there is not enough points)
           size_t j = 0;
-          for (size_t i = 0; i < tracking_status_.size(); ++i)
+          for (size_t i = 0; i < tracking_status_.size() && j < new_pt.size(); ++i)
           {
             if (!tracking_status_[i])
             {
@@ -199,10 +253,10 @@ struct VO_Monocular
               landmarkListPerFrame_.back().insert(landmark_.size() - 1);
 
               pt_to_track_[i] = new_pt[j];
+              tracking_status_[i] = true;
               ++j;
             }
           }
-          std::cout << "_landmark.size() " << landmark_.size() << std::endl;
         }
       }
     }
@@ -212,6 +266,308 @@ struct VO_Monocular
     }
     return bTrackerStatus;
   }
+
+private:
+
+  /// Bearing vector of an image observation
+  Vec3 bearing(const Vec2f & x) const
+  {
+    return (*intrinsic_)(intrinsic_->get_ud_pixel(x.cast<double>())).col(0);
+  }
+
+  /// Landmarks observed in both frames (sorted ids)
+  std::vector<uint32_t> commonLandmarks(const uint32_t frameA, const uint32_t frameB) const
+  {
+    std::vector<uint32_t> ids;
+    ids.reserve(std::min(landmarkListPerFrame_[frameA].size(), landmarkListPerFrame_[frameB].size()));
+    std::set_intersection(
+      landmarkListPerFrame_[frameA].cbegin(), landmarkListPerFrame_[frameA].cend(),
+      landmarkListPerFrame_[frameB].cbegin(), landmarkListPerFrame_[frameB].cend(),
+      std::back_inserter(ids));
+    return ids;
+  }
+
+  /// Median image motion (pixels) of the given landmarks between two frames
+  float medianParallax
+  (
+    const std::vector<uint32_t> & ids,
+    const uint32_t frameA,
+    const uint32_t frameB
+  ) const
+  {
+    if (ids.empty())
+      return 0.f;
+    std::vector<float> parallax;
+    parallax.reserve(ids.size());
+    for (const uint32_t id : ids)
+    {
+      const Measurement * a = landmark_[id].observation(frameA);
+      const Measurement * b = landmark_[id].observation(frameB);
+      if (a && b)
+        parallax.push_back((a->pos_ - b->pos_).norm());
+    }
+    if (parallax.empty())
+      return 0.f;
+    std::nth_element(parallax.begin(), parallax.begin() + parallax.size() / 2, parallax.end());
+    return parallax[parallax.size() / 2];
+  }
+
+  /// Restart the motion estimation from the frameId frame
+  void resetMotion(const uint32_t frameId)
+  {
+    // The landmarks still tracked will be triangulated again in the new reference frame
+    for (const uint32_t id : landmarkListPerFrame_[frameId])
+      landmark_[id].triangulated_ = false;
+    initialized_ = false;
+    keyframeIds_ = {frameId};
+    poses_[frameId] = geometry::Pose3();
+  }
+
+  /// Triangulate the not yet triangulated landmarks observed by two posed frames
+  size_t triangulate
+  (
+    const std::vector<uint32_t> & ids,
+    const uint32_t frameA,
+    const uint32_t frameB
+  )
+  {
+    const geometry::Pose3 & poseA = poses_.at(frameA), & poseB = poses_.at(frameB);
+    size_t triangulated_count = 0;
+    for (const uint32_t id : ids)
+    {
+      Landmark & landmark = landmark_[id];
+      const Measurement * a = landmark.observation(frameA);
+      const Measurement * b = landmark.observation(frameB);
+      if (landmark.triangulated_ || !a || !b)
+        continue;
+      const Vec2 xA = a->pos_.cast<double>(), xB = b->pos_.cast<double>();
+      // Reject low parallax rays since their depth is ill conditioned
+      if (cameras::AngleBetweenRay(poseA, intrinsic_.get(), poseB, intrinsic_.get(), xA, xB) < 2.0)
+        continue;
+      Vec3 X;
+      if (TriangulateDLT(poseA.rotation(), poseA.translation(), bearing(a->pos_),
+                         poseB.rotation(), poseB.translation(), bearing(b->pos_), &X)
+          && intrinsic_->residual(poseA(X), xA).norm() < 4.0
+          && intrinsic_->residual(poseB(X), xB).norm() < 4.0)
+      {
+        landmark.pt_ = X;
+        landmark.triangulated_ = true;
+        ++triangulated_count;
+      }
+    }
+    return triangulated_count;
+  }
+
+  /// Initialize the motion from two frames (robust essential matrix)
+  bool initialize
+  (
+    const std::vector<uint32_t> & ids,
+    const uint32_t frameA,
+    const uint32_t frameB
+  )
+  {
+    Mat xA(2, ids.size()), xB(2, ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      xA.col(i) = landmark_[ids[i]].observation(frameA)->pos_.cast<double>();
+      xB.col(i) = landmark_[ids[i]].observation(frameB)->pos_.cast<double>();
+    }
+    const std::pair<size_t, size_t> image_size(intrinsic_->w(), intrinsic_->h());
+    sfm::RelativePose_Info relativePose_info;
+    relativePose_info.initial_residual_tolerance = 4.0;
+    if (!sfm::robustRelativePose(intrinsic_.get(), intrinsic_.get(), xA, xB,
+          relativePose_info, image_size, image_size, 256)
+        || relativePose_info.vec_inliers.size() < min_pose_landmarks_)
+    {
+      return false;
+    }
+    // The relative pose is expressed in the frameA coordinate system
+    const geometry::Pose3 & poseA = poses_.at(frameA);
+    poses_[frameB] = relativePose_info.relativePose * poseA;
+
+    std::vector<uint32_t> inliers;
+    inliers.reserve(relativePose_info.vec_inliers.size());
+    for (const uint32_t inlier : relativePose_info.vec_inliers)
+      inliers.push_back(ids[inlier]);
+    if (triangulate(inliers, frameA, frameB) < min_pose_landmarks_)
+    {
+      for (const uint32_t id : inliers)
+        landmark_[id].triangulated_ = false;
+      poses_.erase(frameB);
+      return false;
+    }
+    return true;
+  }
+
+  /// Robust P3P resection of a frame from its tracked & triangulated landmarks
+  bool localize(const uint32_t frameId)
+  {
+    std::vector<uint32_t> ids;
+    for (const uint32_t id : landmarkListPerFrame_[frameId])
+      if (landmark_[id].triangulated_)
+        ids.push_back(id);
+    if (ids.size() < min_pose_landmarks_)
+      return false;
+
+    sfm::Image_Localizer_Match_Data resection_data;
+    resection_data.pt2D.resize(2, ids.size());
+    resection_data.pt3D.resize(3, ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      resection_data.pt2D.col(i) = landmark_[ids[i]].obs_.back().pos_.cast<double>();
+      resection_data.pt3D.col(i) = landmark_[ids[i]].pt_;
+    }
+    resection_data.error_max = 4.0;
+    resection_data.max_iteration = 256;
+
+    geometry::Pose3 pose;
+    const Pair image_size(intrinsic_->w(), intrinsic_->h());
+    if (!sfm::SfM_Localizer::Localize(resection::SolverType::P3P_NORDBERG_ECCV18,
+          image_size, intrinsic_.get(), resection_data, pose)
+        || resection_data.vec_inliers.size() < min_pose_landmarks_)
+    {
+      return false;
+    }
+    sfm::SfM_Localizer::RefinePose(intrinsic_.get(), pose, resection_data, true, false);
+    poses_[frameId] = pose;
+    return true;
+  }
+
+  /// Bundle adjustment of the last keyframes poses & their landmarks.
+  /// The window is anchored by the previous keyframes that observe its
+  /// landmarks: their observations are used but their poses are held constant.
+  /// While there is less than two such keyframes (beginning of the sequence),
+  /// the gauge (position, orientation & scale) is restored after the
+  /// adjustment from the two oldest keyframes of the problem.
+  void localBundleAdjustment()
+  {
+    if (keyframeIds_.size() < 2)
+      return;
+    const size_t window_size = std::min<size_t>(keyframeIds_.size(), ba_window_size_);
+    const std::vector<uint32_t> window(keyframeIds_.end() - window_size, keyframeIds_.end());
+
+    std::set<uint32_t> window_landmarks;
+    for (const uint32_t frameId : window)
+    {
+      for (const uint32_t id : landmarkListPerFrame_[frameId])
+      {
+        if (landmark_[id].triangulated_)
+          window_landmarks.insert(id);
+      }
+    }
+
+    // Previous keyframes (the most recent ones) that observe the window landmarks
+    std::vector<uint32_t> anchors;
+    for (auto it = keyframeIds_.rbegin() + window_size;
+      it != keyframeIds_.rend() && anchors.size() < ba_window_size_; ++it)
+    {
+      const std::set<uint32_t> & ids = landmarkListPerFrame_[*it];
+      if (std::any_of(ids.cbegin(), ids.cend(),
+        [&](const uint32_t id) { return window_landmarks.count(id) != 0; }))
+      {
+        anchors.push_back(*it);
+      }
+    }
+    std::vector<uint32_t> frames(anchors.rbegin(), anchors.rend());
+    frames.insert(frames.end(), window.cbegin(), window.cend());
+
+    // Export the window and its anchors as a SfM scene
+    sfm::SfM_Data sfm_data;
+    sfm_data.intrinsics[0] = intrinsic_;
+    for (const uint32_t frameId : frames)
+    {
+      sfm_data.views[frameId] = std::make_shared<sfm::View>(
+        "", frameId, 0, frameId, intrinsic_->w(), intrinsic_->h());
+      sfm_data.poses[frameId] = poses_.at(frameId);
+    }
+    for (const uint32_t id : window_landmarks)
+    {
+      const Landmark & landmark = landmark_[id];
+      sfm::Landmark sfm_landmark;
+      sfm_landmark.X = landmark.pt_;
+      for (const uint32_t frameId : frames)
+      {
+        const Measurement * obs = landmark.observation(frameId);
+        if (obs)
+          sfm_landmark.obs[frameId] = sfm::Observation(obs->pos_.cast<double>(), id);
+      }
+      if (sfm_landmark.obs.size() > 1)
+        sfm_data.structure[id] = sfm_landmark;
+    }
+
+    sfm::Bundle_Adjustment_Ceres bundle_adjustment_obj(
+      sfm::Bundle_Adjustment_Ceres::BA_Ceres_options(false));
+    sfm::Optimize_Options ba_refine_options(
+      cameras::Intrinsic_Parameter_Type::NONE,
+      sfm::Extrinsic_Parameter_Type::ADJUST_ALL,
+      sfm::Structure_Parameter_Type::ADJUST_ALL);
+    ba_refine_options.constant_poses_opt.insert(anchors.cbegin(), anchors.cend());
+    if (!bundle_adjustment_obj.Adjust(sfm_data, ba_refine_options))
+      return;
+
+    // Restore the gauge if the anchors do not fix it: move the first keyframe
+    // back to its previous pose and keep the distance between the first two keyframes.
+    if (anchors.size() < 2)
+    {
+      const geometry::Pose3 & first = poses_.at(frames[0]);
+      const geometry::Pose3 & first_adjusted = sfm_data.poses.at(frames[0]);
+      const double baseline = (poses_.at(frames[1]).center() - first.center()).norm();
+      const double baseline_adjusted =
+        (sfm_data.poses.at(frames[1]).center() - first_adjusted.center()).norm();
+      if (baseline_adjusted <= 0.0)
+        return;
+      sfm::ApplySimilarity(geometry::Similarity3(first_adjusted, baseline / baseline_adjusted), sfm_data);
+      sfm::ApplySimilarity(geometry::Similarity3(first.inverse(), 1.0), sfm_data);
+    }
+
+    for (const uint32_t frameId : window)
+      poses_[frameId] = sfm_data.poses.at(frameId);
+    for (const auto & landmark_it : sfm_data.structure)
+      landmark_[landmark_it.first].pt_ = landmark_it.second.X;
+  }
+
+  /// Estimate the current frame pose and tell if it must be a keyframe
+  void computePoseAndKeyframe(const uint32_t frameId)
+  {
+    if (keyframeIds_.empty())
+    {
+      resetMotion(frameId); // The first frame is the reference keyframe
+      return;
+    }
+    const uint32_t lastKf = keyframeIds_.back();
+    const std::vector<uint32_t> ids = commonLandmarks(lastKf, frameId);
+    const float parallax = medianParallax(ids, lastKf, frameId);
+
+    if (!initialized_)
+    {
+      if (ids.size() < min_pose_landmarks_)
+      {
+        resetMotion(frameId); // Not enough tracks left, use a new reference keyframe
+      }
+      else if (parallax > keyframe_parallax_ && initialize(ids, lastKf, frameId))
+      {
+        keyframeIds_.push_back(frameId);
+        initialized_ = true;
+        localBundleAdjustment();
+      }
+      return;
+    }
+
+    if (!localize(frameId))
+    {
+      // Pose estimation failed: restart the motion initialization
+      resetMotion(frameId);
+      return;
+    }
+
+    const float track_ratio = ids.size() / static_cast<float>(landmarkListPerFrame_[lastKf].size());
+    if (parallax > keyframe_parallax_ || track_ratio < keyframe_track_ratio_)
+    {
+      keyframeIds_.push_back(frameId);
+      triangulate(ids, lastKf, frameId);
+      localBundleAdjustment();
+    }
+  }
 };
 
 } // namespace VO
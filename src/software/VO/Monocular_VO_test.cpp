@@ -0,0 +1,353 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/cameras/Camera_Pinhole.hpp"
+#include "openMVG/features/feature.hpp"
+#include "openMVG/image/image_container.hpp"
+
+#include "software/VO/Monocular_VO.hpp"
+#include "software/VO/Tracker.hpp"
+#include "software/VO/Tracker_klt.hpp"
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+
+using namespace openMVG;
+using namespace openMVG::VO;
+
+namespace {
+
+// Tracker that shifts the points by one pixel and detects a fixed number of
+//  points (less than the requested count), as a detector on a low texture image
+struct PartialTracker : public Abstract_Tracker
+{
+  size_t detected_count_ = 10;
+
+  bool track
+  (
+    const image::Image<unsigned char> & ima,
+    const std::vector<features::PointFeature> & pt_to_track,
+    std::vector<features::PointFeature> & pt_tracked,
+    std::vector<bool> & status
+  ) override
+  {
+    pt_tracked.resize(pt_to_track.size());
+    for (size_t i = 0; i < pt_to_track.size(); ++i)
+      pt_tracked[i] = features::PointFeature(pt_to_track[i].x() + 1.f, pt_to_track[i].y());
+    // Every slot is reported as tracked, even the unused ones
+    status.assign(pt_to_track.size(), true);
+    return !pt_to_track.empty();
+  }
+
+  bool detect
+  (
+    const image::Image<unsigned char> & ima,
+    std::vector<features::PointFeature> & pt_to_track,
+    const size_t count
+  ) const override
+  {
+    pt_to_track.clear();
+    for (size_t i = 0; i < std::min(count, detected_count_); ++i)
+      pt_to_track.emplace_back(10.f, 10.f * (i + 1));
+    return !pt_to_track.empty();
+  }
+};
+
+// Tracker using the ground truth projections of a synthetic scene
+struct SyntheticTracker : public Abstract_Tracker
+{
+  const std::vector<Vec3> & points_;
+  const std::vector<geometry::Pose3> & poses_;
+  const cameras::Pinhole_Intrinsic & camera_;
+  size_t frame_ = 0;
+  mutable size_t next_point_ = 0;
+  mutable std::map<std::pair<float, float>, size_t> point_id_; // image position -> point id
+
+  SyntheticTracker
+  (
+    const std::vector<Vec3> & points,
+    const std::vector<geometry::Pose3> & poses,
+    const cameras::Pinhole_Intrinsic & camera
+  ): points_(points), poses_(poses), camera_(camera)
+  {
+  }
+
+  bool project(const size_t point_id, Vec2 & x) const
+  {
+    const Vec3 X = poses_[frame_](points_[point_id]);
+    if (X(2) <= 0)
+      return false;
+    x = camera_.project(X);
+    return x(0) >= 0 && x(1) >= 0 && x(0) < camera_.w() && x(1) < camera_.h();
+  }
+
+  bool track
+  (
+    const image::Image<unsigned char> & ima,
+    const std::vector<features::PointFeature> & pt_to_track,
+    std::vector<features::PointFeature> & pt_tracked,
+    std::vector<bool> & status
+  ) override
+  {
+    pt_tracked.resize(pt_to_track.size());
+    status.assign(pt_to_track.size(), false);
+    std::map<std::pair<float, float>, size_t> tracked_point_id;
+    for (size_t i = 0; i < pt_to_track.size(); ++i)
+    {
+      const auto it = point_id_.find({pt_to_track[i].x(), pt_to_track[i].y()});
+      Vec2 x;
+      if (it == point_id_.end() || !project(it->second, x))
+        continue;
+      pt_tracked[i] = features::PointFeature(x(0), x(1));
+      tracked_point_id[{pt_tracked[i].x(), pt_tracked[i].y()}] = it->second;
+      status[i] = true;
+    }
+    point_id_.swap(tracked_point_id);
+    return std::count(status.cbegin(), status.cend(), true) != 0;
+  }
+
+  bool detect
+  (
+    const image::Image<unsigned char> & ima,
+    std::vector<features::PointFeature> & pt_to_track,
+    const size_t count
+  ) const override
+  {
+    pt_to_track.clear();
+    for (; pt_to_track.size() < count && next_point_ < points_.size(); ++next_point_)
+    {
+      Vec2 x;
+      if (!project(next_point_, x))
+        continue;
+      pt_to_track.emplace_back(x(0), x(1));
+      point_id_[{pt_to_track.back().x(), pt_to_track.back().y()}] = next_point_;
+    }
+    return pt_to_track.size() == count;
+  }
+};
+
+// Dark image with a grid of bright squares (4 corners per square),
+//  shifted by offset pixels along the x axis
+image::Image<unsigned char> SquaresImage
+(
+  const int squares_per_row,
+  const int square_rows,
+  const int offset
+)
+{
+  image::Image<unsigned char> ima(320, 240, true, 20);
+  for (int r = 0; r < square_rows; ++r)
+    for (int c = 0; c < squares_per_row; ++c)
+      for (int i = 0; i < 14; ++i)
+        for (int j = 0; j < 14; ++j) // (a small gradient avoids corner score ties)
+          ima(40 + r * 50 + i, 40 + c * 50 + offset + j) = 160 + i + 2 * j;
+  return ima;
+}
+
+// Check that the landmark observations follow the image translation
+bool CheckLandmarkMotion
+(
+  const VO_Monocular & vo,
+  const float motion
+)
+{
+  for (const Landmark & landmark : vo.landmark_)
+  {
+    for (size_t i = 1; i < landmark.obs_.size(); ++i)
+    {
+      const Measurement & a = landmark.obs_[i-1], & b = landmark.obs_[i];
+      if (a.frameId_ + 1 != b.frameId_ ||
+          std::abs(b.pos_(0) - a.pos_(0) - motion) > 0.1f ||
+          std::abs(b.pos_(1) - a.pos_(1)) > 0.1f)
+        return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TEST(VO_Monocular, PartialDetection)
+{
+  // The detector returns less points than the free tracking slots
+  PartialTracker tracker;
+  VO_Monocular vo(&tracker, 50);
+  const image::Image<unsigned char> ima(64, 64, true, 0);
+
+  EXPECT_FALSE(vo.nextFrame(ima, 0));
+  EXPECT_EQ(10, vo.landmark_.size());
+  EXPECT_EQ(10, vo.landmarkListPerFrame_[0].size());
+
+  // The untracked slots stay untracked: only the 10 landmarks are observed
+  //  and 10 new landmarks are created
+  EXPECT_TRUE(vo.nextFrame(ima, 1));
+  EXPECT_EQ(20, vo.landmark_.size());
+  EXPECT_EQ(20, vo.landmarkListPerFrame_[1].size());
+  EXPECT_TRUE(vo.nextFrame(ima, 2));
+  EXPECT_EQ(30, vo.landmark_.size());
+  EXPECT_EQ(30, vo.landmarkListPerFrame_[2].size());
+
+  for (size_t id = 0; id < vo.landmark_.size(); ++id)
+  {
+    // Landmarks created at frame id/10 are observed once per frame
+    EXPECT_EQ(3 - id / 10, vo.landmark_[id].obs_.size());
+  }
+  EXPECT_TRUE(CheckLandmarkMotion(vo, 1.f));
+}
+
+TEST(VO_Monocular, KLT_Tracking)
+{
+  // 12 squares give 48 corners, for 20 tracked features
+  Tracker_KLT tracker;
+  VO_Monocular vo(&tracker, 20);
+  const int frame_count = 10;
+  for (int frame = 0; frame < frame_count; ++frame)
+  {
+    vo.nextFrame(SquaresImage(4, 3, frame), frame);
+    EXPECT_TRUE(vo.landmarkListPerFrame_.back().size() <= 20);
+  }
+  EXPECT_EQ(20, vo.landmarkListPerFrame_.back().size());
+  // Some corners are tracked along the whole sequence
+  const bool full_track = std::any_of(vo.landmark_.cbegin(), vo.landmark_.cend(),
+    [](const Landmark & landmark) { return landmark.obs_.size() == frame_count; });
+  EXPECT_TRUE(full_track);
+  EXPECT_TRUE(CheckLandmarkMotion(vo, 1.f));
+}
+
+TEST(VO_Monocular, KLT_LowTexture)
+{
+  // A single square: far less corners than the tracking slots
+  //  (the detector cannot provide the requested points, nothing is tracked)
+  Tracker_KLT tracker;
+  VO_Monocular vo(&tracker, 500);
+  const int frame_count = 10;
+  for (int frame = 0; frame < frame_count; ++frame)
+  {
+    EXPECT_FALSE(vo.nextFrame(SquaresImage(1, 1, frame), frame));
+    EXPECT_TRUE(vo.landmarkListPerFrame_.back().empty());
+  }
+  EXPECT_TRUE(vo.landmark_.empty());
+  EXPECT_EQ(0, std::count(vo.tracking_status_.cbegin(), vo.tracking_status_.cend(), true));
+}
+
+TEST(Tracker, DetectCount)
+{
+  // The trackers provide exactly count points, or report a failure
+  Tracker_KLT tracker_klt;
+  Tracker_fast_dipole tracker_dipole;
+  const std::vector<Abstract_Tracker*> trackers = {&tracker_klt, &tracker_dipole};
+  for (const Abstract_Tracker * tracker : trackers)
+  {
+    // Single square: 4 corners
+    const image::Image<unsigned char> ima = SquaresImage(1, 1, 0);
+    std::vector<features::PointFeature> pts;
+    EXPECT_TRUE(tracker->detect(ima, pts, 4));
+    EXPECT_EQ(4, pts.size());
+    pts.clear();
+    EXPECT_FALSE(tracker->detect(ima, pts, 5));
+    EXPECT_TRUE(pts.empty());
+  }
+
+  // The KLT tracker corners are far enough from the image border to be tracked
+  //  (the squares are cut by the border area)
+  const int border = tracker_klt.window_half_size_ + 1;
+  image::Image<unsigned char> ima(320, 240, true, 20);
+  for (const int x0 : {-7, 150, 313})
+    for (int i = 0; i < 14; ++i)
+      for (int j = 0; j < 14; ++j)
+        if (x0 + j >= 0 && x0 + j < ima.Width())
+          ima(100 + i, x0 + j) = 160 + i + 2 * j;
+  std::vector<features::PointFeature> pts;
+  EXPECT_TRUE(tracker_klt.detect(ima, pts, 4));
+  EXPECT_FALSE(tracker_klt.detect(ima, pts, 5));
+  for (const features::PointFeature & pt : pts)
+  {
+    EXPECT_TRUE(pt.x() >= border && pt.x() < ima.Width() - border - 1);
+    EXPECT_TRUE(pt.y() >= border && pt.y() < ima.Height() - border - 1);
+  }
+}
+
+TEST(VO_Monocular, MotionEstimation)
+{
+  const cameras::Pinhole_Intrinsic camera(640, 480, 500, 320, 240);
+
+  // Camera moving sideways in front of a random point cloud
+  const int frame_count = 60;
+  std::vector<geometry::Pose3> poses;
+  for (int frame = 0; frame < frame_count; ++frame)
+  {
+    const double s = frame * 0.05;
+    const Mat3 R = Eigen::AngleAxisd(0.05 * std::sin(s), Vec3::UnitY()).toRotationMatrix();
+    poses.emplace_back(R, Vec3(s, 0.1 * std::sin(s), 0));
+  }
+  std::mt19937 random_generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  std::vector<Vec3> points;
+  for (int i = 0; i < 20000; ++i)
+  {
+    points.emplace_back(
+      distribution(random_generator) * 8 + 1.5,
+      distribution(random_generator) * 3,
+      6 + 3 * distribution(random_generator));
+  }
+
+  SyntheticTracker tracker(points, poses, camera);
+  VO_Monocular vo(&tracker, 300, std::make_shared<cameras::Pinhole_Intrinsic>(camera));
+  const image::Image<unsigned char> ima(camera.w(), camera.h(), true, 0);
+  std::map<uint32_t, geometry::Pose3> previous_keyframes;
+  for (int frame = 0; frame < frame_count; ++frame)
+  {
+    tracker.frame_ = frame;
+    vo.nextFrame(ima, frame);
+
+    // The keyframes that left the sliding window keep their pose
+    for (const auto & pose_it : previous_keyframes)
+    {
+      EXPECT_MATRIX_NEAR(pose_it.second.rotation(), vo.poses_.at(pose_it.first).rotation(), 1e-12);
+      EXPECT_MATRIX_NEAR(pose_it.second.center(), vo.poses_.at(pose_it.first).center(), 1e-12);
+    }
+    if (vo.keyframeIds_.size() > vo.ba_window_size_)
+    {
+      const uint32_t id = vo.keyframeIds_[vo.keyframeIds_.size() - vo.ba_window_size_ - 1];
+      previous_keyframes.emplace(id, vo.poses_.at(id));
+    }
+  }
+
+  // Keyframes have been inserted and the frames are localized
+  EXPECT_TRUE(vo.keyframeIds_.size() >= 3);
+  EXPECT_TRUE(vo.poses_.size() >= frame_count / 2);
+
+  // Compare with the ground truth, up to the similarity given by the first
+  //  two keyframes (the monocular motion is known up to scale)
+  const uint32_t a = vo.keyframeIds_[0], b = vo.keyframeIds_[1];
+  const geometry::Pose3 & pose_a = vo.poses_.at(a);
+  const double scale = (poses[b].center() - poses[a].center()).norm()
+    / (vo.poses_.at(b).center() - pose_a.center()).norm();
+  const double trajectory_length = (poses.back().center() - poses.front().center()).norm();
+  for (const auto & pose_it : vo.poses_)
+  {
+    const uint32_t frame = pose_it.first;
+    if (frame < a)
+      continue;
+    const Vec3 center = poses[a].rotation().transpose() *
+      (scale * (pose_a.rotation() * (pose_it.second.center() - pose_a.center())))
+      + poses[a].center();
+    EXPECT_TRUE((center - poses[frame].center()).norm() < 0.01 * trajectory_length);
+
+    const Mat3 relative_rotation = pose_it.second.rotation() * pose_a.rotation().transpose();
+    const Mat3 gt_relative_rotation = poses[frame].rotation() * poses[a].rotation().transpose();
+    EXPECT_NEAR(0.0, Eigen::AngleAxisd(relative_rotation * gt_relative_rotation.transpose()).angle(), 1e-3);
+  }
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
+/* ************************************************************************* */
@@ -16,7 +16,6 @@
 #include <openMVG/features/feature_container.hpp>
 #include "openMVG/matching/metric.hpp"
 
-#include <random>
 #include <vector>
 
 namespace openMVG  {
@@ -111,25 +110,15 @@ struct Tracker_fast_dipole : public Abstract_Tracker
     const size_t count
   ) const override
   {
-    std::mt19937 gen(std::mt19937::default_seed);
-    const std::vector<unsigned char> scores = {30, 20, 10, 5};
-    // use a sequence of scores 'in order to deal with lighting change'
+    // Corners evenly spread over the image
+    //  (the grid cells use an adaptive threshold 'in order to deal with lighting change')
     features::PointFeatures feats;
-    for (const unsigned char fast_score : scores)
+    features::FastCornerDetector fastCornerDetector(9, 30);
+    fastCornerDetector.detect(ima, feats, count, 64, 5);
+    if (feats.size() == count)
     {
-      features::FastCornerDetector fastCornerDetector(9, fast_score);
-      fastCornerDetector.detect(ima, feats);
-
-      if (feats.size() > count)
-      {
-        // shuffle to avoid to sample only in one bucket
-        std::shuffle(feats.begin(), feats.end(), gen);
-        feats.resize(count); // cut the array to keep only a given count of features
-        pt_to_track.swap(feats);
-
-        return true;
-      }
-      feats.clear();
+      pt_to_track.swap(feats);
+      return true;
     }
     return false; // Cannot compute a sufficient number of points for the given image
   }
@@ -0,0 +1,302 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2026 openMVG authors.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef TRACKER_KLT_VO_HPP
+#define TRACKER_KLT_VO_HPP
+
+#include "openMVG/features/fast/fast_detector.hpp"
+#include "openMVG/features/feature.hpp"
+#include "openMVG/features/feature_container.hpp"
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/image/image_filtering.hpp"
+#include "openMVG/image/image_resampling.hpp"
+
+#include <software/VO/Abstract_Tracker.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace openMVG  {
+namespace VO  {
+
+/// Pyramidal Lucas-Kanade feature tracker (OpenCV free).
+/// Implements the iterative pyramidal scheme of:
+/// [1] "Pyramidal Implementation of the Lucas Kanade Feature Tracker,
+///      Description of the algorithm". Jean-Yves Bouguet. Intel Corporation.
+///
+/// - Each frame is converted to a float Gaussian pyramid (blur + decimation),
+/// - the template patch and its Scharr gradients are sampled once per level
+///    from the previous frame,
+/// - the patch of the current frame is resampled at each iteration.
+/// Since all the pixels of a patch share the same sub-pixel offset, the
+/// bilinear interpolation uses the same four weights for the whole patch and
+/// the patch rows are processed as contiguous arrays (SIMD friendly loops).
+struct Tracker_KLT : public Abstract_Tracker
+{
+  using Pyramid = std::vector<image::Image<float>>;
+
+  // Tracker parameters
+  int pyramid_levels_;      // Number of pyramid levels (1 = no pyramid)
+  int window_half_size_;    // Patch is (2 * window_half_size_ + 1)^2
+  int max_iteration_;       // Maximal number of Gauss-Newton iterations per level
+  float epsilon_;           // Displacement update convergence threshold (in pixel)
+  float min_eigen_value_;   // Min eigenvalue of the (per pixel) structure tensor
+  float max_residual_;      // Max mean absolute intensity residual of a track
+
+  // data for tracking (previous frame pyramid and its gradients)
+  Pyramid prev_pyramid_, prev_dx_, prev_dy_;
+
+  explicit Tracker_KLT
+  (
+    const int pyramid_levels = 3,
+    const int window_half_size = 7,
+    const int max_iteration = 20,
+    const float epsilon = 0.01f,
+    const float min_eigen_value = 1.0f,
+    const float max_residual = 20.f
+  ):
+    pyramid_levels_(std::max(1, pyramid_levels)),
+    window_half_size_(window_half_size),
+    max_iteration_(max_iteration),
+    epsilon_(epsilon),
+    min_eigen_value_(min_eigen_value),
+    max_residual_(max_residual)
+  {
+  }
+
+  /// Try to track current point set in the provided image
+  /// return false when tracking failed (=> to send frame to relocalization)
+  bool track
+  (
+    const image::Image<unsigned char> & ima,
+    const std::vector<features::PointFeature> & pt_to_track,
+    std::vector<features::PointFeature> & pt_tracked,
+    std::vector<bool> & status
+  ) override
+  {
+    Pyramid pyramid;
+    BuildPyramid(ima, pyramid);
+
+    std::vector<unsigned char> tracked(pt_to_track.size(), 0);
+    if (!pt_to_track.empty() && !prev_pyramid_.empty())
+    {
+      pt_tracked.resize(pt_to_track.size());
+      #ifdef OPENMVG_USE_OPENMP
+      #pragma omp parallel for schedule(dynamic)
+      #endif
+      for (int i = 0; i < static_cast<int>(pt_to_track.size()); ++i)
+      {
+        Vec2f pos;
+        tracked[i] = TrackPoint(pyramid, pt_to_track[i].coords(), pos);
+        pt_tracked[i].coords() = pos;
+      }
+    }
+    status.assign(tracked.cbegin(), tracked.cend());
+
+    // swap frame for the next tracking iteration
+    // (only the template gradients of the previous frame are required)
+    prev_dx_.resize(pyramid.size());
+    prev_dy_.resize(pyramid.size());
+    for (size_t level = 0; level < pyramid.size(); ++level)
+    {
+      image::ImageScharrXDerivative(pyramid[level], prev_dx_[level]);
+      image::ImageScharrYDerivative(pyramid[level], prev_dy_[level]);
+    }
+    prev_pyramid_.swap(pyramid);
+
+    const size_t tracked_point_count = std::accumulate(status.begin(), status.end(), 0);
+    return (tracked_point_count != 0);
+  }
+
+  // suggest new feature point for tracking (count point are kept)
+  // (as Tracker_fast_dipole, return false if count trackable points cannot be found)
+  bool detect
+  (
+    const image::Image<unsigned char> & ima,
+    std::vector<features::PointFeature> & pt_to_track,
+    const size_t count
+  ) const override
+  {
+    // Points too close to the border cannot be tracked on the first level:
+    //  the corners are detected in the trackable area only
+    //  (FAST tests the pixels 3 pixels away from the area border)
+    const int border = window_half_size_ + 1;
+    const int
+      x_begin = std::max(0, border - 3), x_end = std::min(ima.Width(), ima.Width() - border + 2),
+      y_begin = std::max(0, border - 3), y_end = std::min(ima.Height(), ima.Height() - border + 2);
+    if (x_end - x_begin <= 6 || y_end - y_begin <= 6)
+      return false;
+    const image::Image<unsigned char> trackable_area(
+      ima.GetMat().block(y_begin, x_begin, y_end - y_begin, x_end - x_begin));
+
+    // Corners evenly spread over the image (adaptive threshold per grid cell)
+    features::PointFeatures feats;
+    features::FastCornerDetector fastCornerDetector(9, 30);
+    fastCornerDetector.detect(trackable_area, feats, count, 64, 5);
+    if (feats.size() == count)
+    {
+      for (features::PointFeature & pt : feats)
+        pt.coords() += Vec2f(x_begin, y_begin);
+      pt_to_track.swap(feats);
+      return true;
+    }
+    return false; // Cannot compute a sufficient number of points for the given image
+  }
+
+private:
+
+  /// Build a Gaussian pyramid: each level is blurred and decimated by 2,
+  /// a pixel (x,y) of the level l is located at (x,y) * 2^l in the base image.
+  void BuildPyramid
+  (
+    const image::Image<unsigned char> & ima,
+    Pyramid & pyramid
+  ) const
+  {
+    pyramid.resize(pyramid_levels_);
+    pyramid[0] = ima.GetMat().cast<float>();
+    image::Image<float> blurred;
+    for (int level = 1; level < pyramid_levels_; ++level)
+    {
+      image::ImageGaussianFilter(pyramid[level-1], 1.0, blurred, 2);
+      image::ImageDecimate(blurred, pyramid[level]);
+    }
+  }
+
+  /// Tell if the patch centered on pos can be bilinearly sampled in the image
+  bool IsPatchInside
+  (
+    const image::Image<float> & ima,
+    const Vec2f & pos
+  ) const
+  {
+    // (written with float comparisons in order to reject diverged (nan) positions)
+    return pos(0) >= window_half_size_ && pos(1) >= window_half_size_
+      && pos(0) < ima.Width() - window_half_size_ - 1
+      && pos(1) < ima.Height() - window_half_size_ - 1;
+  }
+
+  /// Bilinear resampling of the patch centered on pos
+  /// (all the patch pixels share the same four interpolation weights).
+  void SamplePatch
+  (
+    const image::Image<float> & ima,
+    const Vec2f & pos,
+    float * patch
+  ) const
+  {
+    const int win = 2 * window_half_size_ + 1;
+    const int x = static_cast<int>(std::floor(pos(0))), y = static_cast<int>(std::floor(pos(1)));
+    const float ax = pos(0) - x, ay = pos(1) - y;
+    const float
+      w00 = (1.f - ax) * (1.f - ay), w01 = ax * (1.f - ay),
+      w10 = (1.f - ax) * ay,         w11 = ax * ay;
+    const int stride = ima.Width();
+    const float * row = ima.data() + (y - window_half_size_) * stride + x - window_half_size_;
+    for (int r = 0; r < win; ++r, row += stride, patch += win)
+    {
+      const float * row0 = row, * row1 = row + stride;
+      for (int c = 0; c < win; ++c)
+      {
+        patch[c] = w00 * row0[c] + w01 * row0[c+1] + w10 * row1[c] + w11 * row1[c+1];
+      }
+    }
+  }
+
+  /// Track a single point from the previous pyramid to the current one
+  /// return true if the point has been tracked (pos is then the found position)
+  bool TrackPoint
+  (
+    const Pyramid & pyramid,
+    const Vec2f & prev_pos,
+    Vec2f & pos
+  ) const
+  {
+    const int win = 2 * window_half_size_ + 1;
+    const int patch_size = win * win;
+    std::vector<float> buffer(4 * patch_size);
+    float
+      * templ = &buffer[0],
+      * grad_x = &buffer[patch_size],
+      * grad_y = &buffer[2 * patch_size],
+      * current = &buffer[3 * patch_size];
+
+    Vec2f displacement = Vec2f::Zero();
+    bool converged = false;
+    for (int level = pyramid_levels_ - 1; level >= 0; --level)
+    {
+      const float scale = 1.f / (1 << level);
+      const Vec2f prev_pos_level = prev_pos * scale;
+      if (level != pyramid_levels_ - 1)
+        displacement *= 2.f; // propagate the coarser level estimate
+
+      if (!IsPatchInside(prev_pyramid_[level], prev_pos_level))
+      {
+        if (level == 0)
+          return false;
+        continue; // The point is too close to the border for this level
+      }
+
+      // Template patch, gradients & structure tensor
+      SamplePatch(prev_pyramid_[level], prev_pos_level, templ);
+      SamplePatch(prev_dx_[level], prev_pos_level, grad_x);
+      SamplePatch(prev_dy_[level], prev_pos_level, grad_y);
+      float gxx = 0.f, gxy = 0.f, gyy = 0.f;
+      for (int k = 0; k < patch_size; ++k)
+      {
+        gxx += grad_x[k] * grad_x[k];
+        gxy += grad_x[k] * grad_y[k];
+        gyy += grad_y[k] * grad_y[k];
+      }
+      const float min_eigen_value =
+        (gxx + gyy - std::sqrt((gxx - gyy) * (gxx - gyy) + 4.f * gxy * gxy)) / (2.f * patch_size);
+      if (min_eigen_value < min_eigen_value_)
+        return false; // Not enough texture to solve the aperture problem
+      const float inv_det = 1.f / (gxx * gyy - gxy * gxy);
+
+      // Gauss-Newton iterations
+      converged = false;
+      for (int iter = 0; iter < max_iteration_ && !converged; ++iter)
+      {
+        const Vec2f current_pos = prev_pos_level + displacement;
+        if (!IsPatchInside(pyramid[level], current_pos))
+          return false;
+        SamplePatch(pyramid[level], current_pos, current);
+
+        float bx = 0.f, by = 0.f;
+        for (int k = 0; k < patch_size; ++k)
+        {
+          const float residual = templ[k] - current[k];
+          bx += residual * grad_x[k];
+          by += residual * grad_y[k];
+        }
+        const Vec2f delta((gyy * bx - gxy * by) * inv_det, (gxx * by - gxy * bx) * inv_det);
+        displacement += delta;
+        converged = delta.squaredNorm() < epsilon_ * epsilon_;
+      }
+    }
+
+    pos = prev_pos + displacement;
+    if (!IsPatchInside(pyramid[0], pos))
+      return false;
+
+    // Reject tracks with a too large photometric residual (occlusion, drift)
+    SamplePatch(pyramid[0], pos, current);
+    float residual = 0.f;
+    for (int k = 0; k < patch_size; ++k)
+      residual += std::abs(templ[k] - current[k]);
+    return residual < max_residual_ * patch_size;
+  }
+};
+
+} // namespace VO
+} // namespace openMVG
+
+#endif // TRACKER_KLT_VO_HPP
@@ -12,10 +12,12 @@
 #include "software/VO/CGlWindow.hpp"
 #include "software/VO/Monocular_VO.hpp"
 #include "software/VO/Tracker.hpp"
+#include "software/VO/Tracker_klt.hpp"
 #if defined HAVE_OPENCV
 #include "software/VO/Tracker_opencv_klt.hpp"
 #endif
 
+#include "openMVG/cameras/Camera_Pinhole.hpp"
 #include "openMVG/sfm/sfm_data.hpp"
 #include "openMVG/sfm/sfm_data_io.hpp"
 
@@ -38,11 +40,13 @@ int main(int argc, char **argv)
   std::string sOutFile = "";
   unsigned int uTracker = 0;
   unsigned int uTrackerPointCount = 1500;
+  double focal_pixels = -1.0;
 
   cmd.add( make_option('i', sImaDirectory, "imadir") );
   cmd.add( make_option('t', uTracker, "tracker") );
   cmd.add( make_option('o', sOutFile, "output_file") );
   cmd.add( make_option('p', uTrackerPointCount, "point_count") );
+  cmd.add( make_option('f', focal_pixels, "focal") );
   cmd.add( make_switch('d', "disable_tracking_display") );
 
   try {
@@ -57,7 +61,10 @@ int main(int argc, char **argv)
 #if defined HAVE_OPENCV
     << "\t 1: Feature tracking based tracking; Fast + KLT pyramidal tracking. \n"
 #endif
+    << "\t 2: Feature tracking based tracking; Fast + native KLT pyramidal tracking. \n"
     << "[-p|--point_count] Number of points to track. (default: " << uTrackerPointCount << ")\n"
+    << "[-f|--focal] Focal length in pixels (principal point at the image center).\n"
+    << "\t If set, the camera motion is estimated (keyframes + local bundle adjustment).\n"
     << "[-d|--disable_tracking_display] Disable tracking display \n"
     << std::endl;
 
@@ -71,6 +78,7 @@ int main(int argc, char **argv)
             << "--output_file " << sOutFile << std::endl
             << "--point_count " << uTrackerPointCount << std::endl
             << "--tracker " << uTracker << std::endl
+            << "--focal " << focal_pixels << std::endl
             << "--disable_tracking_display " << static_cast<int>(cmd.used('d')) << std::endl;
 
   if (sImaDirectory.empty() || !stlplus::is_folder(sImaDirectory))
@@ -136,6 +144,9 @@ int main(int argc, char **argv)
       tracker_ptr.reset(new Tracker_opencv_KLT);
     break;
 #endif
+    case 2:
+      tracker_ptr.reset(new Tracker_KLT);
+    break;
     default:
     std::cerr << "Unknow tracking method" << std::endl;
     return EXIT_FAILURE;
@@ -160,6 +171,14 @@ int main(int argc, char **argv)
       {
         // no window created yet, initialize it with the first frame
 
+        if (focal_pixels > 0)
+        {
+          // Camera model used for the motion estimation
+          monocular_vo.intrinsic_ = std::make_shared<cameras::Pinhole_Intrinsic>(
+            currentImage.Width(), currentImage.Height(), focal_pixels,
+            currentImage.Width() / 2.0, currentImage.Height() / 2.0);
+        }
+
         const double aspect_ratio = currentImage.Width() / (double)currentImage.Height();
         window.Init(640, 640 / aspect_ratio, "VisualOdometry--TrackingViewer");
         glGenTextures(1, &text2D);             //allocate the memory for texture
@@ -266,6 +285,23 @@ int main(int argc, char **argv)
   openMVG::sfm::SfM_Data sfm_data;
   ConvertVOLandmarkToSfMDataLandmark(monocular_vo.landmark_, sfm_data.structure);
   std::cout << "Found SFM #landmarks: " << sfm_data.structure.size() << std::endl;
+  if (monocular_vo.intrinsic_)
+  {
+    // Export the camera motion (the views are indexed by frameId)
+    sfm_data.s_root_path = sImaDirectory;
+    sfm_data.intrinsics[0] = monocular_vo.intrinsic_;
+    for (size_t i = 0; i < vec_image.size(); ++i)
+    {
+      sfm_data.views[i] = std::make_shared<sfm::View>(vec_image[i], i, 0, i,
+        monocular_vo.intrinsic_->w(), monocular_vo.intrinsic_->h());
+    }
+    for (const auto & pose_it : monocular_vo.poses_)
+    {
+      sfm_data.poses[pose_it.first] = pose_it.second;
+    }
+    std::cout << "Found SFM #poses: " << sfm_data.poses.size()
+      << " (#keyframes: " << monocular_vo.keyframeIds_.size() << ")" << std::endl;
+  }
   if (!Save(sfm_data, sOutFile, openMVG::sfm::ESfM_Data(openMVG::sfm::ALL)))
     return EXIT_FAILURE;
 